@@ -198,7 +198,8 @@ public:
 enum ObIOContextType : uint8_t
 {
   IO_CONTEXT_TYPE_LOCAL = 0,
-  IO_CONTEXT_TYPE_LOCAL_CACHE = 1
+  IO_CONTEXT_TYPE_LOCAL_CACHE = 1,
+  IO_CONTEXT_TYPE_LOCAL_URING = 2
 };
 
 class ObIOContext
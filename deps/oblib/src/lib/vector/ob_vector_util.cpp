@@ -90,10 +90,32 @@ bool check_vsag_init()
 #endif
 }
 
+int set_parallel_executor(obvectorlib::ParallelExecutor executor)
+{
+  INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+  return ret;
+#else
+  obvectorlib::set_parallel_executor(executor);
+  return ret;
+#endif
+}
+
+int set_disk_index_dir(const char *dir)
+{
+  INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+  return ret;
+#else
+  obvectorlib::set_disk_index_dir(dir);
+  return ret;
+#endif
+}
+
 int create_index(obvectorlib::VectorIndexPtr& index_handler, int index_type,
                  const char* dtype, const char* metric, int dim,
                  int max_degree, int ef_construction, int ef_search,
-                 void* allocator)
+                 void* allocator, int build_thread_num)
 {
   INIT_SUCC(ret);
 #ifdef OB_BUILD_CDC_DISABLE_VSAG
@@ -108,7 +130,8 @@ int create_index(obvectorlib::VectorIndexPtr& index_handler, int index_type,
                                    max_degree,
                                    ef_construction,
                                    ef_search,
-                                   allocator);
+                                   allocator,
+                                   build_thread_num);
 #endif
 }
 
@@ -157,6 +180,28 @@ int knn_search(obvectorlib::VectorIndexPtr index_handler, float* query_vector,in
 #endif
 }
 
+int knn_search_batch(obvectorlib::VectorIndexPtr index_handler, float* query_vectors, int64_t query_num,
+                     int dim, int64_t topk, const float** result_dists, const int64_t** result_ids,
+                     int64_t* result_sizes, int ef_search, void* invalid,
+                     const std::atomic<float>* distance_bounds,
+                     std::atomic<float>* result_bounds,
+                     void* valid)
+{
+  INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+  return ret;
+#else
+  obvectorlib::SearchParam param;
+  param.ef_search_ = ef_search;
+  param.distance_bounds_ = distance_bounds;
+  param.result_bounds_ = result_bounds;
+  param.valid_ = valid;
+  return obvectorlib::knn_search_batch(index_handler, query_vectors, query_num, dim, topk,
+                                       result_dists, result_ids, result_sizes,
+                                       param, invalid);
+#endif
+}
+
 int fserialize(obvectorlib::VectorIndexPtr index_handler, std::ostream& out_stream)
 {
     INIT_SUCC(ret);
@@ -187,6 +232,105 @@ int delete_index(obvectorlib::VectorIndexPtr& index_handler)
 #endif
 }
 
+int remove_index(obvectorlib::VectorIndexPtr index_handler, int64_t* ids, int64_t size, int64_t &removed_cnt)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    removed_cnt = 0;
+    return ret;
+#else
+    return obvectorlib::remove_index(index_handler, ids, size, removed_cnt);
+#endif
+}
+
+int prepare_compact_index(obvectorlib::VectorIndexPtr index_handler)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    return ret;
+#else
+    return obvectorlib::prepare_compact_index(index_handler);
+#endif
+}
+
+int compact_index(obvectorlib::VectorIndexPtr index_handler, int64_t &removed_cnt)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    removed_cnt = 0;
+    return ret;
+#else
+    return obvectorlib::compact_index(index_handler, removed_cnt);
+#endif
+}
+
+int calibrate_recall(obvectorlib::VectorIndexPtr index_handler,
+                     int64_t topk,
+                     const int64_t* ef_searches,
+                     int64_t ef_cnt,
+                     int64_t sample_cnt,
+                     float* recalls)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    return ret;
+#else
+    return obvectorlib::calibrate_recall(index_handler, topk, ef_searches, ef_cnt, sample_cnt, recalls);
+#endif
+}
+
+int knn_search_iterator(obvectorlib::VectorIndexPtr index_handler, float* query_vector, int dim,
+                        obvectorlib::VectorIteratorPtr& iter)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    return ret;
+#else
+    return obvectorlib::knn_search_iterator(index_handler, query_vector, dim, iter);
+#endif
+}
+
+int knn_search_next(obvectorlib::VectorIndexPtr index_handler, obvectorlib::VectorIteratorPtr iter,
+                    int64_t topk, const float*& result_dist, const int64_t*& result_ids,
+                    int64_t &result_size, int ef_search, void* invalid)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    return ret;
+#else
+    obvectorlib::SearchParam param;
+    param.ef_search_ = ef_search;
+    return obvectorlib::knn_search_next(index_handler, iter, topk, result_dist, result_ids,
+                                        result_size, param, invalid);
+#endif
+}
+
+int delete_iterator(obvectorlib::VectorIteratorPtr& iter)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    return ret;
+#else
+    return obvectorlib::delete_iterator(iter);
+#endif
+}
+
+int range_search(obvectorlib::VectorIndexPtr index_handler, float* query_vector, int dim,
+                 float radius, int64_t limit, const float*& result_dist, const int64_t*& result_ids,
+                 int64_t &result_size, int ef_search, void* invalid, void* valid)
+{
+    INIT_SUCC(ret);
+#ifdef OB_BUILD_CDC_DISABLE_VSAG
+    return ret;
+#else
+    obvectorlib::SearchParam param;
+    param.ef_search_ = ef_search;
+    param.valid_ = valid;
+    return obvectorlib::range_search(index_handler, query_vector, dim, radius, limit, result_dist,
+                                     result_ids, result_size, param, invalid);
+#endif
+}
+
 } //namespace obvectorlib
 } //namespace common
 } //namespace oceanbase
\ No newline at end of file
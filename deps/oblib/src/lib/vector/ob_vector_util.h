@@ -48,10 +48,14 @@ int init_vasg_logger(void* logger);
 
 bool check_vsag_init();
 
+int set_parallel_executor(obvectorlib::ParallelExecutor executor);
+
+int set_disk_index_dir(const char *dir);
+
 int create_index(obvectorlib::VectorIndexPtr& index_handler, int index_type,
                  const char* dtype, const char* metric, int dim,
                  int max_degree, int ef_construction, int ef_search,
-                 void* allocator = NULL);
+                 void* allocator = NULL, int build_thread_num = 1);
 
 int build_index(obvectorlib::VectorIndexPtr index_handler, float* vector_list, int64_t* ids, int dim, int size);
 
@@ -63,10 +67,62 @@ int knn_search(obvectorlib::VectorIndexPtr index_handler,float* query_vector,int
                const float*& result_dist, const int64_t*& result_ids, int64_t &result_size, int ef_search,
                void* invalid = NULL);
 
+// search query_num vectors stored continuously in query_vectors, the result of the i-th query is
+// returned in result_dists[i], result_ids[i] and result_sizes[i].
+// when the results are merged with another index, the i-th query stops once its candidates are
+// farther than distance_bounds[i], and publishes its k-th distance to result_bounds[i].
+// when valid is set, only the ids in it are returned.
+int knn_search_batch(obvectorlib::VectorIndexPtr index_handler, float* query_vectors, int64_t query_num,
+                     int dim, int64_t topk, const float** result_dists, const int64_t** result_ids,
+                     int64_t* result_sizes, int ef_search, void* invalid = NULL,
+                     const std::atomic<float>* distance_bounds = NULL,
+                     std::atomic<float>* result_bounds = NULL,
+                     void* valid = NULL);
+
 int fserialize(obvectorlib::VectorIndexPtr index_handler, std::ostream& out_stream);
 
 int fdeserialize(obvectorlib::VectorIndexPtr& index_handler, std::istream& in_stream);
 int delete_index(obvectorlib::VectorIndexPtr& index_handler);
+
+// mark the vectors of ids deleted, the ids not in the index are ignored and removed_cnt is the
+// number of marked ones. searches can run on the index meanwhile.
+int remove_index(obvectorlib::VectorIndexPtr index_handler, int64_t* ids, int64_t size, int64_t &removed_cnt);
+
+// compute the repaired links around the vectors marked deleted, without changing the index.
+// searches can run on the index meanwhile.
+int prepare_compact_index(obvectorlib::VectorIndexPtr index_handler);
+
+// remove the vectors marked deleted and repair the graph around them, by the links computed by
+// prepare_compact_index. no other operation can run on the index meanwhile.
+int compact_index(obvectorlib::VectorIndexPtr index_handler, int64_t &removed_cnt);
+
+// measure the average recall of topk searches with each of ef_searches, by searching sampled
+// vectors of the index and comparing with an exact scan. recalls has ef_cnt slots.
+int calibrate_recall(obvectorlib::VectorIndexPtr index_handler,
+                     int64_t topk,
+                     const int64_t* ef_searches,
+                     int64_t ef_cnt,
+                     int64_t sample_cnt,
+                     float* recalls);
+
+// start a knn search whose results are fetched in batches by knn_search_next, the iter is freed
+// by delete_iterator.
+int knn_search_iterator(obvectorlib::VectorIndexPtr index_handler, float* query_vector, int dim,
+                        obvectorlib::VectorIteratorPtr& iter);
+
+// fetch the next topk nearest results of the iter, the results fetched before are skipped. less
+// than topk results are returned once the search ends.
+int knn_search_next(obvectorlib::VectorIndexPtr index_handler, obvectorlib::VectorIteratorPtr iter,
+                    int64_t topk, const float*& result_dist, const int64_t*& result_ids,
+                    int64_t &result_size, int ef_search, void* invalid = NULL);
+
+int delete_iterator(obvectorlib::VectorIteratorPtr& iter);
+
+// return the results within radius of the query, nearest first, at most limit of them. radius is
+// in the metric of the index, which is the squared distance for l2.
+int range_search(obvectorlib::VectorIndexPtr index_handler, float* query_vector, int dim,
+                 float radius, int64_t limit, const float*& result_dist, const int64_t*& result_ids,
+                 int64_t &result_size, int ef_search, void* invalid = NULL, void* valid = NULL);
 } // namesapce obvectorutil
 } // namespace common
 } // namespace oceanbase
@@ -38,6 +38,9 @@ extern const char* const METRIC_L2;
 extern const char* const METRIC_COSINE;
 extern const char* const METRIC_IP;
 extern const char* const DATATYPE_FLOAT32;
+extern const char* const DATATYPE_FLOAT16;
+extern const char* const DATATYPE_BFLOAT16;
+extern const char* const DATATYPE_INT8;
 extern const char* const BLANK_INDEX;
 
 // parameters
@@ -67,6 +70,9 @@ extern const char* const HNSW_PARAMETER_M;
 extern const char* const HNSW_PARAMETER_CONSTRUCTION;
 extern const char* const HNSW_PARAMETER_USE_STATIC;
 extern const char* const HNSW_PARAMETER_REVERSED_EDGES;
+extern const char* const HNSW_PARAMETER_BUILD_THREAD_NUM;
+extern const char* const HNSW_PARAMETER_USE_SQ8;
+extern const char* const HNSW_PARAMETER_ELEMENT_TYPE;
 
 // statstic key
 extern const char* const STATSTIC_MEMORY;
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -33,6 +34,30 @@ namespace vsag {
 class Index;
 using IndexPtr = std::shared_ptr<Index>;
 
+/**
+  * The state of a knn search that is resumed by KnnSearchNext, created by KnnSearchIterator
+  */
+class IteratorContext {
+public:
+    virtual ~IteratorContext() = default;
+};
+using IteratorContextPtr = std::shared_ptr<IteratorContext>;
+
+/**
+  * Typed search parameters, used instead of the json string to avoid building and
+  * parsing json on the query path
+  */
+struct SearchParam {
+    // [hnsw] size of the dynamic candidate list
+    int64_t ef_search = 0;
+    // [hnsw] enhance the result by conjugate graph if the index has one
+    bool use_conjugate_graph_search = true;
+    // [hnsw] stop the search once the nearest unvisited candidate is farther than the bound,
+    // used when the results are merged with another search that may already have k results
+    // closer than the bound. the bound can be lowered by another thread during the search
+    const std::atomic<float>* distance_bound = nullptr;
+};
+
 class Index {
 public:
     // [basic methods]
@@ -117,6 +142,25 @@ public:
               const std::string& parameters,
               const std::function<bool(int64_t)>& filter) const = 0;
 
+    /**
+      * Performing single KNN search on index with typed parameters
+      *
+      * @param query should contains dim, num_elements and vectors
+      * @param k the result size of every query
+      * @param param the typed search parameters
+      * @param filter represents whether an element is filtered out by pre-filter
+      * @return result contains
+      *                - num_elements: 1
+      *                - ids, distances: length is (num_elements * k)
+      */
+    virtual tl::expected<DatasetPtr, Error>
+    KnnSearch(const DatasetPtr& query,
+              int64_t k,
+              const SearchParam& param,
+              const std::function<bool(int64_t)>& filter) const {
+        throw std::runtime_error("Index not support knn search with typed parameters");
+    }
+
     /**
       * Performing single range search on index
       *
@@ -221,6 +265,88 @@ public:
         throw std::runtime_error("Index doesn't support get distance by id");
     };
 
+    /**
+     * Relabel the vectors inside the index so that the neighbors in the graph are close in
+     * memory, the ids of the vectors are not changed.
+     *
+     * @return result indicates whether the index is reordered.
+     */
+    virtual tl::expected<bool, Error>
+    Reorder() {
+        throw std::runtime_error("Index doesn't support reorder");
+    };
+
+    /**
+     * Prepare the graph repair of the next Compact, without blocking the searches. Compact
+     * repairs the graph by itself when the index is changed in between.
+     *
+     * @return result is the number of repaired links.
+     */
+    virtual tl::expected<uint32_t, Error>
+    PrepareCompact() {
+        throw std::runtime_error("Index doesn't support compact");
+    };
+
+    /**
+     * Physically remove the vectors removed by Remove, and repair the graph around them.
+     *
+     * @return result is the number of vectors removed from the index.
+     */
+    virtual tl::expected<uint32_t, Error>
+    Compact() {
+        throw std::runtime_error("Index doesn't support compact");
+    };
+
+    /**
+     * Measure the recall of knn searches with each ef_search, by using sampled vectors of the
+     * index as queries and comparing the results with an exact scan.
+     *
+     * @param k is the number of neighbors searched for each query.
+     * @param ef_searches are the ef_search values to measure.
+     * @param sample_count is the number of sampled queries.
+     * @return result is the average recall of each ef_search, in the same order.
+     */
+    virtual tl::expected<std::vector<float>, Error>
+    CalibrateRecall(int64_t k,
+                    const std::vector<int64_t>& ef_searches,
+                    int64_t sample_count) const {
+        throw std::runtime_error("Index doesn't support calibrate recall");
+    };
+
+    /**
+     * Start a knn search whose results are fetched in batches by KnnSearchNext, so that more
+     * neighbors can be fetched without searching again from the entry point.
+     *
+     * @param query should contains dim, num_elements(must be 1) and vectors
+     * @return result is the context of the search, which keeps the visited vectors.
+     */
+    virtual tl::expected<IteratorContextPtr, Error>
+    KnnSearchIterator(const DatasetPtr& query) const {
+        throw std::runtime_error("Index doesn't support knn search iterator");
+    };
+
+    /**
+     * Fetch the next k nearest neighbors of the search, the neighbors fetched before are not
+     * returned again. Once the index is compacted or reordered, the search starts again from
+     * the entry point and still skips the neighbors fetched before.
+     *
+     * @param context is created by KnnSearchIterator on the same index.
+     * @param k the result size of this batch, less results are returned when the search ends
+     * @param param the typed search parameters, ef_search is the size of the candidate list
+     * @param filter represents whether an element is filtered out by pre-filter
+     * @return result contains
+     *                - num_elements: 1
+     *                - dim: the size of results
+     *                - ids, distances: length is dim
+     */
+    virtual tl::expected<DatasetPtr, Error>
+    KnnSearchNext(const IteratorContextPtr& context,
+                  int64_t k,
+                  const SearchParam& param,
+                  const std::function<bool(int64_t)>& filter) const {
+        throw std::runtime_error("Index doesn't support knn search iterator");
+    };
+
 public:
     // [serialize/deserialize with binaryset]
 
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -25,6 +26,11 @@
 namespace vsag {
 
 class Options {
+public:
+    // Runs task(0) .. task(num_tasks - 1) concurrently and returns after all of them finished.
+    using ParallelExecutor =
+        std::function<void(size_t num_tasks, const std::function<void(size_t)>& task)>;
+
 public:
     static Options&
     Instance();
@@ -60,6 +66,15 @@ public:
     void
     set_block_size_limit(size_t size);
 
+    // Gets the executor used to run the workers of a multi-threaded index building. When it is
+    // not set, the workers run on threads spawned by the library itself; the host application
+    // may set it to run them on threads it manages (e.g. with its own resource isolation).
+    ParallelExecutor
+    parallel_executor() const;
+
+    void
+    set_parallel_executor(const ParallelExecutor& executor);
+
     Logger*
     logger();
 
@@ -90,6 +105,9 @@ private:
     std::atomic<size_t> block_size_limit_{128 * 1024 * 1024};
 
     Logger* logger_ = nullptr;
+
+    mutable std::mutex executor_mutex_;
+    ParallelExecutor parallel_executor_;
 };
 
 using Option = Options;  // for compatibility
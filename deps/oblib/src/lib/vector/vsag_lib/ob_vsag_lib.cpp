@@ -14,8 +14,17 @@
 #include "default_logger.h"
 #include "vsag/logger.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <chrono>
+#include <cmath>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <vector>
 
 namespace obvectorlib {
 
@@ -45,6 +54,11 @@ SlowTaskTimer::~SlowTaskTimer() {
     }
 }
 
+// diskann 的构建和查询参数
+static const float DISKANN_PQ_SAMPLE_RATE = 0.1;
+static const int64_t DISKANN_BEAM_SEARCH = 4;
+static const int64_t DISKANN_MAX_IO_LIMIT = 512;
+
 class HnswIndexHandler
 {
 public:
@@ -52,7 +66,9 @@ public:
 
   HnswIndexHandler(bool is_create, bool is_build, bool use_static,
                    int max_degree, int ef_construction, int ef_search, int dim,
-                   std::shared_ptr<vsag::Index> index, vsag::Allocator* allocator):
+                   std::shared_ptr<vsag::Index> index, vsag::Allocator* allocator,
+                   int build_thread_num, IndexType index_type, const std::string& metric,
+                   const std::string& element_type):
       is_created_(is_create),
       is_build_(is_build),
       use_static_(use_static),
@@ -61,7 +77,11 @@ public:
       ef_search_(ef_search),
       dim_(dim),
       index_(index),
-      allocator_(allocator)
+      allocator_(allocator),
+      build_thread_num_(build_thread_num),
+      index_type_(index_type),
+      metric_(metric),
+      element_type_(element_type)
   {}
 
   ~HnswIndexHandler() {
@@ -74,9 +94,12 @@ public:
   int get_index_number();
   int add_index(const vsag::DatasetPtr& incremental);
   int knn_search(const vsag::DatasetPtr& query, int64_t topk,
-                const std::string& parameters,
+                const vsag::SearchParam& parameters,
                 const float*& dist, const int64_t*& ids, int64_t &result_size,
                 const std::function<bool(int64_t)>& filter);
+  // diskann can only be built once, so the vectors added to it are kept until it is built,
+  // which happens only when the ddl serializes it. queries before that scan the kept vectors.
+  int finish_build();
   std::shared_ptr<vsag::Index>& get_index() {return index_;}
   void set_index(std::shared_ptr<vsag::Index> hnsw) {index_ = hnsw;}
   vsag::Allocator* get_allocator() {return allocator_;}
@@ -85,6 +108,17 @@ public:
   inline int get_ef_construction() {return ef_construction_;}
   inline int get_ef_search() {return ef_search_;}
   inline int get_dim() {return dim_;}
+  inline int get_build_thread_num() {return build_thread_num_;}
+  inline IndexType get_index_type() {return index_type_;}
+  inline const std::string& get_metric() {return metric_;}
+  inline const std::string& get_element_type() {return element_type_;}
+
+private:
+  int copy_result(const vsag::DatasetPtr& result, const float*& dist, const int64_t*& ids);
+  float pending_distance(const float* query, const float* vector) const;
+  int brute_force_search(const float* query, int64_t topk,
+                         const float*& dist, const int64_t*& ids, int64_t &result_size,
+                         const std::function<bool(int64_t)>& filter);
 
 private:
   bool is_created_;
@@ -96,6 +130,13 @@ private:
   int dim_;
   std::shared_ptr<vsag::Index> index_;
   vsag::Allocator* allocator_;
+  int build_thread_num_;
+  IndexType index_type_;
+  std::string metric_;
+  std::string element_type_;
+  std::mutex pending_mutex_;
+  std::vector<float> pending_vectors_;
+  std::vector<int64_t> pending_ids_;
 };
 
 int HnswIndexHandler::build_index(const vsag::DatasetPtr& base)
@@ -111,12 +152,26 @@ int HnswIndexHandler::build_index(const vsag::DatasetPtr& base)
 
 int HnswIndexHandler::get_index_number()
 {
-    return index_->GetNumElements();
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    return index_->GetNumElements() + pending_ids_.size();
 }
 
 int HnswIndexHandler::add_index(const vsag::DatasetPtr& incremental)
 {
     vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    if (DISKANN_TYPE == index_type_) {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        if (index_->GetNumElements() > 0) {
+            // the built graph can not be extended
+            return static_cast<int>(vsag::ErrorType::BUILD_TWICE);
+        }
+        int64_t num = incremental->GetNumElements();
+        const float* vectors = incremental->GetFloat32Vectors();
+        const int64_t* ids = incremental->GetIds();
+        pending_vectors_.insert(pending_vectors_.end(), vectors, vectors + num * dim_);
+        pending_ids_.insert(pending_ids_.end(), ids, ids + num);
+        return 0;
+    }
     if (const auto num = index_->Add(incremental); num.has_value()) {
         vsag::logger::debug(" after add index, index count {}", get_index_number());
         return 0;
@@ -126,14 +181,168 @@ int HnswIndexHandler::add_index(const vsag::DatasetPtr& incremental)
     return static_cast<int>(error);
 }
 
+int HnswIndexHandler::finish_build()
+{
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (pending_ids_.empty()) {
+        return 0;
+    }
+    SlowTaskTimer t("diskann build");
+    auto base = vsag::Dataset::Make();
+    base->Dim(dim_)
+        ->NumElements(pending_ids_.size())
+        ->Ids(pending_ids_.data())
+        ->Float32Vectors(pending_vectors_.data())
+        ->Owner(false);
+    if (const auto num = index_->Build(base); num.has_value()) {
+        std::vector<float>().swap(pending_vectors_);
+        std::vector<int64_t>().swap(pending_ids_);
+        return 0;
+    } else {
+        error = num.error().type;
+    }
+    return static_cast<int>(error);
+}
+
+// the results of diskann are not allocated by the allocator of the index, copy them so that
+// the caller can release them as the results of hnsw
+int HnswIndexHandler::copy_result(const vsag::DatasetPtr& result, const float*& dist, const int64_t*& ids)
+{
+    int64_t result_size = result->GetDim();
+    if (allocator_ == nullptr || result_size == 0) {
+        result->Owner(false);
+        dist = result->GetDistances();
+        ids = result->GetIds();
+        return 0;
+    }
+    float* dist_copy = static_cast<float*>(allocator_->Allocate(sizeof(float) * result_size));
+    int64_t* ids_copy = static_cast<int64_t*>(allocator_->Allocate(sizeof(int64_t) * result_size));
+    if (dist_copy == nullptr || ids_copy == nullptr) {
+        allocator_->Deallocate(dist_copy);
+        allocator_->Deallocate(ids_copy);
+        return static_cast<int>(vsag::ErrorType::NO_ENOUGH_MEMORY);
+    }
+    memcpy(dist_copy, result->GetDistances(), sizeof(float) * result_size);
+    memcpy(ids_copy, result->GetIds(), sizeof(int64_t) * result_size);
+    dist = dist_copy;
+    ids = ids_copy;
+    return 0;
+}
+
+// same distances as hnsw: squared l2, 1 - ip and 1 - cosine similarity
+float HnswIndexHandler::pending_distance(const float* query, const float* vector) const
+{
+    float dist = 0;
+    if (metric_ == vsag::METRIC_L2) {
+        for (int i = 0; i < dim_; ++i) {
+            float diff = query[i] - vector[i];
+            dist += diff * diff;
+        }
+    } else {
+        float ip = 0;
+        float query_norm = 0;
+        float vector_norm = 0;
+        for (int i = 0; i < dim_; ++i) {
+            ip += query[i] * vector[i];
+            query_norm += query[i] * query[i];
+            vector_norm += vector[i] * vector[i];
+        }
+        if (metric_ == vsag::METRIC_COSINE) {
+            ip = (query_norm == 0 || vector_norm == 0) ? 0 : ip / std::sqrt(query_norm * vector_norm);
+        }
+        dist = 1 - ip;
+    }
+    return dist;
+}
+
+// the caller holds pending_mutex_, the results are released by the caller as the results of hnsw
+int HnswIndexHandler::brute_force_search(const float* query, int64_t topk,
+                                         const float*& dist, const int64_t*& ids, int64_t &result_size,
+                                         const std::function<bool(int64_t)>& filter)
+{
+    SlowTaskTimer t("diskann brute force search");
+    std::priority_queue<std::pair<float, int64_t>> heap;
+    for (size_t i = 0; topk > 0 && i < pending_ids_.size(); ++i) {
+        if (filter && filter(pending_ids_[i])) {
+            continue;
+        }
+        float d = pending_distance(query, pending_vectors_.data() + i * dim_);
+        if (static_cast<int64_t>(heap.size()) < topk) {
+            heap.emplace(d, pending_ids_[i]);
+        } else if (d < heap.top().first) {
+            heap.pop();
+            heap.emplace(d, pending_ids_[i]);
+        }
+    }
+    result_size = heap.size();
+    dist = nullptr;
+    ids = nullptr;
+    if (result_size == 0) {
+        return 0;
+    }
+    float* dist_res = nullptr;
+    int64_t* ids_res = nullptr;
+    if (allocator_ == nullptr) {
+        dist_res = new (std::nothrow) float[result_size];
+        ids_res = new (std::nothrow) int64_t[result_size];
+    } else {
+        dist_res = static_cast<float*>(allocator_->Allocate(sizeof(float) * result_size));
+        ids_res = static_cast<int64_t*>(allocator_->Allocate(sizeof(int64_t) * result_size));
+    }
+    if (dist_res == nullptr || ids_res == nullptr) {
+        if (allocator_ == nullptr) {
+            delete[] dist_res;
+            delete[] ids_res;
+        } else {
+            allocator_->Deallocate(dist_res);
+            allocator_->Deallocate(ids_res);
+        }
+        result_size = 0;
+        return static_cast<int>(vsag::ErrorType::NO_ENOUGH_MEMORY);
+    }
+    for (int64_t i = result_size - 1; i >= 0; --i) {
+        dist_res[i] = heap.top().first;
+        ids_res[i] = heap.top().second;
+        heap.pop();
+    }
+    dist = dist_res;
+    ids = ids_res;
+    return 0;
+}
+
 int HnswIndexHandler::knn_search(const vsag::DatasetPtr& query, int64_t topk,
-               const std::string& parameters,
+               const vsag::SearchParam& parameters,
                const float*& dist, const int64_t*& ids, int64_t &result_size,
                const std::function<bool(int64_t)>& filter) {
-    vsag::logger::debug("  search_parameters:{}", parameters);
+    vsag::logger::debug("  ef_search:{}", parameters.ef_search);
     vsag::logger::debug("  topk:{}", topk);
     vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
 
+    if (DISKANN_TYPE == index_type_) {
+        int ret = 0;
+        {
+            // building the graph is left to the ddl, a query never waits for it
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            if (!pending_ids_.empty()) {
+                return brute_force_search(query->GetFloat32Vectors(), topk, dist, ids, result_size, filter);
+            }
+        }
+        // the graph and the full vectors are read from disk, io_limit bounds the reads per query
+        nlohmann::json diskann_parameters{{"ef_search", parameters.ef_search},
+                                          {"beam_search", DISKANN_BEAM_SEARCH},
+                                          {"io_limit", std::min<int64_t>(parameters.ef_search, DISKANN_MAX_IO_LIMIT)}};
+        nlohmann::json search_parameters{{"diskann", diskann_parameters}};
+        auto result = index_->KnnSearch(query, topk, search_parameters.dump(), filter);
+        if (!result.has_value()) {
+            return static_cast<int>(result.error().type);
+        } else if (0 != (ret = copy_result(result.value(), dist, ids))) {
+            return ret;
+        }
+        result_size = result.value()->GetDim();
+        return 0;
+    }
+
     auto result = index_->KnnSearch(query, topk, parameters, filter);
     if (result.has_value()) {
         //result的生命周期
@@ -154,6 +363,8 @@ int HnswIndexHandler::knn_search(const vsag::DatasetPtr& query, int64_t topk,
 }
 
 bool is_init_ = vsag::init();
+static std::string disk_index_dir_;
+static std::atomic<int64_t> disk_index_file_seq_(0);
 
 void
 set_log_level(int64_t level_num) {
@@ -182,6 +393,257 @@ void set_block_size_limit(uint64_t size) {
     vsag::Options::Instance().set_block_size_limit(size);
 }
 
+static void run_parallel_task(void* task_arg, int64_t task_idx) {
+    (*static_cast<const std::function<void(size_t)>*>(task_arg))(task_idx);
+}
+
+void set_parallel_executor(ParallelExecutor executor) {
+    if (executor == nullptr) {
+        vsag::Options::Instance().set_parallel_executor(nullptr);
+    } else {
+        vsag::Options::Instance().set_parallel_executor(
+            [executor](size_t task_num, const std::function<void(size_t)>& task) {
+                executor(task_num, run_parallel_task, (void*)&task);
+            });
+    }
+}
+
+void set_disk_index_dir(const char* dir) {
+    disk_index_dir_ = (dir == nullptr ? "" : dir);
+}
+
+static const char* get_index_name(IndexType index_type) {
+    return DISKANN_TYPE == index_type ? vsag::INDEX_DISKANN : vsag::INDEX_HNSW;
+}
+
+static std::string make_index_parameters(IndexType index_type, const char* dtype, const char* metric, int dim,
+                                         int max_degree, int ef_construction, int ef_search,
+                                         int build_thread_num) {
+    if (DISKANN_TYPE == index_type) {
+        // dim*FP32 -> pq_dims*INT8, 内存中只保留 pq 码, 图和原始向量在查询时从磁盘读取
+        nlohmann::json diskann_parameters{{"max_degree", max_degree},
+                                          {"ef_construction", ef_construction},
+                                          {"pq_dims", std::max(1, dim / 4)},
+                                          {"pq_sample_rate", DISKANN_PQ_SAMPLE_RATE},
+                                          {"use_pq_search", false}};
+        nlohmann::json index_parameters{{"dtype", vsag::DATATYPE_FLOAT32}, {"metric_type", metric}, {"dim", dim}, {"diskann", diskann_parameters}};
+        return index_parameters.dump();
+    }
+    bool use_static = false;
+    // 量化索引在量化后的图上检索, 再用原始查询向量对候选重排
+    bool use_sq8 = (HNSW_SQ_TYPE == index_type);
+    nlohmann::json hnsw_parameters{{"max_degree", max_degree},
+                            {"ef_construction", ef_construction},
+                            {"ef_search", ef_search},
+                            {"use_static", use_static},
+                            {"build_thread_num", build_thread_num},
+                            {"use_sq8", use_sq8},
+                            {"element_type", dtype}};
+    // 输入向量总是 float32, dtype 只决定图中向量的存储类型
+    nlohmann::json index_parameters{{"dtype", vsag::DATATYPE_FLOAT32}, {"metric_type", metric}, {"dim", dim}, {"hnsw", hnsw_parameters}};
+    return index_parameters.dump();
+}
+
+// 从内存中读取 binary 的 reader, 用于 diskann 中常驻内存的部分
+class BinaryReader : public vsag::Reader {
+public:
+    explicit BinaryReader(const vsag::Binary& binary) : binary_(binary) {}
+
+    void Read(uint64_t offset, uint64_t len, void* dest) override {
+        memcpy(dest, binary_.data.get() + offset, len);
+    }
+
+    void AsyncRead(uint64_t offset, uint64_t len, void* dest, vsag::CallBack callback) override {
+        Read(offset, len, dest);
+        callback(vsag::IOErrorCode::IO_SUCCESS, "success");
+    }
+
+    uint64_t Size() const override {
+        return binary_.size;
+    }
+
+private:
+    vsag::Binary binary_;
+};
+
+// diskann 按 binary set 的格式写入流: key 的个数, 然后依次是每个 key 的长度, key, 数据长度和数据
+static void write_binary_set(std::ostream& out_stream, const vsag::BinarySet& bs) {
+    auto keys = bs.GetKeys();
+    uint64_t key_num = keys.size();
+    out_stream.write((const char*)&key_num, sizeof(key_num));
+    for (const auto& key : keys) {
+        vsag::Binary b = bs.Get(key);
+        uint64_t key_len = key.size();
+        uint64_t data_len = b.size;
+        out_stream.write((const char*)&key_len, sizeof(key_len));
+        out_stream.write(key.data(), key_len);
+        out_stream.write((const char*)&data_len, sizeof(data_len));
+        out_stream.write((const char*)b.data.get(), data_len);
+    }
+}
+
+// binary 通过索引的 allocator 分配, 计入租户的 vsag 内存
+static bool alloc_binary(vsag::Allocator* allocator, uint64_t size, vsag::Binary& b) {
+    b.size = size;
+    if (size == 0) {
+        b.data.reset();
+    } else if (allocator == nullptr) {
+        b.data.reset(new (std::nothrow) int8_t[size]);
+    } else {
+        int8_t* data = static_cast<int8_t*>(allocator->Allocate(size));
+        if (data != nullptr) {
+            b.data = std::shared_ptr<int8_t[]>(data, [allocator](int8_t* p) { allocator->Deallocate(p); });
+        }
+    }
+    return size == 0 || b.data != nullptr;
+}
+
+// diskann 的图和原始向量(layout file)写到 disk_index_dir_ 下的文件中, 查询时按需读取,
+// 文件打开后即删除, 随 reader 释放而回收。layout 不能留在内存中, 没有设置目录时报错。
+static int open_layout_file(std::ofstream& file, std::string& filename) {
+    if (disk_index_dir_.empty()) {
+        vsag::logger::error("   disk index dir is not set, can not load diskann layout");
+        return static_cast<int>(vsag::ErrorType::MISSING_FILE);
+    }
+    filename = disk_index_dir_ + "/diskann_layout_" + std::to_string(disk_index_file_seq_.fetch_add(1));
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        vsag::logger::error("   failed to create diskann layout file {}", filename);
+        return static_cast<int>(vsag::ErrorType::MISSING_FILE);
+    }
+    return 0;
+}
+
+static int close_layout_file(std::ofstream& file, const std::string& filename, uint64_t size,
+                             std::shared_ptr<vsag::Reader>& reader) {
+    int ret = 0;
+    file.close();
+    if (file.fail()) {
+        vsag::logger::error("   failed to write diskann layout file {}", filename);
+        ret = static_cast<int>(vsag::ErrorType::INTERNAL_ERROR);
+    } else {
+        reader = vsag::Factory::CreateLocalFileReader(filename, 0, size);
+    }
+    std::remove(filename.c_str());
+    return ret;
+}
+
+// the layout is copied from the stream to the file by chunks, it is never held in memory as a whole
+static int stream_layout_to_file(std::istream& in_stream, uint64_t size, vsag::Allocator* allocator,
+                                 std::shared_ptr<vsag::Reader>& reader) {
+    static const uint64_t LAYOUT_COPY_CHUNK_SIZE = 4 << 20;
+    std::ofstream file;
+    std::string filename;
+    vsag::Binary chunk;
+    int ret = open_layout_file(file, filename);
+    if (ret != 0) {
+    } else if (!alloc_binary(allocator, std::min(size, LAYOUT_COPY_CHUNK_SIZE), chunk)) {
+        ret = static_cast<int>(vsag::ErrorType::NO_ENOUGH_MEMORY);
+    } else {
+        for (uint64_t copied = 0; ret == 0 && copied < size; ) {
+            uint64_t len = std::min(size - copied, LAYOUT_COPY_CHUNK_SIZE);
+            if (!in_stream.read((char*)chunk.data.get(), len)) {
+                vsag::logger::error("   failed to read diskann layout, read {} of {}", copied, size);
+                ret = static_cast<int>(vsag::ErrorType::READ_ERROR);
+            } else if (!file.write((const char*)chunk.data.get(), len)) {
+                vsag::logger::error("   failed to write diskann layout file {}", filename);
+                ret = static_cast<int>(vsag::ErrorType::INTERNAL_ERROR);
+            } else {
+                copied += len;
+            }
+        }
+    }
+    if (!filename.empty()) {
+        int tmp_ret = close_layout_file(file, filename, size, reader);
+        ret = (ret == 0 ? tmp_ret : ret);
+    }
+    return ret;
+}
+
+// the layout of a built index is already in memory, it is moved to the file so that the
+// built index keeps only the pq codes as the loaded one
+static int write_layout_to_file(const vsag::Binary& layout, std::shared_ptr<vsag::Reader>& reader) {
+    std::ofstream file;
+    std::string filename;
+    int ret = open_layout_file(file, filename);
+    if (ret == 0) {
+        file.write((const char*)layout.data.get(), layout.size);
+        ret = close_layout_file(file, filename, layout.size, reader);
+    }
+    return ret;
+}
+
+// 按 write_binary_set 的格式读取, 除 layout 外的部分常驻内存
+static int read_reader_set(std::istream& in_stream, vsag::Allocator* allocator, vsag::ReaderSet& reader_set) {
+    int ret = 0;
+    uint64_t key_num = 0;
+    if (!in_stream.read((char*)&key_num, sizeof(key_num))) {
+        ret = static_cast<int>(vsag::ErrorType::READ_ERROR);
+    }
+    for (uint64_t i = 0; ret == 0 && i < key_num; ++i) {
+        uint64_t key_len = 0;
+        uint64_t data_len = 0;
+        std::string key;
+        in_stream.read((char*)&key_len, sizeof(key_len));
+        key.resize(key_len);
+        in_stream.read(&key[0], key_len);
+        in_stream.read((char*)&data_len, sizeof(data_len));
+        if (!in_stream.good()) {
+            ret = static_cast<int>(vsag::ErrorType::READ_ERROR);
+        } else if (key == vsag::DISKANN_LAYOUT_FILE) {
+            std::shared_ptr<vsag::Reader> reader;
+            if (0 == (ret = stream_layout_to_file(in_stream, data_len, allocator, reader))) {
+                reader_set.Set(key, reader);
+            }
+        } else {
+            vsag::Binary b;
+            if (!alloc_binary(allocator, data_len, b)) {
+                ret = static_cast<int>(vsag::ErrorType::NO_ENOUGH_MEMORY);
+            } else if (!in_stream.read((char*)b.data.get(), data_len)) {
+                ret = static_cast<int>(vsag::ErrorType::READ_ERROR);
+            } else {
+                reader_set.Set(key, std::make_shared<BinaryReader>(b));
+            }
+        }
+    }
+    return ret;
+}
+
+// 以 reader set 的形式加载 diskann, 内存中只保留 pq 码和 tag
+static int load_disk_index(HnswIndexHandler* hnsw, const vsag::ReaderSet& reader_set) {
+    std::string index_parameters = make_index_parameters(hnsw->get_index_type(), hnsw->get_element_type().c_str(),
+                                                         hnsw->get_metric().c_str(), hnsw->get_dim(),
+                                                         hnsw->get_max_degree(), hnsw->get_ef_construction(),
+                                                         hnsw->get_ef_search(), hnsw->get_build_thread_num());
+    vsag::logger::debug("   load disk index, index parameter:{}", index_parameters);
+    auto index = vsag::Factory::CreateIndex(vsag::INDEX_DISKANN, index_parameters, hnsw->get_allocator());
+    if (!index.has_value()) {
+        return static_cast<int>(index.error().type);
+    }
+    if (auto result = index.value()->Deserialize(reader_set); !result.has_value()) {
+        return static_cast<int>(result.error().type);
+    }
+    hnsw->set_index(index.value());
+    return 0;
+}
+
+static int load_disk_index(HnswIndexHandler* hnsw, const vsag::BinarySet& bs) {
+    int ret = 0;
+    vsag::ReaderSet reader_set;
+    for (const auto& key : bs.GetKeys()) {
+        if (key == vsag::DISKANN_LAYOUT_FILE) {
+            std::shared_ptr<vsag::Reader> reader;
+            if (0 != (ret = write_layout_to_file(bs.Get(key), reader))) {
+                return ret;
+            }
+            reader_set.Set(key, reader);
+        } else {
+            reader_set.Set(key, std::make_shared<BinaryReader>(bs.Get(key)));
+        }
+    }
+    return load_disk_index(hnsw, reader_set);
+}
+
 bool is_supported_index(IndexType index_type) {
     return INVALID_INDEX_TYPE < index_type && index_type < MAX_INDEX_TYPE;
 }
@@ -189,7 +651,8 @@ bool is_supported_index(IndexType index_type) {
 int create_index(VectorIndexPtr& index_handler, IndexType index_type,
                  const char* dtype,
                  const char* metric, int dim,
-                 int max_degree, int ef_construction, int ef_search, void* allocator)
+                 int max_degree, int ef_construction, int ef_search, void* allocator,
+                 int build_thread_num)
 {
     vsag::logger::debug("TRACE LOG[test_create_index]:");
     vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
@@ -214,12 +677,9 @@ int create_index(VectorIndexPtr& index_handler, IndexType index_type,
         // create index
         std::shared_ptr<vsag::Index> hnsw;
         bool use_static = false;
-        nlohmann::json hnsw_parameters{{"max_degree", max_degree},
-                                {"ef_construction", ef_construction},
-                                {"ef_search", ef_search},
-                                {"use_static", use_static}};
-        nlohmann::json index_parameters{{"dtype", dtype}, {"metric_type", metric}, {"dim", dim}, {"hnsw", hnsw_parameters}};
-        if (auto index = vsag::Factory::CreateIndex("hnsw", index_parameters.dump(), vsag_allocator);
+        std::string index_parameters = make_index_parameters(index_type, dtype, metric, dim, max_degree,
+                                                             ef_construction, ef_search, build_thread_num);
+        if (auto index = vsag::Factory::CreateIndex(get_index_name(index_type), index_parameters, vsag_allocator);
             index.has_value()) {
             hnsw = index.value();
             HnswIndexHandler* hnsw_index = new HnswIndexHandler(true,
@@ -230,13 +690,17 @@ int create_index(VectorIndexPtr& index_handler, IndexType index_type,
                                                                 ef_search,
                                                                 dim,
                                                                 hnsw,
-                                                                vsag_allocator);
+                                                                vsag_allocator,
+                                                                build_thread_num,
+                                                                index_type,
+                                                                metric,
+                                                                dtype);
             index_handler = static_cast<VectorIndexPtr>(hnsw_index);
-            vsag::logger::debug("   success to create hnsw index , index parameter:{}, allocator addr:{}",index_parameters.dump(), (void*)vsag_allocator);
+            vsag::logger::debug("   success to create hnsw index , index parameter:{}, allocator addr:{}",index_parameters, (void*)vsag_allocator);
             return 0;
         } else {
             error = index.error().type;
-            vsag::logger::debug("   fail to create hnsw index , index parameter:{}", index_parameters.dump());
+            vsag::logger::debug("   fail to create hnsw index , index parameter:{}", index_parameters);
         }
     } else {
         error = vsag::ErrorType::UNSUPPORTED_INDEX;
@@ -309,9 +773,28 @@ int get_index_number(VectorIndexPtr& index_handler, int64_t &size) {
     return 0;
 }
 
+// the results are sorted by distance, the last one is the k-th nearest
+static void publish_result_bound(std::atomic<float>* result_bound, int64_t topk,
+                                 const float* dist, int64_t result_size) {
+    if (result_bound != nullptr && dist != nullptr && result_size >= topk && result_size > 0) {
+        float bound = dist[result_size - 1];
+        float curr = result_bound->load(std::memory_order_relaxed);
+        while (bound < curr && !result_bound->compare_exchange_weak(curr, bound)) {
+        }
+    }
+}
+
 int knn_search(VectorIndexPtr& index_handler,float* query_vector,int dim, int64_t topk,
                const float*& dist, const int64_t*& ids, int64_t &result_size, int ef_search,
                void* invalid) {
+    SearchParam param;
+    param.ef_search_ = ef_search;
+    return knn_search(index_handler, query_vector, dim, topk, dist, ids, result_size, param, invalid);
+}
+
+int knn_search(VectorIndexPtr& index_handler,float* query_vector,int dim, int64_t topk,
+               const float*& dist, const int64_t*& ids, int64_t &result_size,
+               const SearchParam& param, void* invalid) {
     vsag::logger::debug("TRACE LOG[knn_search]:");
     vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
     int ret = 0;
@@ -322,16 +805,90 @@ int knn_search(VectorIndexPtr& index_handler,float* query_vector,int dim, int64_
     }
     SlowTaskTimer t("knn_search");
     roaring::api::roaring64_bitmap_t *bitmap = static_cast<roaring::api::roaring64_bitmap_t*>(invalid);
-    auto filter = [bitmap](int64_t id) -> bool {
-        return roaring::api::roaring64_bitmap_contains(bitmap, id);
+    roaring::api::roaring64_bitmap_t *valid = static_cast<roaring::api::roaring64_bitmap_t*>(param.valid_);
+    auto filter = [bitmap, valid](int64_t id) -> bool {
+        return roaring::api::roaring64_bitmap_contains(bitmap, id)
+               || (valid != nullptr && !roaring::api::roaring64_bitmap_contains(valid, id));
     };
-    nlohmann::json search_parameters{{"hnsw", {{"ef_search", ef_search}}}};
+    vsag::SearchParam search_parameters;
+    search_parameters.ef_search = param.ef_search_;
+    search_parameters.use_conjugate_graph_search = param.use_conjugate_graph_search_;
+    search_parameters.distance_bound = param.distance_bounds_;
     HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
     auto query = vsag::Dataset::Make();
     query->NumElements(1)->Dim(dim)->Float32Vectors(query_vector)->Owner(false);
-    ret = hnsw->knn_search(query, topk, search_parameters.dump(), dist, ids, result_size, filter);
+    ret = hnsw->knn_search(query, topk, search_parameters, dist, ids, result_size, filter);
     if (ret != 0) {
         vsag::logger::error("   knn search error happend, ret={}", ret);
+    } else {
+        publish_result_bound(param.result_bounds_, topk, dist, result_size);
+    }
+    return ret;
+}
+
+int knn_search_batch(VectorIndexPtr& index_handler, float* query_vectors, int64_t query_num, int dim,
+                     int64_t topk, const float** dists, const int64_t** ids, int64_t* result_sizes,
+                     const SearchParam& param, void* invalid) {
+    vsag::logger::debug("TRACE LOG[knn_search_batch]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    if (index_handler == nullptr || query_vectors == nullptr || dists == nullptr
+        || ids == nullptr || result_sizes == nullptr || query_num <= 0) {
+        vsag::logger::debug("   invalid argument, index_handler:{}, query_vectors:{}, query_num:{}",
+                            (void*)index_handler, (void*)query_vectors, query_num);
+        return static_cast<int>(error);
+    }
+    SlowTaskTimer t("knn_search_batch");
+    for (int64_t i = 0; i < query_num; ++i) {
+        dists[i] = nullptr;
+        ids[i] = nullptr;
+        result_sizes[i] = 0;
+    }
+    roaring::api::roaring64_bitmap_t *bitmap = static_cast<roaring::api::roaring64_bitmap_t*>(invalid);
+    roaring::api::roaring64_bitmap_t *valid = static_cast<roaring::api::roaring64_bitmap_t*>(param.valid_);
+    auto filter = [bitmap, valid](int64_t id) -> bool {
+        return roaring::api::roaring64_bitmap_contains(bitmap, id)
+               || (valid != nullptr && !roaring::api::roaring64_bitmap_contains(valid, id));
+    };
+    vsag::SearchParam search_parameters;
+    search_parameters.ef_search = param.ef_search_;
+    search_parameters.use_conjugate_graph_search = param.use_conjugate_graph_search_;
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+
+    // the queries are dispatched one by one to the workers, each of them borrows a visited
+    // list from the pool of the index, the first error stops the remaining queries.
+    std::atomic<int64_t> next_query(0);
+    std::atomic<int> first_error(0);
+    auto worker = [&](size_t task_idx) {
+        int64_t i = 0;
+        while (first_error.load(std::memory_order_relaxed) == 0
+               && (i = next_query.fetch_add(1, std::memory_order_relaxed)) < query_num) {
+            auto query = vsag::Dataset::Make();
+            query->NumElements(1)->Dim(dim)->Float32Vectors(query_vectors + i * dim)->Owner(false);
+            vsag::SearchParam query_parameters = search_parameters;
+            if (param.distance_bounds_ != nullptr) {
+                query_parameters.distance_bound = param.distance_bounds_ + i;
+            }
+            int ret = hnsw->knn_search(query, topk, query_parameters, dists[i], ids[i], result_sizes[i], filter);
+            if (ret != 0) {
+                int expected = 0;
+                first_error.compare_exchange_strong(expected, ret);
+            } else if (param.result_bounds_ != nullptr) {
+                publish_result_bound(param.result_bounds_ + i, topk, dists[i], result_sizes[i]);
+            }
+        }
+    };
+    static const int64_t MIN_QUERIES_PER_SEARCH_TASK = 4;
+    int64_t task_num = query_num / MIN_QUERIES_PER_SEARCH_TASK;
+    auto executor = vsag::Options::Instance().parallel_executor();
+    if (task_num > 1 && executor) {
+        executor(task_num, worker);
+    }
+    // finish the queries which are not taken by the executor
+    worker(0);
+
+    int ret = first_error.load();
+    if (ret != 0) {
+        vsag::logger::error("   knn search batch error happend, ret={}", ret);
     }
     return ret;
 }
@@ -345,6 +902,10 @@ int serialize(VectorIndexPtr& index_handler, const std::string dir) {
         return static_cast<int>(error);
     }
     HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    if (DISKANN_TYPE == hnsw->get_index_type() && 0 != (ret = hnsw->finish_build())) {
+        vsag::logger::error("   serialize error happend, ret={}", ret);
+        return ret;
+    }
     if (auto bs = hnsw->get_index()->Serialize(); bs.has_value()) {
         hnsw = nullptr;
         auto keys = bs->GetKeys();
@@ -379,12 +940,30 @@ int fserialize(VectorIndexPtr& index_handler, std::ostream& out_stream) {
         return static_cast<int>(error);
     }
     HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
-    if (auto bs = hnsw->get_index()->Serialize(out_stream); bs.has_value()) {
-        return 0;
+    if (DISKANN_TYPE == hnsw->get_index_type()) {
+        if (0 != (ret = hnsw->finish_build())) {
+        } else if (auto bs = hnsw->get_index()->Serialize(); !bs.has_value()) {
+            ret = static_cast<int>(bs.error().type);
+        } else {
+            write_binary_set(out_stream, bs.value());
+            // the built index holds the whole layout in memory, reload it as it is loaded
+            // from the snapshot so that only the pq codes stay in memory
+            ret = load_disk_index(hnsw, bs.value());
+        }
     } else {
-        error = bs.error().type;
+        // relabel the graph in bfs order before it is persisted, so that the snapshot loaded
+        // for queries keeps the neighbors close in memory. the index is still valid if it fails
+        if (auto reordered = hnsw->get_index()->Reorder(); !reordered.has_value()) {
+            vsag::logger::warn("   reorder index failed, serialize it as it is, error={}",
+                               static_cast<int>(reordered.error().type));
+        }
+        if (auto bs = hnsw->get_index()->Serialize(out_stream); bs.has_value()) {
+            return 0;
+        } else {
+            error = bs.error().type;
+            ret = static_cast<int>(error);
+        }
     }
-    ret = static_cast<int>(error);
     if (ret != 0) {
         vsag::logger::error("   fserialize error happend, ret={}", ret);
     }
@@ -401,19 +980,22 @@ int fdeserialize(VectorIndexPtr& index_handler, std::istream& in_stream) {
     }
     HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
     std::shared_ptr<vsag::Index> hnsw_index;
-    bool use_static = hnsw->get_use_static();
-    int max_degree = hnsw->get_max_degree();
-    int ef_construction = hnsw->get_ef_construction();
-    int ef_search = hnsw->get_ef_search();
-    int dim = hnsw->get_dim();
-    nlohmann::json hnsw_parameters{{"max_degree", max_degree},
-                                {"ef_construction", ef_construction},
-                                {"ef_search", ef_search},
-                                {"use_static", use_static}};
-    nlohmann::json index_parameters{
-        {"dtype", "float32"}, {"metric_type", "l2"}, {"dim", dim}, {"hnsw", hnsw_parameters}};
-    vsag::logger::debug("   Deserilize hnsw index , index parameter:{}, allocator addr:{}",index_parameters.dump(),(void*)hnsw->get_allocator());
-    if (auto index = vsag::Factory::CreateIndex("hnsw", index_parameters.dump(), hnsw->get_allocator());
+    std::string index_parameters = make_index_parameters(hnsw->get_index_type(), hnsw->get_element_type().c_str(),
+                                                         hnsw->get_metric().c_str(), hnsw->get_dim(),
+                                                         hnsw->get_max_degree(), hnsw->get_ef_construction(),
+                                                         hnsw->get_ef_search(), hnsw->get_build_thread_num());
+    vsag::logger::debug("   Deserilize hnsw index , index parameter:{}, allocator addr:{}",index_parameters,(void*)hnsw->get_allocator());
+    if (DISKANN_TYPE == hnsw->get_index_type()) {
+        vsag::ReaderSet reader_set;
+        if (0 == (ret = read_reader_set(in_stream, hnsw->get_allocator(), reader_set))) {
+            ret = load_disk_index(hnsw, reader_set);
+        }
+        if (ret != 0) {
+            vsag::logger::error("   fdeserialize error happend, ret={}", ret);
+        }
+        return ret;
+    }
+    if (auto index = vsag::Factory::CreateIndex(get_index_name(hnsw->get_index_type()), index_parameters, hnsw->get_allocator());
         index.has_value()) {
         hnsw_index = index.value();
     } else {
@@ -452,31 +1034,43 @@ int deserialize_bin(VectorIndexPtr& index_handler,const std::string dir) {
     }
     metafile.close();
 
+    const bool is_disk_index = (DISKANN_TYPE == hnsw->get_index_type());
     vsag::BinarySet bs;
+    vsag::ReaderSet reader_set;
     for (auto key : keys) {
         std::ifstream file(dir + "hnsw.index." + key, std::ios::in);
         file.seekg(0, std::ios::end);
-        vsag::Binary b;
-        b.size = file.tellg();
-        b.data.reset(new int8_t[b.size]);
+        uint64_t size = file.tellg();
         file.seekg(0, std::ios::beg);
-        file.read((char*)b.data.get(), b.size);
-        bs.Set(key, b);
-    }
-    bool use_static = hnsw->get_use_static();
-    int max_degree = hnsw->get_max_degree();
-    int ef_construction = hnsw->get_ef_construction();
-    int ef_search = hnsw->get_ef_search();
-    int dim = hnsw->get_dim();
-    nlohmann::json hnsw_parameters{{"max_degree", max_degree},
-                                {"ef_construction", ef_construction},
-                                {"ef_search", ef_search},
-                                {"use_static", use_static}};
-    nlohmann::json index_parameters{
-        {"dtype", "float32"}, {"metric_type", "l2"}, {"dim", dim}, {"hnsw", hnsw_parameters}};
-    vsag::logger::debug("   Deserilize hnsw index , index parameter:{}, allocator addr:{}",index_parameters.dump(),(void*)hnsw->get_allocator());
+        vsag::Binary b;
+        if (is_disk_index && key == vsag::DISKANN_LAYOUT_FILE) {
+            std::shared_ptr<vsag::Reader> reader;
+            ret = stream_layout_to_file(file, size, hnsw->get_allocator(), reader);
+            reader_set.Set(key, reader);
+        } else if (!alloc_binary(hnsw->get_allocator(), size, b)) {
+            ret = static_cast<int>(vsag::ErrorType::NO_ENOUGH_MEMORY);
+        } else if (!file.read((char*)b.data.get(), b.size)) {
+            ret = static_cast<int>(vsag::ErrorType::READ_ERROR);
+        } else if (is_disk_index) {
+            reader_set.Set(key, std::make_shared<BinaryReader>(b));
+        } else {
+            bs.Set(key, b);
+        }
+        if (ret != 0) {
+            vsag::logger::error("   deserialize {} error happend, ret={}", key, ret);
+            return ret;
+        }
+    }
+    if (is_disk_index) {
+        return load_disk_index(hnsw, reader_set);
+    }
+    std::string index_parameters = make_index_parameters(hnsw->get_index_type(), hnsw->get_element_type().c_str(),
+                                                         hnsw->get_metric().c_str(), hnsw->get_dim(),
+                                                         hnsw->get_max_degree(), hnsw->get_ef_construction(),
+                                                         hnsw->get_ef_search(), hnsw->get_build_thread_num());
+    vsag::logger::debug("   Deserilize hnsw index , index parameter:{}, allocator addr:{}",index_parameters,(void*)hnsw->get_allocator());
     std::shared_ptr<vsag::Index> hnsw_index;
-    if (auto index = vsag::Factory::CreateIndex("hnsw", index_parameters.dump(),hnsw->get_allocator());
+    if (auto index = vsag::Factory::CreateIndex(get_index_name(hnsw->get_index_type()), index_parameters, hnsw->get_allocator());
         index.has_value()) {
         hnsw_index = index.value();
     } else {
@@ -498,6 +1092,224 @@ int delete_index(VectorIndexPtr& index_handler) {
     return 0;
 }
 
+int remove_index(VectorIndexPtr& index_handler, int64_t* ids, int64_t size, int64_t &removed_cnt) {
+    vsag::logger::debug("TRACE LOG[remove_index]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    removed_cnt = 0;
+    if (index_handler == nullptr || (ids == nullptr && size > 0)) {
+        vsag::logger::debug("   null pointer addr, index_handler:{}, ids:{}", (void*)index_handler, (void*)ids);
+        return static_cast<int>(error);
+    }
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    if (DISKANN_TYPE == hnsw->get_index_type() || hnsw->get_use_static()) {
+        return static_cast<int>(vsag::ErrorType::UNSUPPORTED_INDEX_OPERATION);
+    }
+    for (int64_t i = 0; i < size; ++i) {
+        // returns false for the ids not in the index
+        if (auto removed = hnsw->get_index()->Remove(ids[i]); !removed.has_value()) {
+            error = removed.error().type;
+            vsag::logger::error("   remove id {} error happend, ret={}", ids[i], static_cast<int>(error));
+            return static_cast<int>(error);
+        } else if (removed.value()) {
+            ++removed_cnt;
+        }
+    }
+    vsag::logger::debug("   remove index removed {} of {} ids", removed_cnt, size);
+    return 0;
+}
+
+int prepare_compact_index(VectorIndexPtr& index_handler) {
+    vsag::logger::debug("TRACE LOG[prepare_compact_index]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    if (index_handler == nullptr) {
+        vsag::logger::debug("   null pointer addr, index_handler:{}", (void*)index_handler);
+        return static_cast<int>(error);
+    }
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    if (DISKANN_TYPE == hnsw->get_index_type() || hnsw->get_use_static()) {
+        return static_cast<int>(vsag::ErrorType::UNSUPPORTED_INDEX_OPERATION);
+    }
+    SlowTaskTimer t("prepare compact index");
+    if (auto prepared = hnsw->get_index()->PrepareCompact(); prepared.has_value()) {
+        vsag::logger::debug("   prepare compact index repaired {} links", prepared.value());
+        return 0;
+    } else {
+        error = prepared.error().type;
+    }
+    vsag::logger::error("   prepare compact index error happend, ret={}", static_cast<int>(error));
+    return static_cast<int>(error);
+}
+
+int compact_index(VectorIndexPtr& index_handler, int64_t &removed_cnt) {
+    vsag::logger::debug("TRACE LOG[compact_index]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    removed_cnt = 0;
+    if (index_handler == nullptr) {
+        vsag::logger::debug("   null pointer addr, index_handler:{}", (void*)index_handler);
+        return static_cast<int>(error);
+    }
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    if (DISKANN_TYPE == hnsw->get_index_type() || hnsw->get_use_static()) {
+        return static_cast<int>(vsag::ErrorType::UNSUPPORTED_INDEX_OPERATION);
+    }
+    SlowTaskTimer t("compact index");
+    if (auto compacted = hnsw->get_index()->Compact(); compacted.has_value()) {
+        removed_cnt = compacted.value();
+        vsag::logger::debug("   compact index removed {} vectors", removed_cnt);
+        return 0;
+    } else {
+        error = compacted.error().type;
+    }
+    vsag::logger::error("   compact index error happend, ret={}", static_cast<int>(error));
+    return static_cast<int>(error);
+}
+
+int calibrate_recall(VectorIndexPtr& index_handler, int64_t topk, const int64_t* ef_searches,
+                     int64_t ef_cnt, int64_t sample_cnt, float* recalls) {
+    vsag::logger::debug("TRACE LOG[calibrate_recall]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    if (index_handler == nullptr || ef_searches == nullptr || recalls == nullptr || ef_cnt <= 0) {
+        vsag::logger::debug("   null pointer addr, index_handler:{}, ef_searches:{}, recalls:{}, ef_cnt:{}",
+                            (void*)index_handler, (void*)ef_searches, (void*)recalls, ef_cnt);
+        return static_cast<int>(error);
+    }
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    if (DISKANN_TYPE == hnsw->get_index_type() || hnsw->get_use_static()) {
+        return static_cast<int>(vsag::ErrorType::UNSUPPORTED_INDEX_OPERATION);
+    }
+    std::vector<int64_t> efs(ef_searches, ef_searches + ef_cnt);
+    if (auto result = hnsw->get_index()->CalibrateRecall(topk, efs, sample_cnt); result.has_value()) {
+        const std::vector<float>& measured = result.value();
+        for (int64_t i = 0; i < ef_cnt; ++i) {
+            recalls[i] = i < static_cast<int64_t>(measured.size()) ? measured[i] : 0;
+            vsag::logger::debug("   calibrate recall ef_search={}, recall={}", efs[i], recalls[i]);
+        }
+        return 0;
+    } else {
+        error = result.error().type;
+    }
+    vsag::logger::error("   calibrate recall error happend, ret={}", static_cast<int>(error));
+    return static_cast<int>(error);
+}
+
+// the handle returned by knn_search_iterator
+struct SearchIterator {
+    vsag::IteratorContextPtr context_;
+};
+
+int knn_search_iterator(VectorIndexPtr& index_handler, float* query_vector, int dim, VectorIteratorPtr& iter) {
+    vsag::logger::debug("TRACE LOG[knn_search_iterator]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    if (index_handler == nullptr || query_vector == nullptr) {
+        vsag::logger::debug("   null pointer addr, index_handler:{}, query_vector:{}",
+                            (void*)index_handler, (void*)query_vector);
+        return static_cast<int>(error);
+    }
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    if (DISKANN_TYPE == hnsw->get_index_type() || hnsw->get_use_static()) {
+        return static_cast<int>(vsag::ErrorType::UNSUPPORTED_INDEX_OPERATION);
+    }
+    auto query = vsag::Dataset::Make();
+    query->NumElements(1)->Dim(dim)->Float32Vectors(query_vector)->Owner(false);
+    if (auto result = hnsw->get_index()->KnnSearchIterator(query); result.has_value()) {
+        iter = new SearchIterator{result.value()};
+        return 0;
+    } else {
+        error = result.error().type;
+    }
+    vsag::logger::error("   knn search iterator error happend, ret={}", static_cast<int>(error));
+    return static_cast<int>(error);
+}
+
+int knn_search_next(VectorIndexPtr& index_handler, VectorIteratorPtr iter, int64_t topk,
+                    const float*& dist, const int64_t*& ids, int64_t &result_size,
+                    const SearchParam& param, void* invalid) {
+    vsag::logger::debug("TRACE LOG[knn_search_next]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    if (index_handler == nullptr || iter == nullptr) {
+        vsag::logger::debug("   null pointer addr, index_handler:{}, iter:{}",
+                            (void*)index_handler, (void*)iter);
+        return static_cast<int>(error);
+    }
+    SlowTaskTimer t("knn_search_next");
+    roaring::api::roaring64_bitmap_t *bitmap = static_cast<roaring::api::roaring64_bitmap_t*>(invalid);
+    roaring::api::roaring64_bitmap_t *valid = static_cast<roaring::api::roaring64_bitmap_t*>(param.valid_);
+    auto filter = [bitmap, valid](int64_t id) -> bool {
+        return (bitmap != nullptr && roaring::api::roaring64_bitmap_contains(bitmap, id))
+               || (valid != nullptr && !roaring::api::roaring64_bitmap_contains(valid, id));
+    };
+    vsag::SearchParam search_parameters;
+    search_parameters.ef_search = param.ef_search_;
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    SearchIterator* search_iter = static_cast<SearchIterator*>(iter);
+    auto result = hnsw->get_index()->KnnSearchNext(search_iter->context_, topk, search_parameters, filter);
+    if (result.has_value()) {
+        // the caller frees the results, like knn_search
+        result.value()->Owner(false);
+        ids = result.value()->GetIds();
+        dist = result.value()->GetDistances();
+        result_size = result.value()->GetDim();
+        vsag::logger::debug("   knn search next returns {} results", result_size);
+        return 0;
+    } else {
+        error = result.error().type;
+    }
+    vsag::logger::error("   knn search next error happend, ret={}", static_cast<int>(error));
+    return static_cast<int>(error);
+}
+
+int delete_iterator(VectorIteratorPtr& iter) {
+    vsag::logger::debug("TRACE LOG[delete_iterator]:");
+    if (iter != nullptr) {
+        delete static_cast<SearchIterator*>(iter);
+        iter = nullptr;
+    }
+    return 0;
+}
+
+int range_search(VectorIndexPtr& index_handler, float* query_vector, int dim, float radius,
+                 int64_t limited_size, const float*& dist, const int64_t*& ids, int64_t &result_size,
+                 const SearchParam& param, void* invalid) {
+    vsag::logger::debug("TRACE LOG[range_search]:");
+    vsag::ErrorType error = vsag::ErrorType::UNKNOWN_ERROR;
+    if (index_handler == nullptr || query_vector == nullptr) {
+        vsag::logger::debug("   null pointer addr, index_handler:{}, query_vector:{}",
+                            (void*)index_handler, (void*)query_vector);
+        return static_cast<int>(error);
+    }
+    HnswIndexHandler* hnsw = static_cast<HnswIndexHandler*>(index_handler);
+    if (DISKANN_TYPE == hnsw->get_index_type() || hnsw->get_use_static()) {
+        return static_cast<int>(vsag::ErrorType::UNSUPPORTED_INDEX_OPERATION);
+    }
+    SlowTaskTimer t("range_search");
+    roaring::api::roaring64_bitmap_t *bitmap = static_cast<roaring::api::roaring64_bitmap_t*>(invalid);
+    roaring::api::roaring64_bitmap_t *valid = static_cast<roaring::api::roaring64_bitmap_t*>(param.valid_);
+    auto filter = [bitmap, valid](int64_t id) -> bool {
+        return (bitmap != nullptr && roaring::api::roaring64_bitmap_contains(bitmap, id))
+               || (valid != nullptr && !roaring::api::roaring64_bitmap_contains(valid, id));
+    };
+    nlohmann::json hnsw_parameters{{"ef_search", param.ef_search_},
+                                   {"use_conjugate_graph_search", param.use_conjugate_graph_search_}};
+    nlohmann::json search_parameters{{"hnsw", hnsw_parameters}};
+    auto query = vsag::Dataset::Make();
+    query->NumElements(1)->Dim(dim)->Float32Vectors(query_vector)->Owner(false);
+    auto result = hnsw->get_index()->RangeSearch(query, radius, search_parameters.dump(), filter,
+                                                 limited_size > 0 ? limited_size : -1);
+    if (result.has_value()) {
+        // the caller frees the results, like knn_search
+        result.value()->Owner(false);
+        ids = result.value()->GetIds();
+        dist = result.value()->GetDistances();
+        result_size = result.value()->GetDim();
+        vsag::logger::debug("   range search returns {} results", result_size);
+        return 0;
+    } else {
+        error = result.error().type;
+    }
+    vsag::logger::error("   range search error happend, ret={}", static_cast<int>(error));
+    return static_cast<int>(error);
+}
+
 int64_t example() {
     return 0;
 }
@@ -514,6 +1326,14 @@ extern void set_block_size_limit_c(uint64_t size) {
     set_block_size_limit(size);
 }
 
+extern void set_parallel_executor_c(ParallelExecutor executor) {
+    set_parallel_executor(executor);
+}
+
+extern void set_disk_index_dir_c(const char* dir) {
+    set_disk_index_dir(dir);
+}
+
 extern bool is_supported_index_c(IndexType index_type) {
     return is_supported_index(index_type);
 }
@@ -521,9 +1341,11 @@ extern bool is_supported_index_c(IndexType index_type) {
 extern int create_index_c(VectorIndexPtr& index_handler, IndexType index_type,
                  const char* dtype,
                  const char* metric, int dim,
-                 int max_degree, int ef_construction, int ef_search, void* allocator)
+                 int max_degree, int ef_construction, int ef_search, void* allocator,
+                 int build_thread_num)
 {
-    return create_index(index_handler, index_type, dtype, metric, dim, max_degree, ef_construction, ef_search, allocator);
+    return create_index(index_handler, index_type, dtype, metric, dim, max_degree, ef_construction, ef_search, allocator,
+                        build_thread_num);
 }
 
 extern int build_index_c(VectorIndexPtr& index_handler,float* vector_list, int64_t* ids, int dim, int size) {
@@ -545,6 +1367,13 @@ extern int knn_search_c(VectorIndexPtr& index_handler,float* query_vector,int di
     return knn_search(index_handler, query_vector, dim, topk, dist, ids, result_size, ef_search, invalid);
 }
 
+extern int knn_search_batch_c(VectorIndexPtr& index_handler, float* query_vectors, int64_t query_num, int dim,
+                              int64_t topk, const float** dists, const int64_t** ids, int64_t* result_sizes,
+                              const SearchParam& param, void* invalid) {
+    return knn_search_batch(index_handler, query_vectors, query_num, dim, topk, dists, ids, result_sizes,
+                            param, invalid);
+}
+
 extern int serialize_c(VectorIndexPtr& index_handler, const std::string dir) {
     return serialize(index_handler, dir);
 }
@@ -556,6 +1385,45 @@ extern int fserialize_c(VectorIndexPtr& index_handler, std::ostream& out_stream)
 extern int delete_index_c(VectorIndexPtr& index_handler) {
     return delete_index(index_handler);
 }
+
+extern int remove_index_c(VectorIndexPtr& index_handler, int64_t* ids, int64_t size, int64_t &removed_cnt) {
+    return remove_index(index_handler, ids, size, removed_cnt);
+}
+
+extern int prepare_compact_index_c(VectorIndexPtr& index_handler) {
+    return prepare_compact_index(index_handler);
+}
+
+extern int compact_index_c(VectorIndexPtr& index_handler, int64_t &removed_cnt) {
+    return compact_index(index_handler, removed_cnt);
+}
+
+extern int calibrate_recall_c(VectorIndexPtr& index_handler, int64_t topk, const int64_t* ef_searches,
+                              int64_t ef_cnt, int64_t sample_cnt, float* recalls) {
+    return calibrate_recall(index_handler, topk, ef_searches, ef_cnt, sample_cnt, recalls);
+}
+
+extern int knn_search_iterator_c(VectorIndexPtr& index_handler, float* query_vector, int dim,
+                                 VectorIteratorPtr& iter) {
+    return knn_search_iterator(index_handler, query_vector, dim, iter);
+}
+
+extern int knn_search_next_c(VectorIndexPtr& index_handler, VectorIteratorPtr iter, int64_t topk,
+                             const float*& dist, const int64_t*& ids, int64_t &result_size,
+                             const SearchParam& param, void* invalid) {
+    return knn_search_next(index_handler, iter, topk, dist, ids, result_size, param, invalid);
+}
+
+extern int delete_iterator_c(VectorIteratorPtr& iter) {
+    return delete_iterator(iter);
+}
+
+extern int range_search_c(VectorIndexPtr& index_handler, float* query_vector, int dim, float radius,
+                          int64_t limited_size, const float*& dist, const int64_t*& ids,
+                          int64_t &result_size, const SearchParam& param, void* invalid) {
+    return range_search(index_handler, query_vector, dim, radius, limited_size, dist, ids,
+                        result_size, param, invalid);
+}
 extern int fdeserialize_c(VectorIndexPtr& index_handler, std::istream& in_stream) {
     return fdeserialize(index_handler, in_stream);
 }
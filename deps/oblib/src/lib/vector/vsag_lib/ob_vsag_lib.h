@@ -1,6 +1,7 @@
 #ifndef OB_VSAG_LIB_H
 #define OB_VSAG_LIB_H
 #include <stdint.h>
+#include <atomic>
 #include <iostream>
 #include <map>
 namespace obvectorlib {
@@ -9,12 +10,34 @@ namespace obvectorlib {
 
 int64_t example();
 typedef void* VectorIndexPtr;
+typedef void* VectorIteratorPtr;
 extern bool is_init_;
 enum IndexType {
   INVALID_INDEX_TYPE = -1,
   HNSW_TYPE = 0,  // 看来暂时只支持 HNSW，菜。
+  HNSW_SQ_TYPE = 1,  // 向量以 8bit 标量量化后存储的 HNSW, 内存约为 HNSW_TYPE 的 1/4
+  DISKANN_TYPE = 2,  // PQ 码常驻内存, 原始向量和图按需从磁盘读取, 只支持一次性构建(在首次查询或序列化时完成)
   MAX_INDEX_TYPE
 };
+// 多线程构建索引时, vsag 通过 ParallelExecutor 并发执行 task(task_arg, 0 .. task_num - 1),
+// 全部执行完成后返回。调用方可以借此让构建任务运行在自己管理的线程上(比如带租户上下文的线程)。
+typedef void (*ParallelTask)(void* task_arg, int64_t task_idx);
+typedef void (*ParallelExecutor)(int64_t task_num, ParallelTask task, void* task_arg);
+// 查询参数, 直接以结构体形式传给 vsag, 查询路径上不再构造和解析 json
+// 与另一个索引的查询结果合并时, 第 i 个查询读取 distance_bounds_[i], 候选距离超过它后提前结束;
+// 查询结果满 topk 时把第 topk 个距离写入 result_bounds_[i], 供另一个索引的查询使用。
+// 两个数组均可为空, knn_search 只使用下标 0
+struct SearchParam {
+  SearchParam()
+    : ef_search_(0), use_conjugate_graph_search_(true),
+      distance_bounds_(nullptr), result_bounds_(nullptr), valid_(nullptr) {}
+  int ef_search_;
+  bool use_conjugate_graph_search_;
+  const std::atomic<float>* distance_bounds_;
+  std::atomic<float>* result_bounds_;
+  // roaring64 bitmap of the only ids which may be returned, nullptr means all ids
+  void* valid_;
+};
 /**
  *   * Get the version based on git revision
  *     *
@@ -42,13 +65,18 @@ extern bool is_init();
 extern void set_log_level(int64_t level_num);
 extern void set_logger(void *logger_ptr);
 extern void set_block_size_limit(uint64_t size);
+extern void set_parallel_executor(ParallelExecutor executor);
+// DISKANN_TYPE 加载后图和原始向量落盘的目录, 未设置时仍保留在内存中
+extern void set_disk_index_dir(const char* dir);
 extern bool is_supported_index(IndexType index_type);
 
 // 创建索引操作
+// dtype 为 hnsw 图中存储向量的元素类型 (float32/float16/bfloat16/int8), 插入和查询的向量总是 float32
 extern int create_index(VectorIndexPtr& index_handler, IndexType index_type,
                         const char* dtype,
                         const char* metric,int dim,
-                        int max_degree, int ef_construction, int ef_search, void* allocator = NULL);
+                        int max_degree, int ef_construction, int ef_search, void* allocator = NULL,
+                        int build_thread_num = 1);
 
 extern int build_index(VectorIndexPtr& index_handler, float* vector_list, int64_t* ids, int dim, int size);
 
@@ -58,11 +86,47 @@ extern int get_index_number(VectorIndexPtr& index_handler, int64_t &size);
 extern int knn_search(VectorIndexPtr& index_handler,float* query_vector, int dim, int64_t topk,
                       const float*& dist, const int64_t*& ids, int64_t &result_size, int ef_search,
                        void* invalid = NULL);
+extern int knn_search(VectorIndexPtr& index_handler,float* query_vector, int dim, int64_t topk,
+                      const float*& dist, const int64_t*& ids, int64_t &result_size,
+                      const SearchParam& param, void* invalid = NULL);
+// 批量查询: query_vectors 中连续存放 query_num 个向量, 第 i 个查询的结果写入 dists[i], ids[i], result_sizes[i],
+// 三个数组由调用方分配(长度为 query_num), 结果内存与 knn_search 相同, 由调用方释放(出错时也需要释放已有结果)。
+// 设置了 ParallelExecutor 时多个查询并发执行, 共用索引的 visited list pool。
+extern int knn_search_batch(VectorIndexPtr& index_handler, float* query_vectors, int64_t query_num, int dim,
+                            int64_t topk, const float** dists, const int64_t** ids, int64_t* result_sizes,
+                            const SearchParam& param, void* invalid = NULL);
 extern int serialize(VectorIndexPtr& index_handler, const std::string dir);
 extern int deserialize_bin(VectorIndexPtr& index_handler, const std::string dir);
 extern int fserialize(VectorIndexPtr& index_handler, std::ostream& out_stream);
 extern int fdeserialize(VectorIndexPtr& index_handler, std::istream& in_stream);
 extern int delete_index(VectorIndexPtr& index_handler);
+// 标记删除 ids 中的向量, 不在索引中的 id 被忽略, removed_cnt 返回实际标记的数量。
+// 只支持 hnsw 类型的索引, 执行期间可以有并发的查询。
+extern int remove_index(VectorIndexPtr& index_handler, int64_t* ids, int64_t size, int64_t &removed_cnt);
+// 预先计算已标记删除的向量的邻居修复后的连接, 不修改索引。
+// 只支持 hnsw 类型的索引, 执行期间可以有并发的查询。
+extern int prepare_compact_index(VectorIndexPtr& index_handler);
+// 物理删除已标记删除的向量并修复其邻居的连接, 使用 prepare_compact_index 预先计算的结果,
+// removed_cnt 返回实际删除的数量。只支持 hnsw 类型的索引, 执行期间不能有其他操作。
+extern int compact_index(VectorIndexPtr& index_handler, int64_t &removed_cnt);
+// 用索引中均匀抽样的 sample_cnt 个向量作为查询, 与精确扫描的结果比较, 测量 topk 查询在每个 ef_searches[i]
+// 下的平均召回率, 写入调用方分配的 recalls[i] (长度为 ef_cnt)。只支持 hnsw 类型的索引。
+extern int calibrate_recall(VectorIndexPtr& index_handler, int64_t topk, const int64_t* ef_searches,
+                            int64_t ef_cnt, int64_t sample_cnt, float* recalls);
+// 迭代查询: knn_search_iterator 创建查询上下文 iter, 之后每次 knn_search_next 按距离从近到远返回接下来的 topk 个结果,
+// 已返回过的结果不会重复返回, 结果不足 topk 时说明查询已结束。结果内存与 knn_search 相同, 由调用方释放。
+// 索引被 compact 或重排后迭代结束。只支持非 static 的 hnsw 类型索引, iter 由 delete_iterator 释放。
+extern int knn_search_iterator(VectorIndexPtr& index_handler, float* query_vector, int dim, VectorIteratorPtr& iter);
+extern int knn_search_next(VectorIndexPtr& index_handler, VectorIteratorPtr iter, int64_t topk,
+                           const float*& dist, const int64_t*& ids, int64_t &result_size,
+                           const SearchParam& param, void* invalid = NULL);
+extern int delete_iterator(VectorIteratorPtr& iter);
+// 范围查询: 返回与查询向量距离不超过 radius 的结果, 按距离从近到远排列, 最多返回 limited_size 个(<= 0 表示不限制)。
+// radius 使用索引自身的距离度量(l2 为平方距离, ip 为 1 - 内积)。结果内存与 knn_search 相同, 由调用方释放。
+// 只支持非 static 的 hnsw 类型索引。
+extern int range_search(VectorIndexPtr& index_handler, float* query_vector, int dim, float radius,
+                        int64_t limited_size, const float*& dist, const int64_t*& ids, int64_t &result_size,
+                        const SearchParam& param, void* invalid = NULL);
 } // namesapce obvectorlib
 #endif // OB_VSAG_LIB_H
 
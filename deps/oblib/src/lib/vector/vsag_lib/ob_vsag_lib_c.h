@@ -33,17 +33,24 @@ extern void set_logger_c(void *logger_ptr);
 typedef void (*set_block_size_limit_ptr)(uint64_t size);
 extern void set_block_size_limit_c(uint64_t size);
 
+typedef void (*set_parallel_executor_ptr)(ParallelExecutor executor);
+extern void set_parallel_executor_c(ParallelExecutor executor);
+typedef void (*set_disk_index_dir_ptr)(const char* dir);
+extern void set_disk_index_dir_c(const char* dir);
+
 typedef bool (*is_supported_index_ptr)(IndexType index_type);
 extern bool is_supported_index_c(IndexType index_type);
 
 typedef int (*create_index_ptr)(VectorIndexPtr& index_handler, IndexType index_type,
                         const char* dtype,
                         const char* metric,int dim,
-                        int max_degree, int ef_construction, int ef_search, void* allocator);
+                        int max_degree, int ef_construction, int ef_search, void* allocator,
+                        int build_thread_num);
 extern int create_index_c(VectorIndexPtr& index_handler, IndexType index_type,
                         const char* dtype,
                         const char* metric,int dim,
-                        int max_degree, int ef_construction, int ef_search, void* allocator = NULL);
+                        int max_degree, int ef_construction, int ef_search, void* allocator = NULL,
+                        int build_thread_num = 1);
 
 typedef int (*build_index_ptr)(VectorIndexPtr& index_handler, float* vector_list, int64_t* ids, int dim, int size);              
 extern int build_index_c(VectorIndexPtr& index_handler, float* vector_list, int64_t* ids, int dim, int size);
@@ -61,6 +68,13 @@ extern int knn_search_c(VectorIndexPtr& index_handler,float* query_vector, int d
                       const float*& dist, const int64_t*& ids, int64_t &result_size, int ef_search,
                       void* invalid = NULL);
 
+typedef int (*knn_search_batch_ptr)(VectorIndexPtr& index_handler, float* query_vectors, int64_t query_num, int dim,
+                            int64_t topk, const float** dists, const int64_t** ids, int64_t* result_sizes,
+                            const SearchParam& param, void* invalid);
+extern int knn_search_batch_c(VectorIndexPtr& index_handler, float* query_vectors, int64_t query_num, int dim,
+                            int64_t topk, const float** dists, const int64_t** ids, int64_t* result_sizes,
+                            const SearchParam& param, void* invalid = NULL);
+
 typedef int (*serialize_ptr)(VectorIndexPtr& index_handler, const std::string dir);          
 extern int serialize_c(VectorIndexPtr& index_handler, const std::string dir);
 
@@ -70,6 +84,39 @@ extern int deserialize_bin_c(VectorIndexPtr& index_handler, const std::string di
 typedef int (*delete_index_ptr)(VectorIndexPtr& index_handler);
 extern int delete_index_c(VectorIndexPtr& index_handler);
 
+typedef int (*remove_index_ptr)(VectorIndexPtr& index_handler, int64_t* ids, int64_t size, int64_t &removed_cnt);
+extern int remove_index_c(VectorIndexPtr& index_handler, int64_t* ids, int64_t size, int64_t &removed_cnt);
+typedef int (*prepare_compact_index_ptr)(VectorIndexPtr& index_handler);
+extern int prepare_compact_index_c(VectorIndexPtr& index_handler);
+typedef int (*compact_index_ptr)(VectorIndexPtr& index_handler, int64_t &removed_cnt);
+extern int compact_index_c(VectorIndexPtr& index_handler, int64_t &removed_cnt);
+typedef int (*calibrate_recall_ptr)(VectorIndexPtr& index_handler, int64_t topk, const int64_t* ef_searches,
+                                    int64_t ef_cnt, int64_t sample_cnt, float* recalls);
+extern int calibrate_recall_c(VectorIndexPtr& index_handler, int64_t topk, const int64_t* ef_searches,
+                              int64_t ef_cnt, int64_t sample_cnt, float* recalls);
+
+typedef int (*knn_search_iterator_ptr)(VectorIndexPtr& index_handler, float* query_vector, int dim,
+                                       VectorIteratorPtr& iter);
+extern int knn_search_iterator_c(VectorIndexPtr& index_handler, float* query_vector, int dim,
+                                 VectorIteratorPtr& iter);
+
+typedef int (*knn_search_next_ptr)(VectorIndexPtr& index_handler, VectorIteratorPtr iter, int64_t topk,
+                                   const float*& dist, const int64_t*& ids, int64_t &result_size,
+                                   const SearchParam& param, void* invalid);
+extern int knn_search_next_c(VectorIndexPtr& index_handler, VectorIteratorPtr iter, int64_t topk,
+                             const float*& dist, const int64_t*& ids, int64_t &result_size,
+                             const SearchParam& param, void* invalid = NULL);
+
+typedef int (*delete_iterator_ptr)(VectorIteratorPtr& iter);
+extern int delete_iterator_c(VectorIteratorPtr& iter);
+
+typedef int (*range_search_ptr)(VectorIndexPtr& index_handler, float* query_vector, int dim, float radius,
+                                int64_t limited_size, const float*& dist, const int64_t*& ids,
+                                int64_t &result_size, const SearchParam& param, void* invalid);
+extern int range_search_c(VectorIndexPtr& index_handler, float* query_vector, int dim, float radius,
+                          int64_t limited_size, const float*& dist, const int64_t*& ids,
+                          int64_t &result_size, const SearchParam& param, void* invalid = NULL);
+
 typedef int (*fserialize_ptr)(VectorIndexPtr& index_handler, std::ostream& out_stream);
 extern int fserialize_c(VectorIndexPtr& index_handler, std::ostream& out_stream);
 
@@ -65,6 +65,8 @@ private:
     size_t size_data_per_element_{0};
     size_t size_links_per_element_{0};
     mutable std::atomic<size_t> num_deleted_{0};  // number of deleted elements
+    // bumped whenever the internal ids are changed, the open knn iterators stop then
+    std::atomic<uint64_t> layout_version_{0};
     size_t M_{0};
     size_t maxM_{0};
     size_t maxM0_{0};
@@ -108,6 +110,7 @@ private:
     mutable std::mutex label_lookup_lock_{};  // lock for label_lookup_
     vsag::UnorderedMap<labeltype, tableint> label_lookup_;
 
+    std::mutex level_generator_lock_{};  // lock for level_generator_
     std::default_random_engine level_generator_;
     std::default_random_engine update_probability_generator_;
 
@@ -124,6 +127,20 @@ private:
     std::mutex deleted_elements_lock_{};             // lock for deleted_elements_
     vsag::UnorderedSet<tableint> deleted_elements_;  // contains internal ids of deleted elements
 
+    // the links repaired by prepareCompaction, applied by the next compactDeleted
+    struct LinkRepair {
+        tableint id_;
+        int level_;
+        size_t offset_;
+        size_t size_;
+    };
+    vsag::Vector<LinkRepair> link_repairs_;
+    vsag::Vector<tableint> repaired_links_;
+    bool compaction_prepared_{false};
+    size_t prepared_element_count_{0};
+    size_t prepared_deleted_count_{0};
+    uint64_t prepared_layout_version_{0};
+
 public:
     HierarchicalNSW(SpaceInterface* s,
                     size_t max_elements,
@@ -142,7 +159,9 @@ public:
           use_reversed_edges_(use_reversed_edges),
           normalize_(normalize),
           label_lookup_(allocator),
-          deleted_elements_(allocator) {
+          deleted_elements_(allocator),
+          link_repairs_(allocator),
+          repaired_links_(allocator) {
         max_elements_ = max_elements;
         num_deleted_ = 0;
         data_size_ = s->get_data_size();
@@ -393,6 +412,7 @@ public:
     int
     getRandomLevel(double reverse_size) {
         std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        std::unique_lock<std::mutex> lock(level_generator_lock_);
         double r = -log(distribution(level_generator_)) * reverse_size;
         return (int)r;
     }
@@ -510,7 +530,8 @@ public:
     searchBaseLayerST(tableint ep_id,
                       const void* data_point,
                       size_t ef,
-                      BaseFilterFunctor* isIdAllowed = nullptr) const {
+                      BaseFilterFunctor* isIdAllowed = nullptr,
+                      const std::atomic<float>* distance_bound = nullptr) const {
         auto vl = visited_list_pool_->getFreeVisitedList();
         vl_type* visited_array = vl->mass;
         vl_type visited_array_tag = vl->curV;
@@ -545,6 +566,11 @@ public:
                 (top_candidates.size() == ef || (!isIdAllowed && !has_deletions))) {
                 break;
             }
+            // the candidates farther than the bound can not enter the merged results
+            if (distance_bound != nullptr && !top_candidates.empty() &&
+                (-current_node_pair.first) > distance_bound->load(std::memory_order_relaxed)) {
+                break;
+            }
             candidate_set.pop();
 
             tableint current_node_id = current_node_pair.second;
@@ -612,7 +638,8 @@ public:
                       const void* data_point,
                       float radius,
                       int64_t ef,
-                      BaseFilterFunctor* isIdAllowed = nullptr) const {
+                      BaseFilterFunctor* isIdAllowed = nullptr,
+                      size_t limited_size = 0) const {
         auto vl = visited_list_pool_->getFreeVisitedList();
         vl_type* visited_array = vl->mass;
         vl_type visited_array_tag = vl->curV;
@@ -641,9 +668,20 @@ public:
 
         visited_array[ep_id] = visited_array_tag;
         uint64_t visited_count = 0;
+        // the distances of the nearest elements within the radius, only the nearest limited_size
+        // ones are returned, so the candidates farther than all of them are not expanded
+        size_t in_range_size = limited_size > 0 ? std::max((size_t)ef, limited_size) : 0;
+        std::priority_queue<float> in_range;
+        if (in_range_size > 0 && !top_candidates.empty()) {
+            in_range.push(top_candidates.top().first);
+        }
 
         while (!candidate_set.empty()) {
             std::pair<float, tableint> current_node_pair = candidate_set.top();
+            if (in_range_size > 0 && in_range.size() >= in_range_size &&
+                (-current_node_pair.first) > in_range.top()) {
+                break;
+            }
 
             candidate_set.pop();
 
@@ -690,8 +728,15 @@ public:
 #endif
 
                         if ((!has_deletions || !isMarkedDeleted(candidate_id)) &&
-                            ((!isIdAllowed) || (*isIdAllowed)(getExternalLabel(candidate_id))))
+                            ((!isIdAllowed) || (*isIdAllowed)(getExternalLabel(candidate_id)))) {
                             top_candidates.emplace(dist, candidate_id);
+                            if (in_range_size > 0 && dist <= radius + THRESHOLD_ERROR) {
+                                in_range.push(dist);
+                                if (in_range.size() > in_range_size) {
+                                    in_range.pop();
+                                }
+                            }
+                        }
 
                         if (!top_candidates.empty())
                             lowerBound = top_candidates.top().first;
@@ -1395,6 +1440,539 @@ public:
         return true;
     }
 
+    /*
+    * Relabels the elements in the bfs order of the level 0 graph from the entry point, so that
+    * the elements visited one after another by a search are close in memory. Only the internal
+    * ids change, the labels are kept. The caller must make sure no other operation is running.
+    */
+    bool
+    reorder() override {
+        if (use_reversed_edges_ || cur_element_count_ <= 1 || enterpoint_node_ == (tableint)-1) {
+            return false;
+        }
+        relabel(false);
+        return true;
+    }
+
+    /*
+    * Computes the links of the live elements with the deleted elements replaced, without
+    * changing the graph, so it can run along with searches. The next compactDeleted applies
+    * them if no element is added or deleted in between. Returns the number of repaired links.
+    */
+    size_t
+    prepareCompaction() override {
+        link_repairs_.clear();
+        repaired_links_.clear();
+        size_t count = cur_element_count_;
+        prepared_element_count_ = count;
+        prepared_deleted_count_ = num_deleted_;
+        prepared_layout_version_ = layout_version_;
+        compaction_prepared_ = false;
+        if (use_reversed_edges_ || prepared_deleted_count_ == 0 ||
+            prepared_deleted_count_ >= count) {
+            return 0;
+        }
+        for (tableint id = 0; id < count; ++id) {
+            if (!isMarkedDeleted(id)) {
+                for (int level = 0; level <= element_levels_[id]; ++level) {
+                    size_t offset = repaired_links_.size();
+                    if (getRepairedLinks(id, level, repaired_links_)) {
+                        link_repairs_.push_back(
+                            {id, level, offset, repaired_links_.size() - offset});
+                    }
+                }
+            }
+        }
+        compaction_prepared_ = true;
+        return link_repairs_.size();
+    }
+
+    /*
+    * Removes the elements marked deleted. The links to a deleted element are replaced by its
+    * neighbors, pruned by the heuristic used by insertion. Then the elements are relabeled so
+    * that the deleted ones are at the tail, and the tail is cut off. Returns the number of
+    * removed elements. The caller must make sure no other operation is running.
+    */
+    size_t
+    compactDeleted() override {
+        size_t count = cur_element_count_;
+        size_t deleted_count = num_deleted_;
+        bool use_prepared = compaction_prepared_ && prepared_element_count_ == count &&
+                            prepared_deleted_count_ == deleted_count &&
+                            prepared_layout_version_ == layout_version_;
+        compaction_prepared_ = false;
+        if (use_reversed_edges_ || deleted_count == 0) {
+            return 0;
+        }
+        if (deleted_count >= count) {
+            clearElements(0, count);
+            enterpoint_node_ = -1;
+            maxlevel_ = -1;
+            deleted_elements_.clear();
+            num_deleted_ = 0;
+            cur_element_count_ = 0;
+            layout_version_++;
+            return deleted_count;
+        }
+        if (isMarkedDeleted(enterpoint_node_)) {
+            int new_level = -1;
+            for (tableint id = 0; id < count; ++id) {
+                if (!isMarkedDeleted(id) && element_levels_[id] > new_level) {
+                    enterpoint_node_ = id;
+                    new_level = element_levels_[id];
+                }
+            }
+            maxlevel_ = new_level;
+        }
+        if (use_prepared) {
+            for (const auto& repair : link_repairs_) {
+                linklistsizeint* data = get_linklist_at_level(repair.id_, repair.level_);
+                memcpy(data + 1,
+                       repaired_links_.data() + repair.offset_,
+                       repair.size_ * sizeof(tableint));
+                setListCount(data, repair.size_);
+            }
+        } else {
+            vsag::Vector<tableint> links(allocator_);
+            for (tableint id = 0; id < count; ++id) {
+                if (!isMarkedDeleted(id)) {
+                    for (int level = 0; level <= element_levels_[id]; ++level) {
+                        links.clear();
+                        if (getRepairedLinks(id, level, links)) {
+                            linklistsizeint* data = get_linklist_at_level(id, level);
+                            memcpy(data + 1, links.data(), links.size() * sizeof(tableint));
+                            setListCount(data, links.size());
+                        }
+                    }
+                }
+            }
+        }
+        link_repairs_.clear();
+        repaired_links_.clear();
+
+        relabel(true);
+
+        size_t live_count = count - deleted_count;
+        clearElements(live_count, count);
+        deleted_elements_.clear();
+        num_deleted_ = 0;
+        cur_element_count_ = live_count;
+        return deleted_count;
+    }
+
+    /*
+    * Measures the average recall of the k nearest neighbor searches with every ef of efs. The
+    * queries are sample_count live elements picked evenly, each one is excluded from its own
+    * results, and the exact neighbors are found by a scan of all the live elements. The caller
+    * must make sure no insertion or removal is running.
+    */
+    std::vector<float>
+    calibrateRecall(size_t k, const std::vector<size_t>& efs, size_t sample_count) override {
+        class ExcludeLabelFilter : public BaseFilterFunctor {
+        public:
+            explicit ExcludeLabelFilter(labeltype label) : label_(label) {
+            }
+            bool
+            operator()(labeltype label) override {
+                return label != label_;
+            }
+
+        private:
+            labeltype label_;
+        };
+
+        std::vector<float> recalls(efs.size(), 0);
+        size_t count = cur_element_count_;
+        size_t live_count = count - num_deleted_;
+        if (k == 0 || sample_count == 0 || live_count <= k) {
+            return recalls;
+        }
+        sample_count = std::min(sample_count, live_count);
+        size_t sampled = 0;
+        tableint id = 0;
+        for (size_t n = 0; n < sample_count; ++n, ++id) {
+            // the first live element from the evenly spaced position
+            id = std::max(id, (tableint)(n * count / sample_count));
+            while (id < count && isMarkedDeleted(id)) {
+                ++id;
+            }
+            if (id >= count) {
+                break;
+            }
+            ++sampled;
+            const void* query = getDataByInternalId(id);
+            std::priority_queue<std::pair<float, labeltype>> exact;
+            for (tableint i = 0; i < count; ++i) {
+                if (i == id || isMarkedDeleted(i)) {
+                    continue;
+                }
+                float dist = fstdistfunc_(query, getDataByInternalId(i), dist_func_param_);
+                if (exact.size() < k) {
+                    exact.emplace(dist, getExternalLabel(i));
+                } else if (dist < exact.top().first) {
+                    exact.pop();
+                    exact.emplace(dist, getExternalLabel(i));
+                }
+            }
+            std::unordered_set<labeltype> truth;
+            while (!exact.empty()) {
+                truth.insert(exact.top().second);
+                exact.pop();
+            }
+            ExcludeLabelFilter filter(getExternalLabel(id));
+            for (size_t j = 0; j < efs.size(); ++j) {
+                auto result = searchKnn(query, k, std::max(efs[j], k), &filter);
+                size_t hit_count = 0;
+                while (!result.empty()) {
+                    hit_count += truth.count(result.top().second);
+                    result.pop();
+                }
+                recalls[j] += (float)hit_count / truth.size();
+            }
+        }
+        for (auto& recall : recalls) {
+            recall = sampled == 0 ? 0 : recall / sampled;
+        }
+        return recalls;
+    }
+
+    std::unique_ptr<KnnIteratorState>
+    searchKnnIterator(const void* query_data) const override {
+        auto state = std::make_unique<IteratorState>();
+        std::shared_ptr<float[]> normalize_query;
+        normalize_vector(query_data, normalize_query);
+        state->query_.assign((const char*)query_data, (const char*)query_data + data_size_);
+        startKnnIterator(state.get());
+        return state;
+    }
+
+    /*
+    * Goes on with the best first search of the iterator. The first batch expands the candidates
+    * as searchKnn does with ef, so it is as good as searchKnn. The later batches expand the
+    * candidates until ef elements are pending and the nearest pending one is nearer than all the
+    * candidates, then it is yielded. Every visited element stays pending until it is yielded, so
+    * the search never visits an element twice. Once the internal ids are changed, the search
+    * starts again from the entry point and skips the elements yielded before.
+    */
+    std::vector<std::pair<float, labeltype>>
+    searchKnnNext(KnnIteratorState* iterator_state,
+                  size_t k,
+                  uint64_t ef,
+                  BaseFilterFunctor* isIdAllowed = nullptr) const override {
+        std::vector<std::pair<float, labeltype>> result;
+        auto* state = static_cast<IteratorState*>(iterator_state);
+        if (state == nullptr) {
+            return result;
+        }
+        if (state->layout_version_ != layout_version_) {
+            startKnnIterator(state);
+        }
+        size_t pending_size = std::max(ef, (uint64_t)k);
+        if (!state->converged_) {
+            convergeKnnIterator(state, pending_size, isIdAllowed);
+            state->converged_ = true;
+        }
+        while (result.size() < k) {
+            while (!state->candidates_.empty() &&
+                   (state->pending_.size() < pending_size ||
+                    state->candidates_.top().first > state->pending_.top().first)) {
+                tableint current_id = state->candidates_.top().second;
+                state->candidates_.pop();
+                expandKnnIterator(state, current_id);
+            }
+            if (state->pending_.empty()) {
+                break;
+            }
+            std::pair<float, tableint> nearest = state->pending_.top();
+            state->pending_.pop();
+            labeltype label = getExternalLabel(nearest.second);
+            if (!isMarkedDeleted(nearest.second) && (!isIdAllowed || (*isIdAllowed)(label)) &&
+                state->yielded_.insert(label).second) {
+                result.emplace_back(-nearest.first, label);
+            }
+        }
+        return result;
+    }
+
+private:
+    // the elements are kept with their negative distances, so the nearest one is on the top
+    class IteratorState : public KnnIteratorState {
+    public:
+        uint64_t layout_version_{0};
+        std::vector<char> query_;
+        std::vector<bool> visited_;
+        // the visited elements whose neighbors are not visited yet
+        std::priority_queue<std::pair<float, tableint>> candidates_;
+        // the visited elements not yielded yet
+        std::priority_queue<std::pair<float, tableint>> pending_;
+        // whether the first batch has expanded the candidates as searchKnn
+        bool converged_{false};
+        // the labels yielded, skipped when the search starts again
+        std::unordered_set<labeltype> yielded_;
+    };
+
+    // searches the upper levels from the entry point, and starts the level 0 search from the
+    // nearest element found
+    void
+    startKnnIterator(IteratorState* state) const {
+        state->layout_version_ = layout_version_;
+        state->visited_.clear();
+        state->candidates_ = {};
+        state->pending_ = {};
+        state->converged_ = false;
+        if (cur_element_count_ == 0) {
+            return;
+        }
+        const void* query = state->query_.data();
+        tableint currObj = enterpoint_node_;
+        float curdist = fstdistfunc_(query, getDataByInternalId(currObj), dist_func_param_);
+        for (int level = maxlevel_; level > 0; level--) {
+            bool changed = true;
+            while (changed) {
+                changed = false;
+                unsigned int* data = (unsigned int*)get_linklist(currObj, level);
+                int size = getListCount(data);
+                tableint* datal = (tableint*)(data + 1);
+                for (int i = 0; i < size; i++) {
+                    tableint cand = datal[i];
+                    if (cand < 0 || cand > max_elements_)
+                        throw std::runtime_error("cand error");
+                    float d = fstdistfunc_(query, getDataByInternalId(cand), dist_func_param_);
+                    if (d < curdist) {
+                        curdist = d;
+                        currObj = cand;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        state->visited_.resize(cur_element_count_, false);
+        state->visited_[currObj] = true;
+        state->candidates_.emplace(-curdist, currObj);
+        state->pending_.emplace(-curdist, currObj);
+    }
+
+    // visits the level 0 neighbors of the element not visited yet, they become candidates and
+    // pending, and are offered to top_candidates when it is given
+    void
+    expandKnnIterator(IteratorState* state,
+                      tableint current_id,
+                      std::priority_queue<std::pair<float, tableint>>* top_candidates = nullptr,
+                      size_t ef = 0,
+                      BaseFilterFunctor* isIdAllowed = nullptr) const {
+        const void* query = state->query_.data();
+        int* data = (int*)get_linklist0(current_id);
+        size_t size = getListCount((linklistsizeint*)data);
+        for (size_t j = 1; j <= size; j++) {
+            tableint candidate_id = *(data + j);
+            if (candidate_id >= state->visited_.size()) {
+                // inserted after the iterator was created
+                state->visited_.resize(candidate_id + 1, false);
+            }
+            if (!state->visited_[candidate_id]) {
+                state->visited_[candidate_id] = true;
+                float dist =
+                    fstdistfunc_(query, getDataByInternalId(candidate_id), dist_func_param_);
+                state->candidates_.emplace(-dist, candidate_id);
+                state->pending_.emplace(-dist, candidate_id);
+                if (top_candidates != nullptr) {
+                    offerKnnIterator(
+                        state, *top_candidates, ef, dist, candidate_id, isIdAllowed);
+                }
+            }
+        }
+    }
+
+    // keeps the ef nearest elements which can be yielded in top_candidates
+    void
+    offerKnnIterator(const IteratorState* state,
+                     std::priority_queue<std::pair<float, tableint>>& top_candidates,
+                     size_t ef,
+                     float dist,
+                     tableint internal_id,
+                     BaseFilterFunctor* isIdAllowed) const {
+        labeltype label = getExternalLabel(internal_id);
+        if (!isMarkedDeleted(internal_id) && (!isIdAllowed || (*isIdAllowed)(label)) &&
+            state->yielded_.count(label) == 0) {
+            top_candidates.emplace(dist, internal_id);
+            if (top_candidates.size() > ef) {
+                top_candidates.pop();
+            }
+        }
+    }
+
+    // expands the candidates like searchKnn, until the nearest one is farther than the ef-th
+    // nearest element which can be yielded, the candidates farther than it are kept for the
+    // later batches
+    void
+    convergeKnnIterator(IteratorState* state, size_t ef, BaseFilterFunctor* isIdAllowed) const {
+        std::priority_queue<std::pair<float, tableint>> top_candidates;
+        if (!state->candidates_.empty()) {
+            offerKnnIterator(state,
+                             top_candidates,
+                             ef,
+                             -state->candidates_.top().first,
+                             state->candidates_.top().second,
+                             isIdAllowed);
+        }
+        while (!state->candidates_.empty()) {
+            float dist = -state->candidates_.top().first;
+            if (top_candidates.size() >= ef && dist > top_candidates.top().first) {
+                break;
+            }
+            tableint current_id = state->candidates_.top().second;
+            state->candidates_.pop();
+            expandKnnIterator(state, current_id, &top_candidates, ef, isIdAllowed);
+        }
+    }
+
+    // appends the links of the element at the level to repaired, with the deleted elements
+    // replaced by their own neighbors which are not deleted, returns false when no link is deleted
+    bool
+    getRepairedLinks(tableint internal_id, int level, vsag::Vector<tableint>& repaired) {
+        linklistsizeint* data = get_linklist_at_level(internal_id, level);
+        size_t size = getListCount(data);
+        tableint* links = (tableint*)(data + 1);
+        bool has_deleted = false;
+        for (size_t j = 0; j < size && !has_deleted; ++j) {
+            has_deleted = isMarkedDeleted(links[j]);
+        }
+        if (!has_deleted) {
+            return false;
+        }
+        std::priority_queue<std::pair<float, tableint>,
+                            vsag::Vector<std::pair<float, tableint>>,
+                            CompareByFirst>
+            candidates(allocator_);
+        vsag::UnorderedSet<tableint> unique_ids(allocator_);
+        unique_ids.insert(internal_id);
+        auto add_candidate = [&](tableint id) {
+            if (!isMarkedDeleted(id) && unique_ids.insert(id).second) {
+                candidates.emplace(fstdistfunc_(getDataByInternalId(id),
+                                                getDataByInternalId(internal_id),
+                                                dist_func_param_),
+                                   id);
+            }
+        };
+        for (size_t j = 0; j < size; ++j) {
+            if (!isMarkedDeleted(links[j])) {
+                add_candidate(links[j]);
+            } else {
+                linklistsizeint* deleted_data = get_linklist_at_level(links[j], level);
+                size_t deleted_size = getListCount(deleted_data);
+                tableint* deleted_links = (tableint*)(deleted_data + 1);
+                for (size_t k = 0; k < deleted_size; ++k) {
+                    add_candidate(deleted_links[k]);
+                }
+            }
+        }
+        getNeighborsByHeuristic2(candidates, level ? maxM_ : maxM0_);
+        while (!candidates.empty()) {
+            repaired.push_back(candidates.top().second);
+            candidates.pop();
+        }
+        return true;
+    }
+
+    // drops the labels, the upper links and the delete marks of the elements in [begin, end)
+    void
+    clearElements(size_t begin, size_t end) {
+        for (tableint id = begin; id < end; ++id) {
+            auto search = label_lookup_.find(getExternalLabel(id));
+            if (search != label_lookup_.end() && search->second == id) {
+                label_lookup_.erase(search);
+            }
+            if (link_lists_[id] != nullptr) {
+                allocator_->Deallocate(link_lists_[id]);
+                link_lists_[id] = nullptr;
+            }
+            element_levels_[id] = 0;
+            // clears the link count and the delete mark
+            *get_linklist0(id) = 0;
+        }
+    }
+
+    // relabels the elements in the bfs order of the level 0 graph from the entry point, the
+    // deleted elements get the largest ids when deleted_last is set
+    void
+    relabel(bool deleted_last) {
+        layout_version_++;
+        size_t count = cur_element_count_;
+        const tableint invalid_id = (tableint)-1;
+        vsag::Vector<tableint> new_ids(count, invalid_id, allocator_);
+        vsag::Vector<tableint> bfs_queue(count, invalid_id, allocator_);
+        size_t next_id = 0;
+        size_t head = 0;
+        for (size_t i = 0; i <= count; ++i) {
+            // start from the entry point, then from the elements not reachable from it
+            tableint start = i == 0 ? enterpoint_node_ : (tableint)(i - 1);
+            if (new_ids[start] != invalid_id || (deleted_last && isMarkedDeleted(start))) {
+                continue;
+            }
+            new_ids[start] = next_id;
+            bfs_queue[next_id++] = start;
+            while (head < next_id) {
+                tableint cur = bfs_queue[head++];
+                linklistsizeint* data = get_linklist0(cur);
+                size_t size = getListCount(data);
+                tableint* links = (tableint*)(data + 1);
+                for (size_t j = 0; j < size; ++j) {
+                    if (new_ids[links[j]] == invalid_id &&
+                        !(deleted_last && isMarkedDeleted(links[j]))) {
+                        new_ids[links[j]] = next_id;
+                        bfs_queue[next_id++] = links[j];
+                    }
+                }
+            }
+        }
+        for (tableint id = 0; deleted_last && id < count; ++id) {
+            if (new_ids[id] == invalid_id) {
+                new_ids[id] = next_id++;
+            }
+        }
+
+        // rewrite the ids stored in the graph and the lookups before moving the elements
+        for (size_t id = 0; id < count; ++id) {
+            for (int level = 0; level <= element_levels_[id]; ++level) {
+                linklistsizeint* data = get_linklist_at_level(id, level);
+                size_t size = getListCount(data);
+                tableint* links = (tableint*)(data + 1);
+                for (size_t j = 0; j < size; ++j) {
+                    links[j] = new_ids[links[j]];
+                }
+            }
+        }
+        for (auto& label_id : label_lookup_) {
+            label_id.second = new_ids[label_id.second];
+        }
+        if (!deleted_elements_.empty()) {
+            vsag::UnorderedSet<tableint> deleted_elements(allocator_);
+            for (auto id : deleted_elements_) {
+                deleted_elements.insert(new_ids[id]);
+            }
+            deleted_elements_.swap(deleted_elements);
+        }
+        enterpoint_node_ = new_ids[enterpoint_node_];
+
+        // move every element to its new id, each swap puts one element at its final place
+        auto tmp_data_element = std::shared_ptr<char[]>(new char[size_data_per_element_]);
+        for (size_t id = 0; id < count; ++id) {
+            while (new_ids[id] != id) {
+                tableint target = new_ids[id];
+                memcpy(tmp_data_element.get(), get_linklist0(id), size_data_per_element_);
+                memcpy(get_linklist0(id), get_linklist0(target), size_data_per_element_);
+                memcpy(get_linklist0(target), tmp_data_element.get(), size_data_per_element_);
+                if (normalize_) {
+                    std::swap(molds_[id], molds_[target]);
+                }
+                std::swap(link_lists_[id], link_lists_[target]);
+                std::swap(element_levels_[id], element_levels_[target]);
+                std::swap(new_ids[id], new_ids[target]);
+            }
+        }
+    }
+
+public:
     void
     dealNoInEdge(tableint id, int level, int m_curmax, int skip_c) {
         // Establish edges from the neighbors of the id pointing to the id.
@@ -1651,7 +2229,8 @@ public:
     searchKnn(const void* query_data,
               size_t k,
               uint64_t ef,
-              BaseFilterFunctor* isIdAllowed = nullptr) const override {
+              BaseFilterFunctor* isIdAllowed = nullptr,
+              const std::atomic<float>* distance_bound = nullptr) const override {
         std::priority_queue<std::pair<float, labeltype>> result;
         if (cur_element_count_ == 0)
             return result;
@@ -1693,11 +2272,11 @@ public:
                             CompareByFirst>
             top_candidates(allocator_);
         if (num_deleted_) {
-            top_candidates =
-                searchBaseLayerST<true, true>(currObj, query_data, std::max(ef, k), isIdAllowed);
+            top_candidates = searchBaseLayerST<true, true>(
+                currObj, query_data, std::max(ef, k), isIdAllowed, distance_bound);
         } else {
-            top_candidates =
-                searchBaseLayerST<false, true>(currObj, query_data, std::max(ef, k), isIdAllowed);
+            top_candidates = searchBaseLayerST<false, true>(
+                currObj, query_data, std::max(ef, k), isIdAllowed, distance_bound);
         }
 
         while (top_candidates.size() > k) {
@@ -1715,7 +2294,8 @@ public:
     searchRange(const void* query_data,
                 float radius,
                 uint64_t ef,
-                BaseFilterFunctor* isIdAllowed = nullptr) const override {
+                BaseFilterFunctor* isIdAllowed = nullptr,
+                size_t limited_size = 0) const override {
         std::priority_queue<std::pair<float, labeltype>> result;
         if (cur_element_count_ == 0)
             return result;
@@ -1758,11 +2338,17 @@ public:
                             CompareByFirst>
             top_candidates(allocator_);
         if (num_deleted_) {
-            throw std::runtime_error(
-                "not support perform range search on a index that deleted some vectors");
+            // searches the nearest elements which are not deleted, and keeps the ones within
+            // the radius
+            size_t k = std::max((size_t)ef, limited_size);
+            top_candidates = searchBaseLayerST<true, true>(currObj, query_data, k, isIdAllowed);
+            while (not top_candidates.empty() &&
+                   top_candidates.top().first > radius + THRESHOLD_ERROR) {
+                top_candidates.pop();
+            }
         } else {
-            top_candidates =
-                searchBaseLayerST<false, true>(currObj, query_data, radius, ef, isIdAllowed);
+            top_candidates = searchBaseLayerST<false, true>(
+                currObj, query_data, radius, ef, isIdAllowed, limited_size);
             // std::cout << "top_candidates.size(): " << top_candidates.size() << std::endl;
         }
 
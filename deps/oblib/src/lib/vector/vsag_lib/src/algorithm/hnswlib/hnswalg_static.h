@@ -1710,11 +1710,13 @@ public:
         return cur_c;
     }
 
+    // the static index searches on pq codes, distance_bound is ignored
     std::priority_queue<std::pair<float, labeltype>>
     searchKnn(const void* query_data,
               size_t k,
               uint64_t ef,
-              BaseFilterFunctor* isIdAllowed = nullptr) const override {
+              BaseFilterFunctor* isIdAllowed = nullptr,
+              const std::atomic<float>* distance_bound = nullptr) const override {
         std::priority_queue<std::pair<float, labeltype>> result;
         if (cur_element_count_ == 0)
             return result;
@@ -1790,7 +1792,8 @@ public:
     searchRange(const void* query_data,
                 float radius,
                 uint64_t ef,
-                BaseFilterFunctor* isIdAllowed = nullptr) const override {
+                BaseFilterFunctor* isIdAllowed = nullptr,
+                size_t limited_size = 0) const override {
         std::runtime_error("static hnsw does not support range search");
         //        std::priority_queue<std::pair<float, labeltype>> result;
         //        if (cur_element_count_ == 0)
@@ -134,8 +134,10 @@ AVX512Capable() {
 
 #include <string.h>
 
+#include <atomic>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <vector>
 
@@ -151,6 +153,13 @@ public:
     }
 };
 
+// keeps the state of a knn search between the batches of searchKnnNext
+class KnnIteratorState {
+public:
+    virtual ~KnnIteratorState() {
+    }
+};
+
 template <typename T>
 class pairGreater {
 public:
@@ -194,17 +203,40 @@ public:
     }
 };
 
+// a space whose stored points are codes of the float vectors rather than the vectors themselves.
+// the graph is built and searched on the codes, and the candidates are reranked by the distance
+// between the float query and the codes.
+class EncodedSpace : public SpaceInterface {
+public:
+    virtual void
+    encode(const float* vector, void* code) const = 0;
+
+    virtual float
+    asymmetric_distance(const float* query, const void* code) const = 0;
+};
+
 template <typename dist_t>
 class AlgorithmInterface {
 public:
     virtual bool
     addPoint(const void* datapoint, labeltype label) = 0;
 
+    // distance_bound: stop once the nearest unvisited candidate is farther than the bound
     virtual std::priority_queue<std::pair<dist_t, labeltype>>
-    searchKnn(const void*, size_t, size_t, BaseFilterFunctor* isIdAllowed = nullptr) const = 0;
-
+    searchKnn(const void*,
+              size_t,
+              size_t,
+              BaseFilterFunctor* isIdAllowed = nullptr,
+              const std::atomic<float>* distance_bound = nullptr) const = 0;
+
+    // the elements within the radius, only the nearest limited_size ones are searched for when it
+    // is not 0
     virtual std::priority_queue<std::pair<dist_t, labeltype>>
-    searchRange(const void*, float, size_t, BaseFilterFunctor* isIdAllowed = nullptr) const = 0;
+    searchRange(const void*,
+                float,
+                size_t,
+                BaseFilterFunctor* isIdAllowed = nullptr,
+                size_t limited_size = 0) const = 0;
 
     // Return k nearest neighbor in the order of closer fist
     virtual std::vector<std::pair<dist_t, labeltype>>
@@ -260,6 +292,50 @@ public:
     virtual bool
     init_memory_space() = 0;
 
+    // relabel the elements to improve the memory locality of searches, return false when the
+    // index is not changed
+    virtual bool
+    reorder() {
+        return false;
+    }
+
+    // prepare the graph repair of the next compactDeleted along with searches, return the
+    // number of repaired links
+    virtual size_t
+    prepareCompaction() {
+        return 0;
+    }
+
+    // physically remove the elements marked deleted, return the number of removed elements
+    virtual size_t
+    compactDeleted() {
+        return 0;
+    }
+
+    // measure the recall of knn searches with each ef against an exact scan, return an empty
+    // vector when it is not supported
+    virtual std::vector<float>
+    calibrateRecall(size_t k, const std::vector<size_t>& efs, size_t sample_count) {
+        return {};
+    }
+
+    // start a knn search whose neighbors are yielded in batches by searchKnnNext, return nullptr
+    // when it is not supported
+    virtual std::unique_ptr<KnnIteratorState>
+    searchKnnIterator(const void* query_data) const {
+        return nullptr;
+    }
+
+    // the next k nearest neighbors of the search, nearest first, the neighbors yielded before are
+    // skipped. return less than k neighbors when the search is exhausted
+    virtual std::vector<std::pair<float, labeltype>>
+    searchKnnNext(KnnIteratorState* state,
+                  size_t k,
+                  uint64_t ef,
+                  BaseFilterFunctor* isIdAllowed = nullptr) const {
+        return {};
+    }
+
     virtual ~AlgorithmInterface() {
     }
 };
@@ -292,3 +368,6 @@ AlgorithmInterface<dist_t>::searchKnnCloserFirst(const void* query_data,
 #include "hnswalg_static.h"
 #include "space_ip.h"
 #include "space_l2.h"
+#include "space_fp16.h"
+#include "space_int8.h"
+#include "space_sq8.h"
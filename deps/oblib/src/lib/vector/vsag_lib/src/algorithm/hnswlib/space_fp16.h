@@ -0,0 +1,203 @@
+// Copyright 2024-present the vsag project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "hnswlib.h"
+
+namespace vsag {
+
+extern hnswlib::DISTFUNC
+GetFP16L2DistanceFunc();
+extern hnswlib::DISTFUNC
+GetFP16InnerProductDistanceFunc();
+extern hnswlib::DISTFUNC
+GetBF16L2DistanceFunc();
+extern hnswlib::DISTFUNC
+GetBF16InnerProductDistanceFunc();
+
+}  // namespace vsag
+
+namespace hnswlib {
+
+// IEEE half precision: 1 sign bit, 5 exponent bits, 10 mantissa bits
+struct FP16Codec {
+    static uint16_t
+    encode(float value) {
+#if defined(__F16C__)
+        return _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+        uint32_t x;
+        memcpy(&x, &value, sizeof(x));
+        uint16_t sign = (x >> 16) & 0x8000;
+        uint32_t abs = x & 0x7fffffff;
+        if (abs >= 0x7f800000) {
+            // inf stays inf, nan stays a quiet nan
+            return sign | (abs > 0x7f800000 ? 0x7e00 : 0x7c00);
+        }
+        if (abs >= 0x477ff000) {
+            // rounds beyond 65504
+            return sign | 0x7c00;
+        }
+        if (abs < 0x38800000) {
+            // subnormal in half precision, counted in units of 2^-24
+            float magnitude;
+            memcpy(&magnitude, &abs, sizeof(magnitude));
+            return sign | (uint16_t)std::nearbyint(magnitude * 16777216.0f);
+        }
+        // rebias the exponent from 127 to 15 and round the mantissa to nearest even
+        abs += 0xc8000fff + ((abs >> 13) & 1);
+        return sign | (uint16_t)(abs >> 13);
+#endif
+    }
+
+    static float
+    decode(uint16_t code) {
+#if defined(__F16C__)
+        return _cvtsh_ss(code);
+#else
+        uint32_t sign = (uint32_t)(code & 0x8000) << 16;
+        uint32_t exp = (code >> 10) & 0x1f;
+        uint32_t mant = code & 0x3ff;
+        uint32_t x;
+        if (exp == 0) {
+            float value = std::ldexp((float)mant, -24);
+            memcpy(&x, &value, sizeof(x));
+            x |= sign;
+        } else if (exp == 0x1f) {
+            x = sign | 0x7f800000 | (mant << 13);
+        } else {
+            x = sign | ((exp + 112) << 23) | (mant << 13);
+        }
+        float value;
+        memcpy(&value, &x, sizeof(value));
+        return value;
+#endif
+    }
+
+    static DISTFUNC
+    l2_distance_func() {
+        return vsag::GetFP16L2DistanceFunc();
+    }
+
+    static DISTFUNC
+    ip_distance_func() {
+        return vsag::GetFP16InnerProductDistanceFunc();
+    }
+};
+
+// bfloat16: the upper half of a float, keeps the float range with 8 mantissa bits
+struct BF16Codec {
+    static uint16_t
+    encode(float value) {
+        uint32_t x;
+        memcpy(&x, &value, sizeof(x));
+        if ((x & 0x7fffffff) > 0x7f800000) {
+            return (x >> 16) | 0x0040;
+        }
+        // round to nearest even
+        x += 0x7fff + ((x >> 16) & 1);
+        return x >> 16;
+    }
+
+    static float
+    decode(uint16_t code) {
+        uint32_t x = (uint32_t)code << 16;
+        float value;
+        memcpy(&value, &x, sizeof(value));
+        return value;
+    }
+
+    static DISTFUNC
+    l2_distance_func() {
+        return vsag::GetBF16L2DistanceFunc();
+    }
+
+    static DISTFUNC
+    ip_distance_func() {
+        return vsag::GetBF16InnerProductDistanceFunc();
+    }
+};
+
+// Stores every dimension as a 16 bits float. The distances are computed on the codes directly by
+// the simd kernels of the cpu, only widening each lane to float, so no decoded copy of the
+// vectors is kept.
+//
+// code layout: | uint16_t code[dim] |
+template <typename Codec>
+class HalfFloatSpace : public EncodedSpace {
+    DISTFUNC fstdistfunc_;
+    size_t data_size_;
+    size_t dim_;
+    bool use_ip_;
+
+public:
+    HalfFloatSpace(size_t dim, bool use_ip) {
+        fstdistfunc_ = use_ip ? Codec::ip_distance_func() : Codec::l2_distance_func();
+        dim_ = dim;
+        use_ip_ = use_ip;
+        data_size_ = dim * sizeof(uint16_t);
+    }
+
+    size_t
+    get_data_size() override {
+        return data_size_;
+    }
+
+    DISTFUNC
+    get_dist_func() override {
+        return fstdistfunc_;
+    }
+
+    void*
+    get_dist_func_param() override {
+        return &dim_;
+    }
+
+    void
+    encode(const float* vector, void* code) const override {
+        auto* codes = (uint16_t*)code;
+        for (size_t i = 0; i < dim_; ++i) {
+            codes[i] = Codec::encode(vector[i]);
+        }
+    }
+
+    float
+    asymmetric_distance(const float* query, const void* code) const override {
+        const auto* codes = (const uint16_t*)code;
+        float res = 0;
+        if (use_ip_) {
+            for (size_t i = 0; i < dim_; ++i) {
+                res += query[i] * Codec::decode(codes[i]);
+            }
+            return 1.0f - res;
+        }
+        for (size_t i = 0; i < dim_; ++i) {
+            float t = query[i] - Codec::decode(codes[i]);
+            res += t * t;
+        }
+        return res;
+    }
+
+    ~HalfFloatSpace() {
+    }
+};
+
+using FP16Space = HalfFloatSpace<FP16Codec>;
+using BF16Space = HalfFloatSpace<BF16Codec>;
+
+}  // namespace hnswlib
@@ -0,0 +1,140 @@
+// Copyright 2024-present the vsag project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "hnswlib.h"
+
+namespace vsag {
+
+extern void
+INT8ComputeL2Sums(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums);
+extern int32_t
+INT8ComputeInnerProduct(const int8_t* codes1, const int8_t* codes2, size_t qty);
+
+}  // namespace vsag
+
+namespace hnswlib {
+
+// Stores every dimension as a signed 8 bits integer, scaled by the largest magnitude of the
+// vector so that the values keep their sign and zero stays exact. The distances between two
+// codes are accumulated in int32 by the simd kernels of the cpu and scaled once at the end.
+//
+// code layout: | float scale | int8_t code[dim] |
+// the decoded value of dimension i is code[i] * scale
+class INT8Space : public EncodedSpace {
+    DISTFUNC fstdistfunc_;
+    size_t data_size_;
+    size_t dim_;
+    bool use_ip_;
+
+public:
+    static constexpr size_t CODE_HEADER_SIZE = sizeof(float);
+
+    INT8Space(size_t dim, bool use_ip) {
+        fstdistfunc_ = use_ip ? INT8InnerProductDistance : INT8L2Sqr;
+        dim_ = dim;
+        use_ip_ = use_ip;
+        data_size_ = CODE_HEADER_SIZE + dim * sizeof(int8_t);
+    }
+
+    size_t
+    get_data_size() override {
+        return data_size_;
+    }
+
+    DISTFUNC
+    get_dist_func() override {
+        return fstdistfunc_;
+    }
+
+    void*
+    get_dist_func_param() override {
+        return &dim_;
+    }
+
+    void
+    encode(const float* vector, void* code) const override {
+        float max_abs = 0;
+        for (size_t i = 0; i < dim_; ++i) {
+            max_abs = std::max(max_abs, std::abs(vector[i]));
+        }
+        float scale = max_abs / 127.0f;
+        *(float*)code = scale;
+        auto* codes = (int8_t*)code + CODE_HEADER_SIZE;
+        if (scale <= 0) {
+            memset(codes, 0, dim_);
+            return;
+        }
+        for (size_t i = 0; i < dim_; ++i) {
+            float value = std::round(vector[i] / scale);
+            codes[i] = (int8_t)std::min(std::max(value, -127.0f), 127.0f);
+        }
+    }
+
+    float
+    asymmetric_distance(const float* query, const void* code) const override {
+        float scale = *(const float*)code;
+        const auto* codes = (const int8_t*)code + CODE_HEADER_SIZE;
+        float res = 0;
+        if (use_ip_) {
+            for (size_t i = 0; i < dim_; ++i) {
+                res += query[i] * codes[i];
+            }
+            return 1.0f - res * scale;
+        }
+        for (size_t i = 0; i < dim_; ++i) {
+            float t = query[i] - codes[i] * scale;
+            res += t * t;
+        }
+        return res;
+    }
+
+    ~INT8Space() {
+    }
+
+private:
+    // |a - b|^2 = sa^2 * |ca|^2 + sb^2 * |cb|^2 - 2 * sa * sb * <ca, cb>, the three integer sums
+    // fit in int32 for any dim below 133143
+    static float
+    INT8L2Sqr(const void* pCode1, const void* pCode2, const void* qty_ptr) {
+        size_t qty = *((size_t*)qty_ptr);
+        float scale1 = *(const float*)pCode1;
+        float scale2 = *(const float*)pCode2;
+        const auto* codes1 = (const int8_t*)pCode1 + CODE_HEADER_SIZE;
+        const auto* codes2 = (const int8_t*)pCode2 + CODE_HEADER_SIZE;
+        int32_t sums[3];
+        vsag::INT8ComputeL2Sums(codes1, codes2, qty, sums);
+        float res = scale1 * scale1 * sums[0] + scale2 * scale2 * sums[1] -
+                    2.0f * scale1 * scale2 * sums[2];
+        return std::max(res, 0.0f);
+    }
+
+    static float
+    INT8InnerProductDistance(const void* pCode1, const void* pCode2, const void* qty_ptr) {
+        size_t qty = *((size_t*)qty_ptr);
+        float scale1 = *(const float*)pCode1;
+        float scale2 = *(const float*)pCode2;
+        const auto* codes1 = (const int8_t*)pCode1 + CODE_HEADER_SIZE;
+        const auto* codes2 = (const int8_t*)pCode2 + CODE_HEADER_SIZE;
+        int32_t dot = vsag::INT8ComputeInnerProduct(codes1, codes2, qty);
+        return 1.0f - scale1 * scale2 * dot;
+    }
+};
+
+}  // namespace hnswlib
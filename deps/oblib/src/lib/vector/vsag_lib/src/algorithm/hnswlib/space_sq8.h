@@ -0,0 +1,140 @@
+// Copyright 2024-present the vsag project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "hnswlib.h"
+
+namespace hnswlib {
+
+// Scalar quantization with 8 bits per dimension. Every vector is quantized with its own
+// range, so the codes need no training and the index stays fully dynamic.
+//
+// code layout: | float lower | float step | uint8_t code[dim] |
+// the decoded value of dimension i is lower + code[i] * step
+class SQ8Space : public EncodedSpace {
+    DISTFUNC fstdistfunc_;
+    size_t data_size_;
+    size_t dim_;
+    bool use_ip_;
+
+public:
+    static constexpr size_t CODE_HEADER_SIZE = 2 * sizeof(float);
+
+    SQ8Space(size_t dim, bool use_ip) {
+        fstdistfunc_ = use_ip ? SQ8InnerProductDistance : SQ8L2Sqr;
+        dim_ = dim;
+        use_ip_ = use_ip;
+        data_size_ = CODE_HEADER_SIZE + dim * sizeof(uint8_t);
+    }
+
+    size_t
+    get_data_size() override {
+        return data_size_;
+    }
+
+    DISTFUNC
+    get_dist_func() override {
+        return fstdistfunc_;
+    }
+
+    void*
+    get_dist_func_param() override {
+        return &dim_;
+    }
+
+    void
+    encode(const float* vector, void* code) const override {
+        float lower = vector[0];
+        float upper = vector[0];
+        for (size_t i = 1; i < dim_; ++i) {
+            lower = std::min(lower, vector[i]);
+            upper = std::max(upper, vector[i]);
+        }
+        float step = (upper - lower) / 255.0f;
+        auto* header = (float*)code;
+        header[0] = lower;
+        header[1] = step;
+        auto* codes = (uint8_t*)code + CODE_HEADER_SIZE;
+        if (step <= 0) {
+            memset(codes, 0, dim_);
+            return;
+        }
+        for (size_t i = 0; i < dim_; ++i) {
+            float value = std::round((vector[i] - lower) / step);
+            codes[i] = (uint8_t)std::min(std::max(value, 0.0f), 255.0f);
+        }
+    }
+
+    // distance between an unquantized query and a stored code, used to rerank the candidates
+    // found on the quantized graph
+    float
+    asymmetric_distance(const float* query, const void* code) const override {
+        const auto* header = (const float*)code;
+        const auto* codes = (const uint8_t*)code + CODE_HEADER_SIZE;
+        float lower = header[0];
+        float step = header[1];
+        float res = 0;
+        if (use_ip_) {
+            for (size_t i = 0; i < dim_; ++i) {
+                res += query[i] * (lower + codes[i] * step);
+            }
+            return 1.0f - res;
+        }
+        for (size_t i = 0; i < dim_; ++i) {
+            float t = query[i] - (lower + codes[i] * step);
+            res += t * t;
+        }
+        return res;
+    }
+
+    ~SQ8Space() {
+    }
+
+private:
+    static float
+    SQ8L2Sqr(const void* pCode1, const void* pCode2, const void* qty_ptr) {
+        size_t qty = *((size_t*)qty_ptr);
+        const auto* header1 = (const float*)pCode1;
+        const auto* header2 = (const float*)pCode2;
+        const auto* codes1 = (const uint8_t*)pCode1 + CODE_HEADER_SIZE;
+        const auto* codes2 = (const uint8_t*)pCode2 + CODE_HEADER_SIZE;
+        float res = 0;
+        for (size_t i = 0; i < qty; ++i) {
+            float t = (header1[0] + codes1[i] * header1[1]) - (header2[0] + codes2[i] * header2[1]);
+            res += t * t;
+        }
+        return res;
+    }
+
+    static float
+    SQ8InnerProductDistance(const void* pCode1, const void* pCode2, const void* qty_ptr) {
+        size_t qty = *((size_t*)qty_ptr);
+        const auto* header1 = (const float*)pCode1;
+        const auto* header2 = (const float*)pCode2;
+        const auto* codes1 = (const uint8_t*)pCode1 + CODE_HEADER_SIZE;
+        const auto* codes2 = (const uint8_t*)pCode2 + CODE_HEADER_SIZE;
+        float res = 0;
+        for (size_t i = 0; i < qty; ++i) {
+            res += (header1[0] + codes1[i] * header1[1]) * (header2[0] + codes2[i] * header2[1]);
+        }
+        return 1.0f - res;
+    }
+};
+
+}  // namespace hnswlib
@@ -40,6 +40,9 @@ const char* const METRIC_L2 = "l2";
 const char* const METRIC_COSINE = "cosine";
 const char* const METRIC_IP = "ip";
 const char* const DATATYPE_FLOAT32 = "float32";
+const char* const DATATYPE_FLOAT16 = "float16";
+const char* const DATATYPE_BFLOAT16 = "bfloat16";
+const char* const DATATYPE_INT8 = "int8";
 const char* const BLANK_INDEX = "blank_index";
 
 // parameters
@@ -69,6 +72,9 @@ const char* const HNSW_PARAMETER_M = "max_degree";
 const char* const HNSW_PARAMETER_CONSTRUCTION = "ef_construction";
 const char* const HNSW_PARAMETER_USE_STATIC = "use_static";
 const char* const HNSW_PARAMETER_REVERSED_EDGES = "use_reversed_edges";
+const char* const HNSW_PARAMETER_BUILD_THREAD_NUM = "build_thread_num";
+const char* const HNSW_PARAMETER_USE_SQ8 = "use_sq8";
+const char* const HNSW_PARAMETER_ELEMENT_TYPE = "element_type";
 
 // statstic key
 const char* const STATSTIC_MEMORY = "memory";
@@ -56,7 +56,9 @@ Factory::CreateIndex(const std::string& origin_name,
                                           false,
                                           params.use_conjugate_graph,
                                           params.normalize,
-                                          allocator);
+                                          allocator,
+                                          params.build_thread_num,
+                                          params.encode_vectors);
         } else if (name == INDEX_FRESH_HNSW) {
             // read parameters from json, throw exception if not exists
             auto params = CreateFreshHnswParameters::FromJson(parameters);
@@ -68,7 +70,9 @@ Factory::CreateIndex(const std::string& origin_name,
                                           true,
                                           false,
                                           params.normalize,
-                                          allocator);
+                                          allocator,
+                                          1,
+                                          params.encode_vectors);
         } else if (name == INDEX_DISKANN) {
             // read parameters from json, throw exception if not exists
             auto params = CreateDiskannParameters::FromJson(parameters);
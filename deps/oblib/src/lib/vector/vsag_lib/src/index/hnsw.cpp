@@ -18,11 +18,14 @@
 
 #include <fmt/format-inl.h>
 
+#include <atomic>
+#include <cmath>
 #include <cstdint>
 #include <exception>
 #include <new>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
+#include <thread>
 
 #include "../algorithm/hnswlib/hnswlib.h"
 #include "../common.h"
@@ -44,6 +47,8 @@ const static int MAXIMAL_M = 64;
 const static uint32_t GENERATE_SEARCH_K = 50;
 const static uint32_t GENERATE_SEARCH_L = 400;
 const static float GENERATE_OMEGA = 0.51;
+const static int64_t MIN_ELEMENTS_PER_BUILD_THREAD = 1024;
+const static int64_t BUILD_BATCH_SIZE = 64;
 
 HNSW::HNSW(std::shared_ptr<hnswlib::SpaceInterface> space_interface,
            int M,
@@ -52,13 +57,28 @@ HNSW::HNSW(std::shared_ptr<hnswlib::SpaceInterface> space_interface,
            bool use_reversed_edges,
            bool use_conjugate_graph,
            bool normalize,
-           Allocator* allocator)
+           Allocator* allocator,
+           int64_t build_thread_num,
+           bool encode_vectors)
     : space(std::move(space_interface)),
       use_static_(use_static),
       use_conjugate_graph_(use_conjugate_graph),
-      use_reversed_edges_(use_reversed_edges) {
+      use_reversed_edges_(use_reversed_edges),
+      build_thread_num_(std::max(build_thread_num, (int64_t)1)),
+      encode_vectors_(encode_vectors),
+      normalize_(normalize) {
     dim_ = *((size_t*)space->get_dist_func_param());
 
+    if (encode_vectors_) {
+        encoded_space_ = std::dynamic_pointer_cast<hnswlib::EncodedSpace>(space);
+        if (not encoded_space_ or use_static_ or use_conjugate_graph) {
+            throw std::runtime_error(MESSAGE_PARAMETER);
+        }
+        // the codes cannot be normalized in place, so the vectors are normalized before
+        // they are encoded
+        normalize = false;
+    }
+
     M = std::min(std::max(M, MINIMAL_M), MAXIMAL_M);
 
     if (ef_construction <= 0) {
@@ -128,13 +148,7 @@ HNSW::build(const DatasetPtr& base) {
         std::vector<int64_t> failed_ids;
         {
             SlowTaskTimer t("hnsw graph");
-            for (int64_t i = 0; i < num_elements; ++i) {
-                // noexcept runtime
-                if (!alg_hnsw->addPoint((const void*)(vectors + i * dim_), ids[i])) {
-                    logger::debug("duplicate point: {}", ids[i]);
-                    failed_ids.emplace_back(ids[i]);
-                }
-            }
+            failed_ids = add_points(vectors, ids, num_elements);
         }
 
         if (use_static_) {
@@ -172,13 +186,7 @@ HNSW::add(const DatasetPtr& base) {
         if (auto result = init_memory_space(); not result.has_value()) {
             return tl::unexpected(result.error());
         }
-        for (int64_t i = 0; i < num_elements; ++i) {
-            // noexcept runtime
-            if (!alg_hnsw->addPoint((const void*)(vectors + i * dim_), ids[i])) {
-                logger::debug("duplicate point: {}", i);
-                failed_ids.push_back(ids[i]);
-            }
-        }
+        failed_ids = add_points(vectors, ids, num_elements);
 
         return failed_ids;
     } catch (const std::invalid_argument& e) {
@@ -187,11 +195,11 @@ HNSW::add(const DatasetPtr& base) {
     }
 }
 
-template <typename FilterType>
+template <typename ParamType, typename FilterType>
 tl::expected<DatasetPtr, Error>
 HNSW::knn_search_internal(const DatasetPtr& query,
                           int64_t k,
-                          const std::string& parameters,
+                          const ParamType& parameters,
                           const FilterType& filter_obj) const {
     if (filter_obj) {
         BitsetOrCallbackFilter filter(filter_obj);
@@ -206,6 +214,38 @@ HNSW::knn_search(const DatasetPtr& query,
                  int64_t k,
                  const std::string& parameters,
                  hnswlib::BaseFilterFunctor* filter_ptr) const {
+    try {
+        // check search parameters
+        auto params = HnswSearchParameters::FromJson(parameters);
+        return this->knn_search(query, k, params, filter_ptr);
+    } catch (const std::invalid_argument& e) {
+        LOG_ERROR_AND_RETURNS(ErrorType::INVALID_ARGUMENT,
+                              "failed to perform knn_search(invalid argument): ",
+                              e.what());
+    }
+}
+
+tl::expected<DatasetPtr, Error>
+HNSW::knn_search(const DatasetPtr& query,
+                 int64_t k,
+                 const SearchParam& param,
+                 hnswlib::BaseFilterFunctor* filter_ptr) const {
+    try {
+        // check search parameters
+        auto params = HnswSearchParameters::FromParam(param);
+        return this->knn_search(query, k, params, filter_ptr);
+    } catch (const std::invalid_argument& e) {
+        LOG_ERROR_AND_RETURNS(ErrorType::INVALID_ARGUMENT,
+                              "failed to perform knn_search(invalid argument): ",
+                              e.what());
+    }
+}
+
+tl::expected<DatasetPtr, Error>
+HNSW::knn_search(const DatasetPtr& query,
+                 int64_t k,
+                 const HnswSearchParameters& params,
+                 hnswlib::BaseFilterFunctor* filter_ptr) const {
     SlowTaskTimer t("hnsw knnsearch", 20);
 
     try {
@@ -230,16 +270,27 @@ HNSW::knn_search(const DatasetPtr& query,
 
         // std::shared_lock lock(rw_mutex_);
 
-        // check search parameters
-        auto params = HnswSearchParameters::FromJson(parameters);
-
         // perform search
         std::priority_queue<std::pair<float, size_t>> results;
         double time_cost;
         try {
             Timer t(time_cost);
-            results = alg_hnsw->searchKnn(
-                (const void*)(vector), k, std::max(params.ef_search, k), filter_ptr);
+            if (encode_vectors_) {
+                // search the encoded graph for all the ef candidates, and pick the k
+                // nearest ones by the float query. distance_bound is not applied as
+                // the distances on the graph are between codes
+                std::vector<char> code(space->get_data_size());
+                encode_vector(vector, code.data());
+                int64_t ef = std::max(params.ef_search, k);
+                results = alg_hnsw->searchKnn((const void*)code.data(), ef, ef, filter_ptr);
+                rerank(vector, results, k);
+            } else {
+                results = alg_hnsw->searchKnn((const void*)(vector),
+                                              k,
+                                              std::max(params.ef_search, k),
+                                              filter_ptr,
+                                              params.distance_bound);
+            }
         } catch (const std::runtime_error& e) {
             LOG_ERROR_AND_RETURNS(ErrorType::INTERNAL_ERROR,
                                   "failed to perofrm knn_search(internalError): ",
@@ -354,12 +405,24 @@ HNSW::range_search(const DatasetPtr& query,
 
         // perform search
         std::priority_queue<std::pair<float, size_t>> results;
+        size_t search_limit = limited_size > 0 ? limited_size : 0;
         double time_cost;
         try {
             std::shared_lock lock(rw_mutex_);
             Timer timer(time_cost);
-            results =
-                alg_hnsw->searchRange((const void*)(vector), radius, params.ef_search, filter_ptr);
+            if (encode_vectors_) {
+                std::vector<char> code(space->get_data_size());
+                encode_vector(vector, code.data());
+                results = alg_hnsw->searchRange(
+                    (const void*)code.data(), radius, params.ef_search, filter_ptr, search_limit);
+                rerank(vector, results, results.size());
+                while (not results.empty() and results.top().first > radius) {
+                    results.pop();
+                }
+            } else {
+                results = alg_hnsw->searchRange(
+                    (const void*)(vector), radius, params.ef_search, filter_ptr, search_limit);
+            }
         } catch (std::runtime_error& e) {
             LOG_ERROR_AND_RETURNS(ErrorType::INTERNAL_ERROR,
                                   "failed to perofrm range_search(internalError): ",
@@ -484,6 +547,122 @@ HNSW::serialize(std::ostream& out_stream) {
     return {};
 }
 
+bool
+HNSW::reorder() {
+    if (use_static_ || empty_index_) {
+        return false;
+    }
+    SlowTaskTimer t("hnsw reorder");
+    std::unique_lock lock(rw_mutex_);
+    return alg_hnsw->reorder();
+}
+
+uint32_t
+HNSW::prepare_compact() {
+    if (use_static_ || empty_index_) {
+        return 0;
+    }
+    SlowTaskTimer t("hnsw prepare compact");
+    std::shared_lock lock(rw_mutex_);
+    return alg_hnsw->prepareCompaction();
+}
+
+uint32_t
+HNSW::compact() {
+    if (use_static_ || empty_index_) {
+        return 0;
+    }
+    SlowTaskTimer t("hnsw compact");
+    std::unique_lock lock(rw_mutex_);
+    return alg_hnsw->compactDeleted();
+}
+
+std::vector<float>
+HNSW::calibrate_recall(int64_t k,
+                       const std::vector<int64_t>& ef_searches,
+                       int64_t sample_count) const {
+    CHECK_ARGUMENT(k > 0, fmt::format("k({}) must be greater than 0", k));
+    CHECK_ARGUMENT(sample_count > 0,
+                   fmt::format("sample_count({}) must be greater than 0", sample_count));
+    std::vector<size_t> efs;
+    for (auto ef_search : ef_searches) {
+        CHECK_ARGUMENT(ef_search > 0,
+                       fmt::format("ef_search({}) must be greater than 0", ef_search));
+        efs.push_back(ef_search);
+    }
+    if (use_static_ || empty_index_) {
+        return std::vector<float>(efs.size(), 0);
+    }
+    SlowTaskTimer t("hnsw calibrate recall");
+    std::shared_lock lock(rw_mutex_);
+    return alg_hnsw->calibrateRecall(k, efs, sample_count);
+}
+
+IteratorContextPtr
+HNSW::knn_search_iterator(const DatasetPtr& query) const {
+    if (use_static_) {
+        throw std::runtime_error("static hnsw doesn't support knn search iterator");
+    }
+    if (empty_index_) {
+        return std::make_shared<HnswIteratorContext>(nullptr);
+    }
+    CHECK_ARGUMENT(query->GetNumElements() == 1, "query dataset should contain 1 vector only");
+    auto vector = query->GetFloat32Vectors();
+    int64_t query_dim = query->GetDim();
+    CHECK_ARGUMENT(query_dim == dim_,
+                   fmt::format("query.dim({}) must be equal to index.dim({})", query_dim, dim_));
+
+    std::shared_lock lock(rw_mutex_);
+    if (encode_vectors_) {
+        // the iterator keeps walking the encoded graph, so the distances it returns are the
+        // ones between codes and are not reranked
+        std::vector<char> code(space->get_data_size());
+        encode_vector(vector, code.data());
+        return std::make_shared<HnswIteratorContext>(alg_hnsw->searchKnnIterator(code.data()));
+    }
+    return std::make_shared<HnswIteratorContext>(alg_hnsw->searchKnnIterator(vector));
+}
+
+DatasetPtr
+HNSW::knn_search_next(const IteratorContextPtr& context,
+                      int64_t k,
+                      const SearchParam& param,
+                      const std::function<bool(int64_t)>& filter) const {
+    CHECK_ARGUMENT(k > 0, fmt::format("k({}) must be greater than 0", k));
+    auto hnsw_context = std::dynamic_pointer_cast<HnswIteratorContext>(context);
+    CHECK_ARGUMENT(hnsw_context != nullptr, "context is not created by hnsw");
+    auto params = HnswSearchParameters::FromParam(param);
+
+    auto result = Dataset::Make();
+    std::vector<std::pair<float, hnswlib::labeltype>> results;
+    if (hnsw_context->state_ != nullptr) {
+        SlowTaskTimer t("hnsw knn search next", 20);
+        std::shared_lock lock(rw_mutex_);
+        if (filter) {
+            BitsetOrCallbackFilter filter_obj(filter);
+            results = alg_hnsw->searchKnnNext(
+                hnsw_context->state_.get(), k, params.ef_search, &filter_obj);
+        } else {
+            results = alg_hnsw->searchKnnNext(hnsw_context->state_.get(), k, params.ef_search);
+        }
+    }
+    if (results.empty()) {
+        result->Dim(0)->NumElements(1);
+        return result;
+    }
+
+    result->Dim(results.size())->NumElements(1)->Owner(true, allocator_->GetRawAllocator());
+    int64_t* ids = (int64_t*)allocator_->Allocate(sizeof(int64_t) * results.size());
+    result->Ids(ids);
+    float* dists = (float*)allocator_->Allocate(sizeof(float) * results.size());
+    result->Distances(dists);
+    for (size_t j = 0; j < results.size(); ++j) {
+        dists[j] = results[j].first;
+        ids[j] = results[j].second;
+    }
+    return result;
+}
+
 tl::expected<void, Error>
 HNSW::deserialize(const BinarySet& binary_set) {
     SlowTaskTimer t("hnsw deserialize");
@@ -696,9 +875,16 @@ HNSW::brute_force(const DatasetPtr& query, int64_t k) {
         result->Distances(dists);
 
         auto vector = query->GetFloat32Vectors();
+        std::vector<char> code;
+        const void* data_point = vector;
+        if (encode_vectors_) {
+            code.resize(space->get_data_size());
+            encode_vector(vector, code.data());
+            data_point = code.data();
+        }
         std::shared_lock lock(rw_mutex_);
         std::priority_queue<std::pair<float, hnswlib::labeltype>> bf_result =
-            alg_hnsw->bruteForce((const void*)vector, k);
+            alg_hnsw->bruteForce(data_point, k);
         result->Dim(std::min(k, (int64_t)bf_result.size()));
 
         for (int i = result->GetDim() - 1; i >= 0; i--) {
@@ -805,4 +991,149 @@ HNSW::init_memory_space() {
     return true;
 }
 
+std::vector<int64_t>
+HNSW::add_points(const float* vectors, const int64_t* ids, int64_t num_elements) {
+    std::vector<int64_t> failed_ids;
+    // the code buffer is only used by the encoded graph, which stores the codes of the vectors
+    auto add_point = [&](int64_t i, std::vector<char>& code) {
+        const void* data_point = vectors + i * dim_;
+        if (encode_vectors_) {
+            code.resize(space->get_data_size());
+            encode_vector(vectors + i * dim_, code.data());
+            data_point = code.data();
+        }
+        return alg_hnsw->addPoint(data_point, ids[i]);
+    };
+
+    int64_t thread_num = std::min(build_thread_num_, num_elements / MIN_ELEMENTS_PER_BUILD_THREAD);
+    // the static graph and the reversed edges are not maintained thread-safely
+    if (thread_num <= 1 or use_static_ or use_reversed_edges_) {
+        std::vector<char> code;
+        for (int64_t i = 0; i < num_elements; ++i) {
+            // noexcept runtime
+            if (!add_point(i, code)) {
+                logger::debug("duplicate point: {}", ids[i]);
+                failed_ids.emplace_back(ids[i]);
+            }
+        }
+        return failed_ids;
+    }
+
+    // addPoint grows the graph when it is full, which is not safe while other threads are
+    // inserting, so reserve the space for the whole batch in advance
+    size_t required_elements = alg_hnsw->getCurrentElementCount() + num_elements;
+    if (required_elements > alg_hnsw->getMaxElements()) {
+        alg_hnsw->resizeIndex(required_elements);
+    }
+
+    logger::debug("build hnsw with {} threads, num_elements={}", thread_num, num_elements);
+    std::vector<std::vector<int64_t>> failed_ids_per_thread(thread_num);
+    std::vector<std::exception_ptr> exceptions(thread_num);
+    std::atomic<int64_t> next_begin{0};
+    auto worker = [&](size_t thread_idx) {
+        try {
+            auto& local_failed_ids = failed_ids_per_thread[thread_idx];
+            std::vector<char> code;
+            for (int64_t begin = next_begin.fetch_add(BUILD_BATCH_SIZE); begin < num_elements;
+                 begin = next_begin.fetch_add(BUILD_BATCH_SIZE)) {
+                int64_t end = std::min(begin + BUILD_BATCH_SIZE, num_elements);
+                for (int64_t i = begin; i < end; ++i) {
+                    if (!add_point(i, code)) {
+                        logger::debug("duplicate point: {}", ids[i]);
+                        local_failed_ids.emplace_back(ids[i]);
+                    }
+                }
+            }
+        } catch (...) {
+            // stop the other workers as soon as possible
+            next_begin.store(num_elements);
+            exceptions[thread_idx] = std::current_exception();
+        }
+    };
+
+    if (auto executor = Options::Instance().parallel_executor(); executor) {
+        executor(thread_num, worker);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(thread_num);
+        for (int64_t i = 0; i < thread_num; ++i) {
+            threads.emplace_back(worker, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    // the executor may have run fewer workers than requested, finish the rest here
+    if (next_begin.load() < num_elements) {
+        worker(0);
+    }
+
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+    for (const auto& local_failed_ids : failed_ids_per_thread) {
+        failed_ids.insert(failed_ids.end(), local_failed_ids.begin(), local_failed_ids.end());
+    }
+    return failed_ids;
+}
+
+static void
+normalize_vector(const float* vector, int64_t dim, std::vector<float>& normalized) {
+    float square_sum = 0;
+    for (int64_t i = 0; i < dim; ++i) {
+        square_sum += vector[i] * vector[i];
+    }
+    float mold = std::sqrt(square_sum);
+    normalized.resize(dim);
+    for (int64_t i = 0; i < dim; ++i) {
+        normalized[i] = mold > 0 ? vector[i] / mold : vector[i];
+    }
+}
+
+void
+HNSW::encode_vector(const float* vector, char* code) const {
+    std::vector<float> normalized;
+    if (normalize_) {
+        normalize_vector(vector, dim_, normalized);
+        vector = normalized.data();
+    }
+    encoded_space_->encode(vector, code);
+}
+
+void
+HNSW::rerank(const float* query,
+             std::priority_queue<std::pair<float, size_t>>& results,
+             int64_t k) const {
+    std::vector<float> normalized;
+    if (normalize_) {
+        normalize_vector(query, dim_, normalized);
+        query = normalized.data();
+    }
+
+    std::priority_queue<std::pair<float, size_t>> reranked;
+    while (not results.empty()) {
+        auto label = results.top().second;
+        results.pop();
+        float dist = encoded_space_->asymmetric_distance(query, alg_hnsw->getDataByLabel(label));
+        reranked.emplace(dist, label);
+        if ((int64_t)reranked.size() > k) {
+            reranked.pop();
+        }
+    }
+    results.swap(reranked);
+}
+
+float
+HNSW::calc_distance_by_id(const float* vector, int64_t id) const {
+    if (not encode_vectors_) {
+        return alg_hnsw->getDistanceByLabel(id, vector);
+    }
+    std::priority_queue<std::pair<float, size_t>> result;
+    result.emplace(0, id);
+    rerank(vector, result, 1);
+    return result.top().first;
+}
+
 }  // namespace vsag
@@ -33,6 +33,7 @@
 #include "../logger.h"
 #include "../safe_allocator.h"
 #include "../utils.h"
+#include "hnsw_zparameters.h"
 #include "vsag/binaryset.h"
 #include "vsag/errors.h"
 #include "vsag/index.h"
@@ -65,6 +66,16 @@ private:
     bool is_bitset_filter_ = false;
 };
 
+class HnswIteratorContext : public IteratorContext {
+public:
+    explicit HnswIteratorContext(std::unique_ptr<hnswlib::KnnIteratorState> state)
+        : state_(std::move(state)) {
+    }
+
+    // null when the index is empty, the search returns nothing then
+    std::unique_ptr<hnswlib::KnnIteratorState> state_;
+};
+
 class HNSW : public Index {
 public:
     HNSW(std::shared_ptr<hnswlib::SpaceInterface> space_interface,
@@ -74,7 +85,9 @@ public:
          bool use_reversed_edges = false,
          bool use_conjugate_graph = false,
          bool normalize = false,
-         Allocator* allocator = nullptr);
+         Allocator* allocator = nullptr,
+         int64_t build_thread_num = 1,
+         bool encode_vectors = false);
 
     virtual ~HNSW() {
         alg_hnsw = nullptr;
@@ -113,6 +126,14 @@ public:
         SAFE_CALL(return this->knn_search_internal(query, k, parameters, invalid));
     }
 
+    tl::expected<DatasetPtr, Error>
+    KnnSearch(const DatasetPtr& query,
+              int64_t k,
+              const SearchParam& param,
+              const std::function<bool(int64_t)>& filter) const override {
+        SAFE_CALL(return this->knn_search_internal(query, k, param, filter));
+    }
+
     tl::expected<DatasetPtr, Error>
     RangeSearch(const DatasetPtr& query,
                 float radius,
@@ -159,7 +180,42 @@ public:
 
     virtual tl::expected<float, Error>
     CalcDistanceById(const float* vector, int64_t id) const override {
-        SAFE_CALL(return alg_hnsw->getDistanceByLabel(id, vector));
+        SAFE_CALL(return this->calc_distance_by_id(vector, id));
+    };
+
+    tl::expected<bool, Error>
+    Reorder() override {
+        SAFE_CALL(return this->reorder());
+    };
+
+    tl::expected<uint32_t, Error>
+    PrepareCompact() override {
+        SAFE_CALL(return this->prepare_compact());
+    };
+
+    tl::expected<uint32_t, Error>
+    Compact() override {
+        SAFE_CALL(return this->compact());
+    };
+
+    tl::expected<std::vector<float>, Error>
+    CalibrateRecall(int64_t k,
+                    const std::vector<int64_t>& ef_searches,
+                    int64_t sample_count) const override {
+        SAFE_CALL(return this->calibrate_recall(k, ef_searches, sample_count));
+    };
+
+    tl::expected<IteratorContextPtr, Error>
+    KnnSearchIterator(const DatasetPtr& query) const override {
+        SAFE_CALL(return this->knn_search_iterator(query));
+    };
+
+    tl::expected<DatasetPtr, Error>
+    KnnSearchNext(const IteratorContextPtr& context,
+                  int64_t k,
+                  const SearchParam& param,
+                  const std::function<bool(int64_t)>& filter) const override {
+        SAFE_CALL(return this->knn_search_next(context, k, param, filter));
     };
 
 public:
@@ -219,11 +275,11 @@ private:
     tl::expected<bool, Error>
     remove(int64_t id);
 
-    template <typename FilterType>
+    template <typename ParamType, typename FilterType>
     tl::expected<DatasetPtr, Error>
     knn_search_internal(const DatasetPtr& query,
                         int64_t k,
-                        const std::string& parameters,
+                        const ParamType& parameters,
                         const FilterType& filter_obj) const;
 
     tl::expected<DatasetPtr, Error>
@@ -232,6 +288,18 @@ private:
                const std::string& parameters,
                hnswlib::BaseFilterFunctor* filter_ptr) const;
 
+    tl::expected<DatasetPtr, Error>
+    knn_search(const DatasetPtr& query,
+               int64_t k,
+               const SearchParam& param,
+               hnswlib::BaseFilterFunctor* filter_ptr) const;
+
+    tl::expected<DatasetPtr, Error>
+    knn_search(const DatasetPtr& query,
+               int64_t k,
+               const HnswSearchParameters& params,
+               hnswlib::BaseFilterFunctor* filter_ptr) const;
+
     template <typename FilterType>
     tl::expected<DatasetPtr, Error>
     range_search_internal(const DatasetPtr& query,
@@ -280,12 +348,54 @@ private:
     tl::expected<bool, Error>
     init_memory_space();
 
+    // inserts the points into alg_hnsw, using up to build_thread_num_ threads, and returns the
+    // ids that failed to insert. the caller must hold rw_mutex_ exclusively.
+    std::vector<int64_t>
+    add_points(const float* vectors, const int64_t* ids, int64_t num_elements);
+
+    // encodes the vector into the layout stored by the encoded graph, normalizing it first
+    // when the metric is cosine
+    void
+    encode_vector(const float* vector, char* code) const;
+
+    // replaces the distances between codes of the candidates with the distances to the float
+    // query, and keeps the k nearest ones
+    void
+    rerank(const float* query,
+           std::priority_queue<std::pair<float, size_t>>& results,
+           int64_t k) const;
+
+    float
+    calc_distance_by_id(const float* vector, int64_t id) const;
+
+    bool
+    reorder();
+
+    uint32_t
+    prepare_compact();
+
+    uint32_t
+    compact();
+
+    std::vector<float>
+    calibrate_recall(int64_t k, const std::vector<int64_t>& ef_searches, int64_t sample_count) const;
+
+    IteratorContextPtr
+    knn_search_iterator(const DatasetPtr& query) const;
+
+    DatasetPtr
+    knn_search_next(const IteratorContextPtr& context,
+                    int64_t k,
+                    const SearchParam& param,
+                    const std::function<bool(int64_t)>& filter) const;
+
     BinarySet
     empty_binaryset() const;
 
 private:
     std::shared_ptr<hnswlib::AlgorithmInterface<float>> alg_hnsw;
     std::shared_ptr<hnswlib::SpaceInterface> space;
+    std::shared_ptr<hnswlib::EncodedSpace> encoded_space_;
 
     bool use_conjugate_graph_;
     std::shared_ptr<ConjugateGraph> conjugate_graph_;
@@ -295,6 +405,9 @@ private:
     bool empty_index_ = false;
     bool use_reversed_edges_ = false;
     bool is_init_memory_ = false;
+    int64_t build_thread_num_ = 1;
+    bool encode_vectors_ = false;
+    bool normalize_ = false;
 
     std::shared_ptr<SafeAllocator> allocator_;
 
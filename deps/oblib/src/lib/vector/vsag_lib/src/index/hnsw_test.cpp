@@ -15,9 +15,11 @@
 
 #include "hnsw.h"
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <unordered_set>
 #include <vector>
 
 #include "../logger.h"
@@ -82,6 +84,65 @@ TEST_CASE("build with allocator", "[ut][hnsw]") {
     REQUIRE(result.has_value());
 }
 
+TEST_CASE("build & add with multiple threads", "[ut][hnsw]") {
+    vsag::logger::set_level(vsag::logger::level::debug);
+
+    int64_t dim = 32;
+    int64_t max_degree = 12;
+    int64_t ef_construction = 100;
+    int64_t build_thread_num = 4;
+    auto index = std::make_shared<vsag::HNSW>(std::make_shared<hnswlib::L2Space>(dim),
+                                              max_degree,
+                                              ef_construction,
+                                              false,
+                                              false,
+                                              false,
+                                              false,
+                                              nullptr,
+                                              build_thread_num);
+
+    const int64_t num_elements = 10000;
+    auto [ids, vectors] = fixtures::generate_ids_and_vectors(num_elements, dim);
+
+    auto dataset = vsag::Dataset::Make();
+    dataset->Dim(dim)
+        ->NumElements(num_elements / 2)
+        ->Ids(ids.data())
+        ->Float32Vectors(vectors.data())
+        ->Owner(false);
+    auto build_result = index->Build(dataset);
+    REQUIRE(build_result.has_value());
+    REQUIRE(build_result->empty());
+
+    // the second half together with a duplicated first half
+    auto incremental = vsag::Dataset::Make();
+    incremental->Dim(dim)
+        ->NumElements(num_elements)
+        ->Ids(ids.data())
+        ->Float32Vectors(vectors.data())
+        ->Owner(false);
+    auto add_result = index->Add(incremental);
+    REQUIRE(add_result.has_value());
+    REQUIRE(add_result->size() == num_elements / 2);
+    REQUIRE(index->GetNumElements() == num_elements);
+    REQUIRE(index->CheckGraphIntegrity());
+
+    nlohmann::json params{
+        {"hnsw", {{"ef_search", 100}}},
+    };
+    int64_t correct = 0;
+    for (int64_t i = 0; i < num_elements; i += 100) {
+        auto query = vsag::Dataset::Make();
+        query->NumElements(1)->Dim(dim)->Float32Vectors(vectors.data() + i * dim)->Owner(false);
+        auto result = index->KnnSearch(query, 1, params.dump());
+        REQUIRE(result.has_value());
+        if (result.value()->GetIds()[0] == ids[i]) {
+            ++correct;
+        }
+    }
+    REQUIRE(correct >= (num_elements / 100) * 0.95);
+}
+
 TEST_CASE("knn_search", "[ut][hnsw]") {
     vsag::logger::set_level(vsag::logger::level::debug);
 
@@ -153,6 +214,54 @@ TEST_CASE("knn_search", "[ut][hnsw]") {
         REQUIRE_FALSE(result.has_value());
         REQUIRE(result.error().type == vsag::ErrorType::INVALID_ARGUMENT);
     }
+
+    SECTION("typed parameters") {
+        auto filter = [](int64_t id) -> bool { return false; };
+        vsag::SearchParam search_param;
+        search_param.ef_search = 100;
+        auto json_result = index->KnnSearch(query, k, params.dump(), filter);
+        auto typed_result = index->KnnSearch(query, k, search_param, filter);
+        REQUIRE(json_result.has_value());
+        REQUIRE(typed_result.has_value());
+        REQUIRE(json_result.value()->GetDim() == typed_result.value()->GetDim());
+        for (int64_t i = 0; i < typed_result.value()->GetDim(); ++i) {
+            REQUIRE(json_result.value()->GetIds()[i] == typed_result.value()->GetIds()[i]);
+        }
+    }
+
+    SECTION("typed parameters with distance bound") {
+        auto filter = [](int64_t id) -> bool { return false; };
+        vsag::SearchParam search_param;
+        search_param.ef_search = 100;
+        auto unbounded_result = index->KnnSearch(query, k, search_param, filter);
+        REQUIRE(unbounded_result.has_value());
+        REQUIRE(unbounded_result.value()->GetDim() > 0);
+
+        // the nearest result is always kept, the search stops before going farther
+        std::atomic<float> bound(-1.0f);
+        search_param.distance_bound = &bound;
+        auto bounded_result = index->KnnSearch(query, k, search_param, filter);
+        REQUIRE(bounded_result.has_value());
+        REQUIRE(bounded_result.value()->GetDim() >= 1);
+        REQUIRE(bounded_result.value()->GetDim() <= unbounded_result.value()->GetDim());
+
+        bound.store(std::numeric_limits<float>::max());
+        auto loose_result = index->KnnSearch(query, k, search_param, filter);
+        REQUIRE(loose_result.has_value());
+        REQUIRE(loose_result.value()->GetDim() == unbounded_result.value()->GetDim());
+        for (int64_t i = 0; i < loose_result.value()->GetDim(); ++i) {
+            REQUIRE(loose_result.value()->GetIds()[i] == unbounded_result.value()->GetIds()[i]);
+        }
+    }
+
+    SECTION("invalid typed parameters ef_search") {
+        auto filter = [](int64_t id) -> bool { return false; };
+        vsag::SearchParam search_param;
+        search_param.ef_search = 0;
+        auto result = index->KnnSearch(query, k, search_param, filter);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error().type == vsag::ErrorType::INVALID_ARGUMENT);
+    }
 }
 
 TEST_CASE("range_search", "[ut][hnsw]") {
@@ -251,6 +360,63 @@ TEST_CASE("range_search", "[ut][hnsw]") {
     }
 }
 
+TEST_CASE("range search with deleted elements and limit", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 16;
+    int64_t num_base = 1000;
+    size_t limit = 20;
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+
+    const float* query = base_vectors.data();
+    std::vector<std::pair<float, int64_t>> exact;
+    for (int64_t i = 0; i < num_base; ++i) {
+        exact.emplace_back(alg_hnsw->getDistanceByLabel(base_ids[i], query), base_ids[i]);
+    }
+    std::sort(exact.begin(), exact.end());
+    auto count_hit = [&](std::priority_queue<std::pair<float, hnswlib::labeltype>> result,
+                         size_t begin) {
+        std::unordered_set<int64_t> truth;
+        for (size_t i = begin; i < begin + limit; ++i) {
+            truth.insert(exact[i].second);
+        }
+        int64_t hit = 0;
+        while (!result.empty()) {
+            hit += truth.count(result.top().second);
+            result.pop();
+        }
+        return hit;
+    };
+
+    // a radius covering all elements only searches for the nearest limit ones
+    float loose_radius = exact.back().first + 1;
+    auto result = alg_hnsw->searchRange(query, loose_radius, 100, nullptr, limit);
+    REQUIRE(result.size() >= limit);
+    REQUIRE(count_hit(result, 0) >= limit - 1);
+    REQUIRE(alg_hnsw->searchRange(query, loose_radius, 100).size() == num_base);
+
+    // the deleted elements are skipped instead of failing the search
+    alg_hnsw->markDelete(exact[0].second);
+    float radius = exact[limit].first;
+    result = alg_hnsw->searchRange(query, radius, 100, nullptr, limit);
+    REQUIRE(result.size() <= limit);
+    REQUIRE(result.top().first <= radius + 1e-5);
+    REQUIRE(count_hit(result, 1) >= limit - 1);
+    delete alg_hnsw;
+}
+
 TEST_CASE("serialize empty index", "[ut][hnsw]") {
     vsag::logger::set_level(vsag::logger::level::debug);
 
@@ -379,6 +545,134 @@ TEST_CASE("static hnsw", "[ut][hnsw]") {
     REQUIRE(remove_result.error().type == vsag::ErrorType::UNSUPPORTED_INDEX_OPERATION);
 }
 
+TEST_CASE("sq8 hnsw", "[ut][hnsw]") {
+    vsag::logger::set_level(vsag::logger::level::debug);
+
+    int64_t dim = 128;
+    int64_t max_degree = 12;
+    int64_t ef_construction = 100;
+    auto index = std::make_shared<vsag::HNSW>(std::make_shared<hnswlib::SQ8Space>(dim, false),
+                                              max_degree,
+                                              ef_construction,
+                                              false,
+                                              false,
+                                              false,
+                                              false,
+                                              nullptr,
+                                              1,
+                                              true);
+    auto float_index = std::make_shared<vsag::HNSW>(
+        std::make_shared<hnswlib::L2Space>(dim), max_degree, ef_construction);
+
+    const int64_t num_elements = 1000;
+    auto [ids, vectors] = fixtures::generate_ids_and_vectors(num_elements, dim);
+
+    auto dataset = vsag::Dataset::Make();
+    dataset->Dim(dim)
+        ->NumElements(num_elements)
+        ->Ids(ids.data())
+        ->Float32Vectors(vectors.data())
+        ->Owner(false);
+    REQUIRE(index->Build(dataset).has_value());
+    REQUIRE(float_index->Build(dataset).has_value());
+    REQUIRE(index->GetMemoryUsage() < float_index->GetMemoryUsage());
+
+    nlohmann::json params{
+        {"hnsw", {{"ef_search", 100}}},
+    };
+    int64_t correct = 0;
+    for (int64_t i = 0; i < num_elements; i += 10) {
+        auto query = vsag::Dataset::Make();
+        query->NumElements(1)->Dim(dim)->Float32Vectors(vectors.data() + i * dim)->Owner(false);
+        auto result = index->KnnSearch(query, 1, params.dump());
+        REQUIRE(result.has_value());
+        if (result.value()->GetIds()[0] == ids[i]) {
+            ++correct;
+        }
+    }
+    REQUIRE(correct >= (num_elements / 10) * 0.95);
+
+    // the distance is computed against the unquantized query
+    auto distance = index->CalcDistanceById(vectors.data(), ids[0]);
+    REQUIRE(distance.has_value());
+    REQUIRE(distance.value() < 1e-3);
+
+    auto query = vsag::Dataset::Make();
+    query->NumElements(1)->Dim(dim)->Float32Vectors(vectors.data())->Owner(false);
+    auto range_result = index->RangeSearch(query, 1e-3, params.dump());
+    REQUIRE(range_result.has_value());
+    REQUIRE(range_result.value()->GetDim() >= 1);
+    REQUIRE(range_result.value()->GetIds()[0] == ids[0]);
+
+    // the quantized graph cannot be static or enhanced by the conjugate graph
+    REQUIRE_THROWS(std::make_shared<vsag::HNSW>(std::make_shared<hnswlib::SQ8Space>(dim, false),
+                                                max_degree,
+                                                ef_construction,
+                                                true,
+                                                false,
+                                                false,
+                                                false,
+                                                nullptr,
+                                                1,
+                                                true));
+    REQUIRE_THROWS(std::make_shared<vsag::HNSW>(std::make_shared<hnswlib::SQ8Space>(dim, false),
+                                                max_degree,
+                                                ef_construction,
+                                                false,
+                                                false,
+                                                true,
+                                                false,
+                                                nullptr,
+                                                1,
+                                                true));
+}
+
+TEST_CASE("hnsw with narrow element types", "[ut][hnsw]") {
+    vsag::logger::set_level(vsag::logger::level::debug);
+
+    int64_t dim = 128;
+    int64_t max_degree = 12;
+    int64_t ef_construction = 100;
+    const int64_t num_elements = 1000;
+    auto [ids, vectors] = fixtures::generate_ids_and_vectors(num_elements, dim);
+
+    auto dataset = vsag::Dataset::Make();
+    dataset->Dim(dim)
+        ->NumElements(num_elements)
+        ->Ids(ids.data())
+        ->Float32Vectors(vectors.data())
+        ->Owner(false);
+    std::vector<std::shared_ptr<hnswlib::SpaceInterface>> spaces{
+        std::make_shared<hnswlib::FP16Space>(dim, false),
+        std::make_shared<hnswlib::BF16Space>(dim, false),
+        std::make_shared<hnswlib::INT8Space>(dim, false)};
+    nlohmann::json params{
+        {"hnsw", {{"ef_search", 100}}},
+    };
+    for (const auto& space : spaces) {
+        auto index = std::make_shared<vsag::HNSW>(
+            space, max_degree, ef_construction, false, false, false, false, nullptr, 1, true);
+        REQUIRE(space->get_data_size() < dim * sizeof(float));
+        REQUIRE(index->Build(dataset).has_value());
+
+        int64_t correct = 0;
+        for (int64_t i = 0; i < num_elements; i += 10) {
+            auto query = vsag::Dataset::Make();
+            query->NumElements(1)->Dim(dim)->Float32Vectors(vectors.data() + i * dim)->Owner(false);
+            auto result = index->KnnSearch(query, 1, params.dump());
+            REQUIRE(result.has_value());
+            if (result.value()->GetIds()[0] == ids[i]) {
+                ++correct;
+            }
+        }
+        REQUIRE(correct >= (num_elements / 10) * 0.95);
+
+        auto distance = index->CalcDistanceById(vectors.data(), ids[0]);
+        REQUIRE(distance.has_value());
+        REQUIRE(distance.value() < 1e-2);
+    }
+}
+
 TEST_CASE("hnsw add vector with duplicated id", "[ut][hnsw]") {
     vsag::logger::set_level(vsag::logger::level::debug);
 
@@ -804,3 +1098,352 @@ TEST_CASE("get data by label", "[ut][hnsw]") {
         delete alg_hnsw_static;
     }
 }
+
+TEST_CASE("reorder keeps labels and search results", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 32;
+    int64_t num_base = 1000;
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+    std::vector<std::vector<std::pair<float, hnswlib::labeltype>>> before;
+    for (int64_t i = 0; i < num_base; i += 10) {
+        before.push_back(alg_hnsw->searchKnnCloserFirst(base_vectors.data() + i * dim, 10, 100));
+    }
+
+    REQUIRE(alg_hnsw->reorder());
+
+    for (int64_t i = 0; i < num_base; ++i) {
+        REQUIRE(alg_hnsw->getDistanceByLabel(base_ids[i], base_vectors.data() + i * dim) == 0);
+    }
+    for (int64_t i = 0; i < num_base; i += 10) {
+        auto after = alg_hnsw->searchKnnCloserFirst(base_vectors.data() + i * dim, 10, 100);
+        REQUIRE(after == before[i / 10]);
+    }
+    delete alg_hnsw;
+}
+
+TEST_CASE("compact deleted elements", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 32;
+    int64_t num_base = 1000;
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+    for (int64_t i = 0; i < num_base; i += 2) {
+        alg_hnsw->markDelete(base_ids[i]);
+    }
+
+    REQUIRE(alg_hnsw->compactDeleted() == num_base / 2);
+    REQUIRE(alg_hnsw->getCurrentElementCount() == num_base / 2);
+    REQUIRE(alg_hnsw->getDeletedCount() == 0);
+
+    for (int64_t i = 0; i < num_base; ++i) {
+        REQUIRE(alg_hnsw->isValidLabel(base_ids[i]) == (i % 2 == 1));
+    }
+    int64_t correct = 0;
+    for (int64_t i = 1; i < num_base; i += 2) {
+        auto result = alg_hnsw->searchKnn(base_vectors.data() + i * dim, 1, 100);
+        REQUIRE(result.size() == 1);
+        correct += result.top().second == base_ids[i] ? 1 : 0;
+    }
+    REQUIRE(correct > num_base / 2 * 0.95);
+    delete alg_hnsw;
+}
+
+TEST_CASE("compact deleted elements with prepared links", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 32;
+    int64_t num_base = 1000;
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+    for (int64_t i = 0; i < num_base; i += 4) {
+        alg_hnsw->markDelete(base_ids[i]);
+    }
+
+    // the preparation does not change the graph
+    REQUIRE(alg_hnsw->prepareCompaction() > 0);
+    REQUIRE(alg_hnsw->getCurrentElementCount() == num_base);
+    REQUIRE(alg_hnsw->getDeletedCount() == num_base / 4);
+    auto result = alg_hnsw->searchKnn(base_vectors.data() + dim, 1, 100);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result.top().second == base_ids[1]);
+
+    // the prepared links are dropped when more elements are deleted in between
+    alg_hnsw->markDelete(base_ids[2]);
+    int64_t deleted_count = num_base / 4 + 1;
+    REQUIRE(alg_hnsw->compactDeleted() == deleted_count);
+    REQUIRE(alg_hnsw->getCurrentElementCount() == num_base - deleted_count);
+
+    // the prepared links are applied
+    for (int64_t i = 1; i < num_base; i += 4) {
+        alg_hnsw->markDelete(base_ids[i]);
+    }
+    REQUIRE(alg_hnsw->prepareCompaction() > 0);
+    REQUIRE(alg_hnsw->compactDeleted() == num_base / 4);
+    REQUIRE(alg_hnsw->getCurrentElementCount() == num_base / 2 - 1);
+    REQUIRE(alg_hnsw->getDeletedCount() == 0);
+
+    int64_t correct = 0;
+    for (int64_t i = 3; i < num_base; ++i) {
+        if (i % 4 < 2) {
+            REQUIRE_FALSE(alg_hnsw->isValidLabel(base_ids[i]));
+            continue;
+        }
+        REQUIRE(alg_hnsw->isValidLabel(base_ids[i]));
+        auto result = alg_hnsw->searchKnn(base_vectors.data() + i * dim, 1, 100);
+        REQUIRE(result.size() == 1);
+        correct += result.top().second == base_ids[i] ? 1 : 0;
+    }
+    REQUIRE(correct > (num_base / 2 - 1) * 0.95);
+    delete alg_hnsw;
+}
+
+TEST_CASE("compact all deleted elements", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 32;
+    int64_t num_base = 100;
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->markDelete(base_ids[i]);
+    }
+
+    REQUIRE(alg_hnsw->prepareCompaction() == 0);
+    REQUIRE(alg_hnsw->compactDeleted() == num_base);
+    REQUIRE(alg_hnsw->getCurrentElementCount() == 0);
+    REQUIRE(alg_hnsw->getDeletedCount() == 0);
+    for (int64_t i = 0; i < num_base; ++i) {
+        REQUIRE_FALSE(alg_hnsw->isValidLabel(base_ids[i]));
+    }
+    REQUIRE(alg_hnsw->searchKnn(base_vectors.data(), 1, 100).empty());
+
+    // the emptied index takes new elements
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+    REQUIRE(alg_hnsw->getCurrentElementCount() == num_base);
+    auto result = alg_hnsw->searchKnn(base_vectors.data() + dim, 1, 100);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result.top().second == base_ids[1]);
+    delete alg_hnsw;
+}
+
+TEST_CASE("calibrate recall", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 32;
+    int64_t num_base = 1000;
+    int64_t k = 10;
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+    for (int64_t i = 0; i < num_base; i += 10) {
+        alg_hnsw->markDelete(base_ids[i]);
+    }
+
+    std::vector<size_t> efs = {10, 50, 200};
+    auto recalls = alg_hnsw->calibrateRecall(k, efs, 100);
+    REQUIRE(recalls.size() == efs.size());
+    for (size_t i = 0; i < recalls.size(); ++i) {
+        REQUIRE(recalls[i] > 0);
+        REQUIRE(recalls[i] <= 1.0f);
+        if (i > 0) {
+            REQUIRE(recalls[i] + 0.01f >= recalls[i - 1]);
+        }
+    }
+    REQUIRE(recalls.back() > 0.95f);
+
+    // too few elements to measure
+    REQUIRE(alg_hnsw->calibrateRecall(num_base, efs, 100) == std::vector<float>(efs.size(), 0));
+    delete alg_hnsw;
+}
+
+TEST_CASE("knn search iterator", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 32;
+    int64_t num_base = 1000;
+    int64_t batch = 50;
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+    for (int64_t i = 0; i < num_base; i += 10) {
+        alg_hnsw->markDelete(base_ids[i]);
+    }
+
+    const float* query = base_vectors.data() + 5 * dim;
+    auto state = alg_hnsw->searchKnnIterator(query);
+    REQUIRE(state != nullptr);
+
+    // fetch every live element batch by batch
+    std::unordered_set<int64_t> fetched;
+    std::vector<int64_t> ordered;
+    while (true) {
+        auto results = alg_hnsw->searchKnnNext(state.get(), batch, 100);
+        for (const auto& [dist, label] : results) {
+            REQUIRE(fetched.insert(label).second);
+            ordered.push_back(label);
+        }
+        if (static_cast<int64_t>(results.size()) < batch) {
+            break;
+        }
+    }
+    REQUIRE(static_cast<int64_t>(fetched.size()) == num_base - num_base / 10);
+
+    // the first batches are the nearest elements
+    std::vector<std::pair<float, int64_t>> exact;
+    for (int64_t i = 0; i < num_base; ++i) {
+        if (i % 10 != 0) {
+            exact.emplace_back(alg_hnsw->getDistanceByLabel(base_ids[i], query), base_ids[i]);
+        }
+    }
+    std::sort(exact.begin(), exact.end());
+    std::unordered_set<int64_t> nearest(ordered.begin(), ordered.begin() + 2 * batch);
+    int64_t hit = 0;
+    for (int64_t i = 0; i < 2 * batch; ++i) {
+        hit += nearest.count(exact[i].second);
+    }
+    REQUIRE(hit > 2 * batch * 0.95);
+
+    // the iterator starts again once the internal ids are changed, without repeating
+    auto restarted = alg_hnsw->searchKnnIterator(query);
+    fetched.clear();
+    for (const auto& [dist, label] : alg_hnsw->searchKnnNext(restarted.get(), batch, 100)) {
+        fetched.insert(label);
+    }
+    REQUIRE(static_cast<int64_t>(fetched.size()) == batch);
+    alg_hnsw->compactDeleted();
+    while (true) {
+        auto results = alg_hnsw->searchKnnNext(restarted.get(), batch, 100);
+        for (const auto& [dist, label] : results) {
+            REQUIRE(fetched.insert(label).second);
+        }
+        if (static_cast<int64_t>(results.size()) < batch) {
+            break;
+        }
+    }
+    REQUIRE(static_cast<int64_t>(fetched.size()) == num_base - num_base / 10);
+    delete alg_hnsw;
+}
+
+TEST_CASE("knn search iterator recall", "[ut][hnsw]") {
+    vsag::Options::Instance().logger()->SetLevel(vsag::Logger::Level::kDEBUG);
+
+    // parameters
+    int dim = 32;
+    int64_t num_base = 2000;
+    int64_t num_query = 100;
+    int64_t k = 10;
+    std::vector<uint64_t> efs = {10, 20, 50};
+
+    // data
+    auto [base_ids, base_vectors] = fixtures::generate_ids_and_vectors(num_base, dim);
+
+    // hnsw index
+    hnswlib::L2Space space(dim);
+    vsag::DefaultAllocator allocator;
+    auto* alg_hnsw = new hnswlib::HierarchicalNSW(&space, num_base, &allocator, 8, 50);
+    alg_hnsw->init_memory_space();
+    for (int64_t i = 0; i < num_base; ++i) {
+        alg_hnsw->addPoint(base_vectors.data() + i * dim, base_ids[i]);
+    }
+
+    // the first batch of the iterator is as good as searchKnn with the same ef
+    for (auto ef : efs) {
+        int64_t knn_hit = 0;
+        int64_t iterator_hit = 0;
+        for (int64_t q = 0; q < num_query; ++q) {
+            const float* query = base_vectors.data() + (q * 17 % num_base) * dim;
+            std::vector<std::pair<float, int64_t>> exact;
+            for (int64_t i = 0; i < num_base; ++i) {
+                exact.emplace_back(alg_hnsw->getDistanceByLabel(base_ids[i], query), base_ids[i]);
+            }
+            std::partial_sort(exact.begin(), exact.begin() + k, exact.end());
+            std::unordered_set<int64_t> truth;
+            for (int64_t i = 0; i < k; ++i) {
+                truth.insert(exact[i].second);
+            }
+
+            auto result = alg_hnsw->searchKnn(query, k, ef);
+            while (!result.empty()) {
+                knn_hit += truth.count(result.top().second);
+                result.pop();
+            }
+            auto state = alg_hnsw->searchKnnIterator(query);
+            auto batch = alg_hnsw->searchKnnNext(state.get(), k, ef);
+            REQUIRE(static_cast<int64_t>(batch.size()) == k);
+            for (const auto& [dist, label] : batch) {
+                iterator_hit += truth.count(label);
+            }
+        }
+        REQUIRE(iterator_hit >= knn_hit);
+    }
+    delete alg_hnsw;
+}
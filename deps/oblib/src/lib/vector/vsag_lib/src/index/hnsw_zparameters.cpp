@@ -43,13 +43,47 @@ CreateHnswParameters::FromJson(const std::string& json_string) {
     // set obj.space
     CHECK_ARGUMENT(params.contains(INDEX_HNSW),
                    fmt::format("parameters must contains {}", INDEX_HNSW));
-    if (params[PARAMETER_METRIC_TYPE] == METRIC_L2) {
-        obj.space = std::make_shared<hnswlib::L2Space>(params[PARAMETER_DIM]);
-    } else if (params[PARAMETER_METRIC_TYPE] == METRIC_IP) {
-        obj.space = std::make_shared<hnswlib::InnerProductSpace>(params[PARAMETER_DIM]);
-    } else if (params[PARAMETER_METRIC_TYPE] == METRIC_COSINE) {
-        obj.normalize = true;
-        obj.space = std::make_shared<hnswlib::InnerProductSpace>(params[PARAMETER_DIM]);
+    bool use_sq8 = params[INDEX_HNSW].contains(HNSW_PARAMETER_USE_SQ8) &&
+                   params[INDEX_HNSW][HNSW_PARAMETER_USE_SQ8];
+    // the vectors are always passed in as float32, the element type is how the graph stores them
+    std::string element_type = DATATYPE_FLOAT32;
+    if (params[INDEX_HNSW].contains(HNSW_PARAMETER_ELEMENT_TYPE)) {
+        element_type = params[INDEX_HNSW][HNSW_PARAMETER_ELEMENT_TYPE];
+    }
+    CHECK_ARGUMENT(element_type == DATATYPE_FLOAT32 or element_type == DATATYPE_FLOAT16 or
+                       element_type == DATATYPE_BFLOAT16 or element_type == DATATYPE_INT8,
+                   fmt::format("parameters[{}] must in [{}, {}, {}, {}], now is {}",
+                               HNSW_PARAMETER_ELEMENT_TYPE,
+                               DATATYPE_FLOAT32,
+                               DATATYPE_FLOAT16,
+                               DATATYPE_BFLOAT16,
+                               DATATYPE_INT8,
+                               element_type));
+    CHECK_ARGUMENT(not use_sq8 or element_type == DATATYPE_FLOAT32,
+                   fmt::format("{} cannot be used with {}({})",
+                               HNSW_PARAMETER_USE_SQ8,
+                               HNSW_PARAMETER_ELEMENT_TYPE,
+                               element_type));
+    obj.encode_vectors = use_sq8 or element_type != DATATYPE_FLOAT32;
+    if (params[PARAMETER_METRIC_TYPE] == METRIC_L2 or
+        params[PARAMETER_METRIC_TYPE] == METRIC_IP or
+        params[PARAMETER_METRIC_TYPE] == METRIC_COSINE) {
+        size_t dim = params[PARAMETER_DIM];
+        bool use_ip = params[PARAMETER_METRIC_TYPE] != METRIC_L2;
+        obj.normalize = params[PARAMETER_METRIC_TYPE] == METRIC_COSINE;
+        if (use_sq8) {
+            obj.space = std::make_shared<hnswlib::SQ8Space>(dim, use_ip);
+        } else if (element_type == DATATYPE_FLOAT16) {
+            obj.space = std::make_shared<hnswlib::FP16Space>(dim, use_ip);
+        } else if (element_type == DATATYPE_BFLOAT16) {
+            obj.space = std::make_shared<hnswlib::BF16Space>(dim, use_ip);
+        } else if (element_type == DATATYPE_INT8) {
+            obj.space = std::make_shared<hnswlib::INT8Space>(dim, use_ip);
+        } else if (use_ip) {
+            obj.space = std::make_shared<hnswlib::InnerProductSpace>(dim);
+        } else {
+            obj.space = std::make_shared<hnswlib::L2Space>(dim);
+        }
     } else {
         std::string metric = params[PARAMETER_METRIC_TYPE];
         throw std::invalid_argument(fmt::format("parameters[{}] must in [{}, {}, {}], now is {}",
@@ -87,6 +121,27 @@ CreateHnswParameters::FromJson(const std::string& json_string) {
     } else {
         obj.use_conjugate_graph = false;
     }
+
+    // the encoded graph keeps no float vectors, which the static graph and the conjugate
+    // graph both rely on
+    CHECK_ARGUMENT(not obj.encode_vectors or not obj.use_static,
+                   fmt::format("{}/{} cannot be used with {}",
+                               HNSW_PARAMETER_USE_SQ8,
+                               HNSW_PARAMETER_ELEMENT_TYPE,
+                               HNSW_PARAMETER_USE_STATIC));
+    CHECK_ARGUMENT(not obj.encode_vectors or not obj.use_conjugate_graph,
+                   fmt::format("{}/{} cannot be used with {}",
+                               HNSW_PARAMETER_USE_SQ8,
+                               HNSW_PARAMETER_ELEMENT_TYPE,
+                               PARAMETER_USE_CONJUGATE_GRAPH));
+
+    // set obj.build_thread_num
+    if (params[INDEX_HNSW].contains(HNSW_PARAMETER_BUILD_THREAD_NUM)) {
+        obj.build_thread_num = params[INDEX_HNSW][HNSW_PARAMETER_BUILD_THREAD_NUM];
+        CHECK_ARGUMENT(
+            (1 <= obj.build_thread_num) and (obj.build_thread_num <= 200),
+            fmt::format("build_thread_num({}) must in range[1, 200]", obj.build_thread_num));
+    }
     return obj;
 }
 
@@ -117,6 +172,19 @@ HnswSearchParameters::FromJson(const std::string& json_string) {
     return obj;
 }
 
+HnswSearchParameters
+HnswSearchParameters::FromParam(const SearchParam& param) {
+    HnswSearchParameters obj;
+
+    obj.ef_search = param.ef_search;
+    CHECK_ARGUMENT((1 <= obj.ef_search) and (obj.ef_search <= 1000),
+                   fmt::format("ef_search({}) must in range[1, 1000]", obj.ef_search));
+    obj.use_conjugate_graph_search = param.use_conjugate_graph_search;
+    obj.distance_bound = param.distance_bound;
+
+    return obj;
+}
+
 CreateFreshHnswParameters
 CreateFreshHnswParameters::FromJson(const std::string& json_string) {
     auto parrent_obj = CreateHnswParameters::FromJson(json_string);
@@ -127,6 +195,7 @@ CreateFreshHnswParameters::FromJson(const std::string& json_string) {
     obj.space = parrent_obj.space;
     obj.use_static = false;
     obj.normalize = parrent_obj.normalize;
+    obj.encode_vectors = parrent_obj.encode_vectors;
 
     // set obj.use_reversed_edges
     obj.use_reversed_edges = true;
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "../algorithm/hnswlib/hnswlib.h"
+#include "vsag/index.h"
 
 namespace vsag {
 
@@ -36,6 +37,11 @@ public:
     bool use_static;
     bool normalize = false;
 
+    // optional vars
+    int64_t build_thread_num = 1;
+    // the graph stores codes of the vectors (sq8 or a narrower element type) instead of float32
+    bool encode_vectors = false;
+
 protected:
     CreateHnswParameters() = default;
 };
@@ -58,11 +64,17 @@ public:
     static HnswSearchParameters
     FromJson(const std::string& json_string);
 
+    static HnswSearchParameters
+    FromParam(const SearchParam& param);
+
 public:
     // required vars
     int64_t ef_search;
     bool use_conjugate_graph_search;
 
+    // optional vars
+    const std::atomic<float>* distance_bound = nullptr;
+
 private:
     HnswSearchParameters() = default;
 };
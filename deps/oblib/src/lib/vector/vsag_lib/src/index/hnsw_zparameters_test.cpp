@@ -17,6 +17,7 @@
 #include "hnsw_zparameters.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
 
 TEST_CASE("create hnsw with invalid metric type", "[ut][hnsw]") {
     auto json_string = R"(
@@ -39,3 +40,31 @@ TEST_CASE("create hnsw with invalid metric type", "[ut][hnsw]") {
 
     REQUIRE_THROWS_AS(vsag::CreateHnswParameters::FromJson(json_string), std::invalid_argument);
 }
+
+TEST_CASE("create hnsw with element type", "[ut][hnsw]") {
+    auto make_json = [](const std::string& element_type, bool use_sq8) {
+        nlohmann::json params{{"dtype", "float32"},
+                              {"metric_type", "l2"},
+                              {"dim", 512},
+                              {"hnsw",
+                               {{"max_degree", 16},
+                                {"ef_construction", 100},
+                                {"element_type", element_type},
+                                {"use_sq8", use_sq8}}}};
+        return params.dump();
+    };
+
+    auto params = vsag::CreateHnswParameters::FromJson(make_json("float32", false));
+    REQUIRE_FALSE(params.encode_vectors);
+    params = vsag::CreateHnswParameters::FromJson(make_json("float16", false));
+    REQUIRE(params.encode_vectors);
+    REQUIRE(params.space->get_data_size() == 512 * sizeof(uint16_t));
+    params = vsag::CreateHnswParameters::FromJson(make_json("int8", false));
+    REQUIRE(params.encode_vectors);
+
+    // sq8 already picks how the vectors are stored
+    REQUIRE_THROWS_AS(vsag::CreateHnswParameters::FromJson(make_json("bfloat16", true)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(vsag::CreateHnswParameters::FromJson(make_json("float64", false)),
+                      std::invalid_argument);
+}
@@ -38,6 +38,18 @@ Options::logger() {
     return logger_;
 }
 
+Options::ParallelExecutor
+Options::parallel_executor() const {
+    std::lock_guard<std::mutex> lock(executor_mutex_);
+    return parallel_executor_;
+}
+
+void
+Options::set_parallel_executor(const ParallelExecutor& executor) {
+    std::lock_guard<std::mutex> lock(executor_mutex_);
+    parallel_executor_ = executor;
+}
+
 void
 Options::set_block_size_limit(size_t size) {
     if (size < 2 * 1024 * 1024) {
@@ -16,6 +16,8 @@
 
 #include <x86intrin.h>
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 
 namespace vsag {
@@ -156,4 +158,155 @@ PQDistanceAVXFloat256(const void* single_dim_centers, float single_dim_val, void
     }
 }
 
+#if defined(ENABLE_AVX2)
+static inline float
+ReduceAddAVX(__m256 sum) {
+    __m128 res = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    res = _mm_hadd_ps(res, res);
+    res = _mm_hadd_ps(res, res);
+    return _mm_cvtss_f32(res);
+}
+
+static inline int32_t
+ReduceAddAVX(__m256i sum) {
+    __m128i res = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    res = _mm_hadd_epi32(res, res);
+    res = _mm_hadd_epi32(res, res);
+    return _mm_cvtsi128_si32(res);
+}
+
+static inline __m256
+LoadFP16AVX(const uint16_t* codes) {
+    return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)codes));
+}
+
+static inline __m256
+LoadBF16AVX(const uint16_t* codes) {
+    __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)codes));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(x, 16));
+}
+
+static inline float
+BF16ToFloatAVX(uint16_t code) {
+    uint32_t x = (uint32_t)code << 16;
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+}
+
+float
+FP16L2SqrAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    size_t qty8 = qty >> 3 << 3;
+    __m256 sum = _mm256_setzero_ps();
+    for (size_t i = 0; i < qty8; i += 8) {
+        __m256 diff = _mm256_sub_ps(LoadFP16AVX(pVect1 + i), LoadFP16AVX(pVect2 + i));
+        sum = _mm256_fmadd_ps(diff, diff, sum);
+    }
+    float res = ReduceAddAVX(sum);
+    for (size_t i = qty8; i < qty; i++) {
+        float t = _cvtsh_ss(pVect1[i]) - _cvtsh_ss(pVect2[i]);
+        res += t * t;
+    }
+    return res;
+}
+
+float
+FP16InnerProductAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    size_t qty8 = qty >> 3 << 3;
+    __m256 sum = _mm256_setzero_ps();
+    for (size_t i = 0; i < qty8; i += 8) {
+        sum = _mm256_fmadd_ps(LoadFP16AVX(pVect1 + i), LoadFP16AVX(pVect2 + i), sum);
+    }
+    float res = ReduceAddAVX(sum);
+    for (size_t i = qty8; i < qty; i++) {
+        res += _cvtsh_ss(pVect1[i]) * _cvtsh_ss(pVect2[i]);
+    }
+    return res;
+}
+
+float
+BF16L2SqrAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    size_t qty8 = qty >> 3 << 3;
+    __m256 sum = _mm256_setzero_ps();
+    for (size_t i = 0; i < qty8; i += 8) {
+        __m256 diff = _mm256_sub_ps(LoadBF16AVX(pVect1 + i), LoadBF16AVX(pVect2 + i));
+        sum = _mm256_fmadd_ps(diff, diff, sum);
+    }
+    float res = ReduceAddAVX(sum);
+    for (size_t i = qty8; i < qty; i++) {
+        float t = BF16ToFloatAVX(pVect1[i]) - BF16ToFloatAVX(pVect2[i]);
+        res += t * t;
+    }
+    return res;
+}
+
+float
+BF16InnerProductAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    size_t qty8 = qty >> 3 << 3;
+    __m256 sum = _mm256_setzero_ps();
+    for (size_t i = 0; i < qty8; i += 8) {
+        sum = _mm256_fmadd_ps(LoadBF16AVX(pVect1 + i), LoadBF16AVX(pVect2 + i), sum);
+    }
+    float res = ReduceAddAVX(sum);
+    for (size_t i = qty8; i < qty; i++) {
+        res += BF16ToFloatAVX(pVect1[i]) * BF16ToFloatAVX(pVect2[i]);
+    }
+    return res;
+}
+
+// the codes are widened to int16, and madd sums the products of each pair of lanes into int32
+void
+INT8L2SumsAVX(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums) {
+    size_t qty16 = qty >> 4 << 4;
+    __m256i norm1 = _mm256_setzero_si256();
+    __m256i norm2 = _mm256_setzero_si256();
+    __m256i dot = _mm256_setzero_si256();
+    for (size_t i = 0; i < qty16; i += 16) {
+        __m256i c1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(codes1 + i)));
+        __m256i c2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(codes2 + i)));
+        norm1 = _mm256_add_epi32(norm1, _mm256_madd_epi16(c1, c1));
+        norm2 = _mm256_add_epi32(norm2, _mm256_madd_epi16(c2, c2));
+        dot = _mm256_add_epi32(dot, _mm256_madd_epi16(c1, c2));
+    }
+    sums[0] = ReduceAddAVX(norm1);
+    sums[1] = ReduceAddAVX(norm2);
+    sums[2] = ReduceAddAVX(dot);
+    for (size_t i = qty16; i < qty; i++) {
+        int32_t c1 = codes1[i];
+        int32_t c2 = codes2[i];
+        sums[0] += c1 * c1;
+        sums[1] += c2 * c2;
+        sums[2] += c1 * c2;
+    }
+}
+
+int32_t
+INT8InnerProductAVX(const int8_t* codes1, const int8_t* codes2, size_t qty) {
+    size_t qty16 = qty >> 4 << 4;
+    __m256i dot = _mm256_setzero_si256();
+    for (size_t i = 0; i < qty16; i += 16) {
+        __m256i c1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(codes1 + i)));
+        __m256i c2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(codes2 + i)));
+        dot = _mm256_add_epi32(dot, _mm256_madd_epi16(c1, c2));
+    }
+    int32_t res = ReduceAddAVX(dot);
+    for (size_t i = qty16; i < qty; i++) {
+        res += (int32_t)codes1[i] * codes2[i];
+    }
+    return res;
+}
+#endif
+
 }  // namespace vsag
@@ -16,6 +16,7 @@
 
 #include <x86intrin.h>
 
+#include <cstdint>
 #include <iostream>
 
 namespace vsag {
@@ -85,4 +86,167 @@ InnerProductSIMD16ExtAVX512(const void* pVect1v, const void* pVect2v, const void
     return sum;
 }
 
+static inline __m512
+LoadFP16AVX512(const uint16_t* codes, __mmask16 mask) {
+    return _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mask, codes));
+}
+
+static inline __m512
+LoadBF16AVX512(const uint16_t* codes, __mmask16 mask) {
+    __m512i x = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, codes));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(x, 16));
+}
+
+// the tail is loaded by a mask, the masked lanes are zeros and add nothing to the sums
+static inline __mmask16
+TailMask16(size_t rest) {
+    return rest >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << rest) - 1);
+}
+
+static inline __mmask32
+TailMask32(size_t rest) {
+    return rest >= 32 ? (__mmask32)0xffffffff : (__mmask32)((1u << rest) - 1);
+}
+
+static inline __mmask64
+TailMask64(size_t rest) {
+    return rest >= 64 ? (__mmask64)-1 : (__mmask64)((1ull << rest) - 1);
+}
+
+float
+FP16L2SqrAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    __m512 sum = _mm512_setzero_ps();
+    for (size_t i = 0; i < qty; i += 16) {
+        __mmask16 mask = TailMask16(qty - i);
+        __m512 diff =
+            _mm512_sub_ps(LoadFP16AVX512(pVect1 + i, mask), LoadFP16AVX512(pVect2 + i, mask));
+        sum = _mm512_fmadd_ps(diff, diff, sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+float
+FP16InnerProductAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    __m512 sum = _mm512_setzero_ps();
+    for (size_t i = 0; i < qty; i += 16) {
+        __mmask16 mask = TailMask16(qty - i);
+        sum = _mm512_fmadd_ps(
+            LoadFP16AVX512(pVect1 + i, mask), LoadFP16AVX512(pVect2 + i, mask), sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+float
+BF16L2SqrAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    __m512 sum = _mm512_setzero_ps();
+    for (size_t i = 0; i < qty; i += 16) {
+        __mmask16 mask = TailMask16(qty - i);
+        __m512 diff =
+            _mm512_sub_ps(LoadBF16AVX512(pVect1 + i, mask), LoadBF16AVX512(pVect2 + i, mask));
+        sum = _mm512_fmadd_ps(diff, diff, sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+float
+BF16InnerProductAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    __m512 sum = _mm512_setzero_ps();
+    for (size_t i = 0; i < qty; i += 16) {
+        __mmask16 mask = TailMask16(qty - i);
+        sum = _mm512_fmadd_ps(
+            LoadBF16AVX512(pVect1 + i, mask), LoadBF16AVX512(pVect2 + i, mask), sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+// the codes are widened to int16, and madd sums the products of each pair of lanes into int32
+void
+INT8L2SumsAVX512(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums) {
+    __m512i norm1 = _mm512_setzero_si512();
+    __m512i norm2 = _mm512_setzero_si512();
+    __m512i dot = _mm512_setzero_si512();
+    for (size_t i = 0; i < qty; i += 32) {
+        __mmask32 mask = TailMask32(qty - i);
+        __m512i c1 = _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(mask, codes1 + i));
+        __m512i c2 = _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(mask, codes2 + i));
+        norm1 = _mm512_add_epi32(norm1, _mm512_madd_epi16(c1, c1));
+        norm2 = _mm512_add_epi32(norm2, _mm512_madd_epi16(c2, c2));
+        dot = _mm512_add_epi32(dot, _mm512_madd_epi16(c1, c2));
+    }
+    sums[0] = _mm512_reduce_add_epi32(norm1);
+    sums[1] = _mm512_reduce_add_epi32(norm2);
+    sums[2] = _mm512_reduce_add_epi32(dot);
+}
+
+int32_t
+INT8InnerProductAVX512(const int8_t* codes1, const int8_t* codes2, size_t qty) {
+    __m512i dot = _mm512_setzero_si512();
+    for (size_t i = 0; i < qty; i += 32) {
+        __mmask32 mask = TailMask32(qty - i);
+        __m512i c1 = _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(mask, codes1 + i));
+        __m512i c2 = _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(mask, codes2 + i));
+        dot = _mm512_add_epi32(dot, _mm512_madd_epi16(c1, c2));
+    }
+    return _mm512_reduce_add_epi32(dot);
+}
+
+// vpdpbusd multiplies unsigned by signed bytes, so the first codes are offset by 128:
+// <c1, c2> = <c1 + 128, c2> - 128 * sum(c2). the sums of 4 products are at most
+// 4 * 255 * 128, so the int32 lanes never overflow
+__attribute__((target("avx512vnni"))) void
+INT8L2SumsAVX512VNNI(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums) {
+    const __m512i offset = _mm512_set1_epi8((char)0x80);
+    const __m512i ones = _mm512_set1_epi8(1);
+    __m512i norm1 = _mm512_setzero_si512();
+    __m512i norm2 = _mm512_setzero_si512();
+    __m512i dot = _mm512_setzero_si512();
+    __m512i sum1 = _mm512_setzero_si512();
+    __m512i sum2 = _mm512_setzero_si512();
+    for (size_t i = 0; i < qty; i += 64) {
+        __mmask64 mask = TailMask64(qty - i);
+        __m512i c1 = _mm512_maskz_loadu_epi8(mask, codes1 + i);
+        __m512i c2 = _mm512_maskz_loadu_epi8(mask, codes2 + i);
+        __m512i u1 = _mm512_xor_si512(c1, offset);
+        __m512i u2 = _mm512_xor_si512(c2, offset);
+        norm1 = _mm512_dpbusd_epi32(norm1, u1, c1);
+        norm2 = _mm512_dpbusd_epi32(norm2, u2, c2);
+        dot = _mm512_dpbusd_epi32(dot, u1, c2);
+        sum1 = _mm512_dpbusd_epi32(sum1, ones, c1);
+        sum2 = _mm512_dpbusd_epi32(sum2, ones, c2);
+    }
+    int32_t total1 = _mm512_reduce_add_epi32(sum1);
+    int32_t total2 = _mm512_reduce_add_epi32(sum2);
+    sums[0] = _mm512_reduce_add_epi32(norm1) - 128 * total1;
+    sums[1] = _mm512_reduce_add_epi32(norm2) - 128 * total2;
+    sums[2] = _mm512_reduce_add_epi32(dot) - 128 * total2;
+}
+
+__attribute__((target("avx512vnni"))) int32_t
+INT8InnerProductAVX512VNNI(const int8_t* codes1, const int8_t* codes2, size_t qty) {
+    const __m512i offset = _mm512_set1_epi8((char)0x80);
+    const __m512i ones = _mm512_set1_epi8(1);
+    __m512i dot = _mm512_setzero_si512();
+    __m512i sum2 = _mm512_setzero_si512();
+    for (size_t i = 0; i < qty; i += 64) {
+        __mmask64 mask = TailMask64(qty - i);
+        __m512i c1 = _mm512_maskz_loadu_epi8(mask, codes1 + i);
+        __m512i c2 = _mm512_maskz_loadu_epi8(mask, codes2 + i);
+        dot = _mm512_dpbusd_epi32(dot, _mm512_xor_si512(c1, offset), c2);
+        sum2 = _mm512_dpbusd_epi32(sum2, ones, c2);
+    }
+    return _mm512_reduce_add_epi32(dot) - 128 * _mm512_reduce_add_epi32(sum2);
+}
+
 }  // namespace vsag
@@ -14,6 +14,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 
 namespace vsag {
@@ -60,4 +63,108 @@ PQDistanceFloat256(const void* single_dim_centers, float single_dim_val, void* r
     }
 }
 
+static float
+FP16ToFloat(uint16_t code) {
+    uint32_t sign = (uint32_t)(code & 0x8000) << 16;
+    uint32_t exp = (code >> 10) & 0x1f;
+    uint32_t mant = code & 0x3ff;
+    uint32_t x;
+    if (exp == 0) {
+        float value = std::ldexp((float)mant, -24);
+        memcpy(&x, &value, sizeof(x));
+        x |= sign;
+    } else if (exp == 0x1f) {
+        x = sign | 0x7f800000 | (mant << 13);
+    } else {
+        x = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+}
+
+static float
+BF16ToFloat(uint16_t code) {
+    uint32_t x = (uint32_t)code << 16;
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+}
+
+float
+FP16L2Sqr(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    float res = 0;
+    for (size_t i = 0; i < qty; i++) {
+        float t = FP16ToFloat(pVect1[i]) - FP16ToFloat(pVect2[i]);
+        res += t * t;
+    }
+    return res;
+}
+
+float
+FP16InnerProduct(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    float res = 0;
+    for (size_t i = 0; i < qty; i++) {
+        res += FP16ToFloat(pVect1[i]) * FP16ToFloat(pVect2[i]);
+    }
+    return res;
+}
+
+float
+BF16L2Sqr(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    float res = 0;
+    for (size_t i = 0; i < qty; i++) {
+        float t = BF16ToFloat(pVect1[i]) - BF16ToFloat(pVect2[i]);
+        res += t * t;
+    }
+    return res;
+}
+
+float
+BF16InnerProduct(const void* pVect1v, const void* pVect2v, const void* qty_ptr) {
+    const auto* pVect1 = (const uint16_t*)pVect1v;
+    const auto* pVect2 = (const uint16_t*)pVect2v;
+    size_t qty = *((size_t*)qty_ptr);
+    float res = 0;
+    for (size_t i = 0; i < qty; i++) {
+        res += BF16ToFloat(pVect1[i]) * BF16ToFloat(pVect2[i]);
+    }
+    return res;
+}
+
+void
+INT8L2Sums(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums) {
+    int32_t norm1 = 0;
+    int32_t norm2 = 0;
+    int32_t dot = 0;
+    for (size_t i = 0; i < qty; i++) {
+        int32_t c1 = codes1[i];
+        int32_t c2 = codes2[i];
+        norm1 += c1 * c1;
+        norm2 += c2 * c2;
+        dot += c1 * c2;
+    }
+    sums[0] = norm1;
+    sums[1] = norm2;
+    sums[2] = dot;
+}
+
+int32_t
+INT8InnerProduct(const int8_t* codes1, const int8_t* codes2, size_t qty) {
+    int32_t dot = 0;
+    for (size_t i = 0; i < qty; i++) {
+        dot += (int32_t)codes1[i] * codes2[i];
+    }
+    return dot;
+}
+
 }  // namespace vsag
@@ -33,6 +33,13 @@ float (*InnerProductDistanceSIMD16ExtResiduals)(const void*, const void*, const
 float (*InnerProductDistanceSIMD4Ext)(const void*, const void*, const void*);
 float (*InnerProductDistanceSIMD4ExtResiduals)(const void*, const void*, const void*);
 
+float (*FP16L2SqrSIMD)(const void*, const void*, const void*) = FP16L2Sqr;
+float (*FP16InnerProductSIMD)(const void*, const void*, const void*) = FP16InnerProduct;
+float (*BF16L2SqrSIMD)(const void*, const void*, const void*) = BF16L2Sqr;
+float (*BF16InnerProductSIMD)(const void*, const void*, const void*) = BF16InnerProduct;
+void (*INT8L2SumsSIMD)(const int8_t*, const int8_t*, size_t, int32_t*) = INT8L2Sums;
+int32_t (*INT8InnerProductSIMD)(const int8_t*, const int8_t*, size_t) = INT8InnerProduct;
+
 SimdStatus
 setup_simd() {
     L2SqrSIMD16Ext = L2Sqr;
@@ -47,6 +54,13 @@ setup_simd() {
     InnerProductDistanceSIMD4Ext = InnerProductDistance;
     InnerProductDistanceSIMD4ExtResiduals = InnerProductDistance;
 
+    FP16L2SqrSIMD = FP16L2Sqr;
+    FP16InnerProductSIMD = FP16InnerProduct;
+    BF16L2SqrSIMD = BF16L2Sqr;
+    BF16InnerProductSIMD = BF16InnerProduct;
+    INT8L2SumsSIMD = INT8L2Sums;
+    INT8InnerProductSIMD = INT8InnerProduct;
+
     SimdStatus ret;
 
     if (cpuinfo_has_x86_sse()) {
@@ -86,6 +100,15 @@ setup_simd() {
 #ifndef ENABLE_AVX2
     }
 #else
+        // the avx2 kernels also convert float16 by f16c and accumulate by fma
+        if (cpuinfo_has_x86_fma3() && cpuinfo_has_x86_f16c()) {
+            FP16L2SqrSIMD = FP16L2SqrAVX;
+            FP16InnerProductSIMD = FP16InnerProductAVX;
+            BF16L2SqrSIMD = BF16L2SqrAVX;
+            BF16InnerProductSIMD = BF16InnerProductAVX;
+            INT8L2SumsSIMD = INT8L2SumsAVX;
+            INT8InnerProductSIMD = INT8InnerProductAVX;
+        }
     }
     ret.dist_support_avx2 = true;
 #endif
@@ -101,6 +124,16 @@ setup_simd() {
 #else
         L2SqrSIMD16Ext = L2SqrSIMD16ExtAVX512;
         InnerProductSIMD16Ext = InnerProductSIMD16ExtAVX512;
+        FP16L2SqrSIMD = FP16L2SqrAVX512;
+        FP16InnerProductSIMD = FP16InnerProductAVX512;
+        BF16L2SqrSIMD = BF16L2SqrAVX512;
+        BF16InnerProductSIMD = BF16InnerProductAVX512;
+        INT8L2SumsSIMD = INT8L2SumsAVX512;
+        INT8InnerProductSIMD = INT8InnerProductAVX512;
+        if (cpuinfo_has_x86_avx512vnni()) {
+            INT8L2SumsSIMD = INT8L2SumsAVX512VNNI;
+            INT8InnerProductSIMD = INT8InnerProductAVX512VNNI;
+        }
     }
     ret.dist_support_avx512f = true;
     ret.dist_support_avx512dq = true;
@@ -126,6 +159,46 @@ GetInnerProductDistanceFunc(size_t dim) {
     }
 }
 
+static float
+FP16InnerProductDistance(const void* pVect1, const void* pVect2, const void* qty_ptr) {
+    return 1.0f - FP16InnerProductSIMD(pVect1, pVect2, qty_ptr);
+}
+
+static float
+BF16InnerProductDistance(const void* pVect1, const void* pVect2, const void* qty_ptr) {
+    return 1.0f - BF16InnerProductSIMD(pVect1, pVect2, qty_ptr);
+}
+
+DistanceFunc
+GetFP16L2DistanceFunc() {
+    return FP16L2SqrSIMD;
+}
+
+DistanceFunc
+GetFP16InnerProductDistanceFunc() {
+    return FP16InnerProductDistance;
+}
+
+DistanceFunc
+GetBF16L2DistanceFunc() {
+    return BF16L2SqrSIMD;
+}
+
+DistanceFunc
+GetBF16InnerProductDistanceFunc() {
+    return BF16InnerProductDistance;
+}
+
+void
+INT8ComputeL2Sums(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums) {
+    INT8L2SumsSIMD(codes1, codes2, qty, sums);
+}
+
+int32_t
+INT8ComputeInnerProduct(const int8_t* codes1, const int8_t* codes2, size_t qty) {
+    return INT8InnerProductSIMD(codes1, codes2, qty);
+}
+
 PQDistanceFunc
 GetPQDistanceFunc() {
 #ifdef ENABLE_AVX
@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #include <string>
@@ -103,6 +104,21 @@ InnerProductDistance(const void* pVect1, const void* pVect2, const void* qty_ptr
 void
 PQDistanceFloat256(const void* single_dim_centers, float single_dim_val, void* result);
 
+// the kernels on the codes of hnswlib/space_fp16.h and hnswlib/space_int8.h
+float
+FP16L2Sqr(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+FP16InnerProduct(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+BF16L2Sqr(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+BF16InnerProduct(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+// sums[0] = <codes1, codes1>, sums[1] = <codes2, codes2>, sums[2] = <codes1, codes2>
+void
+INT8L2Sums(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums);
+int32_t
+INT8InnerProduct(const int8_t* codes1, const int8_t* codes2, size_t qty);
+
 #if defined(ENABLE_SSE)
 float
 L2SqrSIMD16ExtSSE(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
@@ -144,11 +160,42 @@ void
 PQDistanceAVXFloat256(const void* single_dim_centers, float single_dim_val, void* result);
 #endif
 
+#if defined(ENABLE_AVX2)
+float
+FP16L2SqrAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+FP16InnerProductAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+BF16L2SqrAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+BF16InnerProductAVX(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+void
+INT8L2SumsAVX(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums);
+int32_t
+INT8InnerProductAVX(const int8_t* codes1, const int8_t* codes2, size_t qty);
+#endif
+
 #if defined(ENABLE_AVX512)
 float
 L2SqrSIMD16ExtAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
 float
 InnerProductSIMD16ExtAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+FP16L2SqrAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+FP16InnerProductAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+BF16L2SqrAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+float
+BF16InnerProductAVX512(const void* pVect1v, const void* pVect2v, const void* qty_ptr);
+void
+INT8L2SumsAVX512(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums);
+int32_t
+INT8InnerProductAVX512(const int8_t* codes1, const int8_t* codes2, size_t qty);
+void
+INT8L2SumsAVX512VNNI(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums);
+int32_t
+INT8InnerProductAVX512VNNI(const int8_t* codes1, const int8_t* codes2, size_t qty);
 #endif
 
 typedef float (*DistanceFunc)(const void* pVect1, const void* pVect2, const void* qty_ptr);
@@ -157,6 +204,21 @@ GetL2DistanceFunc(size_t dim);
 DistanceFunc
 GetInnerProductDistanceFunc(size_t dim);
 
+DistanceFunc
+GetFP16L2DistanceFunc();
+DistanceFunc
+GetFP16InnerProductDistanceFunc();
+DistanceFunc
+GetBF16L2DistanceFunc();
+DistanceFunc
+GetBF16InnerProductDistanceFunc();
+
+// dispatched to the kernel of the widest instruction set of the cpu
+void
+INT8ComputeL2Sums(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums);
+int32_t
+INT8ComputeInnerProduct(const int8_t* codes1, const int8_t* codes2, size_t qty);
+
 typedef void (*PQDistanceFunc)(const void* single_dim_centers, float single_dim_val, void* result);
 
 PQDistanceFunc
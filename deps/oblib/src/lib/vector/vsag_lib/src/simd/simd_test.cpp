@@ -17,6 +17,7 @@
 #include <cpuinfo.h>
 
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
 #include <iostream>
 #include <random>
 
@@ -29,6 +30,18 @@ extern DistanceFunc
 GetInnerProductDistanceFunc(size_t dim);
 extern DistanceFunc
 GetL2DistanceFunc(size_t dim);
+extern DistanceFunc
+GetFP16L2DistanceFunc();
+extern DistanceFunc
+GetFP16InnerProductDistanceFunc();
+extern DistanceFunc
+GetBF16L2DistanceFunc();
+extern DistanceFunc
+GetBF16InnerProductDistanceFunc();
+extern void
+INT8ComputeL2Sums(const int8_t* codes1, const int8_t* codes2, size_t qty, int32_t* sums);
+extern int32_t
+INT8ComputeInnerProduct(const int8_t* codes1, const int8_t* codes2, size_t qty);
 
 }  // namespace vsag
 
@@ -93,3 +106,76 @@ TEST_CASE("test l2 instructions", "[ut][simd]") {
         REQUIRE(equal);
     }
 }
+
+float
+HalfToFloat(uint16_t code, bool bf16) {
+    uint32_t x;
+    if (bf16) {
+        x = (uint32_t)code << 16;
+    } else {
+        // the codes are normal numbers
+        x = ((uint32_t)(code & 0x8000) << 16) | ((((code >> 10) & 0x1f) + 112) << 23) |
+            ((uint32_t)(code & 0x3ff) << 13);
+    }
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+}
+
+TEST_CASE("test half float instructions", "[ut][simd]") {
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_int_distribution<uint32_t> distrib_bits;
+    for (bool bf16 : {false, true}) {
+        auto l2_func = bf16 ? vsag::GetBF16L2DistanceFunc() : vsag::GetFP16L2DistanceFunc();
+        auto ip_func = bf16 ? vsag::GetBF16InnerProductDistanceFunc()
+                            : vsag::GetFP16InnerProductDistanceFunc();
+        for (size_t dim = 1; dim < 1026; dim++) {
+            uint16_t codes1[dim];
+            uint16_t codes2[dim];
+            for (int j = 0; j < dim; j++) {
+                // the values are within (-1, 1)
+                uint32_t bits = distrib_bits(rng);
+                codes1[j] = bf16 ? (bits & 0x807f) | ((bits >> 16) % 8 + 119) << 7
+                                 : (bits & 0x83ff) | ((bits >> 16) % 14 + 1) << 10;
+                bits = distrib_bits(rng);
+                codes2[j] = bf16 ? (bits & 0x807f) | ((bits >> 16) % 8 + 119) << 7
+                                 : (bits & 0x83ff) | ((bits >> 16) % 14 + 1) << 10;
+            }
+            float l2 = 0;
+            float ip = 0;
+            for (int j = 0; j < dim; j++) {
+                float t = HalfToFloat(codes1[j], bf16) - HalfToFloat(codes2[j], bf16);
+                l2 += t * t;
+                ip += HalfToFloat(codes1[j], bf16) * HalfToFloat(codes2[j], bf16);
+            }
+            REQUIRE(std::abs(l2 - l2_func(codes1, codes2, &dim)) < 0.001);
+            REQUIRE(std::abs(1 - ip - ip_func(codes1, codes2, &dim)) < 0.001);
+        }
+    }
+}
+
+TEST_CASE("test int8 instructions", "[ut][simd]") {
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_int_distribution<int> distrib_int(-127, 127);
+    for (size_t dim = 1; dim < 1026; dim++) {
+        int8_t codes1[dim];
+        int8_t codes2[dim];
+        int32_t expected[3] = {0, 0, 0};
+        for (int j = 0; j < dim; j++) {
+            codes1[j] = distrib_int(rng);
+            codes2[j] = distrib_int(rng);
+            expected[0] += codes1[j] * codes1[j];
+            expected[1] += codes2[j] * codes2[j];
+            expected[2] += codes1[j] * codes2[j];
+        }
+        // the integer sums are exact
+        int32_t sums[3];
+        vsag::INT8ComputeL2Sums(codes1, codes2, dim, sums);
+        REQUIRE(sums[0] == expected[0]);
+        REQUIRE(sums[1] == expected[1]);
+        REQUIRE(sums[2] == expected[2]);
+        REQUIRE(vsag::INT8ComputeInnerProduct(codes1, codes2, dim) == expected[2]);
+    }
+}
@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "lib/ob_define.h"
+#include "lib/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <signal.h>
+#define private public
+#include "env/ob_simple_log_cluster_env.h"
+#include "logservice/palf/log_define.h"
+#include "logservice/palf/log_io_task.h"
+#include "logservice/palf/log_io_worker.h"
+#include "logservice/palf/log_io_worker_wrapper.h"
+#include "logservice/palf/lsn.h"
+#undef private
+
+const std::string TEST_NAME = "log_io_worker";
+
+using namespace oceanbase::common;
+using namespace oceanbase;
+namespace oceanbase
+{
+using namespace logservice;
+using namespace palf;
+namespace unittest
+{
+class TestObSimpleLogClusterIOWorker : public ObSimpleLogClusterTestEnv
+{
+public:
+  TestObSimpleLogClusterIOWorker() : ObSimpleLogClusterTestEnv()
+  {}
+  // insert 'count' LogIOFlushLogTasks of different palf instances which don't exist,
+  // so writing each of them fails.
+  int insert_invalid_flush_tasks(ObILogAllocator *allocator, LogIOWorker *iow, const int64_t count)
+  {
+    int ret = OB_SUCCESS;
+    for (int64_t i = 0; i < count && OB_SUCC(ret); i++) {
+      const int64_t invalid_palf_id = ATOMIC_AAF(&palf_id_, 1);
+      LogIOFlushLogTask *io_task = allocator->alloc_log_io_flush_log_task(invalid_palf_id, 0);
+      if (OB_ISNULL(io_task)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        PALF_LOG(ERROR, "alloc_log_io_flush_log_task failed", K(ret), K(invalid_palf_id));
+      } else if (OB_FAIL(iow->batch_io_task_mgr_.insert(io_task))) {
+        PALF_LOG(ERROR, "insert failed", K(ret), K(invalid_palf_id));
+        allocator->free_log_io_flush_log_task(io_task);
+      }
+    }
+    return ret;
+  }
+};
+
+int64_t ObSimpleLogClusterTestBase::member_cnt_ = 1;
+int64_t ObSimpleLogClusterTestBase::node_cnt_ = 1;
+std::string ObSimpleLogClusterTestBase::test_name_ = TEST_NAME;
+bool ObSimpleLogClusterTestBase::need_add_arb_server_  = false;
+bool ObSimpleLogClusterTestBase::need_shared_storage_ = false;
+
+// several log streams of one LogIOWorker are written concurrently, and the logs of each
+// log stream are still flushed in order.
+TEST_F(TestObSimpleLogClusterIOWorker, concurrent_flush)
+{
+  SET_CASE_LOG_FILE(TEST_NAME, "concurrent_flush");
+  OB_LOGGER.set_log_level("TRACE");
+  const int64_t MAX_PALF_NUM = 16;
+  const int64_t STREAM_NUM = 3;
+  int64_t leader_idx = 0;
+  int64_t ids[MAX_PALF_NUM];
+  PalfHandleImplGuard leaders[MAX_PALF_NUM];
+  int64_t stream_idx[STREAM_NUM];
+  int64_t stream_count = 0;
+  int64_t palf_count = 0;
+  LogIOWorker *iow = NULL;
+  // palf instances are hashed to the LogIOWorkers, keep the ones sharing the first LogIOWorker
+  while (stream_count < STREAM_NUM && palf_count < MAX_PALF_NUM) {
+    ids[palf_count] = ATOMIC_AAF(&palf_id_, 1);
+    EXPECT_EQ(OB_SUCCESS, create_paxos_group(ids[palf_count], leader_idx, leaders[palf_count]));
+    LogIOWorker *curr_iow = leaders[palf_count].palf_handle_impl_->log_engine_.log_io_worker_;
+    if (NULL == iow) {
+      iow = curr_iow;
+    }
+    if (iow == curr_iow) {
+      stream_idx[stream_count++] = palf_count;
+    }
+    palf_count++;
+  }
+  ASSERT_EQ(STREAM_NUM, stream_count);
+  // the tenant of mittest is a user tenant, its LogIOWorkers have flush threads
+  ASSERT_LT(1, iow->batch_io_task_mgr_.get_io_depth());
+  EXPECT_EQ(iow->batch_io_task_mgr_.get_io_depth(), iow->get_thread_count());
+
+  PalfHandleImplGuard &first_leader = leaders[stream_idx[0]];
+  IOTaskCond io_task_cond(ids[stream_idx[0]], first_leader.palf_handle_impl_->log_engine_.palf_epoch_);
+  for (int64_t round = 0; round < 3; round++) {
+    LSN max_lsns[STREAM_NUM];
+    LSN prev_flushed_lsns[STREAM_NUM];
+    // block the LogIOWorker, the logs of all streams are written in the same round
+    EXPECT_EQ(OB_SUCCESS, iow->submit_io_task(&io_task_cond));
+    for (int64_t i = 0; i < STREAM_NUM; i++) {
+      PalfHandleImplGuard &leader = leaders[stream_idx[i]];
+      EXPECT_EQ(OB_SUCCESS, submit_log(leader, 64, ids[stream_idx[i]], 4 * 1024));
+      max_lsns[i] = leader.palf_handle_impl_->sw_.get_max_lsn();
+      prev_flushed_lsns[i] = leader.palf_handle_impl_->sw_.max_flushed_end_lsn_;
+    }
+    io_task_cond.cond_.signal();
+    // the flushed end lsn of each stream never moves backward
+    bool all_flushed = false;
+    while (false == all_flushed) {
+      all_flushed = true;
+      for (int64_t i = 0; i < STREAM_NUM; i++) {
+        PalfHandleImplGuard &leader = leaders[stream_idx[i]];
+        const LSN flushed_lsn = leader.palf_handle_impl_->sw_.max_flushed_end_lsn_;
+        EXPECT_LE(prev_flushed_lsns[i], flushed_lsn);
+        prev_flushed_lsns[i] = flushed_lsn;
+        all_flushed = all_flushed && flushed_lsn >= max_lsns[i];
+      }
+      usleep(1000);
+    }
+    for (int64_t i = 0; i < STREAM_NUM; i++) {
+      PalfHandleImplGuard &leader = leaders[stream_idx[i]];
+      EXPECT_EQ(max_lsns[i], leader.palf_handle_impl_->log_engine_.get_log_storage()->get_end_lsn());
+      EXPECT_EQ(OB_ITER_END, read_log(leader));
+    }
+    EXPECT_EQ(0, ATOMIC_LOAD(&iow->batch_io_task_mgr_.dispatched_count_));
+  }
+  PALF_LOG(INFO, "end test concurrent_flush", K(palf_count), K(stream_count));
+}
+
+// the failure of a dispatched BatchLogIOFlushLogTask is returned by the round.
+TEST_F(TestObSimpleLogClusterIOWorker, dispatched_task_failed)
+{
+  SET_CASE_LOG_FILE(TEST_NAME, "dispatched_task_failed");
+  OB_LOGGER.set_log_level("TRACE");
+  int64_t id = ATOMIC_AAF(&palf_id_, 1);
+  int64_t leader_idx = 0;
+  PalfHandleImplGuard leader;
+  EXPECT_EQ(OB_SUCCESS, create_paxos_group(id, leader_idx, leader));
+  LogIOWorker *iow = leader.palf_handle_impl_->log_engine_.log_io_worker_;
+  ObILogAllocator *allocator = leader.palf_env_impl_->get_log_allocator();
+  const int64_t io_depth = iow->batch_io_task_mgr_.get_io_depth();
+  ASSERT_LT(1, io_depth);
+
+  IOTaskCond io_task_cond(id, leader.palf_handle_impl_->log_engine_.palf_epoch_);
+  // block the first thread of LogIOWorker, the round is handled by this thread instead, and
+  // the dispatched tasks are written by the flush threads.
+  EXPECT_EQ(OB_SUCCESS, iow->submit_io_task(&io_task_cond));
+  sleep(1);
+  const int64_t flying_log_task = ATOMIC_LOAD(&allocator->flying_log_task_);
+  EXPECT_EQ(OB_SUCCESS, insert_invalid_flush_tasks(allocator, iow, io_depth));
+  const int ret = iow->batch_io_task_mgr_.handle(iow->cb_thread_pool_tg_id_, iow->palf_env_impl_);
+  EXPECT_NE(OB_SUCCESS, ret);
+  EXPECT_EQ(ret, iow->batch_io_task_mgr_.handle_ret_);
+  EXPECT_EQ(0, ATOMIC_LOAD(&iow->batch_io_task_mgr_.dispatched_count_));
+  EXPECT_TRUE(iow->batch_io_task_mgr_.empty());
+  // the LogIOFlushLogTasks of the failed tasks have been freed
+  EXPECT_EQ(flying_log_task, ATOMIC_LOAD(&allocator->flying_log_task_));
+  io_task_cond.cond_.signal();
+
+  // the next round is not affected by the failed one
+  EXPECT_EQ(OB_SUCCESS, submit_log(leader, 32, id, 1024));
+  const LSN max_lsn = leader.palf_handle_impl_->sw_.get_max_lsn();
+  wait_lsn_until_flushed(max_lsn, leader);
+  EXPECT_EQ(OB_ITER_END, read_log(leader));
+  EXPECT_EQ(OB_SUCCESS, iow->batch_io_task_mgr_.handle_ret_);
+  PALF_LOG(INFO, "end test dispatched_task_failed", K(id));
+}
+
+// the flush threads exit on stop, and the tasks dispatched after that are written by the
+// LogIOWorker itself.
+TEST_F(TestObSimpleLogClusterIOWorker, stop_flush_threads)
+{
+  SET_CASE_LOG_FILE(TEST_NAME, "stop_flush_threads");
+  OB_LOGGER.set_log_level("TRACE");
+  int64_t id = ATOMIC_AAF(&palf_id_, 1);
+  int64_t leader_idx = 0;
+  PalfHandleImplGuard leader;
+  EXPECT_EQ(OB_SUCCESS, create_paxos_group(id, leader_idx, leader));
+  ObTenantEnv::set_tenant(get_cluster()[leader_idx]->get_tenant_base());
+  PalfEnvImpl *palf_env_impl = leader.palf_env_impl_;
+  ObILogAllocator *allocator = palf_env_impl->get_log_allocator();
+
+  const int64_t io_depth = 4;
+  LogIOWorkerConfig config;
+  config.io_worker_num_ = 1;
+  config.io_queue_capcity_ = 1024;
+  config.batch_width_ = io_depth;
+  config.batch_depth_ = PALF_SLIDING_WINDOW_SIZE;
+  config.io_depth_ = io_depth;
+  LogIOWorker iow;
+  EXPECT_EQ(OB_SUCCESS, iow.init(config, palf_env_impl->get_tenant_id(),
+                                 palf_env_impl->cb_thread_pool_.get_tg_id(), allocator,
+                                 &palf_env_impl->log_io_worker_wrapper_.throttle_, true, palf_env_impl));
+  EXPECT_EQ(io_depth, iow.get_thread_count());
+  EXPECT_EQ(OB_SUCCESS, iow.start());
+
+  // the flush threads are running
+  const int64_t flying_log_task = ATOMIC_LOAD(&allocator->flying_log_task_);
+  EXPECT_EQ(OB_SUCCESS, insert_invalid_flush_tasks(allocator, &iow, io_depth));
+  EXPECT_NE(OB_SUCCESS, iow.batch_io_task_mgr_.handle(iow.cb_thread_pool_tg_id_, iow.palf_env_impl_));
+  EXPECT_EQ(0, ATOMIC_LOAD(&iow.batch_io_task_mgr_.dispatched_count_));
+
+  // all threads exit after stop, otherwise 'wait' never returns
+  iow.stop();
+  iow.wait();
+  EXPECT_TRUE(iow.has_set_stop());
+
+  // no flush thread consumes the dispatch queue, the round is finished by the caller
+  EXPECT_EQ(OB_SUCCESS, insert_invalid_flush_tasks(allocator, &iow, io_depth));
+  EXPECT_NE(OB_SUCCESS, iow.batch_io_task_mgr_.handle(iow.cb_thread_pool_tg_id_, iow.palf_env_impl_));
+  EXPECT_EQ(0, ATOMIC_LOAD(&iow.batch_io_task_mgr_.dispatched_count_));
+  EXPECT_TRUE(iow.batch_io_task_mgr_.empty());
+  EXPECT_EQ(flying_log_task, ATOMIC_LOAD(&allocator->flying_log_task_));
+  iow.destroy();
+  PALF_LOG(INFO, "end test stop_flush_threads", K(id));
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv) { RUN_SIMPLE_LOG_CLUSTER_TEST(TEST_NAME); }
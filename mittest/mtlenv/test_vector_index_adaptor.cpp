@@ -32,6 +32,7 @@
 #undef protected
 #include <random>
 #include<iostream>
+#include <vector>
 
 namespace oceanbase {
 
@@ -554,6 +555,216 @@ TEST_F(TestVectorIndexAdaptor, vsag_build_index)
   }
 }
 
+TEST_F(TestVectorIndexAdaptor, vsag_knn_search_batch)
+{
+  obvectorlib::VectorIndexPtr index_handler = nullptr;
+  std::mt19937 rng;
+  rng.seed(47);
+  int dim = 128;
+  int max_degree = 16;
+  int ef_search = 200;
+  int ef_construction = 100;
+  const char* const METRIC_L2 = "l2";
+  const char* const DATATYPE_FLOAT32 = "float32";
+
+  ASSERT_EQ(obvectorutil::create_index(index_handler,
+                                       obvectorlib::HNSW_TYPE,
+                                       DATATYPE_FLOAT32,
+                                       METRIC_L2,
+                                       dim,
+                                       max_degree,
+                                       ef_construction,
+                                       ef_search), 0);
+
+  int num_vectors = 10000;
+  int64_t *ids = new int64_t[num_vectors];
+  float *vecs = new float[dim * num_vectors];
+  std::uniform_real_distribution<> distrib_real;
+  for (int64_t i = 0; i < num_vectors; ++i) {
+    ids[i] = i;
+  }
+  for (int64_t i = 0; i < num_vectors * dim; ++i) {
+    vecs[i] = distrib_real(rng);
+  }
+  ASSERT_EQ(0, obvectorutil::build_index(index_handler, vecs, ids, dim, num_vectors));
+
+  const int64_t query_num = 16;
+  int64_t expect_cnt = 10;
+  roaring::api::roaring64_bitmap_t *bitmap = roaring::api::roaring64_bitmap_create();
+  roaring64_bitmap_add(bitmap, 7055);
+  roaring64_bitmap_add(bitmap, 2030);
+  float *query_vecs = new float[dim * query_num];
+  for (int64_t i = 0; i < dim * query_num; ++i) {
+    query_vecs[i] = distrib_real(rng);
+  }
+
+  const float *batch_dists[query_num];
+  const int64_t *batch_ids[query_num];
+  int64_t batch_sizes[query_num];
+  ASSERT_EQ(0, obvectorutil::knn_search_batch(index_handler,
+                                             query_vecs,
+                                             query_num,
+                                             dim,
+                                             expect_cnt,
+                                             batch_dists,
+                                             batch_ids,
+                                             batch_sizes,
+                                             ef_search,
+                                             bitmap));
+
+  for (int64_t q = 0; q < query_num; ++q) {
+    const float *result_dist = nullptr;
+    const int64_t *result_ids = nullptr;
+    int64_t result_size = 0;
+    ASSERT_EQ(0, obvectorutil::knn_search(index_handler,
+                                         query_vecs + q * dim,
+                                         dim,
+                                         expect_cnt,
+                                         result_dist,
+                                         result_ids,
+                                         result_size,
+                                         ef_search,
+                                         bitmap));
+    ASSERT_EQ(result_size, batch_sizes[q]);
+    for (int64_t i = 0; i < result_size; ++i) {
+      ASSERT_EQ(result_ids[i], batch_ids[q][i]);
+      ASSERT_NE(7055, batch_ids[q][i]);
+      ASSERT_NE(2030, batch_ids[q][i]);
+    }
+  }
+}
+
+static void add_delta_vids(ObVectorQueryAdaptorResultContext &ctx,
+                           const std::vector<uint64_t> &insert_vids,
+                           const std::vector<uint64_t> &delete_vids)
+{
+  for (uint64_t vid : insert_vids) {
+    roaring::api::roaring64_bitmap_add(ctx.bitmaps_->insert_bitmap_, vid);
+  }
+  for (uint64_t vid : delete_vids) {
+    roaring::api::roaring64_bitmap_add(ctx.bitmaps_->delete_bitmap_, vid);
+  }
+}
+
+TEST_F(TestVectorIndexAdaptor, delta_bitmap_cache)
+{
+  ObArenaAllocator allocator(ObModIds::TEST);
+  lib::ContextParam param;
+  lib::MemoryContext mem_context;
+  param.set_mem_attr(MTL_ID()).set_properties(lib::ADD_CHILD_THREAD_SAFE | lib::ALLOC_THREAD_SAFE);
+  ASSERT_EQ(ROOT_CONTEXT->CREATE_CONTEXT(mem_context, param), 0);
+  ObPluginVectorIndexAdaptor adaptor(&allocator, mem_context, MTL_ID());
+
+  // incr data applied by the leader dml: vid 1 ~ 3 inserted, vid 2 deleted
+  ObVectorIndexRoaringBitMap incr_bitmaps;
+  incr_bitmaps.insert_bitmap_ = roaring::api::roaring64_bitmap_create();
+  incr_bitmaps.delete_bitmap_ = roaring::api::roaring64_bitmap_create();
+  roaring::api::roaring64_bitmap_add(incr_bitmaps.insert_bitmap_, 1);
+  roaring::api::roaring64_bitmap_add(incr_bitmaps.insert_bitmap_, 3);
+  roaring::api::roaring64_bitmap_add(incr_bitmaps.delete_bitmap_, 2);
+  ObVectorIndexMemData incr_data;
+  incr_data.bitmap_ = &incr_bitmaps;
+  incr_data.set_inited();
+  adaptor.incr_data_ = &incr_data;
+
+  transaction::ObTransService *txs = MTL(transaction::ObTransService *);
+  ASSERT_NE(nullptr, txs);
+  SCN commit_version;
+  ASSERT_EQ(OB_SUCCESS, adaptor.get_committed_data_version(commit_version));
+  const SCN scan_scn = SCN::plus(commit_version, 100);
+  ObArenaAllocator tmp_allocator(ObModIds::TEST);
+  bool is_hit = false;
+
+  // a scan missing rows of a concurrent uncommitted insert is incomplete and not cached
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    add_delta_vids(ctx, {1}, {2});
+    ASSERT_EQ(OB_SUCCESS, adaptor.try_cache_delta_bitmaps(&ctx, scan_scn, adaptor.delta_dml_seq_, commit_version));
+    ASSERT_EQ(nullptr, adaptor.delta_cache_bitmaps_);
+  }
+
+  // a scan at a snapshot older than committed data is not cached
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    add_delta_vids(ctx, {1, 3}, {2});
+    ASSERT_EQ(OB_SUCCESS, adaptor.try_cache_delta_bitmaps(&ctx, scan_scn, adaptor.delta_dml_seq_,
+                                                          SCN::plus(scan_scn, 1)));
+    ASSERT_EQ(nullptr, adaptor.delta_cache_bitmaps_);
+  }
+
+  // a complete scan is cached and reused by later snapshots only
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    add_delta_vids(ctx, {1, 3}, {2});
+    ASSERT_EQ(OB_SUCCESS, adaptor.try_cache_delta_bitmaps(&ctx, scan_scn, adaptor.delta_dml_seq_, commit_version));
+    ASSERT_NE(nullptr, adaptor.delta_cache_bitmaps_);
+  }
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, commit_version, is_hit));
+    ASSERT_FALSE(is_hit);
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, SCN::plus(scan_scn, 10), is_hit));
+    ASSERT_TRUE(is_hit);
+    ASSERT_TRUE(roaring::api::roaring64_bitmap_equals(ctx.bitmaps_->insert_bitmap_, incr_bitmaps.insert_bitmap_));
+    ASSERT_TRUE(roaring::api::roaring64_bitmap_contains(ctx.bitmaps_->delete_bitmap_, 2));
+  }
+
+  // insert of vid 4 which is rolled back later: the dml bumps the seq and invalidates the cache,
+  // and vid 4 stays in incr bitmap, so no later scan is complete until the next sync
+  ATOMIC_INC(&adaptor.delta_dml_seq_);
+  roaring::api::roaring64_bitmap_add(incr_bitmaps.insert_bitmap_, 4);
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, SCN::plus(scan_scn, 10), is_hit));
+    ASSERT_FALSE(is_hit);
+    add_delta_vids(ctx, {1, 3}, {2});
+    ASSERT_EQ(OB_SUCCESS, adaptor.try_cache_delta_bitmaps(&ctx, SCN::plus(scan_scn, 10),
+                                                          adaptor.delta_dml_seq_, commit_version));
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, SCN::plus(scan_scn, 20), is_hit));
+    ASSERT_FALSE(is_hit);
+  }
+  roaring::api::roaring64_bitmap_remove(incr_bitmaps.insert_bitmap_, 4);
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    add_delta_vids(ctx, {1, 3}, {2});
+    ASSERT_EQ(OB_SUCCESS, adaptor.try_cache_delta_bitmaps(&ctx, SCN::plus(scan_scn, 10),
+                                                          adaptor.delta_dml_seq_, commit_version));
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, SCN::plus(scan_scn, 20), is_hit));
+    ASSERT_TRUE(is_hit);
+  }
+
+  // a commit replayed on this replica moves the committed version beyond the query snapshot
+  txs->get_tx_version_mgr().update_max_commit_ts(SCN::plus(scan_scn, 30), false);
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, SCN::plus(scan_scn, 20), is_hit));
+    ASSERT_FALSE(is_hit);
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, SCN::plus(scan_scn, 30), is_hit));
+    ASSERT_TRUE(is_hit);
+  }
+
+  // replayed sync log or role change invalidates the cache for follower reads
+  adaptor.invalidate_delta_bitmap_cache();
+  {
+    ObVectorQueryAdaptorResultContext ctx(MTL_ID(), &allocator, &tmp_allocator, &tmp_allocator);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_bitmaps());
+    ASSERT_EQ(OB_SUCCESS, adaptor.get_cached_delta_bitmaps(&ctx, SCN::plus(scan_scn, 40), is_hit));
+    ASSERT_FALSE(is_hit);
+  }
+
+  adaptor.incr_data_ = nullptr;
+  incr_data.bitmap_ = nullptr;
+  roaring::api::roaring64_bitmap_free(incr_bitmaps.insert_bitmap_);
+  roaring::api::roaring64_bitmap_free(incr_bitmaps.delete_bitmap_);
+}
+
 TEST_F(TestVectorIndexAdaptor, vsag_add_index)
 {
   //ASSERT_EQ(obvectorutil::example(), 0);
@@ -1155,6 +1366,54 @@ TEST_F(TestVectorIndexAdaptor, mem_ctx)
 
 }
 
+TEST_F(TestVectorIndexAdaptor, vsag_mem_context_slab)
+{
+  lib::ContextParam param;
+  lib::MemoryContext parent_mem_context;
+  param.set_mem_attr(MTL_ID())
+    .set_properties(lib::ADD_CHILD_THREAD_SAFE | lib::ALLOC_THREAD_SAFE | lib::RETURN_MALLOC_DEFAULT);
+  ASSERT_EQ(ROOT_CONTEXT->CREATE_CONTEXT(parent_mem_context, param), 0);
+  uint64_t all_vsag_use_mem = 0;
+  ObVsagMemContext mem_ctx(&all_vsag_use_mem);
+  ASSERT_EQ(OB_SUCCESS, mem_ctx.init(parent_mem_context, &all_vsag_use_mem, MTL_ID()));
+  const int64_t empty_hold = mem_ctx.get_slab_hold();
+
+  const int64_t alloc_cnt = 100000;
+  std::vector<void *> ptrs;
+  for (int64_t i = 0; i < alloc_cnt; ++i) {
+    // 16 ~ 1000 bytes, spread over all size classes
+    void *ptr = mem_ctx.Allocate(16 + i % 985);
+    ASSERT_NE(nullptr, ptr);
+    MEMSET(ptr, 0xA5, 16);
+    ptrs.push_back(ptr);
+  }
+  const int64_t full_hold = mem_ctx.get_slab_hold();
+  ASSERT_GT(full_hold, alloc_cnt * 16);
+  ASSERT_GT(all_vsag_use_mem, 0UL);
+
+  // freeing every other slot keeps the blocks
+  for (int64_t i = 0; i < alloc_cnt; i += 2) {
+    mem_ctx.Deallocate(ptrs[i]);
+    ptrs[i] = nullptr;
+  }
+  ASSERT_GT(mem_ctx.get_slab_hold(), full_hold / 2);
+
+  // the freed slots are reused
+  for (int64_t i = 0; i < alloc_cnt; i += 2) {
+    ptrs[i] = mem_ctx.Allocate(16 + i % 985);
+    ASSERT_NE(nullptr, ptrs[i]);
+  }
+  ASSERT_LE(mem_ctx.get_slab_hold(), full_hold + ObVsagMemContext::SLAB_CLASS_CNT * OB_MALLOC_NORMAL_BLOCK_SIZE);
+
+  // empty blocks are returned, except the ones cached by each way
+  for (int64_t i = 0; i < alloc_cnt; ++i) {
+    mem_ctx.Deallocate(ptrs[i]);
+  }
+  ASSERT_EQ(0UL, all_vsag_use_mem);
+  ASSERT_LE(mem_ctx.get_slab_hold(),
+            empty_hold + ObVsagMemContext::SLAB_CLASS_CNT * ObVsagMemContext::SLAB_NWAY * OB_MALLOC_NORMAL_BLOCK_SIZE);
+}
+
 #if 0
 TEST_F(TestVectorIndexAdaptor, vsag_alloc)
 {
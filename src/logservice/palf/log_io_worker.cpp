@@ -73,9 +73,14 @@ int LogIOWorker::init(const LogIOWorkerConfig &config,
     PALF_LOG(ERROR, "io task queue init failed", K(ret), K(config));
   } else if (OB_FAIL(batch_io_task_mgr_.init(config.batch_width_,
                                              config.batch_depth_,
+                                             config.io_depth_,
+                                             tenant_id,
                                              allocator,
                                              &wait_cost_stat_))) {
     PALF_LOG(ERROR, "BatchLogIOFlushLogTaskMgr init failed", K(ret), K(config));
+  } else if (OB_FAIL(share::ObThreadPool::set_thread_count(MAX(1, config.io_depth_)))) {
+    // the first thread consumes 'queue_', the others are flush threads.
+    PALF_LOG(ERROR, "set_thread_count failed", K(ret), K(config));
   } else {
     share::ObThreadPool::set_run_wrapper(MTL_CTX());
     log_io_worker_num_ = config.io_worker_num_;
@@ -174,8 +179,13 @@ int LogIOWorker::notify_need_writing_throttling(const bool &need_throttling)
 
 void LogIOWorker::run1()
 {
-  lib::set_thread_name("IOWorker");
-  (void) run_loop_();
+  if (0 == get_thread_idx()) {
+    lib::set_thread_name("IOWorker");
+    (void) run_loop_();
+  } else {
+    lib::set_thread_name("IOWorkerFlush");
+    (void) run_flush_loop_();
+  }
 }
 
 int LogIOWorker::handle_io_task_with_throttling_(LogIOTask *io_task)
@@ -265,6 +275,18 @@ int LogIOWorker::run_loop_()
   return ret;
 }
 
+int LogIOWorker::run_flush_loop_()
+{
+  int ret = OB_SUCCESS;
+  // NB: the dispatched tasks which are left after the flush threads have stopped will be written
+  // by the LogIOWorker itself, see 'wait_dispatched_tasks_'.
+  while (false == has_set_stop()
+      && false == (OB_NOT_NULL(&lib::Thread::current()) ? lib::Thread::current().has_set_stop() : false)) {
+    (void)batch_io_task_mgr_.do_dispatched_task(QUEUE_WAIT_TIME);
+  }
+  return ret;
+}
+
 bool LogIOWorker::need_reduce_(LogIOTask *io_task)
 {
   bool bool_ret = false;
@@ -342,7 +364,8 @@ int LogIOWorker::update_throttling_options_()
 
 LogIOWorker::BatchLogIOFlushLogTaskMgr::BatchLogIOFlushLogTaskMgr()
   : handle_count_(0), usable_count_(0), batch_width_(0),
-    wait_cost_stat_(NULL)
+    wait_cost_stat_(NULL), io_depth_(0), dispatch_queue_(), dispatch_cond_(),
+    dispatched_count_(0), handle_ret_(OB_SUCCESS), tg_id_(-1), palf_env_impl_(NULL)
 {}
 
 LogIOWorker::BatchLogIOFlushLogTaskMgr::~BatchLogIOFlushLogTaskMgr()
@@ -352,6 +375,8 @@ LogIOWorker::BatchLogIOFlushLogTaskMgr::~BatchLogIOFlushLogTaskMgr()
 
 int LogIOWorker::BatchLogIOFlushLogTaskMgr::init(int64_t batch_width,
                                                  int64_t batch_depth,
+                                                 int64_t io_depth,
+                                                 const int64_t tenant_id,
                                                  ObIAllocator *allocator,
                                                  ObMiniStat::ObStatItem *wait_cost_stat)
 {
@@ -359,7 +384,12 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::init(int64_t batch_width,
   batch_io_task_array_.set_allocator(allocator);
   if (OB_FAIL(batch_io_task_array_.init(batch_width))) {
     PALF_LOG(ERROR, "batch_io_task_array_ init failed", K(ret));
+  } else if (io_depth > 1 && OB_FAIL(dispatch_queue_.init(batch_width, "IOWorkerDQ", tenant_id))) {
+    PALF_LOG(ERROR, "dispatch_queue_ init failed", K(ret), K(batch_width), K(io_depth));
+  } else if (io_depth > 1 && OB_FAIL(dispatch_cond_.init(ObWaitEventIds::CLOG_WRITER_COND_WAIT))) {
+    PALF_LOG(ERROR, "dispatch_cond_ init failed", K(ret), K(io_depth));
   } else {
+    io_depth_ = io_depth;
     for (int i = 0; i < batch_width  && OB_SUCC(ret); i++) {
       bool last_io_task_push_success = false;
       char *ptr = reinterpret_cast<char*>(mtl_malloc(sizeof(BatchLogIOFlushLogTask), "LogIOTask"));
@@ -406,6 +436,13 @@ void LogIOWorker::BatchLogIOFlushLogTaskMgr::destroy()
   }
   wait_cost_stat_ = NULL;
   batch_io_task_array_.destroy();
+  io_depth_ = 0;
+  dispatched_count_ = 0;
+  handle_ret_ = OB_SUCCESS;
+  tg_id_ = -1;
+  palf_env_impl_ = NULL;
+  dispatch_queue_.destroy();
+  dispatch_cond_.destroy();
 }
 
 int LogIOWorker::BatchLogIOFlushLogTaskMgr::insert(LogIOFlushLogTask *io_task)
@@ -430,25 +467,38 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id, IPalfEnv
   // even if execute 'do_task_' for one of LogIOFlushLogTask failed, we need
   // execute 'do_task_' for next LogIOFlushLogTask.
   const int64_t first_handle_ts = ObTimeUtility::fast_current_time();
+  tg_id_ = tg_id;
+  palf_env_impl_ = palf_env_impl;
+  handle_ret_ = OB_SUCCESS;
   for (int64_t i = 0; i < count; i++) {
     BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
+    int tmp_ret = OB_SUCCESS;
     if (OB_ISNULL(io_task)) {
       ret = OB_ERR_UNEXPECTED;
       PALF_LOG(ERROR, "BatchLogIOFlushLogTask in batch_io_task_array_ is nullptr, unexpected error!!!",
                K(ret), KP(io_task), K(i));
     } else if (OB_FAIL(statistics_wait_cost_(first_handle_ts, io_task))) {
       PALF_LOG(WARN, "do statistics failed", K(ret));
-    } else if (OB_FAIL(io_task->do_task(tg_id, palf_env_impl))) {
-      PALF_LOG(WARN, "do_task failed", K(ret), KP(io_task));
-    } else {
+    } else if (io_depth_ <= 1 || count - 1 == i) {
+      do_batch_io_task_(io_task);
+    } else if (FALSE_IT(ATOMIC_INC(&dispatched_count_))) {
+    } else if (OB_TMP_FAIL(dispatch_queue_.push(io_task))) {
+      ATOMIC_DEC(&dispatched_count_);
+      do_batch_io_task_(io_task);
+    }
+  }
+  // NB: 'batch_io_task_array_' can be reused only after all of the dispatched tasks have been written.
+  wait_dispatched_tasks_();
+  if (OB_SUCC(ret)) {
+    ret = ATOMIC_LOAD(&handle_ret_);
+  }
+  for (int64_t i = 0; i < count; i++) {
+    BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
+    if (OB_NOT_NULL(io_task)) {
       if (OB_NOT_NULL(wait_cost_stat_)) {
         wait_cost_stat_->stat(io_task->get_count(), io_task->get_accum_in_queue_time());
       }
       io_task->reset_accum_in_queue_time();
-      PALF_LOG(TRACE, "BatchLogIOFlushLogTaskMgr::handle success", K(ret), K(handle_count_),
-          KP(io_task));
-    }
-    if (OB_NOT_NULL(io_task)) {
       // 'handle_count_' used for statistics
       handle_count_ += io_task->get_count();
       io_task->reuse();
@@ -458,6 +508,48 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id, IPalfEnv
   return ret;
 }
 
+int LogIOWorker::BatchLogIOFlushLogTaskMgr::do_dispatched_task(const int64_t timeout_us)
+{
+  int ret = OB_SUCCESS;
+  void *task = NULL;
+  if (OB_FAIL(dispatch_queue_.pop(task, timeout_us))) {
+    // no dispatched task
+  } else {
+    do_batch_io_task_(reinterpret_cast<BatchLogIOFlushLogTask *>(task));
+    if (0 == ATOMIC_AAF(&dispatched_count_, -1)) {
+      ObThreadCondGuard guard(dispatch_cond_);
+      (void)dispatch_cond_.signal();
+    }
+  }
+  return ret;
+}
+
+void LogIOWorker::BatchLogIOFlushLogTaskMgr::do_batch_io_task_(BatchLogIOFlushLogTask *io_task)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(io_task->do_task(tg_id_, palf_env_impl_))) {
+    PALF_LOG(WARN, "do_task failed", K(ret), KP(io_task));
+    (void)ATOMIC_BCAS(&handle_ret_, OB_SUCCESS, ret);
+  } else {
+    PALF_LOG(TRACE, "BatchLogIOFlushLogTaskMgr::handle success", K(ret), K(handle_count_),
+        KP(io_task));
+  }
+}
+
+void LogIOWorker::BatchLogIOFlushLogTaskMgr::wait_dispatched_tasks_()
+{
+  // Write the dispatched tasks which have not been taken by the flush threads, this also
+  // guarantees the round can finish after the flush threads have stopped.
+  while (ATOMIC_LOAD(&dispatched_count_) > 0 && OB_SUCCESS == do_dispatched_task(0)) {
+  }
+  if (ATOMIC_LOAD(&dispatched_count_) > 0) {
+    ObThreadCondGuard guard(dispatch_cond_);
+    while (ATOMIC_LOAD(&dispatched_count_) > 0) {
+      (void)dispatch_cond_.wait_us(DISPATCH_WAIT_INTERVAL_US);
+    }
+  }
+}
+
 bool LogIOWorker::BatchLogIOFlushLogTaskMgr::empty()
 {
   return usable_count_ == batch_width_;
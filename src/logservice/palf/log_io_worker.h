@@ -22,6 +22,7 @@
 #include "lib/hash/ob_array_hash_map.h"             // ObArrayHashMap
 #include "lib/atomic/ob_atomic.h"                   // ATOMIC_LOAD
 #include "lib/function/ob_function.h"               // ObFunction
+#include "lib/lock/ob_thread_cond.h"                // ObThreadCond
 #include "share/ob_thread_pool.h"                   // ObThreadPool
 #include "common/ob_clock_generator.h"              // ObClockGenerator
 #include "log_io_task.h"                            // LogBatchIOFlushLogTask
@@ -51,7 +52,8 @@ struct LogIOWorkerConfig
   }
   bool is_valid() const
   {
-    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 <= batch_width_ && 0 <= batch_depth_;
+    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 <= batch_width_ && 0 <= batch_depth_
+        && 0 <= io_depth_;
   }
   void reset()
   {
@@ -59,12 +61,17 @@ struct LogIOWorkerConfig
     io_queue_capcity_ = 0;
     batch_width_ = 0;
     batch_depth_ = 0;
+    io_depth_ = 0;
   }
   int64_t io_worker_num_;
   int64_t io_queue_capcity_;
   int64_t batch_width_;
   int64_t batch_depth_;
-  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth));
+  // the max number of BatchLogIOFlushLogTask(of different palf instances) written concurrently
+  // by one LogIOWorker, 0 or 1 means writing them one by one.
+  int64_t io_depth_;
+  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth),
+               K_(io_depth));
 };
 
 class LogIOWorker : public share::ObThreadPool
@@ -92,6 +99,7 @@ private:
   bool need_reduce_(LogIOTask *task);
   int reduce_io_task_(void *task);
   int handle_io_task_(LogIOTask *io_task);
+  int run_flush_loop_();
   int handle_io_task_with_throttling_(LogIOTask *io_task);
   int update_throttling_options_();
   int run_loop_();
@@ -102,26 +110,51 @@ private:
   static constexpr int64_t QUEUE_WAIT_TIME = 100 * 1000;
 private:
 
+  // The BatchLogIOFlushLogTasks of one round belong to different palf instances, and they are
+  // independent of each other. When 'io_depth' is greater than 1, the LogIOWorker dispatches
+  // them to its flush threads and writes the last one by itself, so several log streams are
+  // written concurrently. A round finishes after all of its BatchLogIOFlushLogTasks have been
+  // written, therefore the LogIOFlushLogTasks of one palf instance are still written in order.
   class BatchLogIOFlushLogTaskMgr {
   public:
     BatchLogIOFlushLogTaskMgr();
     ~BatchLogIOFlushLogTaskMgr();
-    int init(int64_t batch_width, int64_t batch_depth, ObIAllocator *allocator, ObMiniStat::ObStatItem *wait_cost_stat);
+    int init(int64_t batch_width, int64_t batch_depth, int64_t io_depth, const int64_t tenant_id,
+             ObIAllocator *allocator, ObMiniStat::ObStatItem *wait_cost_stat);
     void destroy();
     int insert(LogIOFlushLogTask *io_task);
     int handle(const int64_t tg_id, IPalfEnvImpl *palf_env_impl);
+    // called by the flush threads, write one dispatched BatchLogIOFlushLogTask
+    // @retval OB_SUCCESS, one task has been written
+    //         OB_ENTRY_NOT_EXIST, no task has been dispatched in 'timeout_us'
+    int do_dispatched_task(const int64_t timeout_us);
     bool empty();
-    TO_STRING_KV(K_(batch_io_task_array), K_(usable_count), K_(batch_width));
+    int64_t get_io_depth() const { return io_depth_; }
+    TO_STRING_KV(K_(batch_io_task_array), K_(usable_count), K_(batch_width), K_(io_depth),
+                 K_(dispatched_count));
   private:
     int find_usable_batch_io_task_(const int64_t palf_id, BatchLogIOFlushLogTask *&batch_io_task);
     int statistics_wait_cost_(int64_t first_handle_time, BatchLogIOFlushLogTask *batch_io_task);
+    void do_batch_io_task_(BatchLogIOFlushLogTask *io_task);
+    void wait_dispatched_tasks_();
   private:
+    static constexpr int64_t DISPATCH_WAIT_INTERVAL_US = 1000;
     typedef ObFixedArray<BatchLogIOFlushLogTask *, common::ObIAllocator> BatchLogIOFlushLogTaskArray;
     BatchLogIOFlushLogTaskArray batch_io_task_array_;
     int64_t handle_count_;
     int64_t usable_count_;
     int64_t batch_width_;
     ObMiniStat::ObStatItem *wait_cost_stat_;
+    int64_t io_depth_;
+    // the BatchLogIOFlushLogTasks waiting for the flush threads
+    ObLightyQueue dispatch_queue_;
+    common::ObThreadCond dispatch_cond_;
+    // the number of dispatched BatchLogIOFlushLogTasks which have not been written
+    int64_t dispatched_count_;
+    // the first error of the current round
+    int handle_ret_;
+    int64_t tg_id_;
+    IPalfEnvImpl *palf_env_impl_;
   };
   typedef common::ObSpinLock SpinLock;
   typedef common::ObSpinLockGuard SpinLockGuard;
@@ -1405,6 +1405,9 @@ int PalfEnvImpl::init_log_io_worker_config_(const int log_writer_parallelism,
   // a balanced state.
   constexpr int64_t default_min_io_queue_cap = PALF_SLIDING_WINDOW_SIZE * 2;
   constexpr int64_t default_min_batch_width = 1;
+  // Each LogIOWorker writes at most 'default_max_io_depth' log streams concurrently, the log
+  // streams of meta tenant and sys tenant are few, no need to write them concurrently.
+  constexpr int64_t default_max_io_depth = 4;
   // Assume that a maximum of 100 * 1024 I/O tasks exist simultaneously in single PalfEnvImpl
   config.io_worker_num_ = real_log_writer_parallelism;
   config.io_queue_capcity_ = MAX(default_min_io_queue_cap,
@@ -1412,6 +1415,7 @@ int PalfEnvImpl::init_log_io_worker_config_(const int log_writer_parallelism,
   config.batch_width_ = MAX(default_min_batch_width,
                             tmp_upper_align_div(default_io_batch_width, real_log_writer_parallelism));
   config.batch_depth_ = PALF_SLIDING_WINDOW_SIZE;
+  config.io_depth_ = is_user_tenant(tenant_id) ? MIN(config.batch_width_, default_max_io_depth) : 1;
   PALF_LOG(INFO, "init_log_io_worker_config_ success", K(config), K(tenant_id), K(log_writer_parallelism));
   return ret;
 }
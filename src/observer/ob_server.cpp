@@ -2872,6 +2872,18 @@ int ObServer::init_sql()
     }
   }
 
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(ObPluginVectorIndexUtils::set_vsag_parallel_executor())) {
+      LOG_ERROR("failed to initialize VSAG parallel executor.", K(ret));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(ObPluginVectorIndexUtils::set_vsag_disk_index_dir())) {
+      LOG_ERROR("failed to initialize VSAG disk index dir.", K(ret));
+    }
+  }
+
   if (OB_SUCC(ret)) {
     LOG_INFO("init sql done");
   } else {
@@ -507,6 +507,7 @@ int ObTableLoadService::check_support_direct_load(ObSchemaGetterGuard &schema_gu
     bool has_udt_column = false;
     bool has_fts_index = false;
     bool has_multivalue_index = false;
+    bool has_vector_index = false;
     bool has_invisible_column = false;
     bool has_unused_column = false;
     bool has_roaringbitmap_column = false;
@@ -547,6 +548,14 @@ int ObTableLoadService::check_support_direct_load(ObSchemaGetterGuard &schema_gu
       LOG_WARN("direct-load does not support table has multi-value index", KR(ret));
       FORWARD_USER_ERROR_MSG(ret, "%sdirect-load does not support table has multi-value index", tmp_prefix);
     }
+    // check if exists vector index
+    else if (OB_FAIL(table_schema->check_has_vector_index(schema_guard, has_vector_index))) {
+      LOG_WARN("fail to check has vector index", K(ret));
+    } else if (has_vector_index) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("direct-load does not support table has vector index", KR(ret));
+      FORWARD_USER_ERROR_MSG(ret, "%sdirect-load does not support table has vector index", tmp_prefix);
+    }
     // check if exists generated column
     else if (OB_UNLIKELY(table_schema->has_generated_column())) {
       ret = OB_NOT_SUPPORTED;
@@ -638,6 +638,13 @@ bool ObConfigPublishSchemaModeChecker::check(const ObConfigItem& t) const
          || 0 == t.case_compare(PUBLISH_SCHEMA_MODE_ASYNC);
 }
 
+bool ObConfigLocalIOEngineChecker::check(const ObConfigItem& t) const
+{
+  return 0 == t.case_compare("LIBAIO")
+         || 0 == t.case_compare("IO_URING")
+         || 0 == t.case_compare("IO_URING_SQPOLL");
+}
+
 bool ObConfigMemoryLimitChecker::check(const ObConfigItem &t) const
 {
   bool is_valid = false;
@@ -647,6 +647,17 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObConfigPublishSchemaModeChecker);
 };
 
+class ObConfigLocalIOEngineChecker
+  : public ObConfigChecker
+{
+public:
+  ObConfigLocalIOEngineChecker() {}
+  virtual ~ObConfigLocalIOEngineChecker() {}
+  bool check(const ObConfigItem& t) const;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObConfigLocalIOEngineChecker);
+};
+
 // config item container
 class ObConfigStringKey
 {
@@ -256,6 +256,9 @@ int ObIOAllocator::init(const uint64_t tenant_id, const int64_t memory_limit)
 void ObIOAllocator::destroy()
 {
   is_inited_ = false;
+  if (nullptr != macro_pool_.get_begin_ptr()) {
+    ObSNIODeviceWrapper::get_instance().unregister_io_buffer(macro_pool_.get_begin_ptr());
+  }
   macro_pool_.destroy();
   inner_allocator_.destroy();
 }
@@ -358,6 +361,12 @@ int ObIOAllocator::init_macro_pool(const int64_t memory_limit)
   } else {
     block_count_ = block_count;
     LOG_INFO("succ to init io macro pool", K(memory_limit), K(block_count));
+    // the macro pool is the buffer of most large reads, let io_uring skip pinning its pages
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(ObSNIODeviceWrapper::get_instance().register_io_buffer(
+            macro_pool_.get_begin_ptr(), macro_pool_.get_total_size()))) {
+      LOG_WARN("fail to register io macro pool", K(tmp_ret), K(block_count));
+    }
   }
   return ret;
 }
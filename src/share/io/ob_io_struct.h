@@ -78,6 +78,8 @@ public:
   int free(void *ptr);
   bool contain(void *ptr);
   int64_t get_block_size() const { return SIZE; }
+  char *get_begin_ptr() const { return begin_ptr_; }
+  int64_t get_total_size() const { return capacity_ * SIZE; }
 private:
   bool is_inited_;
   int64_t capacity_;
@@ -486,7 +488,8 @@ private:
 };
 
 // each device has several channels, including async channels and sync channels.
-// this interface better in ObIODevice and can be replaced by io_uring.
+// this interface better in ObIODevice, the local device runs it on io_uring when
+// _local_io_engine is IO_URING or IO_URING_SQPOLL.
 class ObDeviceChannel final
 {
 public:
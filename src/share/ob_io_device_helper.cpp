@@ -213,6 +213,22 @@ void ObSNIODeviceWrapper::destroy()
   }
 }
 
+int ObSNIODeviceWrapper::register_io_buffer(void *buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (NULL != local_device_ && OB_FAIL(local_device_->register_io_buffer(buf, size))) {
+    LOG_WARN("fail to register io buffer", K(ret), KP(buf), K(size));
+  }
+  return ret;
+}
+
+void ObSNIODeviceWrapper::unregister_io_buffer(void *buf)
+{
+  if (NULL != local_device_) {
+    local_device_->unregister_io_buffer(buf);
+  }
+}
+
 /**
  * --------------------------------ObIODeviceLocalFileOp------------------------------------
  */
@@ -80,6 +80,10 @@ public:
   void destroy();
 
   ObIODevice &get_local_device() { abort_unless(NULL != local_device_); return *local_device_; }
+  // register long-lived io buffers into the io_uring engine of the local device, does nothing
+  // if the local device is not created
+  int register_io_buffer(void *buf, const int64_t size);
+  void unregister_io_buffer(void *buf);
 
   // just for unittest (mock_tenant_module_env)
   void set_local_device(ObLocalDevice *local_device)
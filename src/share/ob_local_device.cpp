@@ -78,6 +78,19 @@ void *ObLocalIOEvents::get_ith_data(const int64_t i) const
 }
 
 
+ObLocalIOEngine get_local_io_engine(const ObString &str)
+{
+  ObLocalIOEngine engine = LOCAL_IO_ENGINE_MAX;
+  if (0 == str.case_compare("LIBAIO")) {
+    engine = LOCAL_IO_ENGINE_LIBAIO;
+  } else if (0 == str.case_compare("IO_URING")) {
+    engine = LOCAL_IO_ENGINE_IO_URING;
+  } else if (0 == str.case_compare("IO_URING_SQPOLL")) {
+    engine = LOCAL_IO_ENGINE_IO_URING_SQPOLL;
+  }
+  return engine;
+}
+
 /**
  * ---------------------------------------------ObLocalDevice---------------------------------------------------
  */
@@ -97,9 +110,14 @@ ObLocalDevice::ObLocalDevice()
     block_bitmap_(nullptr),
     allocator_(),
     iocb_pool_(),
-    is_fs_support_punch_hole_(true)
+    is_fs_support_punch_hole_(true),
+    io_engine_(LOCAL_IO_ENGINE_LIBAIO),
+    fixed_buffer_lock_(common::ObLatchIds::LOCAL_DEVICE_LOCK),
+    fixed_buffer_cnt_(0),
+    uring_contexts_()
 {
 
+  MEMSET(fixed_buffers_, 0, sizeof(fixed_buffers_));
   MEMSET(store_dir_, 0, sizeof(store_dir_));
   MEMSET(sstable_dir_, 0, sizeof(sstable_dir_));
   MEMSET(store_path_, 0, sizeof(store_path_));
@@ -167,6 +185,11 @@ int ObLocalDevice::init(const common::ObIODOpts &opts)
         STRNCPY(store_dir_, store_dir, STRLEN(store_dir));
         STRNCPY(sstable_dir_, sstable_dir, STRLEN(sstable_dir));
         media_id_ = media_id;
+        io_engine_ = get_local_io_engine(GCONF._local_io_engine.str());
+        if (LOCAL_IO_ENGINE_MAX == io_engine_) {
+          io_engine_ = LOCAL_IO_ENGINE_LIBAIO;
+        }
+        SHARE_LOG(INFO, "local device io engine", K(io_engine_), K(GCONF._local_io_engine.str()));
       }
     }
   }
@@ -286,6 +309,10 @@ void ObLocalDevice::destroy()
   is_inited_ = false;
   is_marked_ = false;
   is_fs_support_punch_hole_ = true;
+  io_engine_ = LOCAL_IO_ENGINE_LIBAIO;
+  MEMSET(fixed_buffers_, 0, sizeof(fixed_buffers_));
+  fixed_buffer_cnt_ = 0;
+  uring_contexts_.reset();
 
   MEMSET(store_dir_, 0, sizeof(store_dir_));
   MEMSET(sstable_dir_, 0, sizeof(sstable_dir_));
@@ -910,6 +937,13 @@ int ObLocalDevice::io_setup(
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     SHARE_LOG(WARN, "The ObLocalDevice has not been inited, ", K(ret));
+  } else if (LOCAL_IO_ENGINE_IO_URING == io_engine_ || LOCAL_IO_ENGINE_IO_URING_SQPOLL == io_engine_) {
+    if (OB_FAIL(io_uring_setup(max_events, io_context))) {
+      // e.g. io_uring is disabled by kernel.io_uring_disabled or seccomp
+      SHARE_LOG(WARN, "Fail to setup io uring, fall back to libaio", K(ret), K(io_engine_));
+      io_engine_ = LOCAL_IO_ENGINE_LIBAIO;
+      ret = io_setup(max_events, io_context);
+    }
   } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObLocalIOContext)))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     SHARE_LOG(WARN, "Fail to allocate memory, ", K(ret));
@@ -943,6 +977,8 @@ int ObLocalDevice::io_destroy(common::ObIOContext *io_context)
   } else if (OB_ISNULL(io_context)) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid argument, ", KP(io_context));
+  } else if (ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING == io_context->get_type()) {
+    io_uring_destroy(static_cast<ObLocalIOUringContext *>(io_context));
   } else if (OB_UNLIKELY(ObIOContextType::IO_CONTEXT_TYPE_LOCAL != io_context->get_type())) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer", K(ret), KP(io_context),
@@ -1054,7 +1090,8 @@ int ObLocalDevice::io_submit(
   } else if (OB_ISNULL(io_context) || OB_ISNULL(iocb)) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid argument, ", KP(io_context), KP(iocb));
-  } else if (OB_UNLIKELY((ObIOContextType::IO_CONTEXT_TYPE_LOCAL != io_context->get_type())
+  } else if (OB_UNLIKELY((ObIOContextType::IO_CONTEXT_TYPE_LOCAL != io_context->get_type()
+                          && ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING != io_context->get_type())
                          || (ObIOCBType::IOCB_TYPE_LOCAL != iocb->get_type()))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io_context or iocb pointer", K(ret), KP(io_context), "io_context_type",
@@ -1062,6 +1099,14 @@ int ObLocalDevice::io_submit(
   } else if (OB_ISNULL(local_iocb = static_cast<ObLocalIOCB *> (iocb))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local iocb pointer is null", K(ret), KP(iocb));
+  } else if (ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING == io_context->get_type()) {
+    ObLocalIOUringContext *uring_context = static_cast<ObLocalIOUringContext *>(io_context);
+    const struct iocb &cb = local_iocb->iocb_;
+    const int64_t buf_index = get_fixed_buffer_index(cb.u.c.buf, cb.u.c.nbytes);
+    if (OB_FAIL(uring_context->ring_.submit(cb, buf_index))) {
+      SHARE_LOG(WARN, "Fail to submit io uring, ", K(ret), K(buf_index));
+    }
+    time_guard.click("LocalDevice_submit");
   } else if (OB_ISNULL(local_io_context = static_cast<ObLocalIOContext *> (io_context))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local io context pointer is null", K(ret), KP(io_context));
@@ -1093,6 +1138,9 @@ int ObLocalDevice::io_cancel(
   } else if (OB_ISNULL(io_context) || OB_ISNULL(iocb)) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid argument, ", KP(io_context),KP(iocb));
+  } else if (ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING == io_context->get_type()) {
+    // the request returns by get_events as usual
+    ret = OB_NOT_SUPPORTED;
   } else if (OB_UNLIKELY((ObIOContextType::IO_CONTEXT_TYPE_LOCAL != io_context->get_type())
                          || (ObIOCBType::IOCB_TYPE_LOCAL != iocb->get_type()))) {
     ret = OB_INVALID_ARGUMENT;
@@ -1131,7 +1179,8 @@ int ObLocalDevice::io_getevents(
   } else if (OB_ISNULL(io_context) || OB_ISNULL(events)) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid argument, ", KP(io_context),KP(events));
-  } else if (OB_UNLIKELY((ObIOContextType::IO_CONTEXT_TYPE_LOCAL != io_context->get_type())
+  } else if (OB_UNLIKELY((ObIOContextType::IO_CONTEXT_TYPE_LOCAL != io_context->get_type()
+                          && ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING != io_context->get_type())
                          || (ObIOEventsType::IO_EVENTS_TYPE_LOCAL != events->get_type()))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io_context or io_events pointer", K(ret), KP(io_context),
@@ -1139,6 +1188,15 @@ int ObLocalDevice::io_getevents(
   } else if (OB_ISNULL(local_io_events = static_cast<ObLocalIOEvents *> (events))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local io events pointer is null", K(ret), KP(events));
+  } else if (ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING == io_context->get_type()) {
+    ObLocalIOUringContext *uring_context = static_cast<ObLocalIOUringContext *>(io_context);
+    int64_t complete_cnt = 0;
+    if (OB_FAIL(uring_context->ring_.get_events(min_nr, local_io_events->max_event_cnt_,
+                                                local_io_events->io_events_, timeout,
+                                                complete_cnt))) {
+      SHARE_LOG(WARN, "Fail to get io uring events, ", K(ret));
+    }
+    local_io_events->complete_io_cnt_ = complete_cnt;
   } else if (OB_ISNULL(local_io_context = static_cast<ObLocalIOContext *> (io_context))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local io context pointer is null", K(ret), KP(io_context));
@@ -1221,6 +1279,155 @@ void ObLocalDevice::free_io_events(common::ObIOEvents *io_event)
   }
 }
 
+int ObLocalDevice::register_io_buffer(void *buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  int64_t slot = -1;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalDevice has not been inited, ", K(ret));
+  } else if (LOCAL_IO_ENGINE_LIBAIO == io_engine_) {
+    // do nothing
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(size <= 0 || size > MAX_FIXED_BUFFER_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", K(ret), KP(buf), K(size));
+  } else {
+    lib::ObMutexGuard guard(fixed_buffer_lock_);
+    for (int64_t i = 0; -1 == slot && i < ObLocalIOUring::MAX_FIXED_BUFFER_CNT; ++i) {
+      if (nullptr == fixed_buffers_[i].iov_base) {
+        slot = i;
+      }
+    }
+    if (-1 == slot) {
+      ret = OB_SIZE_OVERFLOW;
+      SHARE_LOG(WARN, "too many fixed buffers", K(ret), K(fixed_buffer_cnt_));
+    } else {
+      struct iovec iov;
+      iov.iov_base = buf;
+      iov.iov_len = size;
+      // register into the rings before publishing the slot, so a submission never names a slot
+      // which the kernel does not know yet
+      for (int64_t i = 0; OB_SUCC(ret) && i < uring_contexts_.count(); ++i) {
+        ObLocalIOUring &ring = uring_contexts_.at(i)->ring_;
+        if (ring.support_fixed_buffer() && OB_FAIL(ring.update_fixed_buffer(slot, iov))) {
+          SHARE_LOG(WARN, "Fail to register fixed buffer", K(ret), K(slot), KP(buf), K(size));
+        }
+      }
+      if (OB_FAIL(ret)) {
+        struct iovec empty_iov;
+        MEMSET(&empty_iov, 0, sizeof(empty_iov));
+        for (int64_t i = 0; i < uring_contexts_.count(); ++i) {
+          ObLocalIOUring &ring = uring_contexts_.at(i)->ring_;
+          if (ring.support_fixed_buffer()) {
+            IGNORE_RETURN ring.update_fixed_buffer(slot, empty_iov);
+          }
+        }
+      } else {
+        ATOMIC_STORE(&fixed_buffers_[slot].iov_base, buf);
+        ATOMIC_STORE(&fixed_buffers_[slot].iov_len, static_cast<size_t>(size));
+        ATOMIC_INC(&fixed_buffer_cnt_);
+        SHARE_LOG(INFO, "register fixed io buffer", K(slot), KP(buf), K(size), K(fixed_buffer_cnt_));
+      }
+    }
+  }
+  return ret;
+}
+
+void ObLocalDevice::unregister_io_buffer(void *buf)
+{
+  int ret = OB_SUCCESS;
+  if (OB_LIKELY(is_inited_) && nullptr != buf && LOCAL_IO_ENGINE_LIBAIO != io_engine_) {
+    lib::ObMutexGuard guard(fixed_buffer_lock_);
+    for (int64_t slot = 0; slot < ObLocalIOUring::MAX_FIXED_BUFFER_CNT; ++slot) {
+      if (buf == fixed_buffers_[slot].iov_base) {
+        ATOMIC_STORE(&fixed_buffers_[slot].iov_len, 0);
+        ATOMIC_STORE(&fixed_buffers_[slot].iov_base, nullptr);
+        ATOMIC_DEC(&fixed_buffer_cnt_);
+        struct iovec empty_iov;
+        MEMSET(&empty_iov, 0, sizeof(empty_iov));
+        for (int64_t i = 0; i < uring_contexts_.count(); ++i) {
+          ObLocalIOUring &ring = uring_contexts_.at(i)->ring_;
+          if (ring.support_fixed_buffer() && OB_FAIL(ring.update_fixed_buffer(slot, empty_iov))) {
+            SHARE_LOG(WARN, "Fail to unregister fixed buffer", K(ret), K(slot), KP(buf));
+          }
+        }
+        SHARE_LOG(INFO, "unregister fixed io buffer", K(slot), KP(buf), K(fixed_buffer_cnt_));
+        break;
+      }
+    }
+  }
+}
+
+int ObLocalDevice::io_uring_setup(const uint32_t max_events, common::ObIOContext *&io_context)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
+  if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObLocalIOUringContext)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    SHARE_LOG(WARN, "Fail to allocate memory, ", K(ret));
+  } else if (FALSE_IT(uring_context = new (buf) ObLocalIOUringContext())) {
+  } else if (OB_FAIL(uring_context->ring_.init(max_events,
+                                               LOCAL_IO_ENGINE_IO_URING_SQPOLL == io_engine_))) {
+    SHARE_LOG(WARN, "Fail to init io uring, ", K(ret), K(max_events), K(io_engine_));
+  } else {
+    lib::ObMutexGuard guard(fixed_buffer_lock_);
+    ObLocalIOUring &ring = uring_context->ring_;
+    for (int64_t slot = 0; OB_SUCC(ret) && slot < ObLocalIOUring::MAX_FIXED_BUFFER_CNT; ++slot) {
+      if (nullptr != fixed_buffers_[slot].iov_base && ring.support_fixed_buffer()
+          && OB_FAIL(ring.update_fixed_buffer(slot, fixed_buffers_[slot]))) {
+        SHARE_LOG(WARN, "Fail to register fixed buffer", K(ret), K(slot));
+      }
+    }
+    if (FAILEDx(uring_contexts_.push_back(uring_context))) {
+      SHARE_LOG(WARN, "Fail to push back uring context", K(ret));
+    } else {
+      io_context = uring_context;
+      SHARE_LOG(INFO, "setup io uring", K(ring));
+    }
+  }
+
+  if (OB_FAIL(ret) && nullptr != buf) {
+    if (nullptr != uring_context) {
+      uring_context->~ObLocalIOUringContext();
+    }
+    allocator_.free(buf);
+  }
+  return ret;
+}
+
+void ObLocalDevice::io_uring_destroy(ObLocalIOUringContext *uring_context)
+{
+  {
+    lib::ObMutexGuard guard(fixed_buffer_lock_);
+    for (int64_t i = 0; i < uring_contexts_.count(); ++i) {
+      if (uring_context == uring_contexts_.at(i)) {
+        IGNORE_RETURN uring_contexts_.remove(i);
+        break;
+      }
+    }
+  }
+  uring_context->~ObLocalIOUringContext();
+  allocator_.free(uring_context);
+}
+
+int64_t ObLocalDevice::get_fixed_buffer_index(const void *buf, const int64_t size) const
+{
+  int64_t buf_index = ObLocalIOUring::NO_FIXED_BUFFER;
+  if (ATOMIC_LOAD(&fixed_buffer_cnt_) > 0) {
+    const char *begin = static_cast<const char *>(buf);
+    for (int64_t slot = 0; slot < ObLocalIOUring::MAX_FIXED_BUFFER_CNT; ++slot) {
+      const size_t len = ATOMIC_LOAD(&fixed_buffers_[slot].iov_len);
+      const char *base = static_cast<const char *>(ATOMIC_LOAD(&fixed_buffers_[slot].iov_base));
+      if (len > 0 && nullptr != base && begin >= base && begin + size <= base + len) {
+        buf_index = slot;
+        break;
+      }
+    }
+  }
+  return buf_index;
+}
+
 int64_t ObLocalDevice::get_total_block_size() const
 {
   return block_file_size_;
@@ -15,7 +15,9 @@
 
 #include <libaio.h>
 #include "lib/allocator/ob_fifo_allocator.h"
+#include "lib/container/ob_se_array.h"
 #include "common/storage/ob_io_device.h"
+#include "share/ob_local_io_uring.h"
 
 namespace oceanbase {
 namespace share {
@@ -50,6 +52,32 @@ private:
   io_context_t io_context_;
 };
 
+// io context of one async io channel when _local_io_engine is IO_URING or IO_URING_SQPOLL, the
+// iocbs are prepared as libaio ones and translated to sqes when submitting
+class ObLocalIOUringContext : public common::ObIOContext
+{
+public:
+  ObLocalIOUringContext() : ring_() {}
+  virtual ~ObLocalIOUringContext() {}
+  virtual ObIOContextType get_type() const override
+  {
+    return ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING;
+  }
+private:
+  friend class ObLocalDevice;
+  ObLocalIOUring ring_;
+};
+
+enum ObLocalIOEngine : uint8_t
+{
+  LOCAL_IO_ENGINE_LIBAIO = 0,
+  LOCAL_IO_ENGINE_IO_URING = 1,
+  LOCAL_IO_ENGINE_IO_URING_SQPOLL = 2,
+  LOCAL_IO_ENGINE_MAX
+};
+
+ObLocalIOEngine get_local_io_engine(const common::ObString &str);
+
 class ObLocalIOEvents : public common::ObIOEvents
 {
 public:
@@ -197,6 +225,10 @@ public:
   virtual common::ObIOEvents *alloc_io_events(const uint32_t max_events) override;
   virtual void free_iocb(common::ObIOCB *iocb) override;
   virtual void free_io_events(common::ObIOEvents *io_event) override;
+  // register the buffer into the io urings, the io inside the buffer uses the fixed opcodes.
+  // Does nothing with libaio.
+  int register_io_buffer(void *buf, const int64_t size);
+  void unregister_io_buffer(void *buf);
 
   // space management interface
   virtual int64_t get_total_block_size() const override;
@@ -217,9 +249,13 @@ private:
   int resize_block_file(const int64_t new_size);
   int64_t get_block_file_offset(const common::ObIOFd &fd, const int64_t offset);
   int try_punch_hole(const int64_t block_index);
+  int io_uring_setup(const uint32_t max_events, common::ObIOContext *&io_context);
+  void io_uring_destroy(ObLocalIOUringContext *uring_context);
+  int64_t get_fixed_buffer_index(const void *buf, const int64_t size) const;
 
 private:
   static const int64_t DEFUALT_PRE_ALLOCATED_IOCB_COUNT = 32 * 512;// 32 thread * max_io_depth
+  static const int64_t MAX_FIXED_BUFFER_SIZE = 1L << 30; // limited by the kernel
 
   bool is_inited_;
   bool is_marked_;
@@ -240,6 +276,12 @@ private:
   common::ObFIFOAllocator allocator_;
   ObIOCBPool<ObLocalIOCB> iocb_pool_;
   bool is_fs_support_punch_hole_;
+  ObLocalIOEngine io_engine_;
+  // buffers registered into all the io urings, a slot is free if its iov_base is null
+  lib::ObMutex fixed_buffer_lock_;
+  struct iovec fixed_buffers_[ObLocalIOUring::MAX_FIXED_BUFFER_CNT];
+  int64_t fixed_buffer_cnt_;
+  common::ObSEArray<ObLocalIOUringContext *, 16> uring_contexts_;
 };
 
 OB_INLINE int64_t ObLocalDevice::get_block_file_offset(const common::ObIOFd &fd, const int64_t offset)
@@ -0,0 +1,401 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SHARE
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#include "share/ob_local_io_uring.h"
+#include "share/ob_io_device_helper.h"
+#include "lib/thread/thread.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace share {
+
+static int sys_io_uring_setup(const uint32_t entries, struct io_uring_params *params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int sys_io_uring_enter(const int fd,
+                              const uint32_t to_submit,
+                              const uint32_t min_complete,
+                              const uint32_t flags,
+                              const void *arg,
+                              const size_t arg_size)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                                    arg, arg_size));
+}
+
+static int sys_io_uring_register(const int fd,
+                                 const uint32_t opcode,
+                                 const void *arg,
+                                 const uint32_t nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+ObLocalIOUring::ObLocalIOUring()
+  : is_inited_(false),
+    ring_fd_(-1),
+    sq_entries_(0),
+    cq_entries_(0),
+    use_sqpoll_(false),
+    support_fixed_buffer_(false),
+    sq_lock_(),
+    sq_ring_ptr_(nullptr),
+    sq_ring_size_(0),
+    cq_ring_ptr_(nullptr),
+    cq_ring_size_(0),
+    sqes_(nullptr),
+    sqes_size_(0),
+    sq_head_(nullptr),
+    sq_tail_(nullptr),
+    sq_mask_(nullptr),
+    sq_flags_(nullptr),
+    sq_array_(nullptr),
+    cq_head_(nullptr),
+    cq_tail_(nullptr),
+    cq_mask_(nullptr),
+    cqes_(nullptr)
+{
+}
+
+ObLocalIOUring::~ObLocalIOUring()
+{
+  destroy();
+}
+
+int ObLocalIOUring::init(const uint32_t entries, const bool use_sqpoll)
+{
+  int ret = OB_SUCCESS;
+  struct io_uring_params params;
+  MEMSET(&params, 0, sizeof(params));
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("io uring init twice", K(ret));
+  } else if (OB_UNLIKELY(0 == entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(entries));
+  } else {
+    if (use_sqpoll) {
+      static const uint32_t SQPOLL_IDLE_MS = 1000;
+      params.flags |= IORING_SETUP_SQPOLL;
+      params.sq_thread_idle = SQPOLL_IDLE_MS;
+    }
+    if ((ring_fd_ = sys_io_uring_setup(entries, &params)) < 0) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno(errno);
+      LOG_WARN("fail to setup io uring", K(ret), K(entries), K(use_sqpoll), KERRMSG);
+    } else if (OB_UNLIKELY(0 == (params.features & IORING_FEAT_EXT_ARG))) {
+      // the get_events thread waits with timeout, which needs IORING_ENTER_EXT_ARG (5.11)
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("io uring of this kernel does not support waiting with timeout", K(ret),
+               K(params.features));
+    } else if (OB_FAIL(map_rings(&params))) {
+      LOG_WARN("fail to map io uring", K(ret));
+    } else {
+      sq_entries_ = params.sq_entries;
+      cq_entries_ = params.cq_entries;
+      use_sqpoll_ = use_sqpoll;
+      struct io_uring_rsrc_register reg;
+      MEMSET(&reg, 0, sizeof(reg));
+      reg.nr = MAX_FIXED_BUFFER_CNT;
+      reg.flags = IORING_RSRC_REGISTER_SPARSE;
+      if (sys_io_uring_register(ring_fd_, IORING_REGISTER_BUFFERS2, &reg, sizeof(reg)) < 0) {
+        // sparse buffer table needs 5.19, io works without fixed buffers
+        support_fixed_buffer_ = false;
+        LOG_INFO("io uring does not support fixed buffer", K(errno));
+      } else {
+        support_fixed_buffer_ = true;
+      }
+      is_inited_ = true;
+      LOG_INFO("succ to init io uring", KPC(this));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObLocalIOUring::destroy()
+{
+  unmap_rings();
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  use_sqpoll_ = false;
+  support_fixed_buffer_ = false;
+  is_inited_ = false;
+}
+
+int ObLocalIOUring::map_rings(const void *params)
+{
+  int ret = OB_SUCCESS;
+  const struct io_uring_params *p = static_cast<const struct io_uring_params *>(params);
+  const bool single_mmap = 0 != (p->features & IORING_FEAT_SINGLE_MMAP);
+  sq_ring_size_ = p->sq_off.array + p->sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sqes_size_ = p->sq_entries * sizeof(struct io_uring_sqe);
+  void *ptr = nullptr;
+  if (MAP_FAILED == (ptr = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING))) {
+    ret = ObIODeviceLocalFileOp::convert_sys_errno(errno);
+    LOG_WARN("fail to mmap sq ring", K(ret), K_(sq_ring_size), KERRMSG);
+  } else if (FALSE_IT(sq_ring_ptr_ = ptr)) {
+  } else if (single_mmap) {
+    cq_ring_ptr_ = sq_ring_ptr_;
+  } else if (MAP_FAILED == (ptr = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING))) {
+    ret = ObIODeviceLocalFileOp::convert_sys_errno(errno);
+    LOG_WARN("fail to mmap cq ring", K(ret), K_(cq_ring_size), KERRMSG);
+  } else {
+    cq_ring_ptr_ = ptr;
+  }
+  if (OB_FAIL(ret)) {
+  } else if (MAP_FAILED == (ptr = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES))) {
+    ret = ObIODeviceLocalFileOp::convert_sys_errno(errno);
+    LOG_WARN("fail to mmap sqes", K(ret), K_(sqes_size), KERRMSG);
+  } else {
+    char *sq = static_cast<char *>(sq_ring_ptr_);
+    char *cq = static_cast<char *>(cq_ring_ptr_);
+    sqes_ = static_cast<struct io_uring_sqe *>(ptr);
+    sq_head_ = reinterpret_cast<uint32_t *>(sq + p->sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t *>(sq + p->sq_off.tail);
+    sq_mask_ = reinterpret_cast<uint32_t *>(sq + p->sq_off.ring_mask);
+    sq_flags_ = reinterpret_cast<uint32_t *>(sq + p->sq_off.flags);
+    sq_array_ = reinterpret_cast<uint32_t *>(sq + p->sq_off.array);
+    cq_head_ = reinterpret_cast<uint32_t *>(cq + p->cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t *>(cq + p->cq_off.tail);
+    cq_mask_ = reinterpret_cast<uint32_t *>(cq + p->cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq + p->cq_off.cqes);
+  }
+  return ret;
+}
+
+void ObLocalIOUring::unmap_rings()
+{
+  if (nullptr != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (nullptr != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  cq_ring_ptr_ = nullptr;
+  if (nullptr != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+    sq_ring_ptr_ = nullptr;
+  }
+  sq_ring_size_ = 0;
+  cq_ring_size_ = 0;
+  sqes_size_ = 0;
+  sq_head_ = nullptr;
+  sq_tail_ = nullptr;
+  sq_mask_ = nullptr;
+  sq_flags_ = nullptr;
+  sq_array_ = nullptr;
+  cq_head_ = nullptr;
+  cq_tail_ = nullptr;
+  cq_mask_ = nullptr;
+  cqes_ = nullptr;
+}
+
+uint32_t ObLocalIOUring::get_unsubmitted_cnt() const
+{
+  // the tail is published by the senders under sq_lock_, which is not held here
+  uint32_t cnt = 0;
+  if (!use_sqpoll_) {
+    const uint32_t tail = __atomic_load_n(sq_tail_, __ATOMIC_ACQUIRE);
+    cnt = tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  }
+  return cnt;
+}
+
+int ObLocalIOUring::enter(const uint32_t to_submit,
+                          const uint32_t min_complete,
+                          const uint32_t flags,
+                          const struct timespec *timeout)
+{
+  int ret = OB_SUCCESS;
+  int sys_ret = 0;
+  if (nullptr == timeout) {
+    sys_ret = sys_io_uring_enter(ring_fd_, to_submit, min_complete, flags, nullptr, 0);
+  } else {
+    struct __kernel_timespec ts;
+    ts.tv_sec = timeout->tv_sec;
+    ts.tv_nsec = timeout->tv_nsec;
+    struct io_uring_getevents_arg arg;
+    MEMSET(&arg, 0, sizeof(arg));
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+    sys_ret = sys_io_uring_enter(ring_fd_, to_submit, min_complete, flags | IORING_ENTER_EXT_ARG,
+                                 &arg, sizeof(arg));
+  }
+  if (sys_ret < 0) {
+    ret = ObIODeviceLocalFileOp::convert_sys_errno(errno);
+  }
+  return ret;
+}
+
+int ObLocalIOUring::submit(const struct iocb &cb, const int64_t buf_index)
+{
+  int ret = OB_SUCCESS;
+  const bool is_read = IO_CMD_PREAD == cb.aio_lio_opcode;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (OB_UNLIKELY(!is_read && IO_CMD_PWRITE != cb.aio_lio_opcode)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("only pread and pwrite are supported", K(ret), K(cb.aio_lio_opcode));
+  } else {
+    {
+      ObSpinLockGuard guard(sq_lock_);
+      const uint32_t tail = *sq_tail_;
+      if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+        ret = OB_EAGAIN;
+      } else {
+        const uint32_t idx = tail & *sq_mask_;
+        struct io_uring_sqe *sqe = &sqes_[idx];
+        MEMSET(sqe, 0, sizeof(*sqe));
+        if (NO_FIXED_BUFFER == buf_index) {
+          sqe->opcode = is_read ? IORING_OP_READ : IORING_OP_WRITE;
+        } else {
+          sqe->opcode = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+          sqe->buf_index = static_cast<uint16_t>(buf_index);
+        }
+        sqe->fd = cb.aio_fildes;
+        sqe->addr = reinterpret_cast<uint64_t>(cb.u.c.buf);
+        sqe->len = static_cast<uint32_t>(cb.u.c.nbytes);
+        sqe->off = static_cast<uint64_t>(cb.u.c.offset);
+        sqe->user_data = reinterpret_cast<uint64_t>(cb.data);
+        sq_array_[idx] = idx;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+      }
+    }
+    // The syscall is made without sq_lock_, so the other senders only wait for the sqe to be
+    // published. Once the sqe is published it will be submitted sooner or later, by this enter,
+    // the enter of another sender or the get_events thread when it waits, so the failure of
+    // enter is not returned.
+    if (OB_SUCC(ret)) {
+      int tmp_ret = OB_SUCCESS;
+      if (!use_sqpoll_) {
+        const uint32_t to_submit = get_unsubmitted_cnt();
+        if (to_submit > 0) {
+          tmp_ret = enter(to_submit, 0, 0, nullptr);
+        }
+      } else {
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (0 != (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP)) {
+          tmp_ret = enter(0, 0, IORING_ENTER_SQ_WAKEUP, nullptr);
+        }
+      }
+      if (OB_UNLIKELY(OB_SUCCESS != tmp_ret)) {
+        LOG_WARN("fail to enter io uring, retry later", K(tmp_ret), KERRMSG);
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObLocalIOUring::peek_events(const int64_t max_events, struct io_event *events)
+{
+  int64_t cnt = 0;
+  uint32_t head = *cq_head_;
+  const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail && cnt < max_events; ++head, ++cnt) {
+    const struct io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+    events[cnt].data = reinterpret_cast<void *>(cqe->user_data);
+    events[cnt].obj = nullptr;
+    events[cnt].res = cqe->res;
+    events[cnt].res2 = 0;
+  }
+  if (cnt > 0) {
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+  return cnt;
+}
+
+int ObLocalIOUring::get_events(const int64_t min_nr,
+                               const int64_t max_events,
+                               struct io_event *events,
+                               const struct timespec *timeout,
+                               int64_t &complete_cnt)
+{
+  int ret = OB_SUCCESS;
+  complete_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (OB_UNLIKELY(min_nr < 0 || max_events <= 0 || nullptr == events)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(min_nr), K(max_events), KP(events));
+  } else if (0 == (complete_cnt = peek_events(max_events, events)) && min_nr > 0) {
+    int sys_errno = 0;
+    {
+      oceanbase::lib::Thread::WaitGuard guard(oceanbase::lib::Thread::WAIT_FOR_IO_EVENT);
+      do {
+        ret = enter(get_unsubmitted_cnt(), static_cast<uint32_t>(min_nr),
+                    IORING_ENTER_GETEVENTS, timeout);
+        sys_errno = OB_SUCC(ret) ? 0 : errno;
+      } while (EINTR == sys_errno); // ignore EINTR
+    }
+    if (ETIME == sys_errno) {
+      // no io returns before timeout
+      ret = OB_SUCCESS;
+    } else if (OB_FAIL(ret)) {
+      LOG_WARN("fail to wait io uring events", K(ret), KERRMSG);
+    }
+    complete_cnt = peek_events(max_events, events);
+  }
+  return ret;
+}
+
+int ObLocalIOUring::update_fixed_buffer(const int64_t slot, const struct iovec &iov)
+{
+  int ret = OB_SUCCESS;
+  struct io_uring_rsrc_update2 update;
+  MEMSET(&update, 0, sizeof(update));
+  update.offset = static_cast<uint32_t>(slot);
+  update.data = reinterpret_cast<uint64_t>(&iov);
+  update.nr = 1;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (OB_UNLIKELY(!support_fixed_buffer_)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (OB_UNLIKELY(slot < 0 || slot >= MAX_FIXED_BUFFER_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(slot));
+  } else if (sys_io_uring_register(ring_fd_, IORING_REGISTER_BUFFERS_UPDATE,
+                                   &update, sizeof(update)) < 0) {
+    // ENOMEM if the buffer is over RLIMIT_MEMLOCK
+    ret = ObIODeviceLocalFileOp::convert_sys_errno(errno);
+    LOG_WARN("fail to update io uring fixed buffer", K(ret), K(slot), KP(iov.iov_base),
+             K(iov.iov_len), KERRMSG);
+  }
+  return ret;
+}
+
+} /* namespace share */
+} /* namespace oceanbase */
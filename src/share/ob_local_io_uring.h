@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef SRC_SHARE_OB_LOCAL_IO_URING_H_
+#define SRC_SHARE_OB_LOCAL_IO_URING_H_
+
+#include <libaio.h>
+#include <sys/uio.h>
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/utility/ob_print_utils.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace oceanbase {
+namespace share {
+
+// A minimal io_uring driven by the raw syscalls, one for each async io channel.
+//
+// The submission queue has many producers (the io senders), so publishing an sqe is guarded by
+// a spin lock, and the syscall to submit it is made after the lock is released.
+// The completion queue has only one consumer, the get_events thread of the channel, so it is
+// read without lock. With SQPOLL, a kernel thread polls the submission queue and submitting
+// needs no syscall unless the thread has gone to sleep.
+//
+// Buffers are registered into a sparse table of MAX_FIXED_BUFFER_CNT slots, read and write
+// of a buffer inside a registered one use the fixed opcodes, which skip pinning the pages for
+// each io.
+class ObLocalIOUring final
+{
+public:
+  static const int64_t MAX_FIXED_BUFFER_CNT = 64;
+  static const int64_t NO_FIXED_BUFFER = -1;
+
+  ObLocalIOUring();
+  ~ObLocalIOUring();
+  int init(const uint32_t entries, const bool use_sqpoll);
+  void destroy();
+  // submit one libaio iocb prepared by ObLocalDevice, buf_index is NO_FIXED_BUFFER or the
+  // slot of the registered buffer which contains the io buffer.
+  int submit(const struct iocb &cb, const int64_t buf_index);
+  // reap at most max_events completions into events, wait for at least min_nr of them until
+  // timeout if none is ready.
+  int get_events(const int64_t min_nr,
+                 const int64_t max_events,
+                 struct io_event *events,
+                 const struct timespec *timeout,
+                 int64_t &complete_cnt);
+  int update_fixed_buffer(const int64_t slot, const struct iovec &iov);
+  bool support_fixed_buffer() const { return support_fixed_buffer_; }
+  TO_STRING_KV(K_(is_inited), K_(ring_fd), K_(sq_entries), K_(cq_entries), K_(use_sqpoll),
+               K_(support_fixed_buffer));
+
+private:
+  int map_rings(const void *params);
+  void unmap_rings();
+  int enter(const uint32_t to_submit,
+            const uint32_t min_complete,
+            const uint32_t flags,
+            const struct timespec *timeout);
+  int64_t peek_events(const int64_t max_events, struct io_event *events);
+  uint32_t get_unsubmitted_cnt() const;
+
+private:
+  bool is_inited_;
+  int ring_fd_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  bool use_sqpoll_;
+  bool support_fixed_buffer_;
+  common::ObSpinLock sq_lock_;
+  // mapped memory of the rings
+  void *sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  void *cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  struct io_uring_sqe *sqes_;
+  int64_t sqes_size_;
+  // pointers into the rings
+  uint32_t *sq_head_;
+  uint32_t *sq_tail_;
+  uint32_t *sq_mask_;
+  uint32_t *sq_flags_;
+  uint32_t *sq_array_;
+  uint32_t *cq_head_;
+  uint32_t *cq_tail_;
+  uint32_t *cq_mask_;
+  struct io_uring_cqe *cqes_;
+  DISALLOW_COPY_AND_ASSIGN(ObLocalIOUring);
+};
+
+} /* namespace share */
+} /* namespace oceanbase */
+
+#endif /* SRC_SHARE_OB_LOCAL_IO_URING_H_ */
@@ -985,6 +985,12 @@ DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8",
                      "[2,32]",
                      "The number of io threads on each disk. The default value is 8. Range: [2,32] in even integer",
                      ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_local_io_engine, OB_CLUSTER_PARAMETER, "LIBAIO",
+                     common::ObConfigLocalIOEngineChecker,
+                     "the async io engine of the local data disk. "
+                     "IO_URING_SQPOLL polls the submissions by a kernel thread for each io channel. "
+                     "values: LIBAIO, IO_URING, IO_URING_SQPOLL",
+                     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(sync_io_thread_count, OB_CLUSTER_PARAMETER, "0",
         "[0,1024]",
         "The number of io threads for synchronizing request on each device. The default value is 0. Range: [0,1024] in integer",
@@ -2172,6 +2178,10 @@ DEF_INT(ob_vector_memory_limit_percentage, OB_TENANT_PARAMETER, "0",
         "[0,100)",
         "Used to control the upper limit percentage of memory resources that the vector_index module can use. Range:[0, 100)",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_vector_index_parallel_search, OB_TENANT_PARAMETER, "True",
+         "specifies whether the delta index and the snapshot index of a vector index are searched in parallel "
+         "when the delta index is large",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_STR_WITH_CHECKER(ob_storage_s3_url_encode_type, OB_CLUSTER_PARAMETER, "default",
                      common::ObConfigS3URLEncodeTypeChecker,
@@ -630,6 +630,7 @@ enum ObSysVarClassType
   SYS_VAR_RANGE_INDEX_DIVE_LIMIT = 10740,
   SYS_VAR_PARTITION_INDEX_DIVE_LIMIT = 10741,
   SYS_VAR_OB_TABLE_ACCESS_POLICY = 10742,
+  SYS_VAR_OB_HNSW_TARGET_RECALL = 10743,
 };
 
 }
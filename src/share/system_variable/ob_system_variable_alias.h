@@ -625,6 +625,7 @@ namespace share
   static const char* const OB_SV_RANGE_INDEX_DIVE_LIMIT = "range_index_dive_limit";
   static const char* const OB_SV_PARTITION_INDEX_DIVE_LIMIT = "partition_index_dive_limit";
   static const char* const OB_SV_TABLE_ACCESS_POLICY = "ob_table_access_policy";
+  static const char* const OB_SV_HNSW_TARGET_RECALL = "ob_hnsw_target_recall";
 
 }
 }
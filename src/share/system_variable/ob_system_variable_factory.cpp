@@ -919,6 +919,7 @@ const char *ObSysVarFactory::SYS_VAR_NAMES_SORTED_BY_NAME[] = {
   "ob_enable_truncate_flashback",
   "ob_global_debug_sync",
   "ob_hnsw_ef_search",
+  "ob_hnsw_target_recall",
   "ob_interm_result_mem_limit",
   "ob_kv_mode",
   "ob_last_schema_version",
@@ -1531,6 +1532,7 @@ const ObSysVarClassType ObSysVarFactory::SYS_VAR_IDS_SORTED_BY_NAME[] = {
   SYS_VAR_OB_ENABLE_TRUNCATE_FLASHBACK,
   SYS_VAR_OB_GLOBAL_DEBUG_SYNC,
   SYS_VAR_OB_HNSW_EF_SEARCH,
+  SYS_VAR_OB_HNSW_TARGET_RECALL,
   SYS_VAR_OB_INTERM_RESULT_MEM_LIMIT,
   SYS_VAR_OB_KV_MODE,
   SYS_VAR_OB_LAST_SCHEMA_VERSION,
@@ -2348,7 +2350,8 @@ const char *ObSysVarFactory::SYS_VAR_NAMES_SORTED_BY_ID[] = {
   "auto_generate_certs",
   "range_index_dive_limit",
   "partition_index_dive_limit",
-  "ob_table_access_policy"
+  "ob_table_access_policy",
+  "ob_hnsw_target_recall"
 };
 
 bool ObSysVarFactory::sys_var_name_case_cmp(const char *name1, const ObString &name2)
@@ -3162,6 +3165,7 @@ int ObSysVarFactory::create_all_sys_vars()
         + sizeof(ObSysVarRangeIndexDiveLimit)
         + sizeof(ObSysVarPartitionIndexDiveLimit)
         + sizeof(ObSysVarObTableAccessPolicy)
+        + sizeof(ObSysVarObHnswTargetRecall)
         ;
     void *ptr = NULL;
     if (OB_ISNULL(ptr = allocator_.alloc(total_mem_size))) {
@@ -8651,6 +8655,15 @@ int ObSysVarFactory::create_all_sys_vars()
         ptr = (void *)((char *)ptr + sizeof(ObSysVarObTableAccessPolicy));
       }
     }
+    if (OB_SUCC(ret)) {
+      if (OB_ISNULL(sys_var_ptr = new (ptr)ObSysVarObHnswTargetRecall())) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_ERROR("fail to new ObSysVarObHnswTargetRecall", K(ret));
+      } else {
+        store_buf_[ObSysVarsToIdxMap::get_store_idx(static_cast<int64_t>(SYS_VAR_OB_HNSW_TARGET_RECALL))] = sys_var_ptr;
+        ptr = (void *)((char *)ptr + sizeof(ObSysVarObHnswTargetRecall));
+      }
+    }
 
   }
   return ret;
@@ -15360,6 +15373,17 @@ int ObSysVarFactory::create_sys_var(ObIAllocator &allocator_, ObSysVarClassType
       }
       break;
     }
+    case SYS_VAR_OB_HNSW_TARGET_RECALL: {
+      void *ptr = NULL;
+      if (OB_ISNULL(ptr = allocator_.alloc(sizeof(ObSysVarObHnswTargetRecall)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_ERROR("fail to alloc memory", K(ret), K(sizeof(ObSysVarObHnswTargetRecall)));
+      } else if (OB_ISNULL(sys_var_ptr = new (ptr)ObSysVarObHnswTargetRecall())) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_ERROR("fail to new ObSysVarObHnswTargetRecall", K(ret));
+      }
+      break;
+    }
 
     default: {
       ret = OB_ERR_UNEXPECTED;
@@ -4444,6 +4444,13 @@ public:
   inline virtual ObSysVarClassType get_type() const { return SYS_VAR_OB_TABLE_ACCESS_POLICY; }
   inline virtual const common::ObObj &get_global_default_value() const { return ObSysVariables::get_default_value(608); }
 };
+class ObSysVarObHnswTargetRecall : public ObIntSysVar
+{
+public:
+  ObSysVarObHnswTargetRecall() : ObIntSysVar(NULL, NULL, NULL, NULL, NULL) {}
+  inline virtual ObSysVarClassType get_type() const { return SYS_VAR_OB_HNSW_TARGET_RECALL; }
+  inline virtual const common::ObObj &get_global_default_value() const { return ObSysVariables::get_default_value(609); }
+};
 
 
 class ObSysVarFactory
@@ -4467,7 +4474,7 @@ private:
 
 public:
   const static int64_t MYSQL_SYS_VARS_COUNT = 99;
-  const static int64_t OB_SYS_VARS_COUNT = 510;
+  const static int64_t OB_SYS_VARS_COUNT = 511;
   const static int64_t ALL_SYS_VARS_COUNT = MYSQL_SYS_VARS_COUNT + OB_SYS_VARS_COUNT;
   const static int64_t INVALID_MAX_READ_STALE_TIME = -1;
 
@@ -8480,13 +8480,28 @@ static struct VarsInit{
     ObSysVars[608].alias_ = "OB_SV_TABLE_ACCESS_POLICY" ;
     }();
 
+    [&] (){
+      ObSysVars[609].default_value_ = "0" ;
+      ObSysVars[609].info_ = "The recall percent that HNSW vector index searches on the session try to reach by choosing ef_search per query, 0 means ob_hnsw_ef_search is used" ;
+      ObSysVars[609].name_ = "ob_hnsw_target_recall" ;
+      ObSysVars[609].data_type_ = ObUInt64Type ;
+      ObSysVars[609].min_val_ = "0" ;
+      ObSysVars[609].max_val_ = "100" ;
+      ObSysVars[609].flags_ = ObSysVarFlag::SESSION_SCOPE ;
+      ObSysVars[609].id_ = SYS_VAR_OB_HNSW_TARGET_RECALL ;
+      cur_max_var_id = MAX(cur_max_var_id, static_cast<int64_t>(SYS_VAR_OB_HNSW_TARGET_RECALL)) ;
+      ObSysVarsIdToArrayIdx[SYS_VAR_OB_HNSW_TARGET_RECALL] = 609 ;
+      ObSysVars[609].base_value_ = "0" ;
+    ObSysVars[609].alias_ = "OB_SV_HNSW_TARGET_RECALL" ;
+    }();
+
     if (cur_max_var_id >= ObSysVarFactory::OB_MAX_SYS_VAR_ID) { 
       HasInvalidSysVar = true;
     }
   }
 }vars_init;
 
-static int64_t var_amount = 609;
+static int64_t var_amount = 610;
 
 int64_t ObSysVariables::get_all_sys_var_count(){ return ObSysVarFactory::ALL_SYS_VARS_COUNT;}
 ObSysVarClassType ObSysVariables::get_sys_var_id(int64_t i){ return ObSysVars[i].id_;}
@@ -22,9 +22,13 @@
 #include "share/vector_index/ob_vector_index_util.h"
 #include "sql/das/ob_das_dml_vec_iter.h"
 #include "lib/vector/ob_vector_util.h"
+#include "share/vector_index/ob_plugin_vector_index_utils.h"
+#include "share/vector_index/ob_plugin_vector_index_service.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "lib/random/ob_random.h"
 #include "lib/roaringbitmap/ob_roaringbitmap.h"
 #include "lib/roaringbitmap/ob_rb_memory_mgr.h"
+#include "storage/tx/ob_trans_service.h"
 
 namespace oceanbase
 {
@@ -82,7 +86,9 @@ OB_DEF_SERIALIZE_SIZE(ObVectorIndexHNSWParam)
               dim_,
               m_,
               ef_construction_,
-              ef_search_);
+              ef_search_,
+              build_thread_num_,
+              element_type_);
   return len;
 }
 
@@ -96,7 +102,9 @@ OB_DEF_SERIALIZE(ObVectorIndexHNSWParam)
               dim_,
               m_,
               ef_construction_,
-              ef_search_);
+              ef_search_,
+              build_thread_num_,
+              element_type_);
   return ret;
 }
 
@@ -110,6 +118,8 @@ OB_DEF_DESERIALIZE(ObVectorIndexAlgorithmHeader)
 OB_DEF_DESERIALIZE(ObVectorIndexHNSWParam)
 {
   int ret = OB_SUCCESS;
+  // params serialized before the element type was added store float32 vectors
+  element_type_ = VIET_FLOAT32;
   LST_DO_CODE(OB_UNIS_DECODE,
               type_,
               lib_,
@@ -117,7 +127,9 @@ OB_DEF_DESERIALIZE(ObVectorIndexHNSWParam)
               dim_,
               m_,
               ef_construction_,
-              ef_search_);
+              ef_search_,
+              build_thread_num_,
+              element_type_);
   return ret;
 }
 
@@ -280,8 +292,13 @@ ObPluginVectorIndexAdaptor::ObPluginVectorIndexAdaptor(common::ObIAllocator *all
     snapshot_table_id_(OB_INVALID_ID), data_table_id_(OB_INVALID_ID),
     rowkey_vid_table_id_(OB_INVALID_ID), vid_rowkey_table_id_(OB_INVALID_ID),
     ref_cnt_(0), idle_cnt_(0), mem_check_cnt_(0), is_mem_limited_(false), all_vsag_use_mem_(nullptr), allocator_(allocator),
-    parent_mem_ctx_(entity), index_identity_(), follower_sync_statistics_()
+    parent_mem_ctx_(entity), index_identity_(), follower_sync_statistics_(),
+    delta_dml_seq_(0), delta_cache_rwlock_(), delta_cache_scn_(),
+    delta_cache_dml_seq_(-1), delta_cache_commit_version_(), delta_cache_bitmaps_(nullptr),
+    snap_removed_index_(nullptr), snap_removed_vids_(nullptr), snap_removed_cnt_(0),
+    ef_calibrate_rwlock_(), ef_calibrated_cnt_(0)
 {
+  MEMSET(ef_recalls_, 0, sizeof(ef_recalls_));
 }
 
 ObPluginVectorIndexAdaptor::~ObPluginVectorIndexAdaptor()
@@ -306,6 +323,9 @@ ObPluginVectorIndexAdaptor::~ObPluginVectorIndexAdaptor()
     LOG_WARN("failed to free snap memdata", K(ret), KPC(this));
   }
 
+  free_delta_bitmap_cache();
+  free_snap_removed_vids();
+
   // use another memdata struct for the following?
   if (OB_NOT_NULL(allocator_)) {
     if(!index_identity_.empty()) {
@@ -452,7 +472,9 @@ int ObPluginVectorIndexAdaptor::param_deserialize(char *ptr, int32_t length,
   } else {
     type = header.type_;
     switch(type) {
-      case VIAT_HNSW: {
+      case VIAT_HNSW:
+      case VIAT_HNSW_SQ:
+      case VIAT_DISKANN: {
         int64_t param_pos = 0;
         ObVectorIndexHNSWParam *hnsw_param = nullptr;
         if (OB_ISNULL(hnsw_param = static_cast<ObVectorIndexHNSWParam *>
@@ -489,7 +511,7 @@ int ObPluginVectorIndexAdaptor::get_dim(int64_t &dim)
 {
   INIT_SUCC(ret);
   // TODO [WORKDOC] work document NO.1
-  if (type_ == VIAT_HNSW) {
+  if (type_ == VIAT_HNSW || type_ == VIAT_HNSW_SQ || type_ == VIAT_DISKANN) {
     ObVectorIndexHNSWParam *param = nullptr;
     if (OB_ISNULL(param = static_cast<ObVectorIndexHNSWParam*>(algo_data_))) {
       ret = OB_ERR_UNEXPECTED;
@@ -507,7 +529,7 @@ int ObPluginVectorIndexAdaptor::get_dim(int64_t &dim)
 int ObPluginVectorIndexAdaptor::get_hnsw_param(ObVectorIndexHNSWParam *&param)
 {
   INIT_SUCC(ret);
-  if (type_ == VIAT_HNSW) {
+  if (type_ == VIAT_HNSW || type_ == VIAT_HNSW_SQ || type_ == VIAT_DISKANN) {
     if (OB_ISNULL(param = static_cast<ObVectorIndexHNSWParam*>(algo_data_))) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("failed to get param.", K(ret));
@@ -612,11 +634,24 @@ int ObPluginVectorIndexAdaptor::fill_vector_index_info(ObVectorIndexInfo &info)
   return ret;
 }
 
+// diskann can only be built once, so the incremental index of a diskann index is still hnsw,
+// only the snapshot index is built as diskann
+static int get_vsag_index_type(const ObVectorIndexAlgorithmType type,
+                               const ObVectorIndexRecordType record_type)
+{
+  int index_type = obvectorlib::HNSW_TYPE;
+  if (VIAT_HNSW_SQ == type) {
+    index_type = obvectorlib::HNSW_SQ_TYPE;
+  } else if (VIAT_DISKANN == type && VIRT_SNAP == record_type) {
+    index_type = obvectorlib::DISKANN_TYPE;
+  }
+  return index_type;
+}
+
 int ObPluginVectorIndexAdaptor::init_mem_data(ObVectorIndexRecordType type)
 {
   INIT_SUCC(ret);
   ObVectorIndexHNSWParam *param = nullptr;
-  const char* const DATATYPE_FLOAT32 = "float32";
   if (OB_FAIL(get_hnsw_param(param))) {
     LOG_WARN("get hnsw param failed.", K(ret));
   } else if (OB_FAIL(check_vsag_mem_used())) {
@@ -629,14 +664,15 @@ int ObPluginVectorIndexAdaptor::init_mem_data(ObVectorIndexRecordType type)
       } else {
         lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
         if (OB_FAIL(obvectorutil::create_index(incr_data_->index_,
-                                                      obvectorlib::HNSW_TYPE,
-                                                      DATATYPE_FLOAT32,
+                                                      get_vsag_index_type(param->type_, type),
+                                                      VEC_INDEX_ELEMENT_TYPE[param->element_type_],
                                                       VEC_INDEX_ALGTH[param->dist_algorithm_],
                                                       param->dim_,
                                                       param->m_,
                                                       param->ef_construction_,
                                                       param->ef_search_,
-                                                      incr_data_->mem_ctx_))) {
+                                                      incr_data_->mem_ctx_,
+                                                      param->build_thread_num_))) {
           ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
           LOG_WARN("failed to create vsag index.", K(ret));
         }
@@ -705,14 +741,15 @@ int ObPluginVectorIndexAdaptor::init_mem_data(ObVectorIndexRecordType type)
       } else {
         lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
         if (OB_FAIL(obvectorutil::create_index(snap_data_->index_,
-                                               obvectorlib::HNSW_TYPE,
-                                               DATATYPE_FLOAT32,
+                                               get_vsag_index_type(param->type_, type),
+                                               VEC_INDEX_ELEMENT_TYPE[param->element_type_],
                                                VEC_INDEX_ALGTH[param->dist_algorithm_],
                                                param->dim_,
                                                param->m_,
                                                param->ef_construction_,
                                                param->ef_search_,
-                                               snap_data_->mem_ctx_))) {
+                                               snap_data_->mem_ctx_,
+                                               param->build_thread_num_))) {
           ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
           LOG_WARN("failed to create vsag index.", K(ret), K(snap_data_->index_), KPC(param));
         }
@@ -822,6 +859,7 @@ int ObPluginVectorIndexAdaptor::insert_rows(blocksstable::ObDatumRow *rows,
     LOG_WARN("failed to init incr index.", K(ret));
   } else if (row_count <= 0) {
     // do nothing
+  } else if (OB_FALSE_IT(ATOMIC_INC(&delta_dml_seq_))) {
   } else if (OB_FAIL(get_dim(dim))) {
     LOG_WARN("get dim failed.", K(ret));
   } else {
@@ -905,6 +943,19 @@ int ObPluginVectorIndexAdaptor::insert_rows(blocksstable::ObDatumRow *rows,
       }
       ROARING_TRY_CATCH(roaring::api::roaring64_bitmap_add_many(incr_data_->bitmap_->insert_bitmap_, null_vid_count, null_vids));
     }
+    if (OB_SUCC(ret) && del_vid_count > 0) {
+      // record deleted vids, used to check whether a delta buffer scan sees every dml
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+      TCWLockGuard lock_guard(incr_data_->bitmap_rwlock_);
+      if (OB_ISNULL(incr_data_->bitmap_->delete_bitmap_)) {
+        ROARING_TRY_CATCH(incr_data_->bitmap_->delete_bitmap_ = roaring::api::roaring64_bitmap_create());
+        if (OB_SUCC(ret) && OB_ISNULL(incr_data_->bitmap_->delete_bitmap_)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("failed to create incr delete bitmap", K(ret));
+        }
+      }
+      ROARING_TRY_CATCH(roaring::api::roaring64_bitmap_add_many(incr_data_->bitmap_->delete_bitmap_, del_vid_count, del_vids));
+    }
   }
 
   return ret;
@@ -952,10 +1003,12 @@ int ObPluginVectorIndexAdaptor::add_snap_index(float *vectors, int64_t *vids, in
 // Query Processor first
 int ObPluginVectorIndexAdaptor::check_delta_buffer_table_readnext_status(ObVectorQueryAdaptorResultContext *ctx,
                                                                          common::ObNewRowIterator *row_iter,
-                                                                         SCN query_scn)
+                                                                         SCN query_scn,
+                                                                         const bool use_delta_cache)
 {
   INIT_SUCC(ret);
   SCN min_delta_scn;
+  bool is_hit = false;
 
   // TODO 优先判断是否需要等待 PVQ_WAIT
   if (OB_ISNULL(ctx) || OB_ISNULL(row_iter)) {
@@ -963,7 +1016,16 @@ int ObPluginVectorIndexAdaptor::check_delta_buffer_table_readnext_status(ObVecto
     LOG_WARN("get ctx or row_iter invalid.", K(ret), KP(row_iter));
   } else if (OB_FAIL(ctx->init_bitmaps())) {
     LOG_WARN("failed to init ctx bitmaps.", K(ret));
+  } else if (use_delta_cache && OB_FAIL(get_cached_delta_bitmaps(ctx, query_scn, is_hit))) {
+    LOG_WARN("failed to get cached delta bitmaps.", K(ret));
+  } else if (is_hit) {
+    ctx->status_ = PVQ_LACK_SCN;
   } else {
+    const int64_t scan_dml_seq = ATOMIC_LOAD(&delta_dml_seq_);
+    SCN scan_commit_version;
+    if (use_delta_cache && OB_SUCCESS != get_committed_data_version(scan_commit_version)) {
+      scan_commit_version.reset();
+    }
     ObTableScanIterator *table_scan_iter = static_cast<ObTableScanIterator *>(row_iter);
     while (OB_SUCC(ret)) {
       blocksstable::ObDatumRow *datum_row = nullptr;
@@ -1013,12 +1075,159 @@ int ObPluginVectorIndexAdaptor::check_delta_buffer_table_readnext_status(ObVecto
 
     if (OB_SUCC(ret)) {
       ctx->status_ = PVQ_LACK_SCN;
+      // cache is only an optimization, ignore failure
+      int tmp_ret = OB_SUCCESS;
+      if (!use_delta_cache || !scan_commit_version.is_valid()) {
+        // the scan may see uncommitted rows of the reader's own transaction
+      } else if (OB_SUCCESS != (tmp_ret = try_cache_delta_bitmaps(ctx, query_scn, scan_dml_seq, scan_commit_version))) {
+        LOG_WARN("failed to cache delta bitmaps", K(tmp_ret));
+      }
     }
   }
 
   return ret;
 }
 
+int ObPluginVectorIndexAdaptor::get_cached_delta_bitmaps(ObVectorQueryAdaptorResultContext *ctx,
+                                                         SCN query_scn,
+                                                         bool &is_hit)
+{
+  INIT_SUCC(ret);
+  is_hit = false;
+  SCN commit_version;
+  TCRLockGuard lock_guard(delta_cache_rwlock_);
+  if (OB_ISNULL(delta_cache_bitmaps_)) {
+    // no cache yet
+  } else if (delta_cache_dml_seq_ != ATOMIC_LOAD(&delta_dml_seq_)
+             || !query_scn.is_valid() || query_scn < delta_cache_scn_) {
+    // new dml arrived since the cache was built, or the query reads an older version
+  } else if (OB_SUCCESS != get_committed_data_version(commit_version)
+             || commit_version > query_scn) {
+    // some committed data is newer than the query snapshot, which can't be told apart from the cache
+  } else {
+    lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+    ROARING_TRY_CATCH(roaring::api::roaring64_bitmap_or_inplace(ctx->bitmaps_->insert_bitmap_,
+                                                                delta_cache_bitmaps_->insert_bitmap_));
+    ROARING_TRY_CATCH(roaring::api::roaring64_bitmap_or_inplace(ctx->bitmaps_->delete_bitmap_,
+                                                                delta_cache_bitmaps_->delete_bitmap_));
+    if (OB_SUCC(ret)) {
+      is_hit = true;
+      LOG_TRACE("hit delta bitmap cache", K(query_scn), K(commit_version), K_(delta_cache_scn),
+                K_(delta_cache_dml_seq), K_(delta_cache_commit_version));
+    }
+  }
+  return ret;
+}
+
+// The delta buffer table can't be scanned from a given scn, so the scanned bitmaps are cached
+// only when they already contain every dml applied to this adaptor, that is the scanned insert
+// bitmap equals the incr one and every deleted vid is visible. The scan must also cover all data
+// committed before it started, and must not come from a transaction that wrote rows itself.
+// Any later dml, replayed sync log or role change invalidates the cache.
+int ObPluginVectorIndexAdaptor::try_cache_delta_bitmaps(ObVectorQueryAdaptorResultContext *ctx,
+                                                        SCN query_scn,
+                                                        int64_t scan_dml_seq,
+                                                        SCN scan_commit_version)
+{
+  INIT_SUCC(ret);
+  bool is_complete = false;
+  if (OB_ISNULL(ctx) || OB_ISNULL(ctx->bitmaps_) || !query_scn.is_valid() || !scan_commit_version.is_valid()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(ctx), K(query_scn), K(scan_commit_version));
+  } else if (scan_commit_version > query_scn) {
+    // the snapshot is older than some committed data
+  } else if (OB_ISNULL(allocator_) || !is_mem_data_init_atomic(VIRT_INC) || OB_ISNULL(incr_data_->bitmap_)) {
+    // do nothing
+  } else {
+    TCRLockGuard rd_bitmap_lock_guard(incr_data_->bitmap_rwlock_);
+    roaring::api::roaring64_bitmap_t *incr_dbitmap = incr_data_->bitmap_->delete_bitmap_;
+    is_complete = roaring::api::roaring64_bitmap_equals(ctx->bitmaps_->insert_bitmap_,
+                                                        incr_data_->bitmap_->insert_bitmap_)
+                  && (OB_ISNULL(incr_dbitmap)
+                      || roaring::api::roaring64_bitmap_is_subset(incr_dbitmap, ctx->bitmaps_->delete_bitmap_));
+  }
+
+  if (OB_SUCC(ret) && is_complete) {
+    TCWLockGuard lock_guard(delta_cache_rwlock_);
+    ObVectorIndexRoaringBitMap *bitmaps = delta_cache_bitmaps_;
+    if (scan_dml_seq != ATOMIC_LOAD(&delta_dml_seq_)) {
+      // dml arrived during the scan
+    } else if (OB_ISNULL(bitmaps)
+               && OB_ISNULL(bitmaps = static_cast<ObVectorIndexRoaringBitMap *>
+                                      (allocator_->alloc(sizeof(ObVectorIndexRoaringBitMap))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc delta bitmap cache", K(ret));
+    } else {
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+      if (bitmaps != delta_cache_bitmaps_) {
+        bitmaps->insert_bitmap_ = nullptr;
+        bitmaps->delete_bitmap_ = nullptr;
+        delta_cache_bitmaps_ = bitmaps;
+      }
+      if (OB_NOT_NULL(bitmaps->insert_bitmap_)) {
+        roaring::api::roaring64_bitmap_free(bitmaps->insert_bitmap_);
+        bitmaps->insert_bitmap_ = nullptr;
+      }
+      if (OB_NOT_NULL(bitmaps->delete_bitmap_)) {
+        roaring::api::roaring64_bitmap_free(bitmaps->delete_bitmap_);
+        bitmaps->delete_bitmap_ = nullptr;
+      }
+      delta_cache_dml_seq_ = -1;
+      ROARING_TRY_CATCH(bitmaps->insert_bitmap_ = roaring::api::roaring64_bitmap_copy(ctx->bitmaps_->insert_bitmap_));
+      ROARING_TRY_CATCH(bitmaps->delete_bitmap_ = roaring::api::roaring64_bitmap_copy(ctx->bitmaps_->delete_bitmap_));
+      if (OB_SUCC(ret) && (OB_ISNULL(bitmaps->insert_bitmap_) || OB_ISNULL(bitmaps->delete_bitmap_))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to copy delta bitmaps", K(ret));
+      }
+      if (OB_SUCC(ret)) {
+        delta_cache_scn_ = query_scn;
+        delta_cache_commit_version_ = scan_commit_version;
+        delta_cache_dml_seq_ = scan_dml_seq;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObPluginVectorIndexAdaptor::get_committed_data_version(SCN &commit_version)
+{
+  INIT_SUCC(ret);
+  transaction::ObTransService *txs = MTL(transaction::ObTransService *);
+  if (OB_ISNULL(txs)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get null trans service", K(ret));
+  } else if (OB_FAIL(txs->get_max_commit_version(commit_version))) {
+    LOG_WARN("failed to get max commit version", K(ret));
+  }
+  return ret;
+}
+
+void ObPluginVectorIndexAdaptor::invalidate_delta_bitmap_cache()
+{
+  ATOMIC_INC(&delta_dml_seq_);
+}
+
+void ObPluginVectorIndexAdaptor::free_delta_bitmap_cache()
+{
+  TCWLockGuard lock_guard(delta_cache_rwlock_);
+  if (OB_NOT_NULL(delta_cache_bitmaps_)) {
+    lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+    if (OB_NOT_NULL(delta_cache_bitmaps_->insert_bitmap_)) {
+      roaring::api::roaring64_bitmap_free(delta_cache_bitmaps_->insert_bitmap_);
+      delta_cache_bitmaps_->insert_bitmap_ = nullptr;
+    }
+    if (OB_NOT_NULL(delta_cache_bitmaps_->delete_bitmap_)) {
+      roaring::api::roaring64_bitmap_free(delta_cache_bitmaps_->delete_bitmap_);
+      delta_cache_bitmaps_->delete_bitmap_ = nullptr;
+    }
+    if (OB_NOT_NULL(allocator_)) {
+      allocator_->free(delta_cache_bitmaps_);
+    }
+    delta_cache_bitmaps_ = nullptr;
+  }
+  delta_cache_dml_seq_ = -1;
+}
+
 int ObPluginVectorIndexAdaptor::write_into_delta_mem(ObVectorQueryAdaptorResultContext *ctx, int count, float *vectors,  uint64_t *vids)
 {
   INIT_SUCC(ret);
@@ -1584,6 +1793,174 @@ void ObPluginVectorIndexAdaptor::print_vectors(float *vecs, int64_t count, int64
   }
 }
 
+ObVsagDualSearchTask::ObVsagDualSearchTask(const uint64_t tenant_id, float *query_vector,
+                                           const int64_t dim, const int64_t topk, const int ef_search,
+                                           roaring::api::roaring64_bitmap_t *valid)
+  : tenant_id_(tenant_id), query_vector_(query_vector), dim_(dim), topk_(topk),
+    ef_search_(ef_search), valid_(valid), cond_(), next_search_(0), finished_cnt_(0),
+    ref_cnt_(1)
+{
+  MEMSET(searches_, 0, sizeof(searches_));
+  for (int64_t i = 0; i < SEARCH_NUM; ++i) {
+    bounds_[i].store(FLT_MAX);
+  }
+}
+
+ObVsagDualSearchTask::~ObVsagDualSearchTask()
+{
+  cond_.destroy();
+}
+
+int ObVsagDualSearchTask::create(const uint64_t tenant_id,
+                                 float *query_vector,
+                                 const int64_t dim,
+                                 const int64_t topk,
+                                 const int ef_search,
+                                 roaring::api::roaring64_bitmap_t *valid,
+                                 ObVsagDualSearchTask *&task)
+{
+  INIT_SUCC(ret);
+  void *buf = nullptr;
+  task = nullptr;
+  if (OB_ISNULL(buf = ob_malloc(sizeof(ObVsagDualSearchTask), ObMemAttr(tenant_id, "VIndexSearch")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc dual search task.", K(ret));
+  } else if (FALSE_IT(task = new(buf) ObVsagDualSearchTask(tenant_id, query_vector, dim, topk, ef_search, valid))) {
+  } else if (OB_FAIL(task->cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("failed to init cond of dual search task.", K(ret));
+    task->release();
+    task = nullptr;
+  }
+  return ret;
+}
+
+void ObVsagDualSearchTask::release()
+{
+  if (0 == ATOMIC_SAF(&ref_cnt_, 1)) {
+    this->~ObVsagDualSearchTask();
+    ob_free(this);
+  }
+}
+
+void ObVsagDualSearchTask::run()
+{
+  lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+  int64_t idx = 0;
+  while ((idx = ATOMIC_FAA(&next_search_, 1)) < SEARCH_NUM) {
+    Search &search = searches_[idx];
+    search.ret_ = obvectorutil::knn_search_batch(search.index_, query_vector_, 1, /* query_num */
+                                                 dim_, topk_, search.distances_,
+                                                 search.vids_, search.res_cnt_, ef_search_,
+                                                 search.filter_, &bounds_[SEARCH_NUM - 1 - idx],
+                                                 &bounds_[idx], valid_);
+    ObThreadCondGuard guard(cond_);
+    ++finished_cnt_;
+    cond_.signal();
+  }
+}
+
+void ObVsagDualSearchTask::wait()
+{
+  ObThreadCondGuard guard(cond_);
+  while (finished_cnt_ < SEARCH_NUM) {
+    cond_.wait();
+  }
+}
+
+// searching the two indexes at the same time costs two threads, it only pays off when the delta
+// index is large enough to take a noticeable part of the query
+bool ObPluginVectorIndexAdaptor::use_parallel_dual_search()
+{
+  static const int64_t PARALLEL_SEARCH_MIN_DELTA_CNT = 10000;
+  bool bret = false;
+  int64_t delta_cnt = 0;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+  if (!tenant_config.is_valid() || !tenant_config->_enable_vector_index_parallel_search) {
+  } else if (OB_SUCCESS != obvectorutil::get_index_number(get_incr_index(), delta_cnt)) {
+  } else {
+    bret = delta_cnt >= PARALLEL_SEARCH_MIN_DELTA_CNT;
+  }
+  return bret;
+}
+
+// the searches are kept open only for a query without valid vids, and not for diskann whose
+// snapshot index is searched by beams on disk
+bool ObPluginVectorIndexAdaptor::use_search_iter(const ObVectorQueryConditions *query_cond)
+{
+  return OB_NOT_NULL(query_cond->search_iter_)
+         && !query_cond->search_iter_->is_inited()
+         && !query_cond->is_range_search_
+         && OB_ISNULL(query_cond->valid_vids_)
+         && VIAT_DISKANN != type_;
+}
+
+// picks the smallest calibrated ef_search reaching the target recall, ef_search of the session is
+// used until the snapshot index is calibrated. the search only keeps the candidates passing the
+// filters, so ef_search is enlarged by the share of vectors removed by them.
+int64_t ObPluginVectorIndexAdaptor::get_adaptive_ef_search(const ObVectorQueryConditions *query_cond,
+                                                           const roaring::api::roaring64_bitmap_t *dbitmap)
+{
+  int64_t ef_search = query_cond->ef_search_;
+  int64_t snap_count = 0;
+  int64_t incr_count = 0;
+  {
+    TCRLockGuard lock_guard(ef_calibrate_rwlock_);
+    if (ef_calibrated_cnt_ > 0) {
+      ef_search = VEC_INDEX_CALIBRATE_EF_SEARCHES[VEC_INDEX_CALIBRATE_EF_CNT - 1];
+      for (int64_t i = 0; i < VEC_INDEX_CALIBRATE_EF_CNT; ++i) {
+        if (ef_recalls_[i] >= query_cond->target_recall_) {
+          ef_search = VEC_INDEX_CALIBRATE_EF_SEARCHES[i];
+          break;
+        }
+      }
+    }
+  }
+  if (!is_mem_data_init_atomic(VIRT_SNAP) || OB_ISNULL(get_snap_index())
+      || OB_SUCCESS != obvectorutil::get_index_number(get_snap_index(), snap_count)) {
+    snap_count = 0;
+  }
+  if (!is_mem_data_init_atomic(VIRT_INC) || OB_ISNULL(get_incr_index())
+      || OB_SUCCESS != obvectorutil::get_index_number(get_incr_index(), incr_count)) {
+    incr_count = 0;
+  }
+  const int64_t total_count = snap_count + incr_count;
+  if (total_count > 0) {
+    double pass_ratio = 1.0;
+    if (OB_NOT_NULL(query_cond->valid_vids_)) {
+      uint64_t valid_count = roaring64_bitmap_get_cardinality(query_cond->valid_vids_);
+      pass_ratio *= MIN(1.0, static_cast<double>(valid_count) / total_count);
+    }
+    if (OB_NOT_NULL(dbitmap) && snap_count > 0) {
+      uint64_t delete_count = roaring64_bitmap_get_cardinality(dbitmap);
+      pass_ratio *= 1.0 - MIN(1.0, static_cast<double>(delete_count) / total_count);
+    }
+    pass_ratio = MAX(pass_ratio, 1.0 / VEC_INDEX_MAX_ADAPTIVE_EF_SEARCH);
+    ef_search = static_cast<int64_t>(ceil(ef_search / pass_ratio));
+  }
+  return MIN(ef_search, VEC_INDEX_MAX_ADAPTIVE_EF_SEARCH);
+}
+
+// maps the distance threshold of the query to the radius in the metric of vsag, which is the
+// squared distance for l2 and 1 - inner product for ip. the threshold filter is still applied after
+// lookup, so a radius a bit larger than needed only costs some lookups.
+int ObPluginVectorIndexAdaptor::get_range_search_radius(const double distance_threshold, float &radius)
+{
+  INIT_SUCC(ret);
+  ObVectorIndexHNSWParam *param = nullptr;
+  if (OB_FAIL(get_hnsw_param(param))) {
+    LOG_WARN("failed to get hnsw param.", K(ret));
+  } else if (VIDA_L2 == param->dist_algorithm_) {
+    radius = distance_threshold > 0 ? static_cast<float>(distance_threshold * distance_threshold) : 0;
+  } else if (VIDA_IP == param->dist_algorithm_) {
+    // the threshold is on negative_inner_product, which is the vsag distance minus 1
+    radius = static_cast<float>(MAX(1.0 + distance_threshold, 0.0));
+  } else {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("range search is not supported for the distance algorithm.", K(ret), K(param->dist_algorithm_));
+  }
+  return ret;
+}
+
 int ObPluginVectorIndexAdaptor::vsag_query_vids(ObVectorQueryAdaptorResultContext *ctx,
                                                 ObVectorQueryConditions *query_cond,
                                                 int64_t dim, float *query_vector,
@@ -1621,42 +1998,139 @@ int ObPluginVectorIndexAdaptor::vsag_query_vids(ObVectorQueryAdaptorResultContex
   }
 #endif
 
-  if (OB_SUCC(ret)) {
-    lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
-    TCRLockGuard lock_guard(incr_data_->mem_data_rwlock_);
-    if (OB_FAIL(is_mem_data_init_atomic(VIRT_INC) &&
-                obvectorutil::knn_search(get_incr_index(),
-                                         query_vector,
-                                         dim,
-                                         query_cond->query_limit_,
-                                         delta_distances,
-                                         delta_vids,
-                                         delta_res_cnt,
-                                         query_cond->ef_search_,
-                                         ibitmap))) {
-      ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
-      LOG_WARN("knn search delta failed.", K(ret), K(dim));
-    }
+  int64_t ef_search = query_cond->ef_search_;
+  if (OB_SUCC(ret) && query_cond->target_recall_ > 0) {
+    ef_search = get_adaptive_ef_search(query_cond, dbitmap);
+    LOG_TRACE("adaptive ef search", K(query_cond->target_recall_), K(query_cond->ef_search_), K(ef_search));
   }
-  if (OB_SUCC(ret)) {
+  const bool is_search_iter = use_search_iter(query_cond);
+  // diskann searches by beams on disk and has no range search, the threshold filter is applied after lookup
+  const bool is_range_search = query_cond->is_range_search_ && VIAT_DISKANN != type_;
+
+  if (OB_FAIL(ret)) {
+  } else if (is_search_iter) {
+    if (OB_FAIL(open_search_iter(*query_cond->search_iter_, ibitmap, dbitmap, dim, query_vector, ef_search))) {
+      LOG_WARN("failed to open search iter.", K(ret), K(dim), K(ef_search));
+    } else if (OB_FAIL(query_next_result(*query_cond->search_iter_, query_cond->query_limit_,
+                                         ctx->allocator_, *vids_iter))) {
+      LOG_WARN("failed to query first result of search iter.", K(ret), K(query_cond->query_limit_));
+    }
+  } else if (is_range_search) {
+    float radius = 0;
+    if (OB_FAIL(get_range_search_radius(query_cond->distance_threshold_, radius))) {
+      LOG_WARN("failed to get range search radius.", K(ret), K(query_cond->distance_threshold_));
+    }
+    if (OB_SUCC(ret) && is_mem_data_init_atomic(VIRT_INC)) {
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      TCRLockGuard lock_guard(incr_data_->mem_data_rwlock_);
+      if (OB_FAIL(obvectorutil::range_search(get_incr_index(),
+                                             query_vector,
+                                             dim,
+                                             radius,
+                                             query_cond->query_limit_,
+                                             delta_distances,
+                                             delta_vids,
+                                             delta_res_cnt,
+                                             ef_search,
+                                             ibitmap,
+                                             query_cond->valid_vids_))) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("range search delta failed.", K(ret), K(dim), K(radius));
+      }
+    }
+    if (OB_SUCC(ret) && is_mem_data_init_atomic(VIRT_SNAP)) {
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      TCRLockGuard lock_guard(snap_data_->mem_data_rwlock_);
+      if (OB_FAIL(obvectorutil::range_search(get_snap_index(),
+                                             query_vector,
+                                             dim,
+                                             radius,
+                                             query_cond->query_limit_,
+                                             snap_distances,
+                                             snap_vids,
+                                             snap_res_cnt,
+                                             ef_search,
+                                             dbitmap,
+                                             query_cond->valid_vids_))) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("range search snap failed.", K(ret), K(dim), K(radius));
+      }
+    }
+  } else if (is_mem_data_init_atomic(VIRT_INC) && is_mem_data_init_atomic(VIRT_SNAP)
+             && use_parallel_dual_search()) {
     lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
-    TCRLockGuard lock_guard(snap_data_->mem_data_rwlock_);
-    if (OB_FAIL(is_mem_data_init_atomic(VIRT_SNAP) &&
-                obvectorutil::knn_search(get_snap_index(),
-                                         query_vector,
-                                         dim,
-                                         query_cond->query_limit_,
-                                         snap_distances,
-                                         snap_vids,
-                                         snap_res_cnt,
-                                         query_cond->ef_search_,
-                                         dbitmap))) {
-      ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
-      LOG_WARN("knn search snap failed.", K(ret), K(dim));
+    TCRLockGuard incr_lock_guard(incr_data_->mem_data_rwlock_);
+    TCRLockGuard snap_lock_guard(snap_data_->mem_data_rwlock_);
+    ObVsagDualSearchTask *task = nullptr;
+    ObPluginVectorIndexService *service = MTL(ObPluginVectorIndexService *);
+    if (OB_FAIL(ObVsagDualSearchTask::create(tenant_id_, query_vector, dim, query_cond->query_limit_,
+                                             ef_search, query_cond->valid_vids_, task))) {
+      LOG_WARN("failed to create dual search task.", K(ret));
+    } else {
+      task->searches_[0] = {get_incr_index(), ibitmap, &delta_distances, &delta_vids, &delta_res_cnt, OB_SUCCESS};
+      task->searches_[1] = {get_snap_index(), dbitmap, &snap_distances, &snap_vids, &snap_res_cnt, OB_SUCCESS};
+      // the pool holds a reference until it handles the task, the searches it does not start in
+      // time are taken by this thread
+      if (OB_ISNULL(service) || OB_SUCCESS != service->push_search_task(task)) {
+        LOG_TRACE("search delta and snapshot index in query thread", KP(service));
+      }
+      task->run();
+      task->wait();
+      if (OB_FAIL(task->searches_[0].ret_)) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("knn search delta failed.", K(ret), K(dim));
+      } else if (OB_FAIL(task->searches_[1].ret_)) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("knn search snap failed.", K(ret), K(dim));
+      }
+      task->release();
+      task = nullptr;
     }
-  }
-  if (OB_FAIL(ret)) {
   } else {
+    // a batch of one query, which is the only entry passing valid vids to the search
+    if (OB_SUCC(ret) && is_mem_data_init_atomic(VIRT_INC)) {
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      TCRLockGuard lock_guard(incr_data_->mem_data_rwlock_);
+      if (OB_FAIL(obvectorutil::knn_search_batch(get_incr_index(),
+                                                 query_vector,
+                                                 1, /* query_num */
+                                                 dim,
+                                                 query_cond->query_limit_,
+                                                 &delta_distances,
+                                                 &delta_vids,
+                                                 &delta_res_cnt,
+                                                 ef_search,
+                                                 ibitmap,
+                                                 nullptr, /* distance_bounds */
+                                                 nullptr, /* result_bounds */
+                                                 query_cond->valid_vids_))) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("knn search delta failed.", K(ret), K(dim));
+      }
+    }
+    if (OB_SUCC(ret) && is_mem_data_init_atomic(VIRT_SNAP)) {
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      TCRLockGuard lock_guard(snap_data_->mem_data_rwlock_);
+      if (OB_FAIL(obvectorutil::knn_search_batch(get_snap_index(),
+                                                 query_vector,
+                                                 1, /* query_num */
+                                                 dim,
+                                                 query_cond->query_limit_,
+                                                 &snap_distances,
+                                                 &snap_vids,
+                                                 &snap_res_cnt,
+                                                 ef_search,
+                                                 dbitmap,
+                                                 nullptr, /* distance_bounds */
+                                                 nullptr, /* result_bounds */
+                                                 query_cond->valid_vids_))) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("knn search snap failed.", K(ret), K(dim));
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && !is_search_iter) {
     int64_t actual_res_cnt = 0;
     const ObVsagQueryResult delta_data = {delta_res_cnt, delta_vids, delta_distances};
     const ObVsagQueryResult snap_data = {snap_res_cnt, snap_vids, snap_distances};
@@ -1691,30 +2165,220 @@ int ObPluginVectorIndexAdaptor::vsag_query_vids(ObVectorQueryAdaptorResultContex
     ibitmap = nullptr;
   }
 
-  if (delta_res_cnt != 0) {
-    if (delta_distances != nullptr) {
-      incr_data_->mem_ctx_->Deallocate((void *)delta_distances);
-      delta_distances = nullptr;
+  if (delta_distances != nullptr) {
+    incr_data_->mem_ctx_->Deallocate((void *)delta_distances);
+    delta_distances = nullptr;
+  }
+  if (delta_vids != nullptr) {
+    incr_data_->mem_ctx_->Deallocate((void *)delta_vids);
+    delta_vids = nullptr;
+  }
+  if (snap_distances != nullptr) {
+    snap_data_->mem_ctx_->Deallocate((void *)snap_distances);
+    snap_distances = nullptr;
+  }
+  if (snap_vids != nullptr) {
+    snap_data_->mem_ctx_->Deallocate((void *)snap_vids);
+    snap_vids = nullptr;
+  }
+  LOG_TRACE("now all_vsag_used is: ", K(ATOMIC_LOAD(all_vsag_use_mem_)));
+  return ret;
+}
+
+// the invalid bitmaps are copied as the ones of the query are freed once it returns
+int ObPluginVectorIndexAdaptor::open_search_iter(ObVsagSearchIter &search_iter,
+                                                 const roaring::api::roaring64_bitmap_t *ibitmap,
+                                                 const roaring::api::roaring64_bitmap_t *dbitmap,
+                                                 int64_t dim, float *query_vector, int64_t ef_search)
+{
+  INIT_SUCC(ret);
+  ObVectorIndexMemData *mem_datas[ObVsagSearchIter::SOURCE_CNT] = {incr_data_, snap_data_};
+  const ObVectorIndexRecordType types[ObVsagSearchIter::SOURCE_CNT] = {VIRT_INC, VIRT_SNAP};
+  const roaring::api::roaring64_bitmap_t *invalids[ObVsagSearchIter::SOURCE_CNT] = {ibitmap, dbitmap};
+  if (OB_UNLIKELY(search_iter.is_inited())) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("search iter is opened twice.", K(ret), K(search_iter));
+  } else if (OB_FAIL(search_iter.adaptor_guard_.set_adapter(this))) {
+    LOG_WARN("failed to set adaptor of search iter.", K(ret));
+  } else {
+    // the sources opened are released by reset even if the others failed
+    search_iter.ef_search_ = ef_search;
+    search_iter.is_inited_ = true;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < ObVsagSearchIter::SOURCE_CNT; ++i) {
+    ObVsagSearchIter::Source &source = search_iter.sources_[i];
+    if (!is_mem_data_init_atomic(types[i]) || OB_ISNULL(mem_datas[i]->index_)) {
+      source.is_end_ = true;
+    } else {
+      source.mem_data_ = mem_datas[i];
+      source.mem_data_->inc_ref();
+      if (OB_NOT_NULL(invalids[i])) {
+        lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+        ROARING_TRY_CATCH(source.invalid_ = roaring64_bitmap_copy(invalids[i]));
+      }
+      if (OB_SUCC(ret)) {
+        lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+        TCRLockGuard lock_guard(source.mem_data_->mem_data_rwlock_);
+        if (OB_FAIL(obvectorutil::knn_search_iterator(source.mem_data_->index_, query_vector, dim, source.iter_))) {
+          ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+          LOG_WARN("failed to open knn search iterator.", K(ret), K(i), K(dim));
+        }
+      }
     }
+  }
+  return ret;
+}
 
-    if (delta_vids != nullptr) {
-      incr_data_->mem_ctx_->Deallocate((void *)delta_vids);
-      delta_vids = nullptr;
+// the results of the source are fetched in batches of cnt, the ones not returned are kept until
+// all of them are returned
+int ObPluginVectorIndexAdaptor::fetch_search_iter_source(ObVsagSearchIter &search_iter,
+                                                         const int64_t idx,
+                                                         const int64_t cnt)
+{
+  INIT_SUCC(ret);
+  ObVsagSearchIter::Source &source = search_iter.sources_[idx];
+  lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+  if (OB_NOT_NULL(source.distances_)) {
+    source.mem_data_->mem_ctx_->Deallocate((void *)source.distances_);
+    source.distances_ = nullptr;
+  }
+  if (OB_NOT_NULL(source.vids_)) {
+    source.mem_data_->mem_ctx_->Deallocate((void *)source.vids_);
+    source.vids_ = nullptr;
+  }
+  source.cnt_ = 0;
+  source.pos_ = 0;
+  if (source.is_end_) {
+  } else {
+    TCRLockGuard lock_guard(source.mem_data_->mem_data_rwlock_);
+    if (OB_FAIL(obvectorutil::knn_search_next(source.mem_data_->index_,
+                                              source.iter_,
+                                              cnt,
+                                              source.distances_,
+                                              source.vids_,
+                                              source.cnt_,
+                                              search_iter.ef_search_,
+                                              source.invalid_))) {
+      ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+      LOG_WARN("failed to fetch next results of knn search iterator.", K(ret), K(idx), K(cnt));
+    } else {
+      // less results means the search ended, a compaction in between only restarts the search
+      source.is_end_ = source.cnt_ < cnt;
     }
   }
+  return ret;
+}
 
-  if (snap_res_cnt != 0) {
-    if (snap_distances != nullptr) {
-      snap_data_->mem_ctx_->Deallocate((void *)snap_distances);
-      snap_distances = nullptr;
+int ObPluginVectorIndexAdaptor::query_next_result(ObVsagSearchIter &search_iter,
+                                                  const int64_t batch_size,
+                                                  ObIAllocator *allocator,
+                                                  ObVectorQueryVidIterator &vids_iter)
+{
+  INIT_SUCC(ret);
+  int64_t res_cnt = 0;
+  int64_t *vids = nullptr;
+  if (OB_UNLIKELY(!search_iter.is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("search iter is not opened.", K(ret));
+  } else if (OB_UNLIKELY(batch_size <= 0) || OB_ISNULL(allocator)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument.", K(ret), K(batch_size), KP(allocator));
+  } else if (OB_ISNULL(vids = static_cast<int64_t *>(allocator->alloc(sizeof(int64_t) * batch_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc vids.", K(ret), K(batch_size));
+  }
+  // merge the two sources by distance, a source is refilled once its fetched results are returned
+  while (OB_SUCC(ret) && res_cnt < batch_size) {
+    int64_t nearest = -1;
+    for (int64_t i = 0; OB_SUCC(ret) && i < ObVsagSearchIter::SOURCE_CNT; ++i) {
+      ObVsagSearchIter::Source &source = search_iter.sources_[i];
+      if (source.pos_ >= source.cnt_ && !source.is_end_
+          && OB_FAIL(fetch_search_iter_source(search_iter, i, batch_size))) {
+        LOG_WARN("failed to fetch search iter source.", K(ret), K(i), K(batch_size));
+      } else if (source.pos_ >= source.cnt_) {
+        // the search ended
+      } else if (nearest < 0 || source.distances_[source.pos_]
+                                < search_iter.sources_[nearest].distances_[search_iter.sources_[nearest].pos_]) {
+        nearest = i;
+      }
     }
+    if (OB_FAIL(ret) || nearest < 0) {
+      break;
+    } else {
+      ObVsagSearchIter::Source &source = search_iter.sources_[nearest];
+      vids[res_cnt++] = source.vids_[source.pos_++];
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FALSE_IT(vids_iter.reset())) {
+  } else if (OB_FAIL(vids_iter.init(res_cnt, vids, allocator))) {
+    LOG_WARN("iter init failed.", K(ret), K(res_cnt));
+  } else {
+    search_iter.fetched_cnt_ += res_cnt;
+    LOG_TRACE("query next result of search iter", K(batch_size), K(res_cnt), K(search_iter));
+  }
+  return ret;
+}
 
-    if (snap_vids != nullptr) {
-      snap_data_->mem_ctx_->Deallocate((void *)snap_vids);
-      snap_distances = nullptr;
+void ObPluginVectorIndexAdaptor::release_search_iter(ObVsagSearchIter &search_iter)
+{
+  INIT_SUCC(ret);
+  const ObVectorIndexRecordType types[ObVsagSearchIter::SOURCE_CNT] = {VIRT_INC, VIRT_SNAP};
+  for (int64_t i = 0; i < ObVsagSearchIter::SOURCE_CNT; ++i) {
+    ObVsagSearchIter::Source &source = search_iter.sources_[i];
+    if (OB_NOT_NULL(source.mem_data_)) {
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      if (OB_NOT_NULL(source.distances_)) {
+        source.mem_data_->mem_ctx_->Deallocate((void *)source.distances_);
+      }
+      if (OB_NOT_NULL(source.vids_)) {
+        source.mem_data_->mem_ctx_->Deallocate((void *)source.vids_);
+      }
+      if (OB_NOT_NULL(source.iter_)) {
+        obvectorutil::delete_iterator(source.iter_);
+      }
+      if (OB_FAIL(try_free_memdata_resource(types[i], source.mem_data_, allocator_, tenant_id_))) {
+        LOG_WARN("failed to release mem data of search iter.", K(ret), K(i));
+      }
     }
+    if (OB_NOT_NULL(source.invalid_)) {
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+      roaring64_bitmap_free(source.invalid_);
+    }
+    MEMSET(&source, 0, sizeof(source));
+  }
+}
+
+void ObVsagSearchIter::reset()
+{
+  if (is_inited_ && adaptor_guard_.is_valid()) {
+    adaptor_guard_.get_adatper()->release_search_iter(*this);
+  }
+  ef_search_ = 0;
+  fetched_cnt_ = 0;
+  is_inited_ = false;
+}
+
+bool ObVsagSearchIter::is_end() const
+{
+  bool bret = is_inited_;
+  for (int64_t i = 0; bret && i < SOURCE_CNT; ++i) {
+    bret = sources_[i].is_end_ && sources_[i].pos_ >= sources_[i].cnt_;
+  }
+  return bret;
+}
+
+int ObVsagSearchIter::get_next_result(const int64_t batch_size,
+                                      ObIAllocator *allocator,
+                                      ObVectorQueryVidIterator &vids_iter)
+{
+  INIT_SUCC(ret);
+  if (OB_UNLIKELY(!is_inited_) || OB_UNLIKELY(!adaptor_guard_.is_valid())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("search iter is not opened.", K(ret));
+  } else if (OB_FAIL(adaptor_guard_.get_adatper()->query_next_result(*this, batch_size, allocator, vids_iter))) {
+    LOG_WARN("failed to query next result.", K(ret), K(batch_size));
   }
-  LOG_TRACE("now all_vsag_used is: ", K(ATOMIC_LOAD(all_vsag_use_mem_)));
   return ret;
 }
 
@@ -1725,7 +2389,6 @@ int ObPluginVectorIndexAdaptor::query_result(ObVectorQueryAdaptorResultContext *
   INIT_SUCC(ret);
   vids_iter = nullptr;
   int64_t dim = 0;
-  int64_t *merge_vids = nullptr;
   void *iter_buff = nullptr;
   float *query_vector;
 
@@ -1771,11 +2434,19 @@ int ObPluginVectorIndexAdaptor::query_result(ObVectorQueryAdaptorResultContext *
 
       ObVectorIndexSerializer index_seri(tmp_allocator);
 
-      TCWLockGuard lock_guard(snap_data_->mem_data_rwlock_);
-      if (OB_FAIL(index_seri.deserialize(snap_data_->index_, param, cb, tenant_id_))) {
-        LOG_WARN("serialize index failed.", K(ret));
-      } else {
-        close_snap_data_rb_flag();
+      const bool is_loader = try_begin_snap_load();
+      {
+        TCWLockGuard lock_guard(snap_data_->mem_data_rwlock_);
+        if (!snap_data_->rb_flag_) {
+          // loaded by another thread while waiting for the lock
+        } else if (OB_FAIL(index_seri.deserialize(snap_data_->index_, param, cb, tenant_id_))) {
+          LOG_WARN("serialize index failed.", K(ret));
+        } else {
+          close_snap_data_rb_flag();
+        }
+      }
+      if (is_loader) {
+        end_snap_load();
       }
     }
 
@@ -2145,6 +2816,159 @@ int ObPluginVectorIndexAdaptor::check_need_sync_to_follower(bool &need_sync)
   return ret;
 }
 
+int ObPluginVectorIndexAdaptor::try_compact_snap_index()
+{
+  INIT_SUCC(ret);
+  int64_t snap_count = 0;
+  uint64_t new_count = 0;
+  uint64_t *vids = nullptr;
+  roaring::api::roaring64_bitmap_t *new_vids = nullptr;
+  void *snap_index = get_snap_index();
+  ObArenaAllocator tmp_allocator("VecIdxCompact", OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id_);
+  lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+  if (!is_mem_data_init_atomic(VIRT_SNAP) || !is_mem_data_init_atomic(VIRT_BITMAP)
+      || snap_data_->rb_flag_ || OB_ISNULL(snap_index) || is_snap_loading()) {
+    // do nothing, snapshot index not ready
+  } else if (OB_FAIL(obvectorutil::get_index_number(snap_index, snap_count))) {
+    ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+    LOG_WARN("fail to get snap index number", K(ret));
+  } else if (snap_count <= 0) {
+    // do nothing
+  } else {
+    if (snap_removed_index_ != snap_index) {
+      // snapshot index has been reloaded, the removed vids are back
+      free_snap_removed_vids();
+      snap_removed_index_ = snap_index;
+    }
+    if (OB_ISNULL(snap_removed_vids_)) {
+      ROARING_TRY_CATCH(snap_removed_vids_ = roaring::api::roaring64_bitmap_create());
+    }
+    if (OB_SUCC(ret)) {
+      TCRLockGuard rd_bitmap_lock_guard(vbitmap_data_->bitmap_rwlock_);
+      const roaring::api::roaring64_bitmap_t *delete_bitmap = get_vbitmap_dbitmap();
+      if (OB_NOT_NULL(delete_bitmap)) {
+        ROARING_TRY_CATCH(new_vids = roaring::api::roaring64_bitmap_andnot(delete_bitmap, snap_removed_vids_));
+      }
+    }
+    if (OB_FAIL(ret) || OB_ISNULL(new_vids)) {
+    } else if (0 == (new_count = roaring64_bitmap_get_cardinality(new_vids))) {
+      // do nothing
+    } else if (OB_ISNULL(vids = static_cast<uint64_t *>(tmp_allocator.alloc(sizeof(uint64_t) * new_count)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc delete vids", K(ret), K(new_count));
+    } else {
+      ROARING_TRY_CATCH(roaring64_bitmap_to_uint64_array(new_vids, vids));
+    }
+  }
+
+  if (OB_SUCC(ret) && OB_NOT_NULL(vids)) {
+    // marks only the new deletes, the ones of delta buffer only are not in snapshot and ignored
+    int64_t removed_cnt = 0;
+    TCRLockGuard rd_snap_lock_guard(snap_data_->mem_data_rwlock_);
+    lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+    if (OB_FAIL(obvectorutil::remove_index(snap_index, reinterpret_cast<int64_t *>(vids), new_count, removed_cnt))) {
+      ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+      LOG_WARN("fail to remove deleted vids from snap index", K(ret), K(new_count));
+    } else {
+      ROARING_TRY_CATCH(roaring64_bitmap_or_inplace(snap_removed_vids_, new_vids));
+      snap_removed_cnt_ += removed_cnt;
+    }
+  }
+  if (OB_NOT_NULL(new_vids)) {
+    roaring64_bitmap_free(new_vids);
+    new_vids = nullptr;
+  }
+
+  if (OB_FAIL(ret) || snap_count <= 0 || OB_ISNULL(snap_removed_vids_)) {
+  } else if (snap_removed_cnt_ < snap_count * VEC_INDEX_COMPACT_DELETE_RATIO) {
+    // do nothing, too few deletes in snapshot index
+  } else {
+    // the graph repair runs along with queries, the write lock only covers applying it
+    int64_t compacted_cnt = 0;
+    {
+      TCRLockGuard rd_snap_lock_guard(snap_data_->mem_data_rwlock_);
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      if (OB_FAIL(obvectorutil::prepare_compact_index(snap_index))) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("fail to prepare compact snap index", K(ret), K(snap_count), K(snap_removed_cnt_));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      TCWLockGuard wr_snap_lock_guard(snap_data_->mem_data_rwlock_);
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      if (OB_FAIL(obvectorutil::compact_index(snap_index, compacted_cnt))) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("fail to compact snap index", K(ret), K(snap_count), K(snap_removed_cnt_));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      LOG_INFO("compact snap index", K(snap_count), K(snap_removed_cnt_), K(compacted_cnt), KPC(this));
+      snap_removed_cnt_ = 0;
+    }
+  }
+  return ret;
+}
+
+void ObPluginVectorIndexAdaptor::free_snap_removed_vids()
+{
+  if (OB_NOT_NULL(snap_removed_vids_)) {
+    lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIBitmapADP"));
+    roaring::api::roaring64_bitmap_free(snap_removed_vids_);
+    snap_removed_vids_ = nullptr;
+  }
+  snap_removed_index_ = nullptr;
+  snap_removed_cnt_ = 0;
+}
+
+constexpr int64_t ObPluginVectorIndexAdaptor::VEC_INDEX_CALIBRATE_EF_SEARCHES[];
+
+int ObPluginVectorIndexAdaptor::try_calibrate_ef_search()
+{
+  INIT_SUCC(ret);
+  int64_t snap_count = 0;
+  int64_t calibrated_cnt = ATOMIC_LOAD(&ef_calibrated_cnt_);
+  float recalls[VEC_INDEX_CALIBRATE_EF_CNT] = {0};
+  if (!is_mem_data_init_atomic(VIRT_SNAP) || snap_data_->rb_flag_ || OB_ISNULL(get_snap_index())
+      || is_snap_loading()) {
+    // do nothing, snapshot index not ready
+  } else if (OB_FAIL(obvectorutil::get_index_number(get_snap_index(), snap_count))) {
+    ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+    LOG_WARN("fail to get snap index number", K(ret));
+  } else if (snap_count <= VEC_INDEX_CALIBRATE_TOPK) {
+    // do nothing, too few vectors to measure
+  } else if (calibrated_cnt > 0
+             && snap_count < calibrated_cnt * (1 + VEC_INDEX_CALIBRATE_CHANGE_RATIO)
+             && snap_count > calibrated_cnt * (1 - VEC_INDEX_CALIBRATE_CHANGE_RATIO)) {
+    // do nothing, the recalls measured on a similar index still hold
+  } else {
+    // the exact scans cost sample_cnt * snap_count distances
+    const int64_t sample_cnt = MAX(VEC_INDEX_CALIBRATE_MIN_SAMPLE_CNT,
+                                   MIN(VEC_INDEX_CALIBRATE_MAX_SAMPLE_CNT,
+                                       VEC_INDEX_CALIBRATE_SCAN_BUDGET / snap_count));
+    {
+      TCRLockGuard rd_snap_lock_guard(snap_data_->mem_data_rwlock_);
+      lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(tenant_id_, "VIndexVsagADP"));
+      if (OB_FAIL(obvectorutil::calibrate_recall(get_snap_index(),
+                                                 VEC_INDEX_CALIBRATE_TOPK,
+                                                 VEC_INDEX_CALIBRATE_EF_SEARCHES,
+                                                 VEC_INDEX_CALIBRATE_EF_CNT,
+                                                 sample_cnt,
+                                                 recalls))) {
+        ret = ObPluginVectorIndexHelper::vsag_errcode_2ob(ret);
+        LOG_WARN("fail to calibrate snap index", K(ret), K(snap_count), K(sample_cnt));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      TCWLockGuard wr_lock_guard(ef_calibrate_rwlock_);
+      MEMCPY(ef_recalls_, recalls, sizeof(ef_recalls_));
+      ef_calibrated_cnt_ = snap_count;
+      LOG_INFO("calibrate snap index ef search", K(snap_count), K(sample_cnt),
+               "min_ef_recall", ef_recalls_[0], "max_ef_recall", ef_recalls_[VEC_INDEX_CALIBRATE_EF_CNT - 1]);
+    }
+  }
+  return ret;
+}
+
 // debug function
 void ObPluginVectorIndexAdaptor::output_bitmap(roaring::api::roaring64_bitmap_t *bitmap)
 {
@@ -2227,14 +3051,38 @@ int ObPluginVectorIndexAdaptor::get_snap_vsag_mem_hold()
   return size;
 }
 
+int64_t ObVsagMemContext::get_slab_idx(const int64_t actual_size)
+{
+  int64_t idx = 0;
+  while ((1L << (SLAB_MIN_SIZE_SHIFT + idx)) < actual_size) {
+    ++idx;
+  }
+  return idx;
+}
+
+int64_t ObVsagMemContext::get_slab_hold()
+{
+  int64_t hold = 0;
+  for (int64_t i = 0; i < SLAB_CLASS_CNT; ++i) {
+    hold += slab_allocs_[i].hold();
+  }
+  return hold;
+}
+
 void *ObVsagMemContext::Allocate(size_t size)
 {
   void *ret_ptr = nullptr;
 
   if (size != 0) {
     int64_t actual_size = MEM_PTR_HEAD_SIZE + size;
-
-    void *ptr = mem_context_->get_malloc_allocator().alloc(actual_size);
+    void *ptr = nullptr;
+    if (actual_size <= SLAB_MAX_SIZE) {
+      const int64_t slab_idx = get_slab_idx(actual_size);
+      actual_size = 1L << (SLAB_MIN_SIZE_SHIFT + slab_idx);
+      ptr = slab_allocs_[slab_idx].alloc();
+    } else {
+      ptr = mem_context_->get_malloc_allocator().alloc(actual_size);
+    }
     if (OB_NOT_NULL(ptr)) {
       ATOMIC_AAF(all_vsag_use_mem_, actual_size);
 
@@ -2253,7 +3101,11 @@ void ObVsagMemContext::Deallocate(void* p)
     int64_t size = *(int64_t *)size_ptr;
 
     ATOMIC_SAF(all_vsag_use_mem_, size);
-    mem_context_->get_malloc_allocator().free((char*)p - MEM_PTR_HEAD_SIZE);
+    if (size <= SLAB_MAX_SIZE) {
+      slab_allocs_[get_slab_idx(size)].free(size_ptr);
+    } else {
+      mem_context_->get_malloc_allocator().free(size_ptr);
+    }
     p = nullptr;
   }
 }
@@ -2298,7 +3150,15 @@ int ObVsagMemContext::init(lib::MemoryContext &parent_mem_context,
     .set_page_size(OB_MALLOC_MIDDLE_BLOCK_SIZE)
     .set_parallel(4)
     .set_properties(lib::ALLOC_THREAD_SAFE | lib::RETURN_MALLOC_DEFAULT);
-  if (OB_FAIL(parent_mem_context->CREATE_CONTEXT(mem_context_, param))) {
+  for (int64_t i = 0; OB_SUCC(ret) && i < SLAB_CLASS_CNT; ++i) {
+    if (OB_FAIL(slab_allocs_[i].init(1L << (SLAB_MIN_SIZE_SHIFT + i), attr))) {
+      LOG_WARN("failed to init slab allocator", K(ret), K(i));
+    } else {
+      slab_allocs_[i].set_nway(SLAB_NWAY);
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(parent_mem_context->CREATE_CONTEXT(mem_context_, param))) {
     LOG_WARN("create memory entity failed", K(ret));
   } else {
     all_vsag_use_mem_ = all_vsag_use_mem;
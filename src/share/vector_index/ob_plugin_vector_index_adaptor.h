@@ -14,6 +14,7 @@
 #ifndef OCEANBASE_SHARE_PLUGIN_VECTOR_INDEX_ADAPTOR_H_
 #define OCEANBASE_SHARE_PLUGIN_VECTOR_INDEX_ADAPTOR_H_
 
+#include <atomic>
 #include "share/scn.h"
 #include "share/datum/ob_datum.h"
 #include "roaring/roaring64.h"
@@ -25,6 +26,8 @@
 #include "share/rc/ob_tenant_base.h"
 #include "lib/oblog/ob_log_module.h"
 #include "share/vector_index/ob_plugin_vector_index_serialize.h"
+#include "lib/allocator/ob_small_allocator.h"
+#include "lib/lock/ob_thread_cond.h"
 
 namespace oceanbase
 {
@@ -32,6 +35,7 @@ namespace share
 {
 struct ObPluginVectorIndexTaskCtx;
 class ObVsagMemContext;
+class ObVsagSearchIter;
 
 struct ObVectorIndexInfo
 {
@@ -84,9 +88,21 @@ enum ObVectorIndexAlgorithmLib
 enum ObVectorIndexAlgorithmType
 {
   VIAT_HNSW = 0,
+  VIAT_HNSW_SQ = 1, // hnsw on 8-bit scalar quantized vectors
+  VIAT_DISKANN = 2, // pq codes in memory, graph and full vectors on disk, snapshot only
   VIAT_MAX
 };
 
+// how the hnsw graph stores the vectors, the vectors are always inserted and searched as float32
+enum ObVectorIndexElementType
+{
+  VIET_FLOAT32 = 0,
+  VIET_FLOAT16 = 1,
+  VIET_BFLOAT16 = 2,
+  VIET_INT8 = 3, // scaled by the max magnitude of each vector
+  VIET_MAX
+};
+
 struct ObVectorIndexAlgorithmHeader
 {
   ObVectorIndexAlgorithmType type_;
@@ -96,7 +112,8 @@ struct ObVectorIndexAlgorithmHeader
 struct ObVectorIndexHNSWParam
 {
   ObVectorIndexHNSWParam() :
-    type_(VIAT_MAX), lib_(VIAL_MAX), dim_(0), m_(0), ef_construction_(0), ef_search_(0)
+    type_(VIAT_MAX), lib_(VIAL_MAX), dim_(0), m_(0), ef_construction_(0), ef_search_(0),
+    build_thread_num_(0), element_type_(VIET_FLOAT32)
   {}
   void reset() {
     type_ = VIAT_MAX;
@@ -106,6 +123,8 @@ struct ObVectorIndexHNSWParam
     m_ = 0;
     ef_construction_ = 0;
     ef_search_ = 0;
+    build_thread_num_ = 0;
+    element_type_ = VIET_FLOAT32;
   };
   ObVectorIndexAlgorithmType type_;
   ObVectorIndexAlgorithmLib lib_;
@@ -114,9 +133,12 @@ struct ObVectorIndexHNSWParam
   int64_t m_;
   int64_t ef_construction_;
   int64_t ef_search_;
+  int64_t build_thread_num_; // max threads used to build the snapshot index
+  ObVectorIndexElementType element_type_;
   OB_UNIS_VERSION(1);
 public:
-  TO_STRING_KV(K_(type), K_(lib), K_(dist_algorithm), K_(dim), K_(m), K_(ef_construction), K_(ef_search));
+  TO_STRING_KV(K_(type), K_(lib), K_(dist_algorithm), K_(dim), K_(m), K_(ef_construction), K_(ef_search),
+               K_(build_thread_num), K_(element_type));
 };
 
 enum ObVectorIndexRecordType
@@ -228,9 +250,14 @@ struct ObVectorQueryConditions {
   uint32_t query_limit_;
   bool query_order_; // true: asc, false: desc
   int64_t ef_search_;
+  double target_recall_; // ef_search is chosen per query to reach the recall, 0 means ef_search_ is used
   ObString query_vector_;
   SCN query_scn_;
   common::ObNewRowIterator *row_iter_; // index_snapshot_data_table iter
+  roaring::api::roaring64_bitmap_t *valid_vids_; // vids passing the filters of the query, null means all vids
+  ObVsagSearchIter *search_iter_; // keeps the searches open to fetch more results later, null means one-shot search
+  bool is_range_search_; // only the vids within distance_threshold_ are returned, at most query_limit_ of them
+  double distance_threshold_; // in the distance of the query, not the metric of vsag
 };
 
 struct ObVectorIndexMemData
@@ -238,6 +265,7 @@ struct ObVectorIndexMemData
   ObVectorIndexMemData()
     : is_init_(false),
       rb_flag_(true),
+      is_loading_(false),
       mem_data_rwlock_(),
       bitmap_rwlock_(),
       scn_(),
@@ -248,7 +276,7 @@ struct ObVectorIndexMemData
       mem_ctx_(nullptr) {}
 
 public:
-  TO_STRING_KV(K(rb_flag_), K_(is_init), K_(scn), K_(ref_cnt), K_(curr_vid_max), KP_(index), KPC_(bitmap), KP_(mem_ctx));
+  TO_STRING_KV(K(rb_flag_), K_(is_loading), K_(is_init), K_(scn), K_(ref_cnt), K_(curr_vid_max), KP_(index), KPC_(bitmap), KP_(mem_ctx));
   void free_resource(ObIAllocator *allocator_);
   bool is_inited() const { return is_init_; }
   void set_inited() { is_init_ = true; }
@@ -267,6 +295,7 @@ public:
 public:
   bool is_init_;
   bool rb_flag_;
+  bool is_loading_; // the index is being deserialized, only used by snapshot
   TCRWLock mem_data_rwlock_;
   TCRWLock bitmap_rwlock_;
   SCN scn_;
@@ -380,6 +409,10 @@ public:
   uint64_t get_data_table_id() { return data_table_id_; }
   uint64_t get_rowkey_vid_table_id() { return rowkey_vid_table_id_; }
   uint64_t get_vid_rowkey_table_id() { return vid_rowkey_table_id_; }
+  // queries should not wait for the snapshot being loaded by another thread
+  bool is_snap_loading() { return OB_NOT_NULL(snap_data_) && ATOMIC_LOAD(&snap_data_->is_loading_); }
+  bool try_begin_snap_load() { return ATOMIC_BCAS(&snap_data_->is_loading_, false, true); }
+  void end_snap_load() { ATOMIC_STORE(&snap_data_->is_loading_, false); }
   void close_snap_data_rb_flag() {
     if (is_mem_data_init_atomic(VIRT_SNAP)) {
       snap_data_->rb_flag_ = false;
@@ -426,10 +459,14 @@ public:
   int add_snap_index(float *vectors, int64_t *vids, int num);
 
   // Query Processor first
+  // use_delta_cache must be false when the read may see uncommitted rows, e.g. inside a transaction
   int check_delta_buffer_table_readnext_status(ObVectorQueryAdaptorResultContext *ctx,
                                                common::ObNewRowIterator *row_iter,
-                                               SCN query_scn);
+                                               SCN query_scn,
+                                               const bool use_delta_cache = false);
   int complete_delta_buffer_table_data(ObVectorQueryAdaptorResultContext *ctx);
+  // called when delta buffer data changes without going through insert_rows, e.g. replay
+  void invalidate_delta_bitmap_cache();
   // Query Processor second
   int check_index_id_table_readnext_status(ObVectorQueryAdaptorResultContext *ctx,
                                            common::ObNewRowIterator *row_iter,
@@ -440,6 +477,14 @@ public:
   int query_result(ObVectorQueryAdaptorResultContext *ctx,
                    ObVectorQueryConditions *query_cond,
                    ObVectorQueryVidIterator *&vids_iter);
+  // fetch the next batch_size results of the searches opened by query_result, the results are
+  // farther than the fetched ones and returned by vids_iter. less results are returned once
+  // the searches end.
+  int query_next_result(ObVsagSearchIter &search_iter,
+                        const int64_t batch_size,
+                        ObIAllocator *allocator,
+                        ObVectorQueryVidIterator &vids_iter);
+  void release_search_iter(ObVsagSearchIter &search_iter);
   static int param_deserialize(char *ptr, int32_t length,
                                     ObIAllocator *allocator,
                                     ObVectorIndexAlgorithmType &type,
@@ -473,6 +518,11 @@ public:
                               ObIAllocator *allocator);
 
   int check_need_sync_to_follower(bool &need_sync);
+  // remove the deleted vectors from snapshot index once enough of them accumulated
+  int try_compact_snap_index();
+  void free_snap_removed_vids();
+  // measure the recall of snapshot index with each calibrated ef_search once its size changed enough
+  int try_calibrate_ef_search();
 
   void sync_finish() { follower_sync_statistics_.sync_count_++; }
   void sync_fail() { follower_sync_statistics_.sync_fail_++; }
@@ -503,7 +553,8 @@ public:
               K_(inc_table_id),  K_(vbitmap_table_id), K_(snapshot_table_id),
               K_(ref_cnt), K_(idle_cnt), KP_(allocator),
               K_(index_identity), K_(follower_sync_statistics),
-              K_(mem_check_cnt), K_(is_mem_limited));
+              K_(mem_check_cnt), K_(is_mem_limited),
+              K_(delta_dml_seq), K_(delta_cache_scn), K_(delta_cache_dml_seq), K_(delta_cache_commit_version));
 
 private:
   void *get_incr_index();
@@ -538,6 +589,23 @@ private:
                       ObVectorQueryConditions *query_cond,
                       int64_t dim, float *query_vector,
                       ObVectorQueryVidIterator *&vids_iter);
+  bool use_parallel_dual_search();
+  bool use_search_iter(const ObVectorQueryConditions *query_cond);
+  int open_search_iter(ObVsagSearchIter &search_iter,
+                       const roaring::api::roaring64_bitmap_t *ibitmap,
+                       const roaring::api::roaring64_bitmap_t *dbitmap,
+                       int64_t dim, float *query_vector, int64_t ef_search);
+  int fetch_search_iter_source(ObVsagSearchIter &search_iter, const int64_t idx, const int64_t cnt);
+  int64_t get_adaptive_ef_search(const ObVectorQueryConditions *query_cond,
+                                 const roaring::api::roaring64_bitmap_t *dbitmap);
+  int get_range_search_radius(const double distance_threshold, float &radius);
+  int get_cached_delta_bitmaps(ObVectorQueryAdaptorResultContext *ctx, SCN query_scn, bool &is_hit);
+  int try_cache_delta_bitmaps(ObVectorQueryAdaptorResultContext *ctx,
+                              SCN query_scn,
+                              int64_t scan_dml_seq,
+                              SCN scan_commit_version);
+  int get_committed_data_version(SCN &commit_version);
+  void free_delta_bitmap_cache();
 
 private:
   ObAdapterCreateType create_type_;
@@ -575,15 +643,52 @@ private:
   // statistics for judging whether need sync follower
   ObVectorIndexFollowerSyncStatic follower_sync_statistics_;
 
+  // merged delta buffer bitmaps of the last full scan, reused by queries while no dml arrives
+  int64_t delta_dml_seq_; // bumped by every dml on delta buffer table
+  TCRWLock delta_cache_rwlock_;
+  SCN delta_cache_scn_;
+  int64_t delta_cache_dml_seq_;
+  SCN delta_cache_commit_version_; // max committed version of tenant when the cache was scanned
+  ObVectorIndexRoaringBitMap *delta_cache_bitmaps_;
+  // deleted vids already removed from the snapshot index snap_removed_index_, and the number of
+  // the removed ones which were in it and are not compacted yet
+  void *snap_removed_index_;
+  roaring::api::roaring64_bitmap_t *snap_removed_vids_;
+  int64_t snap_removed_cnt_;
+
   constexpr static uint32_t VEC_INDEX_INCR_DATA_SYNC_THRESHOLD = 100;
   constexpr static uint32_t VEC_INDEX_VBITMAP_SYNC_THRESHOLD = 100;
   constexpr static uint32_t VEC_INDEX_SNAP_DATA_SYNC_THRESHOLD = 1;
   constexpr static uint32_t VEC_INDEX_ADAPTER_MAX_IDLE_COUNT = 3;
+  constexpr static double VEC_INDEX_COMPACT_DELETE_RATIO = 0.2;
+  constexpr static int64_t VEC_INDEX_CALIBRATE_EF_CNT = 7;
+  constexpr static int64_t VEC_INDEX_CALIBRATE_EF_SEARCHES[VEC_INDEX_CALIBRATE_EF_CNT] = {
+    16, 32, 64, 128, 256, 512, 1000
+  };
+  constexpr static int64_t VEC_INDEX_CALIBRATE_TOPK = 10;
+  constexpr static int64_t VEC_INDEX_CALIBRATE_MAX_SAMPLE_CNT = 100;
+  constexpr static int64_t VEC_INDEX_CALIBRATE_MIN_SAMPLE_CNT = 10;
+  // distance computations of the exact scans in one calibration
+  constexpr static int64_t VEC_INDEX_CALIBRATE_SCAN_BUDGET = 100000000;
+  constexpr static double VEC_INDEX_CALIBRATE_CHANGE_RATIO = 0.2;
+  constexpr static int64_t VEC_INDEX_MAX_ADAPTIVE_EF_SEARCH = 1000;
   constexpr const static char* const VEC_INDEX_ALGTH[ObVectorIndexDistAlgorithm::VIDA_MAX] = {
     "l2",
     "ip",
     "cos",
   };
+  constexpr const static char* const VEC_INDEX_ELEMENT_TYPE[ObVectorIndexElementType::VIET_MAX] = {
+    "float32",
+    "float16",
+    "bfloat16",
+    "int8",
+  };
+
+  // recall of snapshot index with each of VEC_INDEX_CALIBRATE_EF_SEARCHES, measured when it had
+  // ef_calibrated_cnt_ vectors, 0 means not calibrated yet
+  TCRWLock ef_calibrate_rwlock_;
+  int64_t ef_calibrated_cnt_;
+  float ef_recalls_[VEC_INDEX_CALIBRATE_EF_CNT];
 };
 
 class ObPluginVectorIndexAdapterGuard
@@ -630,6 +735,112 @@ private:
   ObPluginVectorIndexAdaptor *adapter_;
 };
 
+// Knn searches of a query on the delta and snapshot indexes that stay open after the first
+// results are returned, so that the results filtered out after lookup can be refilled by the
+// next nearest ones without searching from the entry points again. The indexes and the adaptor
+// are referenced until the searches are released.
+class ObVsagSearchIter
+{
+public:
+  ObVsagSearchIter()
+    : adaptor_guard_(),
+      ef_search_(0),
+      fetched_cnt_(0),
+      is_inited_(false)
+  {
+    MEMSET(sources_, 0, sizeof(sources_));
+  }
+  ~ObVsagSearchIter() { reset(); }
+  void reset();
+  bool is_inited() const { return is_inited_; }
+  int64_t get_fetched_cnt() const { return fetched_cnt_; }
+  // all results of the searches are returned
+  bool is_end() const;
+  int get_next_result(const int64_t batch_size,
+                      ObIAllocator *allocator,
+                      ObVectorQueryVidIterator &vids_iter);
+  TO_STRING_KV(K_(ef_search), K_(fetched_cnt), K_(is_inited));
+
+private:
+  friend class ObPluginVectorIndexAdaptor;
+  static const int64_t SOURCE_CNT = 2; // 0: delta index, 1: snapshot index
+  struct Source
+  {
+    ObVectorIndexMemData *mem_data_;  // referenced while the search is open
+    void *iter_;
+    roaring::api::roaring64_bitmap_t *invalid_; // the vids filtered out by the index, owned
+    const int64_t *vids_;             // the fetched results not returned yet, freed by mem_ctx_
+    const float *distances_;
+    int64_t cnt_;
+    int64_t pos_;
+    bool is_end_;
+  };
+  ObPluginVectorIndexAdapterGuard adaptor_guard_;
+  Source sources_[SOURCE_CNT];
+  int64_t ef_search_;
+  int64_t fetched_cnt_;
+  bool is_inited_;
+};
+
+// The delta index (search 0) and the snapshot index (search 1) of a query searched at the same
+// time. The task is queued to the search thread pool of the tenant, and the query thread takes the
+// searches in turn with the pool thread, so the searches which the pool does not start in time are
+// done by the query thread. The task is freed by the last one releasing it.
+class ObVsagDualSearchTask
+{
+public:
+  static const int64_t SEARCH_NUM = 2;
+  struct Search
+  {
+    obvectorlib::VectorIndexPtr index_;
+    roaring::api::roaring64_bitmap_t *filter_;
+    const float **distances_;
+    const int64_t **vids_;
+    int64_t *res_cnt_;
+    int ret_;
+  };
+  static int create(const uint64_t tenant_id,
+                    float *query_vector,
+                    const int64_t dim,
+                    const int64_t topk,
+                    const int ef_search,
+                    roaring::api::roaring64_bitmap_t *valid,
+                    ObVsagDualSearchTask *&task);
+  void inc_ref() { ATOMIC_INC(&ref_cnt_); }
+  void release();
+  // take and run the searches which are not taken yet
+  void run();
+  // wait until all the searches finish
+  void wait();
+  TO_STRING_KV(K_(tenant_id), K_(dim), K_(topk), K_(ef_search), K_(next_search), K_(finished_cnt), K_(ref_cnt));
+
+public:
+  Search searches_[SEARCH_NUM];
+
+private:
+  ObVsagDualSearchTask(const uint64_t tenant_id, float *query_vector, const int64_t dim,
+                       const int64_t topk, const int ef_search, roaring::api::roaring64_bitmap_t *valid);
+  ~ObVsagDualSearchTask();
+
+private:
+  uint64_t tenant_id_;
+  float *query_vector_;
+  int64_t dim_;
+  int64_t topk_;
+  int ef_search_;
+  roaring::api::roaring64_bitmap_t *valid_;
+  // each search stops once its candidates can not beat the k-th result of the other one
+  std::atomic<float> bounds_[SEARCH_NUM];
+  common::ObThreadCond cond_;
+  int64_t next_search_;
+  int64_t finished_cnt_;
+  int64_t ref_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObVsagDualSearchTask);
+};
+
+// Small allocations of vsag (mostly the link lists of hnsw elements) are served by size class
+// small allocators, whose blocks are returned as soon as all slots of them are freed. Large
+// allocations go to the mem context directly.
 class ObVsagMemContext : public vsag::Allocator
 {
 public:
@@ -656,17 +867,29 @@ public:
   void* Reallocate(void* p, size_t size) override;
 
   int64_t hold() {
-    return mem_context_->hold();
+    return mem_context_->hold() + get_slab_hold();
   }
 
+  // free slots of the slab blocks in use are counted as used
   int64_t used() {
-    return mem_context_->used();
+    return mem_context_->used() + get_slab_hold();
   }
 
+private:
+  static int64_t get_slab_idx(const int64_t actual_size);
+  int64_t get_slab_hold();
+
 private:
   uint64_t *all_vsag_use_mem_;
   lib::MemoryContext mem_context_;
   constexpr static int64_t MEM_PTR_HEAD_SIZE = sizeof(int64_t);
+  // slot sizes are 16, 32, ..., 1024 bytes, header included
+  constexpr static int64_t SLAB_MIN_SIZE_SHIFT = 4;
+  constexpr static int64_t SLAB_CLASS_CNT = 7;
+  constexpr static int64_t SLAB_MAX_SIZE = 1L << (SLAB_MIN_SIZE_SHIFT + SLAB_CLASS_CNT - 1);
+  // same as the parallel of the mem context, each way caches one partially used block
+  constexpr static int64_t SLAB_NWAY = 4;
+  common::ObSmallAllocator slab_allocs_[SLAB_CLASS_CNT];
 };
 
 void free_memdata_resource(ObVectorIndexRecordType type,
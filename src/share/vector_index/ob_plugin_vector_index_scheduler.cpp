@@ -929,6 +929,82 @@ int ObPluginVectorIndexLoadScheduler::log_tablets_need_memdata_sync(ObPluginVect
   return ret;
 }
 
+int ObPluginVectorIndexLoadScheduler::compact_deleted_vectors(ObPluginVectorIndexMgr *mgr)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(mgr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get null mgr", KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
+  } else {
+    FOREACH_X(iter, mgr->get_complete_adapter_map(), OB_SUCC(ret)) {
+      ObPluginVectorIndexAdaptor *adapter = iter->second;
+      int tmp_ret = OB_SUCCESS;
+      if (OB_ISNULL(adapter)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get null adapter", KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
+      } else if (iter->first != adapter->get_inc_tablet_id()) {
+        // do nothing, one adapter is mapped by several tablets
+      } else if (OB_TMP_FAIL(adapter->try_compact_snap_index())) {
+        // continue to compact other adapters
+        LOG_WARN("fail to compact snap index", KR(tmp_ret), K(iter->first), K(tenant_id_), K(ls_->get_ls_id()));
+      }
+    }
+  }
+  return ret;
+}
+
+// delta bitmaps cached by queries are only valid for the dml seen by this replica as leader
+void ObPluginVectorIndexLoadScheduler::invalidate_delta_bitmap_caches(ObPluginVectorIndexMgr *mgr)
+{
+  if (OB_NOT_NULL(mgr)) {
+    FOREACH(iter, mgr->get_complete_adapter_map()) {
+      ObPluginVectorIndexAdaptor *adapter = iter->second;
+      if (OB_NOT_NULL(adapter) && iter->first == adapter->get_inc_tablet_id()) {
+        adapter->invalidate_delta_bitmap_cache();
+      }
+    }
+  }
+}
+
+void ObPluginVectorIndexLoadScheduler::invalidate_delta_bitmap_caches()
+{
+  int ret = OB_SUCCESS;
+  ObPluginVectorIndexMgr *mgr = nullptr;
+  if (OB_ISNULL(vector_index_service_) || OB_ISNULL(ls_)) {
+    // not inited
+  } else if (OB_FAIL(vector_index_service_->get_ls_index_mgr_map().get_refactored(ls_->get_ls_id(), mgr))) {
+    if (OB_HASH_NOT_EXIST != ret) {
+      LOG_WARN("fail to get vector index ls mgr", KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
+    }
+  } else {
+    invalidate_delta_bitmap_caches(mgr);
+  }
+}
+
+int ObPluginVectorIndexLoadScheduler::calibrate_ef_search(ObPluginVectorIndexMgr *mgr)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(mgr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get null mgr", KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
+  } else {
+    FOREACH_X(iter, mgr->get_complete_adapter_map(), OB_SUCC(ret)) {
+      ObPluginVectorIndexAdaptor *adapter = iter->second;
+      int tmp_ret = OB_SUCCESS;
+      if (OB_ISNULL(adapter)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get null adapter", KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
+      } else if (iter->first != adapter->get_inc_tablet_id()) {
+        // do nothing, one adapter is mapped by several tablets
+      } else if (OB_TMP_FAIL(adapter->try_calibrate_ef_search())) {
+        // continue to calibrate other adapters
+        LOG_WARN("fail to calibrate ef search", KR(tmp_ret), K(iter->first), K(tenant_id_), K(ls_->get_ls_id()));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObPluginVectorIndexLoadScheduler::execute_all_memdata_sync_task(ObPluginVectorIndexMgr *mgr)
 {
   int ret = OB_SUCCESS;
@@ -1051,6 +1127,17 @@ int ObPluginVectorIndexLoadScheduler::check_and_execute_tasks()
       LOG_WARN("fail to check and execute memdata sync task",
         KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
     }
+
+    // the background tasks below do not cover the error code of memdata sync
+    int tmp_ret = OB_SUCCESS;
+    // remove deleted vectors from snapshot index
+    if (OB_NOT_NULL(index_ls_mgr) && OB_TMP_FAIL(compact_deleted_vectors(index_ls_mgr))) {
+      LOG_WARN("fail to compact deleted vectors", KR(tmp_ret), K(tenant_id_), K(ls_->get_ls_id()));
+    }
+    // measure the recall of snapshot indexes for the queries with a target recall
+    if (OB_NOT_NULL(index_ls_mgr) && OB_TMP_FAIL(calibrate_ef_search(index_ls_mgr))) {
+      LOG_WARN("fail to calibrate ef search", KR(tmp_ret), K(tenant_id_), K(ls_->get_ls_id()));
+    }
   }
   return ret;
 }
@@ -1171,6 +1258,7 @@ int ObPluginVectorIndexLoadScheduler::handle_replay_result(ObVectorIndexSyncLog
   } else if (OB_ISNULL(mgr)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("get invalid vector index ls mgr", KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
+  } else if (OB_FALSE_IT(invalidate_delta_bitmap_caches(mgr))) {
   } else if (OB_FAIL(mgr->get_mem_sync_info().add_task_to_waiting_map(ls_log))){
     LOG_WARN("memdata sync failed to add task", KR(ret), K(tenant_id_), K(ls_->get_ls_id()));
   }
@@ -1232,6 +1320,7 @@ int ObPluginVectorIndexLoadScheduler::switch_to_leader()
   } else {
     ATOMIC_STORE(&is_leader_, true);
     ATOMIC_STORE(&need_do_for_switch_, true);
+    invalidate_delta_bitmap_caches();
   }
   const int64_t cost_us = ObTimeUtility::current_time() - start_time_us;
   FLOG_INFO("vector index scheduler: finish to switch_to_leader", KR(ret), K_(tenant_id), KPC_(ls), K(cost_us));
@@ -1256,6 +1345,7 @@ void ObPluginVectorIndexLoadScheduler::inner_switch_to_follower_()
   const int64_t start_time_us = ObTimeUtility::current_time();
   ATOMIC_STORE(&is_leader_, false);
   ATOMIC_STORE(&need_do_for_switch_, true);
+  invalidate_delta_bitmap_caches();
   const int64_t cost_us = ObTimeUtility::current_time() - start_time_us;
   FLOG_INFO("vector index scheduler: finish to switch_to_follower", K_(tenant_id), KPC_(ls), K(cost_us));
 }
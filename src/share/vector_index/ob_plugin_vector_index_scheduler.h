@@ -241,6 +241,10 @@ public:
   int check_index_adpter_exist(ObPluginVectorIndexMgr *mgr);
 
   int log_tablets_need_memdata_sync(ObPluginVectorIndexMgr *mgr);
+  int compact_deleted_vectors(ObPluginVectorIndexMgr *mgr);
+  int calibrate_ef_search(ObPluginVectorIndexMgr *mgr);
+  void invalidate_delta_bitmap_caches(ObPluginVectorIndexMgr *mgr);
+  void invalidate_delta_bitmap_caches();
   int execute_all_memdata_sync_task(ObPluginVectorIndexMgr *mgr);
   int execute_one_memdata_sync_task(ObPluginVectorIndexMgr *mgr, ObPluginVectorIndexTaskCtx *ctx);
   int check_ls_task_state(ObPluginVectorIndexMgr *mgr);
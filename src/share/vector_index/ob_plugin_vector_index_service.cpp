@@ -707,6 +707,7 @@ void ObPluginVectorIndexService::destroy()
       }
     }
     index_ls_mgr_map_.destroy();
+    search_thread_pool_.destroy();
     allocator_.reset();
     if (memory_context_ != nullptr) {
       DESTROY_CONTEXT(memory_context_);
@@ -745,8 +746,15 @@ int ObPluginVectorIndexService::init(const uint64_t tenant_id,
       .set_page_size(OB_MALLOC_MIDDLE_BLOCK_SIZE)
       .set_label("VectorIndexVsag")
       .set_ablock_size(lib::INTACT_MIDDLE_AOBJECT_SIZE);
+    const int64_t search_thread_num = OB_MIN(ObVectorIndexSearchThreadPool::MAX_SEARCH_THREAD_NUM,
+                                             OB_MAX(1, static_cast<int64_t>(MTL_CPU_COUNT())));
     if (OB_FAIL(ROOT_CONTEXT->CREATE_CONTEXT(memory_context_, param))) {
       LOG_WARN("create memory entity failed", K(ret));
+    } else if (OB_FAIL(search_thread_pool_.init(search_thread_num,
+                                                ObVectorIndexSearchThreadPool::SEARCH_TASK_NUM_LIMIT,
+                                                "VIndexSearch",
+                                                tenant_id))) {
+      LOG_WARN("init vector index search thread pool failed", K(ret), K(search_thread_num));
     } else {
       tenant_id_ = tenant_id;
       schema_service_ = schema_service;
@@ -784,6 +792,7 @@ void ObPluginVectorIndexService::stop()
 {
   if (IS_INIT) {
     LOG_INFO("stop vector index service", K_(tenant_id), K_(is_inited));
+    search_thread_pool_.stop();
   }
 }
 
@@ -791,6 +800,33 @@ void ObPluginVectorIndexService::wait()
 {
   if (IS_INIT) {
     LOG_INFO("wait vector index service", K_(tenant_id));
+    search_thread_pool_.wait();
+  }
+}
+
+int ObPluginVectorIndexService::push_search_task(ObVsagDualSearchTask *task)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObPluginVectorIndexService is not inited", KR(ret), K_(tenant_id));
+  } else if (OB_ISNULL(task)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", KR(ret), KP(task));
+  } else if (FALSE_IT(task->inc_ref())) {
+  } else if (OB_FAIL(search_thread_pool_.push(task))) {
+    LOG_TRACE("failed to push search task", KR(ret), KPC(task));
+    task->release();
+  }
+  return ret;
+}
+
+void ObVectorIndexSearchThreadPool::handle(void *task)
+{
+  ObVsagDualSearchTask *search_task = static_cast<ObVsagDualSearchTask *>(task);
+  if (OB_NOT_NULL(search_task)) {
+    search_task->run();
+    search_task->release();
   }
 }
 
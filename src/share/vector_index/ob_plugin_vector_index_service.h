@@ -15,6 +15,7 @@
 #include "share/ob_ls_id.h"
 #include "share/scn.h"
 #include "lib/lock/ob_recursive_mutex.h"
+#include "lib/thread/ob_simple_thread_pool.h"
 #include "share/rc/ob_tenant_base.h"
 #include "share/vector_index/ob_plugin_vector_index_adaptor.h"
 #include "share/vector_index/ob_plugin_vector_index_scheduler.h"
@@ -223,6 +224,18 @@ struct ObPluginVectorIndexIdentity
   ObString index_identity_; // index_name_prefix
 };
 
+// Long-lived threads of a tenant running the delta index searches of ObVsagDualSearchTask
+// beside the query threads.
+class ObVectorIndexSearchThreadPool : public common::ObSimpleThreadPool
+{
+public:
+  static const int64_t MAX_SEARCH_THREAD_NUM = 8;
+  static const int64_t SEARCH_TASK_NUM_LIMIT = 1024;
+  ObVectorIndexSearchThreadPool() {}
+  virtual ~ObVectorIndexSearchThreadPool() {}
+  virtual void handle(void *task) override;
+};
+
 typedef common::hash::ObHashMap<share::ObLSID, ObPluginVectorIndexMgr*> LSIndexMgrMap;
 // Manage all vector index adapters of a tenant
 class ObPluginVectorIndexService
@@ -263,6 +276,8 @@ public:
                              int64_t dim = 0);
   int check_and_merge_adapter(ObLSID ls_id, ObVecIdxSharedTableInfoMap &info_map);
   int acquire_vector_index_mgr(ObLSID ls_id, ObPluginVectorIndexMgr *&mgr);
+  // queue the task to the search threads, which take a reference of it
+  int push_search_task(ObVsagDualSearchTask *task);
 
   // user interfaces
   int acquire_adapter_guard(ObLSID ls_id,
@@ -300,6 +315,7 @@ private:
   common::ObArenaAllocator alloc_;
   lib::MemoryContext memory_context_;
   uint64_t all_vsag_use_mem_;
+  ObVectorIndexSearchThreadPool search_thread_pool_;
 
 public:
   volatile bool stop_flag_;
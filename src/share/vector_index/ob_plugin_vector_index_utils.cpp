@@ -24,6 +24,9 @@
 #include "storage/tx_storage/ob_access_service.h"
 #include "storage/access/ob_table_scan_iterator.h"
 #include "lib/vector/ob_vector_util.h"
+#include "lib/thread/threads.h"
+#include "lib/file/file_directory_utils.h"
+#include "share/config/ob_server_config.h"
 #include "common/rowkey/ob_rowkey.h"
 #include "src/share/schema/ob_tenant_schema_service.h"
 
@@ -32,6 +35,63 @@ namespace oceanbase
 namespace share
 {
 
+class ObVsagBuildThreads : public lib::Threads
+{
+public:
+  ObVsagBuildThreads(obvectorlib::ParallelTask task, void *task_arg, const lib::ObMemAttr &mem_attr)
+    : task_(task), task_arg_(task_arg), mem_attr_(mem_attr)
+  {}
+  virtual ~ObVsagBuildThreads() {}
+  virtual void run1() override
+  {
+    lib::set_thread_name("VIndexBuild");
+    lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+    task_(task_arg_, static_cast<int64_t>(get_thread_idx()));
+  }
+private:
+  obvectorlib::ParallelTask task_;
+  void *task_arg_;
+  lib::ObMemAttr mem_attr_;
+};
+
+void ObPluginVectorIndexUtils::vsag_parallel_execute(int64_t task_num, obvectorlib::ParallelTask task, void *task_arg)
+{
+  int ret = OB_SUCCESS;
+  int64_t thread_num = task_num;
+  if (OB_NOT_NULL(MTL_CTX())) {
+    // never use more threads than the tenant's cpu
+    thread_num = OB_MIN(task_num, OB_MAX(1, static_cast<int64_t>(MTL_CPU_COUNT())));
+  }
+  ObVsagBuildThreads threads(task, task_arg, lib::ObMallocHookAttrGuard::get_tl_mem_attr());
+  threads.set_run_wrapper(MTL_CTX());
+  if (OB_ISNULL(task) || thread_num <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(task), K(task_num));
+  } else if (OB_FAIL(threads.set_thread_count(thread_num))) {
+    LOG_WARN("failed to set vsag build thread count", K(ret), K(thread_num));
+  } else if (OB_FAIL(threads.start())) {
+    // vsag finishes the tasks which are not executed in the caller thread
+    LOG_WARN("failed to start vsag build threads", K(ret), K(thread_num));
+  }
+  threads.wait();
+  threads.destroy();
+  LOG_TRACE("vsag parallel execute finished", K(ret), K(task_num), K(thread_num));
+}
+
+int ObPluginVectorIndexUtils::set_vsag_disk_index_dir()
+{
+  int ret = OB_SUCCESS;
+  char dir[OB_MAX_FILE_NAME_LENGTH] = {0};
+  if (OB_FAIL(databuff_printf(dir, sizeof(dir), "%s/vec_index", GCONF.data_dir.str()))) {
+    LOG_WARN("failed to print vector index dir", K(ret));
+  } else if (OB_FAIL(FileDirectoryUtils::create_full_path(dir))) {
+    LOG_WARN("failed to create vector index dir", K(ret), K(dir));
+  } else if (OB_FAIL(obvectorutil::set_disk_index_dir(dir))) {
+    LOG_WARN("failed to set vsag disk index dir", K(ret), K(dir));
+  }
+  return ret;
+}
+
 int ObPluginVectorIndexUtils::get_task_read_snapshot(ObLSID &ls_id, SCN &read_version)
 {
   int ret = OB_SUCCESS;
@@ -509,6 +569,8 @@ int ObPluginVectorIndexUtils::try_sync_snapshot_memdata(ObLSID &ls_id,
     } else if (OB_FAIL(adapter->try_init_mem_data(VIRT_SNAP))) {
       LOG_WARN("failed to init snapshot index.", K(ret));
     } else {
+      // queries arriving during the load are answered by brute force instead of waiting
+      const bool is_loader = adapter->try_begin_snap_load();
       TCWLockGuard lock_guard(snap_memdata->mem_data_rwlock_);
       int64_t index_count = 0;
       if (OB_FAIL(obvectorutil::get_index_number(snap_memdata->index_, index_count))) {
@@ -535,6 +597,9 @@ int ObPluginVectorIndexUtils::try_sync_snapshot_memdata(ObLSID &ls_id,
         adapter->close_snap_data_rb_flag();
         LOG_INFO("memdata sync snapshot index complement data", K(index_count), K(ls_id), K(index_type), KPC(adapter));
       }
+      if (is_loader) {
+        adapter->end_snap_load();
+      }
     }
   }
 
@@ -611,6 +676,8 @@ int ObPluginVectorIndexUtils::refresh_memdata(ObLSID &ls_id,
             LOG_WARN("failed to refresh mem snapshots without refresh incr", KR(ret));
           }
         }
+        // incr data synced here doesn't pass insert_rows
+        adapter->invalidate_delta_bitmap_cache();
       }
       if (OB_NOT_NULL(delta_buf_iter) && OB_NOT_NULL(tsc_service)) {
         int tmp_ret = tsc_service->revert_scan_iter(delta_buf_iter);
@@ -63,6 +63,13 @@ public:
   static int set_vsag_logger() {
     return obvectorutil::init_vasg_logger(&ObVsagLoggerSingleton::getInstance());
   }
+  static int set_vsag_parallel_executor() {
+    return obvectorutil::set_parallel_executor(&ObPluginVectorIndexUtils::vsag_parallel_execute);
+  }
+  // the graph and full vectors of loaded diskann indexes are spilled to ${data_dir}/vec_index
+  static int set_vsag_disk_index_dir();
+  // run vsag index build tasks on threads bound to the caller's tenant
+  static void vsag_parallel_execute(int64_t task_num, obvectorlib::ParallelTask task, void *task_arg);
 
   static int add_key_ranges(uint64_t table_id, ObRowkey& rowkey, storage::ObTableScanParam &scan_param);
   static int iter_table_rescan(storage::ObTableScanParam &scan_param, common::ObNewRowIterator *iter);
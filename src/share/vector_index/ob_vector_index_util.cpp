@@ -41,6 +41,7 @@ int ObVectorIndexUtil::parser_params_from_string(
     const int64_t default_m_value = 16;
     const int64_t default_ef_construction_value = 200;
     const int64_t default_ef_search_value = 64;
+    const int64_t default_build_thread_num = 1;
     const ObVectorIndexAlgorithmLib default_lib = ObVectorIndexAlgorithmLib::VIAL_VSAG;
 
     for (int64_t i = 0; OB_SUCC(ret) && i < tmp_param_strs.count(); ++i) {
@@ -74,6 +75,10 @@ int ObVectorIndexUtil::parser_params_from_string(
         } else if (new_param_name == "TYPE") {
           if (new_param_value == "HNSW") {
             param.type_ = ObVectorIndexAlgorithmType::VIAT_HNSW;
+          } else if (new_param_value == "HNSW_SQ") {
+            param.type_ = ObVectorIndexAlgorithmType::VIAT_HNSW_SQ;
+          } else if (new_param_value == "DISKANN") {
+            param.type_ = ObVectorIndexAlgorithmType::VIAT_DISKANN;
           } else {
             ret = OB_NOT_SUPPORTED;
             LOG_WARN("not support vector index type", K(ret), K(new_param_value));
@@ -108,16 +113,47 @@ int ObVectorIndexUtil::parser_params_from_string(
             ret = OB_NOT_SUPPORTED;
             LOG_WARN("not support vector index ef_search value", K(ret), K(int_value), K(new_param_value));
           }
+        } else if (new_param_name == "BUILD_THREAD_NUM") {
+          int64_t int_value = 0;
+          if (OB_FAIL(ObSchemaUtils::str_to_int(new_param_value, int_value))) {
+            LOG_WARN("fail to str_to_int", K(ret), K(new_param_value));
+          } else if (int_value >= 1 && int_value <= 64) {
+            param.build_thread_num_ = int_value;
+          } else {
+            ret = OB_NOT_SUPPORTED;
+            LOG_WARN("not support vector index build_thread_num value", K(ret), K(int_value), K(new_param_value));
+          }
+        } else if (new_param_name == "ELEMENT_TYPE") {
+          if (new_param_value == "FLOAT32") {
+            param.element_type_ = ObVectorIndexElementType::VIET_FLOAT32;
+          } else if (new_param_value == "FLOAT16") {
+            param.element_type_ = ObVectorIndexElementType::VIET_FLOAT16;
+          } else if (new_param_value == "BFLOAT16") {
+            param.element_type_ = ObVectorIndexElementType::VIET_BFLOAT16;
+          } else if (new_param_value == "INT8") {
+            param.element_type_ = ObVectorIndexElementType::VIET_INT8;
+          } else {
+            ret = OB_NOT_SUPPORTED;
+            LOG_WARN("not support vector index element type", K(ret), K(new_param_value));
+          }
         } else {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("unexpected vector index param name", K(ret), K(new_param_name));
         }
       }
     }
+    if (OB_FAIL(ret)) {
+    } else if (ObVectorIndexElementType::VIET_FLOAT32 != param.element_type_
+               && ObVectorIndexAlgorithmType::VIAT_HNSW != param.type_) {
+      // hnsw_sq already quantizes the vectors, and diskann keeps pq codes
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("vector index element type is only supported by hnsw", K(ret), K(param));
+    }
     if (OB_SUCC(ret)) {  // if vector parram not set, set default
       if (param.m_ == 0) { param.m_ = default_m_value; }
       if (param.ef_construction_ == 0) { param.ef_construction_ = default_ef_construction_value; }
       if (param.ef_search_ == 0) { param.ef_search_ = default_ef_search_value; }
+      if (param.build_thread_num_ == 0) { param.build_thread_num_ = default_build_thread_num; }
       if (param.lib_ == ObVectorIndexAlgorithmLib::VIAL_MAX) { param.lib_ = default_lib; }
       param.dim_ = 0; // TODO@xiajin: fill dim
     }
@@ -11,13 +11,112 @@
  */
 
 #include "ob_vector_cosine_distance.h"
+#include "ob_vector_simd_util.h"
 namespace oceanbase
 {
 namespace common
 {
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline bool cosine_calculate(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+{
+  __m256d ip_sum = _mm256_setzero_pd();
+  __m256d a_sum = _mm256_setzero_pd();
+  __m256d b_sum = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 va = _mm256_loadu_ps(a + i);
+    __m256 vb = _mm256_loadu_ps(b + i);
+    __m256 ab = _mm256_mul_ps(va, vb);
+    __m256 aa = _mm256_mul_ps(va, va);
+    __m256 bb = _mm256_mul_ps(vb, vb);
+    ip_sum = _mm256_add_pd(ip_sum, _mm256_add_pd(cvt_lo_pd(ab), cvt_hi_pd(ab)));
+    a_sum = _mm256_add_pd(a_sum, _mm256_add_pd(cvt_lo_pd(aa), cvt_hi_pd(aa)));
+    b_sum = _mm256_add_pd(b_sum, _mm256_add_pd(cvt_lo_pd(bb), cvt_hi_pd(bb)));
+  }
+  ip = hsum_pd(ip_sum);
+  abs_dist_a = hsum_pd(a_sum);
+  abs_dist_b = hsum_pd(b_sum);
+  for (; i < len; ++i) {
+    ip += a[i] * b[i];
+    abs_dist_a += a[i] * a[i];
+    abs_dist_b += b[i] * b[i];
+  }
+  return is_finite_result(ip) && is_finite_result(abs_dist_a) && is_finite_result(abs_dist_b);
+}
+)
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline bool cosine_calculate(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+{
+  __m512d ip_sum = _mm512_setzero_pd();
+  __m512d a_sum = _mm512_setzero_pd();
+  __m512d b_sum = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 va = _mm512_loadu_ps(a + i);
+    __m512 vb = _mm512_loadu_ps(b + i);
+    __m512 ab = _mm512_mul_ps(va, vb);
+    __m512 aa = _mm512_mul_ps(va, va);
+    __m512 bb = _mm512_mul_ps(vb, vb);
+    ip_sum = _mm512_add_pd(ip_sum, _mm512_add_pd(cvt_lo_pd(ab), cvt_hi_pd(ab)));
+    a_sum = _mm512_add_pd(a_sum, _mm512_add_pd(cvt_lo_pd(aa), cvt_hi_pd(aa)));
+    b_sum = _mm512_add_pd(b_sum, _mm512_add_pd(cvt_lo_pd(bb), cvt_hi_pd(bb)));
+  }
+  ip = hsum_pd(ip_sum);
+  abs_dist_a = hsum_pd(a_sum);
+  abs_dist_b = hsum_pd(b_sum);
+  for (; i < len; ++i) {
+    ip += a[i] * b[i];
+    abs_dist_a += a[i] * a[i];
+    abs_dist_b += b[i] * b[i];
+  }
+  return is_finite_result(ip) && is_finite_result(abs_dist_a) && is_finite_result(abs_dist_b);
+}
+)
+
+bool ObVectorCosineDistance::cosine_calculate_avx2(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx2::cosine_calculate(a, b, len, ip, abs_dist_a, abs_dist_b);
+#else
+  return false;
+#endif
+}
+
+bool ObVectorCosineDistance::cosine_calculate_avx512(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx512::cosine_calculate(a, b, len, ip, abs_dist_a, abs_dist_b);
+#else
+  return false;
+#endif
+}
+
 int ObVectorCosineDistance::cosine_similarity_func(const float *a, const float *b, const int64_t len, double &similarity)
 {
-  return cosine_similarity_normal(a, b, len, similarity);
+  int ret = OB_SUCCESS;
+  bool is_done = false;
+#if OB_USE_MULTITARGET_CODE
+  double ip = 0;
+  double abs_dist_a = 0;
+  double abs_dist_b = 0;
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    is_done = cosine_calculate_avx512(a, b, len, ip, abs_dist_a, abs_dist_b);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    is_done = cosine_calculate_avx2(a, b, len, ip, abs_dist_a, abs_dist_b);
+  }
+  if (!is_done) {
+  } else if (0 == abs_dist_a || 0 == abs_dist_b) {
+    similarity = 0;
+    ret = OB_ERR_NULL_VALUE;
+  } else {
+    similarity = ip / (sqrt(abs_dist_a * abs_dist_b));
+  }
+#endif
+  if (!is_done) {
+    ret = cosine_similarity_normal(a, b, len, similarity);
+  }
+  return ret;
 }
 
 int ObVectorCosineDistance::cosine_distance_func(const float *a, const float *b, const int64_t len, double &distance) {
@@ -43,7 +142,7 @@ OB_INLINE double ObVectorCosineDistance::get_cosine_distance(double similarity)
   return 1.0 - similarity;
 }
 
-OB_INLINE int ObVectorCosineDistance::cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+int ObVectorCosineDistance::cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
 {
   int ret = OB_SUCCESS;
   for (int64_t i = 0; OB_SUCC(ret) && i < len; ++i) {
@@ -58,7 +157,7 @@ OB_INLINE int ObVectorCosineDistance::cosine_calculate_normal(const float *a, co
   return ret;
 }
 
-OB_INLINE int ObVectorCosineDistance::cosine_similarity_normal(const float *a, const float *b, const int64_t len, double &similarity)
+int ObVectorCosineDistance::cosine_similarity_normal(const float *a, const float *b, const int64_t len, double &similarity)
 {
   int ret = OB_SUCCESS;
   double ip = 0;
@@ -28,10 +28,13 @@ struct ObVectorCosineDistance
   static int cosine_distance_func(const float *a, const float *b, const int64_t len, double &distance);
 
   // normal func
-  OB_INLINE static int cosine_similarity_normal(const float *a, const float *b, const int64_t len, double &similarity);
-  OB_INLINE static int cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
+  static int cosine_similarity_normal(const float *a, const float *b, const int64_t len, double &similarity);
+  static int cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
   OB_INLINE static double get_cosine_distance(double similarity);
-  // TODO(@jingshui) add simd func
+  // simd funcs, the caller should check the cpu arch. they return false if the arch is not
+  // compiled in or the result is not finite, then the normal func should be used instead.
+  static bool cosine_calculate_avx2(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
+  static bool cosine_calculate_avx512(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
 };
 } // common
 } // oceanbase
@@ -11,16 +11,89 @@
  */
 
 #include "ob_vector_ip_distance.h"
+#include "ob_vector_simd_util.h"
 namespace oceanbase
 {
 namespace common
 {
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline bool ip_distance(const float *a, const float *b, const int64_t len, double &distance)
+{
+  __m256d sum_lo = _mm256_setzero_pd();
+  __m256d sum_hi = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 mul = _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    sum_lo = _mm256_add_pd(sum_lo, cvt_lo_pd(mul));
+    sum_hi = _mm256_add_pd(sum_hi, cvt_hi_pd(mul));
+  }
+  double sum = hsum_pd(_mm256_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    sum += a[i] * b[i];
+  }
+  distance += sum;
+  return is_finite_result(distance);
+}
+)
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline bool ip_distance(const float *a, const float *b, const int64_t len, double &distance)
+{
+  __m512d sum_lo = _mm512_setzero_pd();
+  __m512d sum_hi = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 mul = _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    sum_lo = _mm512_add_pd(sum_lo, cvt_lo_pd(mul));
+    sum_hi = _mm512_add_pd(sum_hi, cvt_hi_pd(mul));
+  }
+  double sum = hsum_pd(_mm512_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    sum += a[i] * b[i];
+  }
+  distance += sum;
+  return is_finite_result(distance);
+}
+)
+
+bool ObVectorIpDistance::ip_distance_avx2(const float *a, const float *b, const int64_t len, double &distance)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx2::ip_distance(a, b, len, distance);
+#else
+  return false;
+#endif
+}
+
+bool ObVectorIpDistance::ip_distance_avx512(const float *a, const float *b, const int64_t len, double &distance)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx512::ip_distance(a, b, len, distance);
+#else
+  return false;
+#endif
+}
+
 int ObVectorIpDistance::ip_distance_func(const float *a, const float *b, const int64_t len, double &distance)
 {
-return ip_distance_normal(a, b, len, distance);
+  int ret = OB_SUCCESS;
+  bool is_done = false;
+  const double init_distance = distance;
+#if OB_USE_MULTITARGET_CODE
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    is_done = ip_distance_avx512(a, b, len, distance);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    is_done = ip_distance_avx2(a, b, len, distance);
+  }
+#endif
+  if (!is_done) {
+    distance = init_distance;
+    ret = ip_distance_normal(a, b, len, distance);
+  }
+  return ret;
 }
 
-OB_INLINE int ObVectorIpDistance::ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance)
+int ObVectorIpDistance::ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance)
 {
   int ret = OB_SUCCESS;
   for (int64_t i = 0; OB_SUCC(ret) && i < len; ++i) {
@@ -27,8 +27,11 @@ struct ObVectorIpDistance
   static int ip_distance_func(const float *a, const float *b, const int64_t len, double &distance);
 
   // normal func
-  OB_INLINE static int ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance);
-  // TODO(@jingshui) add simd func
+  static int ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance);
+  // simd funcs, the caller should check the cpu arch. they return false if the arch is not
+  // compiled in or the result is not finite, then the normal func should be used instead.
+  static bool ip_distance_avx2(const float *a, const float *b, const int64_t len, double &distance);
+  static bool ip_distance_avx512(const float *a, const float *b, const int64_t len, double &distance);
 };
 
 } // common
@@ -11,16 +11,87 @@
  */
 
 #include "ob_vector_l1_distance.h"
+#include "ob_vector_simd_util.h"
 namespace oceanbase
 {
 namespace common
 {
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline bool l1_distance(const float *a, const float *b, const int64_t len, double &distance)
+{
+  __m256d sum_lo = _mm256_setzero_pd();
+  __m256d sum_hi = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 diff = abs_ps(_mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    sum_lo = _mm256_add_pd(sum_lo, cvt_lo_pd(diff));
+    sum_hi = _mm256_add_pd(sum_hi, cvt_hi_pd(diff));
+  }
+  double sum = hsum_pd(_mm256_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    sum += fabs(a[i] - b[i]);
+  }
+  distance = sum;
+  return is_finite_result(sum);
+}
+)
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline bool l1_distance(const float *a, const float *b, const int64_t len, double &distance)
+{
+  __m512d sum_lo = _mm512_setzero_pd();
+  __m512d sum_hi = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 diff = abs_ps(_mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    sum_lo = _mm512_add_pd(sum_lo, cvt_lo_pd(diff));
+    sum_hi = _mm512_add_pd(sum_hi, cvt_hi_pd(diff));
+  }
+  double sum = hsum_pd(_mm512_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    sum += fabs(a[i] - b[i]);
+  }
+  distance = sum;
+  return is_finite_result(sum);
+}
+)
+
+bool ObVectorL1Distance::l1_distance_avx2(const float *a, const float *b, const int64_t len, double &distance)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx2::l1_distance(a, b, len, distance);
+#else
+  return false;
+#endif
+}
+
+bool ObVectorL1Distance::l1_distance_avx512(const float *a, const float *b, const int64_t len, double &distance)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx512::l1_distance(a, b, len, distance);
+#else
+  return false;
+#endif
+}
+
 int ObVectorL1Distance::l1_distance_func(const float *a, const float *b, const int64_t len, double &distance)
 {
-return l1_distance_normal(a, b, len, distance);
+  int ret = OB_SUCCESS;
+  bool is_done = false;
+#if OB_USE_MULTITARGET_CODE
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    is_done = l1_distance_avx512(a, b, len, distance);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    is_done = l1_distance_avx2(a, b, len, distance);
+  }
+#endif
+  if (!is_done) {
+    ret = l1_distance_normal(a, b, len, distance);
+  }
+  return ret;
 }
 
-OB_INLINE int ObVectorL1Distance::l1_distance_normal(const float *a, const float *b, const int64_t len, double &distance)
+int ObVectorL1Distance::l1_distance_normal(const float *a, const float *b, const int64_t len, double &distance)
 {
   int ret = OB_SUCCESS;
   double sum = 0;
@@ -27,8 +27,11 @@ struct ObVectorL1Distance
   static int l1_distance_func(const float *a, const float *b, const int64_t len, double &distance);
 
   // normal func
-  OB_INLINE static int l1_distance_normal(const float *a, const float *b, const int64_t len, double &distance);
-  // TODO(@jingshui) add simd func
+  static int l1_distance_normal(const float *a, const float *b, const int64_t len, double &distance);
+  // simd funcs, the caller should check the cpu arch. they return false if the arch is not
+  // compiled in or the result is not finite, then the normal func should be used instead.
+  static bool l1_distance_avx2(const float *a, const float *b, const int64_t len, double &distance);
+  static bool l1_distance_avx512(const float *a, const float *b, const int64_t len, double &distance);
 };
 } // common
 } // oceanbase
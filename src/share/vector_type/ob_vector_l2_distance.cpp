@@ -11,13 +11,90 @@
  */
 
 #include "ob_vector_l2_distance.h"
+#include "ob_vector_simd_util.h"
 namespace oceanbase
 {
 namespace common
 {
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline bool l2_square(const float *a, const float *b, const int64_t len, double &square)
+{
+  __m256d sum_lo = _mm256_setzero_pd();
+  __m256d sum_hi = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    __m256d diff_lo = cvt_lo_pd(diff);
+    __m256d diff_hi = cvt_hi_pd(diff);
+    sum_lo = _mm256_add_pd(sum_lo, _mm256_mul_pd(diff_lo, diff_lo));
+    sum_hi = _mm256_add_pd(sum_hi, _mm256_mul_pd(diff_hi, diff_hi));
+  }
+  double sum = hsum_pd(_mm256_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    double diff = a[i] - b[i];
+    sum += (diff * diff);
+  }
+  square = sum;
+  return is_finite_result(sum);
+}
+)
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline bool l2_square(const float *a, const float *b, const int64_t len, double &square)
+{
+  __m512d sum_lo = _mm512_setzero_pd();
+  __m512d sum_hi = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 diff = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    __m512d diff_lo = cvt_lo_pd(diff);
+    __m512d diff_hi = cvt_hi_pd(diff);
+    sum_lo = _mm512_add_pd(sum_lo, _mm512_mul_pd(diff_lo, diff_lo));
+    sum_hi = _mm512_add_pd(sum_hi, _mm512_mul_pd(diff_hi, diff_hi));
+  }
+  double sum = hsum_pd(_mm512_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    double diff = a[i] - b[i];
+    sum += (diff * diff);
+  }
+  square = sum;
+  return is_finite_result(sum);
+}
+)
+
+bool ObVectorL2Distance::l2_square_avx2(const float *a, const float *b, const int64_t len, double &square)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx2::l2_square(a, b, len, square);
+#else
+  return false;
+#endif
+}
+
+bool ObVectorL2Distance::l2_square_avx512(const float *a, const float *b, const int64_t len, double &square)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx512::l2_square(a, b, len, square);
+#else
+  return false;
+#endif
+}
+
 int ObVectorL2Distance::l2_square_func(const float *a, const float *b, const int64_t len, double &square)
 {
-  return l2_square_normal(a, b, len, square);
+  int ret = OB_SUCCESS;
+  bool is_done = false;
+#if OB_USE_MULTITARGET_CODE
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    is_done = l2_square_avx512(a, b, len, square);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    is_done = l2_square_avx2(a, b, len, square);
+  }
+#endif
+  if (!is_done) {
+    ret = l2_square_normal(a, b, len, square);
+  }
+  return ret;
 }
 
 int ObVectorL2Distance::l2_distance_func(const float *a, const float *b, const int64_t len, double &distance)
@@ -33,7 +110,7 @@ int ObVectorL2Distance::l2_distance_func(const float *a, const float *b, const i
   return ret;
 }
 
-OB_INLINE int ObVectorL2Distance::l2_square_normal(const float *a, const float *b, const int64_t len, double &square)
+int ObVectorL2Distance::l2_square_normal(const float *a, const float *b, const int64_t len, double &square)
 {
   int ret = OB_SUCCESS;
   double sum = 0;
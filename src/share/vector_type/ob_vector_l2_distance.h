@@ -28,8 +28,11 @@ struct ObVectorL2Distance
   static int l2_distance_func(const float *a, const float *b, const int64_t len, double &distance);
 
   // normal func
-  OB_INLINE static int l2_square_normal(const float *a, const float *b, const int64_t len, double &square);
-  // TODO(@jingshui) add simd func
+  static int l2_square_normal(const float *a, const float *b, const int64_t len, double &square);
+  // simd funcs, the caller should check the cpu arch. they return false if the arch is not
+  // compiled in or the result is not finite, then the normal func should be used instead.
+  static bool l2_square_avx2(const float *a, const float *b, const int64_t len, double &square);
+  static bool l2_square_avx512(const float *a, const float *b, const int64_t len, double &square);
 };
 
 } // common
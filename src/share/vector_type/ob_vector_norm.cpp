@@ -11,13 +11,86 @@
  */
 
 #include "ob_vector_norm.h"
+#include "ob_vector_simd_util.h"
 namespace oceanbase
 {
 namespace common
 {
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline bool vector_norm_square(const float *a, const int64_t len, double &norm_square)
+{
+  __m256d sum_lo = _mm256_setzero_pd();
+  __m256d sum_hi = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 va = _mm256_loadu_ps(a + i);
+    __m256 mul = _mm256_mul_ps(va, va);
+    sum_lo = _mm256_add_pd(sum_lo, cvt_lo_pd(mul));
+    sum_hi = _mm256_add_pd(sum_hi, cvt_hi_pd(mul));
+  }
+  double sum = hsum_pd(_mm256_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    sum += (a[i] * a[i]);
+  }
+  norm_square = sum;
+  return is_finite_result(sum);
+}
+)
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline bool vector_norm_square(const float *a, const int64_t len, double &norm_square)
+{
+  __m512d sum_lo = _mm512_setzero_pd();
+  __m512d sum_hi = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 va = _mm512_loadu_ps(a + i);
+    __m512 mul = _mm512_mul_ps(va, va);
+    sum_lo = _mm512_add_pd(sum_lo, cvt_lo_pd(mul));
+    sum_hi = _mm512_add_pd(sum_hi, cvt_hi_pd(mul));
+  }
+  double sum = hsum_pd(_mm512_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    sum += (a[i] * a[i]);
+  }
+  norm_square = sum;
+  return is_finite_result(sum);
+}
+)
+
+bool ObVectorNorm::vector_norm_square_avx2(const float *a, const int64_t len, double &norm_square)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx2::vector_norm_square(a, len, norm_square);
+#else
+  return false;
+#endif
+}
+
+bool ObVectorNorm::vector_norm_square_avx512(const float *a, const int64_t len, double &norm_square)
+{
+#if OB_USE_MULTITARGET_CODE
+  return specific::avx512::vector_norm_square(a, len, norm_square);
+#else
+  return false;
+#endif
+}
+
 int ObVectorNorm::vector_norm_square_func(const float *a, const int64_t len, double &norm_square)
 {
-  return vector_norm_square_normal(a, len, norm_square);
+  int ret = OB_SUCCESS;
+  bool is_done = false;
+#if OB_USE_MULTITARGET_CODE
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    is_done = vector_norm_square_avx512(a, len, norm_square);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    is_done = vector_norm_square_avx2(a, len, norm_square);
+  }
+#endif
+  if (!is_done) {
+    ret = vector_norm_square_normal(a, len, norm_square);
+  }
+  return ret;
 }
 
 int ObVectorNorm::vector_norm_func(const float *a, const int64_t len, double &norm)
@@ -33,7 +106,7 @@ int ObVectorNorm::vector_norm_func(const float *a, const int64_t len, double &no
   return ret;
 }
 
-OB_INLINE int ObVectorNorm::vector_norm_square_normal(const float *a, const int64_t len, double &norm_square)
+int ObVectorNorm::vector_norm_square_normal(const float *a, const int64_t len, double &norm_square)
 {
   int ret = OB_SUCCESS;
   double sum = 0;
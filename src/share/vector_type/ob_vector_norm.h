@@ -28,8 +28,11 @@ struct ObVectorNorm
   static int vector_norm_func(const float *a, const int64_t len, double &norm);
 
   // normal func
-  OB_INLINE static int vector_norm_square_normal(const float *a, const int64_t len, double &norm_square);
-  // TODO(@jingshui) add simd func
+  static int vector_norm_square_normal(const float *a, const int64_t len, double &norm_square);
+  // simd funcs, the caller should check the cpu arch. they return false if the arch is not
+  // compiled in or the result is not finite, then the normal func should be used instead.
+  static bool vector_norm_square_avx2(const float *a, const int64_t len, double &norm_square);
+  static bool vector_norm_square_avx512(const float *a, const int64_t len, double &norm_square);
 };
 } // common
 } // oceanbase
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2024 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LIB_OB_VECTOR_SIMD_UTIL_H_
+#define OCEANBASE_LIB_OB_VECTOR_SIMD_UTIL_H_
+
+#include <math.h>
+#include "common/ob_target_specific.h"
+#include "lib/ob_define.h"
+
+#if OB_USE_MULTITARGET_CODE
+#include <immintrin.h>
+#endif
+
+namespace oceanbase
+{
+namespace common
+{
+// Helpers shared by the simd distance funcs. The simd funcs keep the accumulation in double
+// like the normal funcs do, so the float lanes are widened to double before being summed.
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline __m256d cvt_lo_pd(const __m256 v)
+{
+  return _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+}
+
+inline __m256d cvt_hi_pd(const __m256 v)
+{
+  return _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+}
+
+inline double hsum_pd(const __m256d v)
+{
+  __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+  return _mm_cvtsd_f64(sum);
+}
+
+inline __m256 abs_ps(const __m256 v)
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+}
+)
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline __m512d cvt_lo_pd(const __m512 v)
+{
+  return _mm512_cvtps_pd(_mm512_castps512_ps256(v));
+}
+
+inline __m512d cvt_hi_pd(const __m512 v)
+{
+  return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)));
+}
+
+inline double hsum_pd(const __m512d v)
+{
+  return _mm512_reduce_add_pd(v);
+}
+
+inline __m512 abs_ps(const __m512 v)
+{
+  return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(v), _mm512_set1_epi32(0x7fffffff)));
+}
+)
+
+// the simd funcs return false when the result is not finite, the caller should then fall back
+// to the normal func which reports the overflow.
+OB_INLINE bool is_finite_result(const double v)
+{
+  return 0 == ::isinf(v) && 0 == ::isnan(v);
+}
+
+} // common
+} // oceanbase
+#endif
@@ -1346,6 +1346,15 @@ int ObTscCgService::generate_vec_ir_ctdef(const ObLogTableScan &op,
         vec_scan_ctdef->children_[3] = snapshot_ctdef;
         vec_scan_ctdef->children_[4] = com_aux_ctdef;
         vec_scan_ctdef->dim_ = dim;
+        vec_scan_ctdef->vec_query_strategy_ = op.get_vector_index_info().query_strategy_;
+        vec_scan_ctdef->selectivity_ = op.get_vector_index_info().selectivity_;
+      }
+    }
+
+    if (OB_SUCC(ret) && OB_NOT_NULL(op.get_vector_index_info().distance_threshold_expr_)) {
+      if (OB_FAIL(cg_.generate_rt_expr(*op.get_vector_index_info().distance_threshold_expr_,
+                                       vec_scan_ctdef->distance_threshold_))) {
+        LOG_WARN("failed to generate distance threshold expr", K(ret));
       }
     }
 
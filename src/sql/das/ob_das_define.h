@@ -434,6 +434,15 @@ enum ObTSCIRScanType : uint16_t
   OB_VEC_COM_AUX_SCAN
 };
 
+// how the scalar filters of a hybrid vector query are applied
+enum ObVecIdxQueryStrategy : uint8_t
+{
+  OB_VEC_POST_FILTER = 0, // search the index with an enlarged top-k, filter the lookup rows
+  OB_VEC_IN_FILTER,       // collect the vids passing the filters, search the index within them
+  OB_VEC_BRUTE_FORCE,     // do not use the index, scan the filtered rows and sort by distance
+  OB_VEC_STRATEGY_MAX
+};
+
 }  // namespace sql
 }  // namespace oceanbase
 #endif /* OBDEV_SRC_SQL_DAS_OB_DAS_DEFINE_H_ */
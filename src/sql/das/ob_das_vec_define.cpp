@@ -19,7 +19,8 @@ namespace sql
 {
 
 OB_SERIALIZE_MEMBER((ObDASVecAuxScanCtDef, ObDASAttachCtDef),
-                    inv_scan_vec_id_col_, vec_index_param_, dim_);
+                    inv_scan_vec_id_col_, vec_index_param_, dim_,
+                    vec_query_strategy_, selectivity_, distance_threshold_);
 OB_SERIALIZE_MEMBER(ObDASVecAuxScanRtDef);
 
 } // sql
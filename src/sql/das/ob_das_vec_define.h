@@ -36,7 +36,10 @@ public:
     : ObDASAttachCtDef(alloc, DAS_OP_VEC_SCAN),
       inv_scan_vec_id_col_(nullptr),
       vec_index_param_(),
-      dim_(0)
+      dim_(0),
+      vec_query_strategy_(OB_VEC_POST_FILTER),
+      selectivity_(1.0),
+      distance_threshold_(nullptr)
   {
   }
   const ObDASScanCtDef *get_inv_idx_scan_ctdef() const
@@ -105,11 +108,15 @@ public:
   int64_t get_com_aux_tbl_idx() const { return ObVecAuxTableIdx::COM_AUX_TBL_IDX; }
 
   INHERIT_TO_STRING_KV("ObDASBaseCtDef", ObDASBaseCtDef,
-                       KPC_(inv_scan_vec_id_col), K_(vec_index_param), K_(dim));
+                       KPC_(inv_scan_vec_id_col), K_(vec_index_param), K_(dim),
+                       K_(vec_query_strategy), K_(selectivity), KPC_(distance_threshold));
 
   ObExpr *inv_scan_vec_id_col_;
   ObString vec_index_param_;
   int64_t dim_;
+  ObVecIdxQueryStrategy vec_query_strategy_;
+  double selectivity_; // selectivity of the filters on the main table
+  ObExpr *distance_threshold_; // upper bound of the vector distance given by a filter, null means none
 };
 
 struct ObDASVecAuxScanRtDef : ObDASAttachRtDef
@@ -21,6 +21,7 @@
 #include "src/share/vector_index/ob_vector_index_util.h"
 #include "src/storage/access/ob_table_scan_iterator.h"
 #include "src/share/schema/ob_tenant_schema_service.h"
+#include "lib/container/ob_heap.h"
 
 namespace oceanbase
 {
@@ -95,6 +96,9 @@ int ObVectorIndexLookupOp::init(const ObDASBaseCtDef *table_lookup_ctdef,
       com_aux_vec_ctdef_ = vir_scan_ctdef->get_com_aux_tbl_ctdef();
       com_aux_vec_rtdef_ = vir_scan_rtdef->get_com_aux_tbl_rtdef();
       set_dim(vir_scan_ctdef->dim_);
+      query_strategy_ = vir_scan_ctdef->vec_query_strategy_;
+      selectivity_ = vir_scan_ctdef->selectivity_;
+      distance_threshold_ = vir_scan_ctdef->distance_threshold_;
       doc_id_lookup_rtdef_->scan_flag_.scan_order_ = ObQueryFlag::KeepOrder;
       lookup_rtdef_->scan_flag_.scan_order_ = ObQueryFlag::KeepOrder;
       if (DAS_OP_SORT == aux_lookup_ctdef->get_doc_id_scan_ctdef()->op_type_) {
@@ -181,8 +185,10 @@ int ObVectorIndexLookupOp::init_sort(const ObDASVecAuxScanCtDef *ir_ctdef,
           LOG_WARN("unexpected arg num", K(ret), K(expr->arg_cnt_));
         } else if (expr->args_[0]->is_const_expr()) {
           search_vec_ = expr->args_[0];
+          distance_expr_ = expr;
         } else if (expr->args_[1]->is_const_expr()) {
           search_vec_ = expr->args_[1];
+          distance_expr_ = expr;
         }
       }
     }
@@ -378,7 +384,11 @@ int ObVectorIndexLookupOp::fetch_index_table_rowkey()
   } else if (OB_ISNULL(adaptor_vid_iter_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("failed to get adaptor_vid_iter", K(ret));
-  } else if (OB_FAIL(adaptor_vid_iter_->get_next_row(row))) {
+  } else if (OB_FAIL(adaptor_vid_iter_->get_next_row(row))
+             && (OB_ITER_END != ret
+                 || OB_FAIL(refill_adaptor_vid_iter())
+                 || OB_FAIL(adaptor_vid_iter_->get_next_row(row)))) {
+    // the vids are refilled once all fetched ones are consumed
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       LOG_WARN("failed to get next next row from text retrieval iter", K(ret));
     }
@@ -410,7 +420,11 @@ int ObVectorIndexLookupOp::fetch_index_table_rowkeys(int64_t &count, const int64
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("failed to get adaptor_vid_iter", K(ret));
   } else if (OB_FALSE_IT(adaptor_vid_iter_->set_batch_size(capacity))) {
-  } else if (OB_FAIL(adaptor_vid_iter_->get_next_rows(row, index_scan_row_cnt))) {
+  } else if (OB_FAIL(adaptor_vid_iter_->get_next_rows(row, index_scan_row_cnt))
+             && (OB_ITER_END != ret
+                 || OB_FAIL(refill_adaptor_vid_iter())
+                 || OB_FAIL(adaptor_vid_iter_->get_next_rows(row, index_scan_row_cnt)))) {
+    // the vids are refilled once all fetched ones are consumed
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       LOG_WARN("failed to get next next row from text retrieval iter", K(ret));
     } else {
@@ -455,6 +469,7 @@ int ObVectorIndexLookupOp::reuse_scan_iter(bool need_switch_param)
     adaptor_vid_iter_->~ObVectorQueryVidIterator();
     adaptor_vid_iter_ = nullptr;
   }
+  destroy_search_iter();
   if (OB_NOT_NULL(delta_buf_rtdef_)) {
     const ObTabletID &scan_tablet_id = delta_buf_scan_param_.tablet_id_;
     delta_buf_scan_param_.need_switch_param_ = scan_tablet_id.is_valid() && scan_tablet_id != delta_buf_tablet_id_;
@@ -814,7 +829,14 @@ int ObVectorIndexLookupOp::call_pva_interface(const ObVidAdaLookupStatus& cur_st
   int ret = OB_SUCCESS;
   switch(cur_state) {
     case ObVidAdaLookupStatus::STATES_INIT: {
-      if (OB_FAIL(adaptor.check_delta_buffer_table_readnext_status(&ada_ctx, delta_buf_iter_, delta_buf_scan_param_.snapshot_.core_.version_))) {
+      const transaction::ObTxReadSnapshot &snapshot = delta_buf_scan_param_.snapshot_;
+      // the cached delta bitmaps hold committed rows seen by a leader read, so reads inside a
+      // transaction, which see their own uncommitted rows, and weak reads bypass the cache
+      const bool use_delta_cache = !snapshot.is_weak_read() && !snapshot.core_.tx_id_.is_valid();
+      if (OB_FAIL(adaptor.check_delta_buffer_table_readnext_status(&ada_ctx,
+                                                                   delta_buf_iter_,
+                                                                   snapshot.core_.version_,
+                                                                   use_delta_cache))) {
         LOG_WARN("fail to check_delta_buffer_table_readnext_status.", K(ret));
       }
       break;
@@ -842,11 +864,17 @@ int ObVectorIndexLookupOp::call_pva_interface(const ObVidAdaLookupStatus& cur_st
     }
     case ObVidAdaLookupStatus::STATES_END: {
       ObVectorQueryConditions query_cond;
-      if (OB_FAIL(set_vector_query_condition(query_cond))) {
+      query_cond.valid_vids_ = nullptr;
+      bool is_searched = false;
+      if (adaptor.is_snap_loading() && OB_FAIL(brute_force_search(is_searched))) {
+        LOG_WARN("fail to brute force search while snapshot is loading.", K(ret));
+      } else if (is_searched) {
+      } else if (OB_FAIL(set_vector_query_condition(query_cond))) {
         LOG_WARN("fail to set query condition.", K(ret));
       } else if (OB_FAIL(adaptor.query_result(&ada_ctx, &query_cond, adaptor_vid_iter_))) {
         LOG_WARN("fail to query result.", K(ret));
       }
+      free_valid_vid_bitmap(query_cond.valid_vids_);
       break;
     }
     default: {
@@ -1179,6 +1207,7 @@ int ObVectorIndexLookupOp::revert_iter()
     adaptor_vid_iter_->~ObVectorQueryVidIterator();
     adaptor_vid_iter_ = nullptr;
   }
+  destroy_search_iter();
 
   if (OB_NOT_NULL(delta_buf_rtdef_)) {
     delta_buf_scan_param_.need_switch_param_ = false;
@@ -1248,6 +1277,265 @@ int ObVectorIndexLookupOp::revert_iter()
   return ret;
 }
 
+// full scan of the main table, the rows are projected to the access exprs of lookup and the
+// pushdown filters of lookup are applied by storage
+int ObVectorIndexLookupOp::open_main_table_scan(ObTableScanParam &scan_param, ObNewRowIterator *&iter)
+{
+  int ret = OB_SUCCESS;
+  ObNewRange scan_range;
+  iter = nullptr;
+  if (OB_FAIL(init_base_idx_scan_param(ls_id_, tablet_id_, lookup_ctdef_, lookup_rtdef_,
+                                       tx_desc_, snapshot_, scan_param))) {
+    LOG_WARN("failed to init main table scan param", K(ret));
+  } else if (OB_FALSE_IT(scan_param.output_exprs_ = &(lookup_ctdef_->pd_expr_spec_.access_exprs_))) {
+  } else if (OB_FALSE_IT(scan_param.op_ = lookup_rtdef_->p_pd_expr_op_)) {
+  } else if (OB_FALSE_IT(scan_param.row2exprs_projector_ = lookup_rtdef_->p_row2exprs_projector_)) {
+  } else if (OB_FAIL(gen_scan_range(0, lookup_ctdef_->ref_table_id_, scan_range))) {
+    LOG_WARN("failed to generate main table scan range", K(ret));
+  } else if (OB_FAIL(scan_param.key_ranges_.push_back(scan_range))) {
+    LOG_WARN("failed to append scan range", K(ret));
+  } else if (OB_FAIL(get_tsc_service().table_scan(scan_param, iter))) {
+    if (OB_SNAPSHOT_DISCARDED == ret && scan_param.fb_snapshot_.is_valid()) {
+      ret = OB_INVALID_QUERY_TIMESTAMP;
+    } else if (OB_TRY_LOCK_ROW_CONFLICT != ret) {
+      LOG_WARN("fail to scan main table", K(scan_param), K(ret));
+    }
+  }
+  return ret;
+}
+
+// compute the result by scanning the main table, used when the snapshot index is being loaded by
+// another thread. is_searched is false when the distance can not be computed from the main table
+// rows, the query then waits for the snapshot index.
+int ObVectorIndexLookupOp::brute_force_search(bool &is_searched)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObTableScanParam scan_param;
+  ObNewRowIterator *scan_iter = nullptr;
+  ObVecDistanceCmp cmp;
+  ObBinaryHeap<ObVecDistanceVid, ObVecDistanceCmp> heap(cmp, &vec_op_alloc_);
+  const int64_t topk = limit_param_.limit_ + limit_param_.offset_;
+  bool has_vid_col = false;
+  bool has_vec_col = false;
+  is_searched = false;
+  if (OB_ISNULL(lookup_ctdef_) || OB_ISNULL(lookup_rtdef_) || OB_ISNULL(doc_id_expr_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected null", K(ret), KP(lookup_ctdef_), KP(lookup_rtdef_), KP(doc_id_expr_));
+  } else if (OB_NOT_NULL(distance_expr_)) {
+    const ExprFixedArray &access_exprs = lookup_ctdef_->pd_expr_spec_.access_exprs_;
+    for (int64_t i = 0; i < access_exprs.count(); ++i) {
+      has_vid_col = has_vid_col || access_exprs.at(i) == doc_id_expr_;
+      has_vec_col = has_vec_col || access_exprs.at(i) == distance_expr_->args_[0]
+                                || access_exprs.at(i) == distance_expr_->args_[1];
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (!has_vid_col || !has_vec_col || topk <= 0) {
+    LOG_TRACE("can not brute force search on main table", K(has_vid_col), K(has_vec_col), K(topk));
+  } else if (OB_FAIL(open_main_table_scan(scan_param, scan_iter))) {
+    LOG_WARN("failed to open main table scan", K(ret));
+  } else {
+    ObEvalCtx &eval_ctx = *lookup_rtdef_->eval_ctx_;
+    while (OB_SUCC(ret)) {
+      ObDatum *dist_datum = nullptr;
+      lookup_rtdef_->p_pd_expr_op_->clear_evaluated_flag();
+      if (OB_FAIL(scan_iter->get_next_row())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("failed to get next row from main table", K(ret));
+        }
+      } else if (OB_FAIL(distance_expr_->eval(eval_ctx, dist_datum))) {
+        LOG_WARN("failed to eval distance", K(ret));
+      } else if (dist_datum->is_null()) {
+      } else {
+        ObVecDistanceVid item;
+        item.distance_ = dist_datum->get_double();
+        item.vid_ = doc_id_expr_->locate_expr_datum(eval_ctx).get_int();
+        if (heap.count() < topk) {
+          if (OB_FAIL(heap.push(item))) {
+            LOG_WARN("failed to push heap", K(ret));
+          }
+        } else if (item.distance_ < heap.top().distance_ && OB_FAIL(heap.replace_top(item))) {
+          LOG_WARN("failed to replace heap top", K(ret));
+        }
+      }
+    }
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+  }
+  if (OB_NOT_NULL(scan_iter) && OB_SUCCESS != (tmp_ret = get_tsc_service().revert_scan_iter(scan_iter))) {
+    LOG_WARN("failed to revert main table scan iter", K(tmp_ret));
+    ret = OB_SUCC(ret) ? tmp_ret : ret;
+  }
+  scan_param.destroy_schema_guard();
+  if (OB_SUCC(ret) && has_vid_col && has_vec_col && topk > 0) {
+    const int64_t total = heap.count();
+    int64_t *vids = nullptr;
+    void *iter_buf = nullptr;
+    if (total > 0 && OB_ISNULL(vids = static_cast<int64_t *>(vec_op_alloc_.alloc(sizeof(int64_t) * total)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc vids", K(ret), K(total));
+    } else if (OB_ISNULL(iter_buf = vec_op_alloc_.alloc(sizeof(ObVectorQueryVidIterator)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc vid iter", K(ret));
+    }
+    // the heap pops the farthest first
+    for (int64_t i = total - 1; OB_SUCC(ret) && i >= 0; --i) {
+      vids[i] = heap.top().vid_;
+      if (OB_FAIL(heap.pop())) {
+        LOG_WARN("failed to pop heap", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FALSE_IT(adaptor_vid_iter_ = new(iter_buf) ObVectorQueryVidIterator())) {
+    } else if (OB_FAIL(adaptor_vid_iter_->init(total, vids, &vec_op_alloc_))) {
+      LOG_WARN("failed to init vid iter", K(ret));
+    } else {
+      is_searched = true;
+      LOG_TRACE("brute force search while snapshot index is loading", K(total), K(topk));
+    }
+  }
+  return ret;
+}
+
+// scan the main table with the pushdown filters and collect the vids of the rows passing them,
+// the index search is then restricted to these vids. bitmap stays null when the filters can not
+// be applied by storage or more than MAX_VALID_VID_CNT rows pass them, the query falls back to
+// post filter then.
+int ObVectorIndexLookupOp::build_valid_vid_bitmap(roaring::api::roaring64_bitmap_t *&bitmap)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObITabletScan &tsc_service = get_tsc_service();
+  ObTableScanParam filter_scan_param;
+  ObNewRowIterator *filter_iter = nullptr;
+  bool has_vid_col = false;
+  bitmap = nullptr;
+  if (OB_ISNULL(lookup_ctdef_) || OB_ISNULL(lookup_rtdef_) || OB_ISNULL(doc_id_expr_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected null", K(ret), KP(lookup_ctdef_), KP(lookup_rtdef_), KP(doc_id_expr_));
+  } else {
+    const ExprFixedArray &access_exprs = lookup_ctdef_->pd_expr_spec_.access_exprs_;
+    for (int64_t i = 0; !has_vid_col && i < access_exprs.count(); ++i) {
+      has_vid_col = access_exprs.at(i) == doc_id_expr_;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (!has_vid_col || lookup_ctdef_->pd_expr_spec_.pushdown_filters_.empty()) {
+    LOG_TRACE("filters are not pushed down to main table, use post filter", K(has_vid_col));
+  } else if (OB_FAIL(open_main_table_scan(filter_scan_param, filter_iter))) {
+    LOG_WARN("failed to open main table filter scan", K(ret));
+  } else {
+    lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(MTL_ID(), "VIBitmapADP"));
+    ROARING_TRY_CATCH(bitmap = roaring::api::roaring64_bitmap_create());
+    if (OB_SUCC(ret) && OB_ISNULL(bitmap)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to create valid vid bitmap", K(ret));
+    }
+    uint64_t valid_cnt = 0;
+    bool is_too_many = false;
+    while (OB_SUCC(ret) && !is_too_many) {
+      lookup_rtdef_->p_pd_expr_op_->clear_evaluated_flag();
+      if (OB_FAIL(filter_iter->get_next_row())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("failed to get next row from main table", K(ret));
+        }
+      } else if (++valid_cnt > MAX_VALID_VID_CNT) {
+        is_too_many = true;
+      } else if (0 == valid_cnt % 10000 && OB_FAIL(THIS_WORKER.check_status())) {
+        LOG_WARN("failed to check status", K(ret));
+      } else {
+        ObDatum &vid_datum = doc_id_expr_->locate_expr_datum(*lookup_rtdef_->eval_ctx_);
+        ROARING_TRY_CATCH(roaring::api::roaring64_bitmap_add(bitmap, vid_datum.get_int()));
+      }
+    }
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+    if (OB_SUCC(ret) && is_too_many) {
+      LOG_TRACE("too many rows pass the filters, use post filter", K(valid_cnt), K_(selectivity));
+      free_valid_vid_bitmap(bitmap);
+    }
+  }
+  if (OB_NOT_NULL(filter_iter) && OB_SUCCESS != (tmp_ret = tsc_service.revert_scan_iter(filter_iter))) {
+    LOG_WARN("failed to revert main table filter scan iter", K(tmp_ret));
+    ret = OB_SUCC(ret) ? tmp_ret : ret;
+  }
+  filter_scan_param.destroy_schema_guard();
+  if (OB_FAIL(ret)) {
+    free_valid_vid_bitmap(bitmap);
+  } else if (OB_NOT_NULL(bitmap)) {
+    LOG_TRACE("succeed to build valid vid bitmap", K(roaring::api::roaring64_bitmap_get_cardinality(bitmap)));
+  }
+  return ret;
+}
+
+// the rows of each lookup batch are counted, so that the vids are refilled only when the filters
+// after lookup have removed some of them
+int ObVectorIndexLookupOp::check_lookup_row_cnt()
+{
+  int ret = OB_SUCCESS;
+  if (OB_NOT_NULL(search_iter_) && search_iter_->is_inited()) {
+    search_output_row_cnt_ += lookup_row_cnt_;
+  }
+  if (OB_FAIL(ObDomainIndexLookupOp::check_lookup_row_cnt())) {
+    LOG_WARN("failed to check lookup row cnt", K(ret));
+  }
+  return ret;
+}
+
+// fetches the next nearest vids of the opened searches once the fetched ones are consumed and the
+// filters after lookup left fewer than limit rows, the batch doubles the vids fetched so far until
+// MAX_VSAG_QUERY_RES_SIZE vids are fetched. returns OB_ITER_END when no vid is left.
+int ObVectorIndexLookupOp::refill_adaptor_vid_iter()
+{
+  int ret = OB_SUCCESS;
+  int64_t fetched_cnt = 0;
+  const int64_t limit_cnt = limit_param_.limit_ + limit_param_.offset_;
+  if (OB_ISNULL(search_iter_) || !search_iter_->is_inited() || OB_ISNULL(adaptor_vid_iter_)) {
+    ret = OB_ITER_END;
+  } else if (search_iter_->is_end()) {
+    // the searches returned all vids of the indexes
+    ret = OB_ITER_END;
+  } else if ((fetched_cnt = search_iter_->get_fetched_cnt()) >= MAX_VSAG_QUERY_RES_SIZE) {
+    ret = OB_ITER_END;
+  } else if (search_output_row_cnt_ >= fetched_cnt || search_output_row_cnt_ >= limit_cnt) {
+    // no vid is filtered out after lookup, or enough rows are left
+    ret = OB_ITER_END;
+  } else {
+    int64_t batch_size = MAX(fetched_cnt, limit_cnt);
+    batch_size = MIN(MAX(batch_size, 1), static_cast<int64_t>(MAX_VSAG_QUERY_RES_SIZE) - fetched_cnt);
+    if (OB_FAIL(search_iter_->get_next_result(batch_size, &vec_op_alloc_, *adaptor_vid_iter_))) {
+      LOG_WARN("failed to get next result of search iter", K(ret), K(batch_size), KPC(search_iter_));
+    } else if (search_iter_->get_fetched_cnt() == fetched_cnt) {
+      ret = OB_ITER_END;
+    } else {
+      LOG_TRACE("refill vids filtered out after lookup", K(fetched_cnt), K(batch_size),
+                K(search_output_row_cnt_), KPC(search_iter_));
+    }
+  }
+  return ret;
+}
+
+void ObVectorIndexLookupOp::destroy_search_iter()
+{
+  if (OB_NOT_NULL(search_iter_)) {
+    search_iter_->~ObVsagSearchIter();
+    search_iter_ = nullptr;
+  }
+  search_output_row_cnt_ = 0;
+}
+
+void ObVectorIndexLookupOp::free_valid_vid_bitmap(roaring::api::roaring64_bitmap_t *&bitmap)
+{
+  if (OB_NOT_NULL(bitmap)) {
+    lib::ObMallocHookAttrGuard malloc_guard(lib::ObMemAttr(MTL_ID(), "VIBitmapADP"));
+    roaring::api::roaring64_bitmap_free(bitmap);
+    bitmap = nullptr;
+  }
+}
+
 int ObVectorIndexLookupOp::set_vector_query_condition(ObVectorQueryConditions &query_cond)
 {
   int ret = OB_SUCCESS;
@@ -1259,16 +1547,55 @@ int ObVectorIndexLookupOp::set_vector_query_condition(ObVectorQueryConditions &q
     query_cond.query_order_ = true;
     query_cond.row_iter_ = snapshot_iter_;
     query_cond.query_scn_ = snapshot_scan_param_.snapshot_.core_.version_;
+    query_cond.valid_vids_ = nullptr;
+    query_cond.search_iter_ = nullptr;
+    query_cond.is_range_search_ = false;
+    query_cond.distance_threshold_ = 0;
     ObSQLSessionInfo *session = nullptr;
     uint64_t ob_hnsw_ef_search = 0;
+    uint64_t ob_hnsw_target_recall = 0;
     ObDatum *vec_datum = NULL;
-    if (OB_FALSE_IT(session = sort_rtdef_->eval_ctx_->exec_ctx_.get_my_session())) {
+    ObDatum *threshold_datum = NULL;
+    if (OB_NOT_NULL(distance_threshold_)
+        && OB_FAIL(distance_threshold_->eval(*(sort_rtdef_->eval_ctx_), threshold_datum))) {
+      LOG_WARN("failed to eval distance threshold", K(ret));
+    } else if (OB_NOT_NULL(threshold_datum) && !threshold_datum->is_null()) {
+      // the vids beyond the threshold are filtered out after lookup anyway, so they are not searched
+      query_cond.is_range_search_ = true;
+      query_cond.distance_threshold_ = threshold_datum->get_double();
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FALSE_IT(session = sort_rtdef_->eval_ctx_->exec_ctx_.get_my_session())) {
     } else if (OB_ISNULL(session)) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("fail to get table schema", K(ret), KPC(session));
     } else if (OB_FAIL(session->get_ob_hnsw_ef_search(ob_hnsw_ef_search))) {
       LOG_WARN("fail to get ob_hnsw_ef_search", K(ret));
     } else if (OB_FALSE_IT(query_cond.ef_search_ = ob_hnsw_ef_search)) {
+    } else if (OB_FAIL(session->get_ob_hnsw_target_recall(ob_hnsw_target_recall))) {
+      LOG_WARN("fail to get ob_hnsw_target_recall", K(ret));
+    } else if (OB_FALSE_IT(query_cond.target_recall_ = ob_hnsw_target_recall / 100.0)) {
+    } else if (OB_VEC_IN_FILTER == query_strategy_
+               && OB_FAIL(build_valid_vid_bitmap(query_cond.valid_vids_))) {
+      LOG_WARN("failed to build valid vid bitmap", K(ret));
+    } else if (OB_ISNULL(query_cond.valid_vids_) && selectivity_ < 1.0 && selectivity_ > 0) {
+      // the filters are applied after lookup, fetch more results so that about limit rows are left,
+      // and search deeper so that the enlarged results keep the recall. the searches are kept open
+      // to refill the results when fewer rows are left.
+      uint64_t fetch_cnt = static_cast<uint64_t>(ceil(query_cond.query_limit_ / selectivity_));
+      fetch_cnt = MIN(MAX(fetch_cnt, static_cast<uint64_t>(query_cond.query_limit_)), MAX_VSAG_QUERY_RES_SIZE);
+      query_cond.query_limit_ = static_cast<uint32_t>(fetch_cnt);
+      query_cond.ef_search_ = MIN(MAX(query_cond.ef_search_, static_cast<int64_t>(fetch_cnt)), MAX_VSAG_EF_SEARCH);
+      if (query_cond.is_range_search_) {
+        // the range search returns all vids within the threshold up to the enlarged limit
+      } else if (OB_ISNULL(search_iter_) && OB_ISNULL(search_iter_ = OB_NEWx(ObVsagSearchIter, &vec_op_alloc_))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc search iter", K(ret));
+      } else {
+        query_cond.search_iter_ = search_iter_;
+      }
+    }
+    if (OB_FAIL(ret)) {
     } else if (OB_UNLIKELY(OB_FAIL(search_vec_->eval(*(sort_rtdef_->eval_ctx_), vec_datum)))) {
       LOG_WARN("eval vec arg failed", K(ret));
     } else if (OB_FALSE_IT(query_cond.query_vector_ = vec_datum->get_string())) {
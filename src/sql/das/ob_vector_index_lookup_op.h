@@ -36,7 +36,11 @@ public:
     vec_op_alloc_("VecIdxLookupOp", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()),
     aux_lookup_iter_(nullptr),
     adaptor_vid_iter_(nullptr),
+    search_iter_(nullptr),
+    search_output_row_cnt_(0),
     search_vec_(nullptr),
+    distance_expr_(nullptr),
+    distance_threshold_(nullptr),
     delta_buf_tablet_id_(ObTabletID::INVALID_TABLET_ID),
     index_id_tablet_id_(ObTabletID::INVALID_TABLET_ID),
     snapshot_tablet_id_(ObTabletID::INVALID_TABLET_ID),
@@ -62,7 +66,9 @@ public:
     sort_rtdef_(nullptr),
     is_inited_(false),
     vec_index_param_(),
-    dim_(0) {}
+    dim_(0),
+    query_strategy_(OB_VEC_POST_FILTER),
+    selectivity_(1.0) {}
   virtual ~ObVectorIndexLookupOp() {};
   int init(const ObDASBaseCtDef *table_lookup_ctdef,
             ObDASBaseRtDef *table_lookup_rtdef,
@@ -108,6 +114,7 @@ protected:
   virtual int fetch_index_table_rowkeys(int64_t &count, const int64_t capacity) override;
   virtual int get_aux_table_rowkey() override;
   virtual int get_aux_table_rowkeys(const int64_t lookup_row_cnt) override;
+  virtual int check_lookup_row_cnt() override;
 private:
   int init_delta_buffer_scan_param();
   int init_index_id_scan_param();
@@ -136,16 +143,41 @@ private:
                                       bool reverse_order = false);
   int gen_scan_range(const int64_t obj_cnt, common::ObTableID table_id, ObNewRange &scan_range);
   int set_vector_query_condition(ObVectorQueryConditions &query_cond);
+  int open_main_table_scan(ObTableScanParam &scan_param, common::ObNewRowIterator *&iter);
+  int build_valid_vid_bitmap(roaring::api::roaring64_bitmap_t *&bitmap);
+  void free_valid_vid_bitmap(roaring::api::roaring64_bitmap_t *&bitmap);
+  int brute_force_search(bool &is_searched);
+  int refill_adaptor_vid_iter();
+  void destroy_search_iter();
+private:
+  struct ObVecDistanceVid
+  {
+    double distance_;
+    int64_t vid_;
+    TO_STRING_KV(K_(distance), K_(vid));
+  };
+  struct ObVecDistanceCmp
+  {
+    bool operator()(const ObVecDistanceVid &l, const ObVecDistanceVid &r) const { return l.distance_ < r.distance_; }
+    int get_error_code() const { return OB_SUCCESS; }
+  };
 private:
   static const int64_t DELTA_BUF_PRI_KEY_CNT = 2;
   static const int64_t INDEX_ID_PRI_KEY_CNT = 3;
   static const int64_t SNAPSHOT_PRI_KEY_CNT = 1;
   static const uint64_t MAX_VSAG_QUERY_RES_SIZE = 16384;
+  static const int64_t MAX_VSAG_EF_SEARCH = 1000; // bounded by vsag hnsw search parameters
+  // the in filter falls back to post filter when more rows pass the filters
+  static const uint64_t MAX_VALID_VID_CNT = 1000000;
 private:
   common::ObArenaAllocator vec_op_alloc_;
   common::ObNewRowIterator *aux_lookup_iter_;
   ObVectorQueryVidIterator* adaptor_vid_iter_;
+  ObVsagSearchIter* search_iter_; // kept open to refill the vids filtered out after lookup
+  int64_t search_output_row_cnt_; // rows left after lookup of the vids fetched by search_iter_
   ObExpr* search_vec_;
+  ObExpr* distance_expr_;
+  ObExpr* distance_threshold_; // the vids are searched by range when the distance is bounded by a filter
   ObTabletID delta_buf_tablet_id_;
   ObTabletID index_id_tablet_id_;
   ObTabletID snapshot_tablet_id_;
@@ -178,6 +210,8 @@ private:
   bool is_inited_;
   ObString vec_index_param_;
   int64_t dim_;
+  ObVecIdxQueryStrategy query_strategy_;
+  double selectivity_;
 };
 
 }  // namespace sql
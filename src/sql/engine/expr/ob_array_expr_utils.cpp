@@ -66,11 +66,7 @@ int ObArrayExprUtils::get_type_vector(
     ObString blob_data = datum.get_string();
     const ObSqlCollectionInfo *coll_info = reinterpret_cast<const ObSqlCollectionInfo *>(value.value_);
     ObCollectionArrayType *arr_type = static_cast<ObCollectionArrayType *>(coll_info->collection_meta_);
-    if (OB_FAIL(ObTextStringHelper::read_real_string_data(&allocator,
-                                                          ObLongTextType,
-                                                          CS_TYPE_BINARY,
-                                                          true,
-                                                          blob_data))) {
+    if (OB_FAIL(get_array_data(allocator, blob_data))) {
       LOG_WARN("fail to get real data.", K(ret), K(blob_data));
     } else if (OB_FAIL(ObArrayTypeObjFactory::construct(allocator, *arr_type, result, true))) {
       LOG_WARN("construct array obj failed", K(ret), K(*coll_info));
@@ -992,14 +988,30 @@ int ObArrayExprUtils::get_array_obj(ObIAllocator &alloc, ObEvalCtx &ctx, const u
   ObString data_str = raw_data;
   if (res == NULL && OB_FAIL(construct_array_obj(alloc, ctx, subschema_id, res))) {
     LOG_WARN("construct array obj failed", K(ret));
+  } else if (OB_FAIL(get_array_data(alloc, data_str))) {
+    LOG_WARN("fail to get real data.", K(ret), K(data_str));
+  } else if (OB_FAIL(res->init(data_str))) {
+    LOG_WARN("failed to init array", K(ret));
+  }
+  return ret;
+}
+
+// In-row arrays scanned from storage still carry the disk lob header and point into the
+// decoded micro block, take the payload in place instead of building a lob iterator per row.
+int ObArrayExprUtils::get_array_data(ObIAllocator &alloc, ObString &data)
+{
+  int ret = OB_SUCCESS;
+  ObLobLocatorV2 locator(data, true/*has_lob_header*/);
+  if (OB_NOT_NULL(data.ptr()) && locator.is_inrow_disk_lob_locator()) {
+    if (OB_FAIL(locator.get_inrow_data(data))) {
+      LOG_WARN("fail to get inrow data", K(ret), K(data));
+    }
   } else if (OB_FAIL(ObTextStringHelper::read_real_string_data(&alloc,
                                                               ObLongTextType,
                                                               CS_TYPE_BINARY,
                                                               true,
-                                                              data_str))) {
-    LOG_WARN("fail to get real data.", K(ret), K(data_str));
-  } else if (OB_FAIL(res->init(data_str))) {
-    LOG_WARN("failed to init array", K(ret));
+                                                              data))) {
+    LOG_WARN("fail to get real data.", K(ret), K(data));
   }
   return ret;
 }
@@ -113,6 +113,20 @@ int ObExprVectorDistance::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw
 {
   int ret = OB_SUCCESS;
   rt_expr.eval_func_ = ObExprVectorDistance::calc_distance;
+  rt_expr.eval_batch_func_ = ObExprVectorDistance::calc_distance_batch;
+  rt_expr.eval_vector_func_ = ObExprVectorDistance::calc_distance_vector;
+  return ret;
+}
+
+int ObExprVectorDistance::get_distance_type(const ObDatum &datum, ObVecDisType &dis_type)
+{
+  int ret = OB_SUCCESS;
+  if (datum.is_null()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid arg", K(ret), K(datum));
+  } else {
+    dis_type = static_cast<ObVecDisType>(datum.get_int());
+  }
   return ret;
 }
 
@@ -124,11 +138,8 @@ int ObExprVectorDistance::calc_distance(const ObExpr &expr, ObEvalCtx &ctx, ObDa
     ObDatum *datum = NULL;
     if (OB_FAIL(expr.args_[2]->eval(ctx, datum))) {
       LOG_WARN("eval failed", K(ret));
-    } else if (datum->is_null()) {
-      ret = OB_INVALID_ARGUMENT;
-      LOG_WARN("invalid arg", K(ret), K(*datum));
-    } else {
-      dis_type = static_cast<ObVecDisType>(datum->get_int());
+    } else if (OB_FAIL(get_distance_type(*datum, dis_type))) {
+      LOG_WARN("failed to get distance type", K(ret));
     }
   }
   if (FAILEDx(calc_distance(expr, ctx, res_datum, dis_type))) {
@@ -157,29 +168,220 @@ int ObExprVectorDistance::calc_distance(const ObExpr &expr, ObEvalCtx &ctx, ObDa
   } else if (OB_ISNULL(arr_l) || OB_ISNULL(arr_r)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("unexpected nullptr", K(ret), K(arr_l), K(arr_r));
-  } else if (OB_UNLIKELY(arr_l->size() != arr_r->size())) {
+  } else {
+    double distance = 0.0;
+    bool is_null = false;
+    if (OB_FAIL(calc_distance(*arr_l, *arr_r, dis_type, distance, is_null))) {
+      LOG_WARN("failed to calc distance", K(ret), K(dis_type));
+    } else if (is_null) {
+      res_datum.set_null();
+    } else {
+      res_datum.set_double(distance);
+    }
+  }
+  return ret;
+}
+
+int ObExprVectorDistance::calc_distance(const ObIArrayType &arr_l, const ObIArrayType &arr_r,
+                                        ObVecDisType dis_type, double &distance, bool &is_null)
+{
+  int ret = OB_SUCCESS;
+  is_null = false;
+  if (OB_UNLIKELY(arr_l.size() != arr_r.size())) {
     ret = OB_ERR_INVALID_VECTOR_DIM;
-    LOG_WARN("check array validty failed", K(ret), K(arr_l->size()), K(arr_r->size()));
-  } else if (arr_l->contain_null() || arr_r->contain_null()) {
+    LOG_WARN("check array validty failed", K(ret), K(arr_l.size()), K(arr_r.size()));
+  } else if (arr_l.contain_null() || arr_r.contain_null()) {
     ret = OB_ERR_NULL_VALUE;
     LOG_WARN("array with null can't calculate vector distance", K(ret));
   } else {
-    double distance = 0.0;
-    const float *data_l = reinterpret_cast<const float*>(arr_l->get_data());
-    const float *data_r = reinterpret_cast<const float*>(arr_r->get_data());
-    const uint32_t size = arr_l->size();
+    const float *data_l = reinterpret_cast<const float*>(arr_l.get_data());
+    const float *data_r = reinterpret_cast<const float*>(arr_r.get_data());
+    const uint32_t size = arr_l.size();
     if (distance_funcs[dis_type] == nullptr) {
       ret = OB_NOT_SUPPORTED;
       LOG_WARN("not support", K(ret), K(dis_type));
     } else if (OB_FAIL(distance_funcs[dis_type](data_l, data_r, size, distance))) {
       if (OB_ERR_NULL_VALUE == ret) {
-        res_datum.set_null();
+        is_null = true;
         ret = OB_SUCCESS; // ignore
       } else {
         LOG_WARN("failed to calc distance", K(ret), K(dis_type));
       }
-    } else {
-      res_datum.set_double(distance);
+    }
+  }
+  return ret;
+}
+
+int ObExprVectorDistance::calc_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                              const ObBitVector &skip, const int64_t batch_size)
+{
+  return calc_distance_batch(expr, ctx, skip, batch_size, ObVecDisType::EUCLIDEAN, false);
+}
+
+int ObExprVectorDistance::calc_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                               const ObBitVector &skip, const EvalBound &bound)
+{
+  return calc_distance_vector(expr, ctx, skip, bound, ObVecDisType::EUCLIDEAN, false);
+}
+
+int ObExprVectorDistance::calc_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                              const ObBitVector &skip, const int64_t batch_size,
+                                              ObVecDisType dis_type, const bool negative)
+{
+  int ret = OB_SUCCESS;
+  ObDatumVector res_datum = expr.locate_expr_datumvector(ctx);
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  ObEvalCtx::TempAllocGuard tmp_alloc_g(ctx);
+  common::ObArenaAllocator &tmp_allocator = tmp_alloc_g.get_allocator();
+  const uint16_t l_meta_id = expr.args_[0]->obj_meta_.get_subschema_id();
+  const uint16_t r_meta_id = expr.args_[1]->obj_meta_.get_subschema_id();
+  // a param which is not a batch result holds the same datum for every row, parse it only once
+  const bool is_l_const = !expr.args_[0]->is_batch_result();
+  const bool is_r_const = !expr.args_[1]->is_batch_result();
+  bool is_l_parsed = false;
+  bool is_r_parsed = false;
+  ObIArrayType *arr_l = NULL;
+  ObIArrayType *arr_r = NULL;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("failed to eval batch result args0", K(ret));
+  } else if (OB_FAIL(expr.args_[1]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("failed to eval batch result args1", K(ret));
+  } else if (3 == expr.arg_cnt_ && OB_FAIL(expr.args_[2]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("failed to eval batch result args2", K(ret));
+  } else {
+    ObDatumVector l_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObDatumVector r_datums = expr.args_[1]->locate_expr_datumvector(ctx);
+    ObDatumVector type_datums;
+    if (3 == expr.arg_cnt_) {
+      type_datums = expr.args_[2]->locate_expr_datumvector(ctx);
+    }
+    for (int64_t j = 0; OB_SUCC(ret) && j < batch_size; ++j) {
+      if (skip.at(j) || eval_flags.at(j)) {
+        continue;
+      }
+      ObVecDisType row_dis_type = dis_type;
+      double distance = 0.0;
+      bool is_null = false;
+      if (3 == expr.arg_cnt_ && OB_FAIL(get_distance_type(*type_datums.at(j), row_dis_type))) {
+        LOG_WARN("failed to get distance type", K(ret));
+      } else if (row_dis_type < ObVecDisType::COSINE || row_dis_type >= ObVecDisType::MAX_TYPE) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpect distance type", K(ret), K(row_dis_type));
+      } else if (l_datums.at(j)->is_null() || r_datums.at(j)->is_null()) {
+        is_null = true;
+      } else if ((!is_l_const || !is_l_parsed)
+                 && OB_FAIL(ObArrayExprUtils::get_array_obj(tmp_allocator, ctx, l_meta_id,
+                                                            l_datums.at(j)->get_string(), arr_l))) {
+        LOG_WARN("construct array obj failed", K(ret));
+      } else if (FALSE_IT(is_l_parsed = true)) {
+      } else if ((!is_r_const || !is_r_parsed)
+                 && OB_FAIL(ObArrayExprUtils::get_array_obj(tmp_allocator, ctx, r_meta_id,
+                                                            r_datums.at(j)->get_string(), arr_r))) {
+        LOG_WARN("construct array obj failed", K(ret));
+      } else if (FALSE_IT(is_r_parsed = true)) {
+      } else if (OB_FAIL(calc_distance(*arr_l, *arr_r, row_dis_type, distance, is_null))) {
+        LOG_WARN("failed to calc distance", K(ret), K(row_dis_type));
+      }
+      if (OB_FAIL(ret)) {
+      } else if (is_null) {
+        res_datum.at(j)->set_null();
+        eval_flags.set(j);
+      } else {
+        res_datum.at(j)->set_double(negative ? -distance : distance);
+        eval_flags.set(j);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprVectorDistance::calc_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                               const ObBitVector &skip, const EvalBound &bound,
+                                               ObVecDisType dis_type, const bool negative)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.args_[0]->eval_vector(ctx, skip, bound))
+      || OB_FAIL(expr.args_[1]->eval_vector(ctx, skip, bound))) {
+    LOG_WARN("fail to eval params", K(ret));
+  } else if (3 == expr.arg_cnt_ && OB_FAIL(expr.args_[2]->eval_vector(ctx, skip, bound))) {
+    LOG_WARN("fail to eval distance type", K(ret));
+  } else {
+    ObEvalCtx::TempAllocGuard tmp_alloc_g(ctx);
+    common::ObArenaAllocator &tmp_allocator = tmp_alloc_g.get_allocator();
+    ObIVector *left_vec = expr.args_[0]->get_vector(ctx);
+    VectorFormat left_format = left_vec->get_format();
+    ObIVector *right_vec = expr.args_[1]->get_vector(ctx);
+    VectorFormat right_format = right_vec->get_format();
+    ObIVector *type_vec = 3 == expr.arg_cnt_ ? expr.args_[2]->get_vector(ctx) : NULL;
+    const uint16_t left_meta_id = expr.args_[0]->obj_meta_.get_subschema_id();
+    const uint16_t right_meta_id = expr.args_[1]->obj_meta_.get_subschema_id();
+    ObIVector *res_vec = expr.get_vector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    // a const vector holds the same value for every row, parse it only once
+    const bool is_left_const = VEC_UNIFORM_CONST == left_format;
+    const bool is_right_const = VEC_UNIFORM_CONST == right_format;
+    bool is_left_parsed = false;
+    bool is_right_parsed = false;
+    ObIArrayType *arr_l = NULL;
+    ObIArrayType *arr_r = NULL;
+    for (int64_t idx = bound.start(); OB_SUCC(ret) && idx < bound.end(); ++idx) {
+      if (skip.at(idx) || eval_flags.at(idx)) {
+        continue;
+      }
+      ObVecDisType row_dis_type = dis_type;
+      double distance = 0.0;
+      bool is_null = false;
+      if (OB_NOT_NULL(type_vec)) {
+        if (type_vec->is_null(idx)) {
+          ret = OB_INVALID_ARGUMENT;
+          LOG_WARN("invalid arg", K(ret), K(idx));
+        } else {
+          row_dis_type = static_cast<ObVecDisType>(type_vec->get_int(idx));
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (row_dis_type < ObVecDisType::COSINE || row_dis_type >= ObVecDisType::MAX_TYPE) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpect distance type", K(ret), K(row_dis_type));
+      } else if (left_vec->is_null(idx) || right_vec->is_null(idx)) {
+        is_null = true;
+      } else if (is_left_const && is_left_parsed) {
+        // reuse the parsed const vector
+      } else if (left_format == VEC_UNIFORM || left_format == VEC_UNIFORM_CONST) {
+        ObString left = left_vec->get_string(idx);
+        if (OB_FAIL(ObNestedVectorFunc::construct_param(tmp_allocator, ctx, left_meta_id, left, arr_l))) {
+          LOG_WARN("construct array obj failed", K(ret));
+        }
+      } else if (OB_FAIL(ObNestedVectorFunc::construct_attr_param(
+                     tmp_allocator, ctx, *expr.args_[0], left_meta_id, idx, arr_l))) {
+        LOG_WARN("construct array obj failed", K(ret));
+      }
+      if (OB_FAIL(ret) || is_null) {
+      } else if (FALSE_IT(is_left_parsed = true)) {
+      } else if (is_right_const && is_right_parsed) {
+        // reuse the parsed const vector
+      } else if (right_format == VEC_UNIFORM || right_format == VEC_UNIFORM_CONST) {
+        ObString right = right_vec->get_string(idx);
+        if (OB_FAIL(ObNestedVectorFunc::construct_param(tmp_allocator, ctx, right_meta_id, right, arr_r))) {
+          LOG_WARN("construct array obj failed", K(ret));
+        }
+      } else if (OB_FAIL(ObNestedVectorFunc::construct_attr_param(
+                     tmp_allocator, ctx, *expr.args_[1], right_meta_id, idx, arr_r))) {
+        LOG_WARN("construct array obj failed", K(ret));
+      }
+      if (OB_FAIL(ret) || is_null) {
+      } else if (FALSE_IT(is_right_parsed = true)) {
+      } else if (OB_FAIL(calc_distance(*arr_l, *arr_r, row_dis_type, distance, is_null))) {
+        LOG_WARN("failed to calc distance", K(ret), K(row_dis_type));
+      }
+      if (OB_FAIL(ret)) {
+      } else if (is_null) {
+        res_vec->set_null(idx);
+        eval_flags.set(idx);
+      } else {
+        res_vec->set_double(idx, negative ? -distance : distance);
+        eval_flags.set(idx);
+      }
     }
   }
   return ret;
@@ -193,6 +395,8 @@ int ObExprVectorL1Distance::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &r
 {
     int ret = OB_SUCCESS;
     rt_expr.eval_func_ = ObExprVectorL1Distance::calc_l1_distance;
+    rt_expr.eval_batch_func_ = ObExprVectorL1Distance::calc_l1_distance_batch;
+    rt_expr.eval_vector_func_ = ObExprVectorL1Distance::calc_l1_distance_vector;
     return ret;
 }
 
@@ -201,6 +405,18 @@ int ObExprVectorL1Distance::calc_l1_distance(const ObExpr &expr, ObEvalCtx &ctx,
   return ObExprVectorDistance::calc_distance(expr, ctx, res_datum, ObVecDisType::MANHATTAN);
 }
 
+int ObExprVectorL1Distance::calc_l1_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                                   const ObBitVector &skip, const int64_t batch_size)
+{
+  return ObExprVectorDistance::calc_distance_batch(expr, ctx, skip, batch_size, ObVecDisType::MANHATTAN, false);
+}
+
+int ObExprVectorL1Distance::calc_l1_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                                    const ObBitVector &skip, const EvalBound &bound)
+{
+  return ObExprVectorDistance::calc_distance_vector(expr, ctx, skip, bound, ObVecDisType::MANHATTAN, false);
+}
+
 ObExprVectorL2Distance::ObExprVectorL2Distance(ObIAllocator &alloc)
     : ObExprVectorDistance(alloc, T_FUN_SYS_L2_DISTANCE, N_VECTOR_L2_DISTANCE, 2, NOT_ROW_DIMENSION) {}
 
@@ -209,6 +425,8 @@ int ObExprVectorL2Distance::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &r
 {
     int ret = OB_SUCCESS;
     rt_expr.eval_func_ = ObExprVectorL2Distance::calc_l2_distance;
+    rt_expr.eval_batch_func_ = ObExprVectorL2Distance::calc_l2_distance_batch;
+    rt_expr.eval_vector_func_ = ObExprVectorL2Distance::calc_l2_distance_vector;
     return ret;
 }
 
@@ -217,6 +435,18 @@ int ObExprVectorL2Distance::calc_l2_distance(const ObExpr &expr, ObEvalCtx &ctx,
   return ObExprVectorDistance::calc_distance(expr, ctx, res_datum, ObVecDisType::EUCLIDEAN);
 }
 
+int ObExprVectorL2Distance::calc_l2_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                                   const ObBitVector &skip, const int64_t batch_size)
+{
+  return ObExprVectorDistance::calc_distance_batch(expr, ctx, skip, batch_size, ObVecDisType::EUCLIDEAN, false);
+}
+
+int ObExprVectorL2Distance::calc_l2_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                                    const ObBitVector &skip, const EvalBound &bound)
+{
+  return ObExprVectorDistance::calc_distance_vector(expr, ctx, skip, bound, ObVecDisType::EUCLIDEAN, false);
+}
+
 ObExprVectorCosineDistance::ObExprVectorCosineDistance(ObIAllocator &alloc)
     : ObExprVectorDistance(alloc, T_FUN_SYS_COSINE_DISTANCE, N_VECTOR_COS_DISTANCE, 2, NOT_ROW_DIMENSION) {}
 
@@ -225,6 +455,8 @@ int ObExprVectorCosineDistance::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExp
 {
     int ret = OB_SUCCESS;
     rt_expr.eval_func_ = ObExprVectorCosineDistance::calc_cosine_distance;
+    rt_expr.eval_batch_func_ = ObExprVectorCosineDistance::calc_cosine_distance_batch;
+    rt_expr.eval_vector_func_ = ObExprVectorCosineDistance::calc_cosine_distance_vector;
     return ret;
 }
 
@@ -233,6 +465,18 @@ int ObExprVectorCosineDistance::calc_cosine_distance(const ObExpr &expr, ObEvalC
   return ObExprVectorDistance::calc_distance(expr, ctx, res_datum, ObVecDisType::COSINE);
 }
 
+int ObExprVectorCosineDistance::calc_cosine_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                                           const ObBitVector &skip, const int64_t batch_size)
+{
+  return ObExprVectorDistance::calc_distance_batch(expr, ctx, skip, batch_size, ObVecDisType::COSINE, false);
+}
+
+int ObExprVectorCosineDistance::calc_cosine_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                                            const ObBitVector &skip, const EvalBound &bound)
+{
+  return ObExprVectorDistance::calc_distance_vector(expr, ctx, skip, bound, ObVecDisType::COSINE, false);
+}
+
 ObExprVectorIPDistance::ObExprVectorIPDistance(ObIAllocator &alloc)
     : ObExprVectorDistance(alloc, T_FUN_SYS_INNER_PRODUCT, N_VECTOR_INNER_PRODUCT, 2, NOT_ROW_DIMENSION) {}
 
@@ -241,6 +485,8 @@ int ObExprVectorIPDistance::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &r
 {
     int ret = OB_SUCCESS;
     rt_expr.eval_func_ = ObExprVectorIPDistance::calc_inner_product;
+    rt_expr.eval_batch_func_ = ObExprVectorIPDistance::calc_inner_product_batch;
+    rt_expr.eval_vector_func_ = ObExprVectorIPDistance::calc_inner_product_vector;
     return ret;
 }
 
@@ -249,6 +495,18 @@ int ObExprVectorIPDistance::calc_inner_product(const ObExpr &expr, ObEvalCtx &ct
   return ObExprVectorDistance::calc_distance(expr, ctx, res_datum, ObVecDisType::DOT);
 }
 
+int ObExprVectorIPDistance::calc_inner_product_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                                     const ObBitVector &skip, const int64_t batch_size)
+{
+  return ObExprVectorDistance::calc_distance_batch(expr, ctx, skip, batch_size, ObVecDisType::DOT, false);
+}
+
+int ObExprVectorIPDistance::calc_inner_product_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                                      const ObBitVector &skip, const EvalBound &bound)
+{
+  return ObExprVectorDistance::calc_distance_vector(expr, ctx, skip, bound, ObVecDisType::DOT, false);
+}
+
 ObExprVectorNegativeIPDistance::ObExprVectorNegativeIPDistance(ObIAllocator &alloc)
     : ObExprVectorDistance(alloc, T_FUN_SYS_NEGATIVE_INNER_PRODUCT, N_VECTOR_NEGATIVE_INNER_PRODUCT, 2, NOT_ROW_DIMENSION) {}
 
@@ -257,6 +515,8 @@ int ObExprVectorNegativeIPDistance::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRa
 {
     int ret = OB_SUCCESS;
     rt_expr.eval_func_ = ObExprVectorNegativeIPDistance::calc_negative_inner_product;
+    rt_expr.eval_batch_func_ = ObExprVectorNegativeIPDistance::calc_negative_inner_product_batch;
+    rt_expr.eval_vector_func_ = ObExprVectorNegativeIPDistance::calc_negative_inner_product_vector;
     return ret;
 }
 
@@ -272,6 +532,18 @@ int ObExprVectorNegativeIPDistance::calc_negative_inner_product(const ObExpr &ex
   return ret;
 }
 
+int ObExprVectorNegativeIPDistance::calc_negative_inner_product_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                                                      const ObBitVector &skip, const int64_t batch_size)
+{
+  return ObExprVectorDistance::calc_distance_batch(expr, ctx, skip, batch_size, ObVecDisType::DOT, true);
+}
+
+int ObExprVectorNegativeIPDistance::calc_negative_inner_product_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                                                       const ObBitVector &skip, const EvalBound &bound)
+{
+  return ObExprVectorDistance::calc_distance_vector(expr, ctx, skip, bound, ObVecDisType::DOT, true);
+}
+
 ObExprVectorDims::ObExprVectorDims(ObIAllocator &alloc)
     : ObExprVector(alloc, T_FUN_SYS_VECTOR_DIMS, N_VECTOR_DIMS, 1, NOT_ROW_DIMENSION) {}
 
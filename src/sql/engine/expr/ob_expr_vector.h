@@ -99,8 +99,23 @@ public:
                       ObExpr &rt_expr) const override;
   static int calc_distance(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
   static int calc_distance(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum, ObVecDisType dis_type);
+  static int calc_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                 const ObBitVector &skip, const int64_t batch_size);
+  static int calc_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                  const ObBitVector &skip, const EvalBound &bound);
+  // the const param (usually the query vector) is parsed only once for the whole batch,
+  // the result is negated if negative is true.
+  static int calc_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                 const ObBitVector &skip, const int64_t batch_size,
+                                 ObVecDisType dis_type, const bool negative);
+  static int calc_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                  const ObBitVector &skip, const EvalBound &bound,
+                                  ObVecDisType dis_type, const bool negative);
 
 private:
+  static int get_distance_type(const ObDatum &datum, ObVecDisType &dis_type);
+  static int calc_distance(const ObIArrayType &arr_l, const ObIArrayType &arr_r,
+                           ObVecDisType dis_type, double &distance, bool &is_null);
   DISALLOW_COPY_AND_ASSIGN(ObExprVectorDistance);
 };
 
@@ -115,6 +130,10 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int calc_l1_distance(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
+  static int calc_l1_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                    const ObBitVector &skip, const int64_t batch_size);
+  static int calc_l1_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                     const ObBitVector &skip, const EvalBound &bound);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprVectorL1Distance);
 };
@@ -130,6 +149,10 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int calc_l2_distance(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
+  static int calc_l2_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                    const ObBitVector &skip, const int64_t batch_size);
+  static int calc_l2_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                     const ObBitVector &skip, const EvalBound &bound);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprVectorL2Distance);
 };
@@ -145,6 +168,10 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int calc_cosine_distance(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
+  static int calc_cosine_distance_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                        const ObBitVector &skip, const int64_t batch_size);
+  static int calc_cosine_distance_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                         const ObBitVector &skip, const EvalBound &bound);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprVectorCosineDistance);
 };
@@ -160,6 +187,10 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int calc_inner_product(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
+  static int calc_inner_product_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                      const ObBitVector &skip, const int64_t batch_size);
+  static int calc_inner_product_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                       const ObBitVector &skip, const EvalBound &bound);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprVectorIPDistance);
 };
@@ -175,6 +206,10 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int calc_negative_inner_product(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
+  static int calc_negative_inner_product_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                               const ObBitVector &skip, const int64_t batch_size);
+  static int calc_negative_inner_product_vector(const ObExpr &expr, ObEvalCtx &ctx,
+                                                const ObBitVector &skip, const EvalBound &bound);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprVectorNegativeIPDistance);
 };
@@ -42,5 +42,261 @@ int GenericProber::equal(JoinTableCtx &ctx,
   return ret;
 }
 
+int DirectInt64Table::init(ObIAllocator &alloc, const int64_t max_batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(NormalizedInt64Table::init(alloc, max_batch_size))) {
+    LOG_WARN("fail to init normalized table", K(ret));
+  } else if (NULL == slots_) {
+    void *slot_buf = alloc.alloc(sizeof(SlotArray));
+    if (OB_ISNULL(slot_buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc memory", K(ret));
+    } else {
+      slots_ = new (slot_buf) SlotArray(*ht_alloc_);
+    }
+  }
+  return ret;
+}
+
+// same as HashTable::build_prepare, except that the buckets are not initialized until the
+// key range is known
+int DirectInt64Table::build_prepare(int64_t row_count, int64_t bucket_count)
+{
+  int ret = OB_SUCCESS;
+  row_count_ = row_count;
+  nbuckets_ = std::max(nbuckets_, bucket_count);
+  collisions_ = 0;
+  used_buckets_ = 0;
+  buckets_->reuse();
+  slots_->reuse();
+  nslots_ = 0;
+  linked_pos_ = 0;
+  min_key_ = INT64_MAX;
+  max_key_ = INT64_MIN;
+  slot_min_key_ = 0;
+  use_direct_ = false;
+  use_hash_ = false;
+  items_->reuse();
+  item_pos_ = 0;
+  OZ (items_->init(row_count));
+  LOG_DEBUG("direct table build prepare", K(row_count), K(bucket_count), K_(nbuckets));
+  return ret;
+}
+
+int DirectInt64Table::insert_batch(JoinTableCtx &ctx,
+                                   ObHJStoredRow **stored_rows,
+                                   const int64_t size,
+                                   int64_t &used_buckets,
+                                   int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  if (use_hash_) {
+    ret = NormalizedInt64Table::insert_batch(ctx, stored_rows, size, used_buckets, collisions);
+  } else {
+    for (int64_t i = 0; i < size; ++i) {
+      Item *item = new_item();
+      item->init(ctx, ctx.build_row_meta_, stored_rows[i], reinterpret_cast<Item *>(END_ITEM));
+      min_key_ = std::min(min_key_, item->key_.data_);
+      max_key_ = std::max(max_key_, item->key_.data_);
+    }
+  }
+  return ret;
+}
+
+// May be called several times after one build_prepare, e.g. once for each partition while
+// building for recursive, the items staged since the last call are linked each time. The slots
+// are sized by the first rows linked, if the later rows are out of them, the table falls back to
+// the buckets rather than linking all the items again for each call.
+int DirectInt64Table::build_finish(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  // the slots must not take more memory than the buckets, which the memory of hash join is
+  // planned with
+  const uint64_t max_slots = nbuckets_ * sizeof(NormalizedBucket<Int64Key>)
+                             / sizeof(DirectBucket<Int64Key>);
+  // range is 0 if the keys span all the int64 values
+  const uint64_t range = 0 == item_pos_
+                         ? 0
+                         : static_cast<uint64_t>(max_key_) - static_cast<uint64_t>(min_key_) + 1;
+  if (use_hash_) {
+    // rows are inserted into the buckets already
+  } else if (!ctx.probe_opt_ || (0 < item_pos_ && (0 == range || range > max_slots))) {
+    if (OB_FAIL(insert_staged_rows(ctx, used_buckets, collisions))) {
+      LOG_WARN("fail to insert staged rows", K(ret));
+    }
+  } else if (linked_pos_ == item_pos_) {
+    // no row is staged since the last call
+  } else if (use_direct_
+             && (min_key_ < slot_min_key_
+                 || static_cast<uint64_t>(max_key_) - static_cast<uint64_t>(slot_min_key_)
+                    >= static_cast<uint64_t>(nslots_))) {
+    if (OB_FAIL(insert_staged_rows(ctx, used_buckets, collisions))) {
+      LOG_WARN("fail to insert staged rows", K(ret));
+    }
+  } else {
+    const RowMeta &row_meta = ctx.build_row_meta_;
+    if (!use_direct_) {
+      slots_->reuse();
+      if (OB_FAIL(slots_->init(range))) {
+        LOG_WARN("fail to init slots", K(ret), K(range));
+      } else {
+        nslots_ = range;
+        slot_min_key_ = min_key_;
+        use_direct_ = true;
+      }
+    }
+    for (int64_t i = linked_pos_; OB_SUCC(ret) && i < item_pos_; ++i) {
+      Item *item = &items_->at(i);
+      DirectBucket<Int64Key> &slot = slots_->at(item->key_.data_ - slot_min_key_);
+      if (!slot.used()) {
+        ++used_buckets;
+      }
+      item->set_next(row_meta, slot.item_);
+      slot.item_ = item;
+    }
+    if (OB_SUCC(ret)) {
+      linked_pos_ = item_pos_;
+    }
+  }
+  LOG_TRACE("direct table build finish", K(ret), K_(use_direct), K_(use_hash), K_(min_key),
+            K_(max_key), K(range), K(max_slots), K_(item_pos));
+  return ret;
+}
+
+// Insert the staged rows into the buckets, and the later rows are inserted into the buckets
+// directly. The items are reused as the chain items, the i-th item is never taken before the
+// i-th row is inserted, so the rows are read into ctx.stored_rows_ batch by batch before they
+// are inserted.
+int DirectInt64Table::insert_staged_rows(JoinTableCtx &ctx,
+                                         int64_t &used_buckets,
+                                         int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  const int64_t staged_cnt = item_pos_;
+  ObHJStoredRow **rows = const_cast<ObHJStoredRow **>(ctx.stored_rows_);
+  item_pos_ = 0;
+  linked_pos_ = 0;
+  // all the rows are inserted again, the slots counted before are dropped
+  used_buckets_ = 0;
+  collisions_ = 0;
+  used_buckets = 0;
+  collisions = 0;
+  slots_->reuse();
+  nslots_ = 0;
+  use_direct_ = false;
+  use_hash_ = true;
+  if (OB_FAIL(buckets_->init(nbuckets_))) {
+    LOG_WARN("fail to init buckets", K(ret), K_(nbuckets));
+  }
+  for (int64_t start = 0; OB_SUCC(ret) && start < staged_cnt; start += ctx.max_batch_size_) {
+    const int64_t size = std::min(ctx.max_batch_size_, staged_cnt - start);
+    for (int64_t i = 0; i < size; ++i) {
+      rows[i] = items_->at(start + i).get_stored_row();
+    }
+    if (OB_FAIL(NormalizedInt64Table::insert_batch(ctx, rows, size, used_buckets, collisions))) {
+      LOG_WARN("fail to insert batch", K(ret));
+    }
+  }
+  return ret;
+}
+
+int DirectInt64Table::probe_batch(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  return use_hash_
+         ? NormalizedInt64Table::probe_batch(ctx, output_info)
+         : probe_batch_direct(ctx, output_info);
+}
+
+// all the items linked in one slot have the key of the slot, so the first item of the slot
+// matches the probe row, and the next call returns the following one. no row matches if no
+// slot is sized, i.e. the build is empty
+int DirectInt64Table::probe_batch_direct(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  int64_t new_selector_cnt = 0;
+  if (output_info.first_probe_) {
+    const Int64Key *keys = reinterpret_cast<const Int64Key *>(ctx.probe_batch_rows_->key_data_);
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      uint64_t pos = static_cast<uint64_t>(keys[output_info.selector_[i]].data_)
+                     - static_cast<uint64_t>(slot_min_key_);
+      if (pos < static_cast<uint64_t>(nslots_)) {
+        __builtin_prefetch(&slots_->at(pos), 0, 1 /*low temporal locality*/);
+      }
+    }
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      int64_t batch_idx = output_info.selector_[i];
+      uint64_t pos = static_cast<uint64_t>(keys[batch_idx].data_)
+                     - static_cast<uint64_t>(slot_min_key_);
+      Item *item = pos < static_cast<uint64_t>(nslots_)
+                   ? slots_->at(pos).get_item()
+                   : reinterpret_cast<Item *>(END_ITEM);
+      if (END_ITEM != reinterpret_cast<uint64_t>(item)) {
+        output_info.left_result_rows_[new_selector_cnt] = item->get_stored_row();
+        ctx.cur_items_[new_selector_cnt] = item->get_next(ctx.build_row_meta_);
+        output_info.selector_[new_selector_cnt++] = batch_idx;
+        if (ctx.need_mark_match()) {
+          item->set_is_match(ctx.build_row_meta_, true);
+        }
+      }
+    }
+    output_info.first_probe_ = false;
+  } else {
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      Item *item = reinterpret_cast<Item *>(ctx.cur_items_[i]);
+      if (END_ITEM != reinterpret_cast<uint64_t>(item)) {
+        output_info.left_result_rows_[new_selector_cnt] = item->get_stored_row();
+        ctx.cur_items_[new_selector_cnt] = item->get_next(ctx.build_row_meta_);
+        output_info.selector_[new_selector_cnt++] = output_info.selector_[i];
+        if (ctx.need_mark_match()) {
+          item->set_is_match(ctx.build_row_meta_, true);
+        }
+      }
+    }
+  }
+  output_info.selector_cnt_ = new_selector_cnt;
+  return ret;
+}
+
+// the slots are used only with probe opt, which is for inner join, so the unmatched rows are
+// never asked for from the slots
+int DirectInt64Table::get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!use_hash_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unmatched rows of direct table", K(ret), K_(use_direct), K_(nslots));
+  } else {
+    ret = NormalizedInt64Table::get_unmatched_rows(ctx, output_info);
+  }
+  return ret;
+}
+
+void DirectInt64Table::reset()
+{
+  if (OB_NOT_NULL(slots_)) {
+    slots_->reset();
+  }
+  nslots_ = 0;
+  linked_pos_ = 0;
+  min_key_ = INT64_MAX;
+  max_key_ = INT64_MIN;
+  slot_min_key_ = 0;
+  use_direct_ = false;
+  use_hash_ = false;
+  NormalizedInt64Table::reset();
+}
+
+void DirectInt64Table::free(ObIAllocator *alloc)
+{
+  // the slots are allocated by ht_alloc_, which is released by NormalizedInt64Table::free
+  if (OB_NOT_NULL(slots_)) {
+    slots_->destroy();
+    alloc->free(slots_);
+    slots_ = nullptr;
+  }
+  NormalizedInt64Table::free(alloc);
+}
+
 } // end namespace sql
 } // end namespace oceanbase
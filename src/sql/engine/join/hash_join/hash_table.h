@@ -20,43 +20,6 @@ namespace oceanbase
 {
 namespace sql
 {
-//template<typename T>
-//struct DirectItem {
-//  static const bool split_null = true;
-//  using CType = ObjTypeTrait<T>::c_type;
-//  void set_matched() { /*do nothing;*/ }
-//  bool is_matched() { /**/ }
-//  bool used() { return NULL == next_; };
-//  bool set_used(bool v);
-//  void set_next(DirectItem *item);
-//  DirectItem *get_next();
-//  DirectItem *construct(key_project, left_stored_rows[i]) {};
-//private:
-//  union {
-//    T hash_value_;
-//    T key_;
-//  }
-//  uint64_t row_ptr_;
-//  DirectItem *next_;
-//};
-//
-//template<typename T>
-//struct DirectFlagItem : public DirectItem {
-//
-//public:
-//  uint8_t flag_;
-//};
-
-//template<typename T>
-//struct DirectBucket : {
-//  using Item = DirectItem<T>;
-//public:
-//  T hash_value();
-//  Item *get_item();
-//public:
-//  Item item_;
-//};
-
 struct Int64Key {
   inline void init_data(const ObFixedArray<int64_t, common::ObIAllocator> *key_proj,
                  const RowMeta &row_meta,
@@ -169,6 +132,20 @@ public:
   Item item_;
 };
 
+// Slot of direct addressed table, the slot of key k is at k - min_key, and links all the items
+// of key k, so the items found need no key compare.
+template<typename T>
+struct DirectBucket {
+  using Item = NormalizedItem<T>;
+  DirectBucket() : item_(reinterpret_cast<Item *>(END_ITEM)) {}
+  Item *get_item() { return item_; }
+  bool used() const { return END_ITEM != reinterpret_cast<uint64_t>(item_); }
+
+  TO_STRING_KV(KP_(item));
+public:
+  Item *item_;
+};
+
 struct GenericItem: public ObHJStoredRow {
   static const bool split_null = false;
   void set_next(const RowMeta &row_meta, GenericItem *item) {
@@ -235,13 +212,6 @@ private:
                               const int64_t batch_idx);
 };
 
-//template<typename Item>
-//struct DirectProber: public ProberBase<Item> {
-//  int equal(Item *item,  JoinTableCtx &ctx, const int64_t batch_idx, bool &is_equal) {
-//    return item->key_ == *(reinterpret_cast<Item::CType *>(ctx.get_probe_key(batch_idx)));
-//  }
-//}
-
 template<typename T>
 struct NormalizedProber final: public ProberBase<NormalizedItem<T>> {
   using Item = NormalizedItem<T>;
@@ -275,6 +245,8 @@ struct IHashTable {
                            const int64_t size,
                            int64_t &used_buckets,
                            int64_t &collisions) = 0;
+  // called after all the rows of one build are inserted
+  virtual int build_finish(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions) = 0;
   virtual int probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info) = 0;
   virtual int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) = 0;
   virtual int project_matched_rows(JoinTableCtx &ctx, OutputInfo &output_info) = 0;
@@ -334,6 +306,13 @@ struct HashTable : public IHashTable
                            const int64_t size,
                            int64_t &used_buckets,
                            int64_t &collisions) override;
+  virtual int build_finish(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions) override
+  {
+    UNUSED(ctx);
+    UNUSED(used_buckets);
+    UNUSED(collisions);
+    return common::OB_SUCCESS;
+  }
   int probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info) override;
   int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) override {
     return ctx.probe_opt_  ? probe_batch_opt(ctx, output_info)
@@ -343,7 +322,7 @@ struct HashTable : public IHashTable
   int get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override;
   int project_matched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override;
   void reset() override;
-  void free(ObIAllocator *alloc);
+  void free(ObIAllocator *alloc) override;
 
   int64_t get_row_count() const override { return row_count_; };
   int64_t get_used_buckets() const override { return used_buckets_; }
@@ -377,9 +356,9 @@ protected:
     int64_t idx = __sync_fetch_and_add(&item_pos_, 1);
     return &items_->at(idx);
   }
+  Item *new_item() { return &items_->at(item_pos_++); }
 private:
   int init_probe_key_data(JoinTableCtx &ctx, OutputInfo &output_info);
-  Item *new_item() { return &items_->at(item_pos_++); }
   int probe_batch_opt(JoinTableCtx &ctx, OutputInfo &output_info);
   int probe_batch_normal(JoinTableCtx &ctx, OutputInfo &output_info);
   int probe_batch_del_match(JoinTableCtx &ctx, OutputInfo &output_info);
@@ -457,14 +436,79 @@ private:
                         ObHJStoredRow *sr, int64_t &used_buckets, int64_t &collisions);
 };
 
-//using DirectInt8Table = HashTable<DirectBucket<int8_t>, NormalizedProber<int8_t>>;
-//using DirectInt16Table = HashTable<DirectBucket<int16_t>, NormalizedProber<int16_t>>;
 //using NormalizedInt32Table = HashTable<NormalizedBucket<int32_t>, NormalizedProber<int32_t>>;
 using NormalizedInt64Table = HashTable<NormalizedBucket<Int64Key>, NormalizedProber<Int64Key>>;
 using NormalizedInt128Table = HashTable<NormalizedBucket<Int128Key>, NormalizedProber<Int128Key>>;
 //using NormalizedFloatTable = HashTable<NormalizedBucket<float>, NormalizedProber<float>>;
 //using NormalizedDoubleTable =  HashTable<NormalizedBucket<double>, NormalizedProber<double>>;
 using GenericTable = HashTable<GenericBucket, GenericProber>;
+
+// Direct addressed table for one integer join key:
+//
+//   slots:
+//   +------+
+//   | NULL |                                  slot of key k is slots[k - min_key]
+//   +------+        +----------+       +----------+
+//   | Item |------->| Item     |------>| Item     |
+//   +------+        +----------+       +----------+
+//   | NULL |
+//   +------+
+//
+// The key range of the build rows is unknown until all of them are inserted, so the rows are
+// staged in items_ while inserting, and are linked into the slots in build_finish if the slots
+// take no more memory than the buckets of the normalized table would. Otherwise the staged rows
+// are inserted into the buckets, and the table works as NormalizedInt64Table. Only used with
+// probe opt, where the key is the only join condition of the inner join.
+struct DirectInt64Table final : public NormalizedInt64Table
+{
+  using Item = NormalizedItem<Int64Key>;
+  using SlotArray = common::ObSegmentArray<DirectBucket<Int64Key>,
+                                           OB_MALLOC_MIDDLE_BLOCK_SIZE,
+                                           common::ModulePageAllocator>;
+  DirectInt64Table()
+      : NormalizedInt64Table(),
+        slots_(NULL),
+        nslots_(0),
+        linked_pos_(0),
+        min_key_(INT64_MAX),
+        max_key_(INT64_MIN),
+        slot_min_key_(0),
+        use_direct_(false),
+        use_hash_(false)
+  {
+  }
+  int init(ObIAllocator &alloc, const int64_t max_batch_size) override;
+  int build_prepare(int64_t row_count, int64_t bucket_count) override;
+  int insert_batch(JoinTableCtx &ctx,
+                   ObHJStoredRow **stored_rows,
+                   const int64_t size,
+                   int64_t &used_buckets,
+                   int64_t &collisions) override;
+  int build_finish(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions) override;
+  int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) override;
+  int get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override;
+  void reset() override;
+  void free(ObIAllocator *alloc) override;
+  int64_t get_mem_used() const override {
+    return NormalizedInt64Table::get_mem_used() + (NULL == slots_ ? 0 : slots_->mem_used());
+  }
+private:
+  int probe_batch_direct(JoinTableCtx &ctx, OutputInfo &output_info);
+  int insert_staged_rows(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions);
+private:
+  SlotArray *slots_;
+  int64_t nslots_;
+  // count of the items linked into the slots
+  int64_t linked_pos_;
+  int64_t min_key_;
+  int64_t max_key_;
+  // key of slots_[0]
+  int64_t slot_min_key_;
+  // rows are linked into the slots
+  bool use_direct_;
+  // rows are inserted into the buckets, the table works as NormalizedInt64Table
+  bool use_hash_;
+};
 using NormalizedSharedInt64Table = NormalizedSharedHashTable<NormalizedBucket<Int64Key>, NormalizedProber<Int64Key>>;
 using NormalizedSharedInt128Table = NormalizedSharedHashTable<NormalizedBucket<Int128Key>, NormalizedProber<Int128Key>>;
 
@@ -62,7 +62,8 @@ int JoinHashTable::init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator)
   } else {
     if (use_normalized ) {
       if (1 == hjt_ctx.build_keys_->count()) {
-        hash_table_ = OB_NEWx(NormalizedInt64Table, (&allocator));
+        // works as NormalizedInt64Table if the key range of build rows is too large
+        hash_table_ = OB_NEWx(DirectInt64Table, (&allocator));
       } else if (2 == hjt_ctx.build_keys_->count()) {
         hash_table_ = OB_NEWx(NormalizedInt128Table, (&allocator));
       }
@@ -102,11 +103,13 @@ int JoinHashTable::build(JoinPartitionRowIter &iter, JoinTableCtx &ctx) {
     }
     LOG_DEBUG("build hash join table", K(read_size), K(ret));
   }
-  hash_table_->set_diag_info(used_buckets, collisions);
-
   if (OB_ITER_END == ret) {
     ret = OB_SUCCESS;
+    if (OB_FAIL(hash_table_->build_finish(ctx, used_buckets, collisions))) {
+      LOG_WARN("fail to finish build", K(ret));
+    }
   }
+  hash_table_->set_diag_info(used_buckets, collisions);
 
   return ret;
 }
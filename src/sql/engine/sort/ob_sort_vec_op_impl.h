@@ -24,6 +24,7 @@
 #include "sql/engine/sort/ob_sort_key_vec_op.h"
 #include "sql/engine/sort/ob_sort_key_fetcher_vec_op.h"
 #include "sql/engine/sort/ob_sort_vec_op_eager_filter.h"
+#include "sql/engine/sort/ob_sort_vec_op_loser_tree.h"
 #include "sql/engine/sort/ob_sort_vec_op_store_row_factory.h"
 #include "sql/engine/expr/ob_array_expr_utils.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
@@ -404,8 +405,9 @@ protected:
   static const int64_t EXTEND_MULTIPLE = 2;
   static const int64_t MAX_MERGE_WAYS = 256;
   static const int64_t INMEMORY_MERGE_SORT_WARN_WAYS = 10000;
-  typedef common::ObBinaryHeap<Store_Row **, Compare, 16> IMMSHeap;
-  typedef common::ObBinaryHeap<SortVecOpChunk *, Compare, MAX_MERGE_WAYS> EMSHeap;
+  // merge of sorted runs is done by loser tree, which has the same interface of binary heap
+  typedef ObSortVecOpLoserTree<Store_Row **, Compare, 16> IMMSHeap;
+  typedef ObSortVecOpLoserTree<SortVecOpChunk *, Compare, MAX_MERGE_WAYS> EMSHeap;
   typedef common::ObBinaryHeap<Store_Row *, Compare> TopnHeap;
 
   union
@@ -1528,6 +1528,8 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::sort_inmem_data()
           prev = &rows_->at(i);
         }
         if (OB_FAIL(ret)) {
+        } else if (OB_FAIL(imms_heap_->build())) {
+          SQL_ENG_LOG(WARN, "build merge tree failed", K(ret));
         } else if (pd_topn_filter_.enabled()
             && OB_FAIL(pd_topn_filter_.update_filter_data(*imms_heap_->top(), sk_row_meta_))) {
           LOG_WARN("failed to update filter data", K(ret));
@@ -1806,6 +1808,9 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::build_ems_heap(int64_t &merg
           chunk = chunk->get_next();
         }
       }
+      if (OB_SUCC(ret) && OB_FAIL(ems_heap_->build())) {
+        SQL_ENG_LOG(WARN, "build merge tree failed", K(ret));
+      }
     }
   }
   if (OB_SUCC(ret)) {
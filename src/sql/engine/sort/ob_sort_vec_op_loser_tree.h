@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_SORT_SORT_VEC_OP_LOSER_TREE_H_
+#define OCEANBASE_SQL_ENGINE_SORT_SORT_VEC_OP_LOSER_TREE_H_
+
+#include "lib/container/ob_se_array.h"
+#include "lib/oblog/ob_log_module.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Loser tree for k-way merge of sorted runs, it has the same interface of common::ObBinaryHeap
+// used by ObSortVecOpImpl, except that all runs are pushed first and `build()` must be called
+// before fetching from the tree.
+//
+// `CompareFunctor` is the comparator of ObBinaryHeap, `cmp(l, r)` returns true if `r` should be
+// output before `l`. Replacing the top replays one path from leaf to root, which costs log2(k)
+// comparisons, while sift down of binary heap costs up to 2 * log2(k).
+//
+// nodes_[0] is the winner, nodes_[1, k) are losers of inner matches, children of node `n`
+// are node `2n` and node `2n + 1`, and player `i` is the leaf `k + i`.
+template <typename T, typename CompareFunctor, int64_t LOCAL_ARRAY_SIZE = 16>
+class ObSortVecOpLoserTree
+{
+public:
+  ObSortVecOpLoserTree(CompareFunctor &cmp, common::ObIAllocator *allocator = NULL)
+    : players_(OB_MALLOC_NORMAL_BLOCK_SIZE, get_page_allocator(allocator)),
+      is_end_(OB_MALLOC_NORMAL_BLOCK_SIZE, get_page_allocator(allocator)),
+      nodes_(OB_MALLOC_NORMAL_BLOCK_SIZE, get_page_allocator(allocator)),
+      winners_(OB_MALLOC_NORMAL_BLOCK_SIZE, get_page_allocator(allocator)),
+      active_cnt_(0), is_built_(false), cmp_(cmp)
+  {
+    STATIC_ASSERT(std::is_trivially_copyable<T>::value, "class is not supported");
+  }
+  ~ObSortVecOpLoserTree() {}
+
+  int push(const T &player)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_FAIL(players_.push_back(player))) {
+      SQL_ENG_LOG(WARN, "push back player failed", K(ret));
+    } else if (OB_FAIL(is_end_.push_back(false))) {
+      SQL_ENG_LOG(WARN, "push back player state failed", K(ret));
+    } else {
+      active_cnt_++;
+      is_built_ = false;
+    }
+    return ret;
+  }
+
+  int build()
+  {
+    int ret = OB_SUCCESS;
+    const int64_t player_cnt = players_.count();
+    nodes_.reuse();
+    winners_.reuse();
+    if (0 == player_cnt) {
+      // all runs are empty, nothing to merge
+    } else if (OB_FAIL(nodes_.prepare_allocate(player_cnt))) {
+      SQL_ENG_LOG(WARN, "prepare allocate failed", K(ret), K(player_cnt));
+    } else if (OB_FAIL(winners_.prepare_allocate(player_cnt * 2))) {
+      SQL_ENG_LOG(WARN, "prepare allocate failed", K(ret), K(player_cnt));
+    } else {
+      for (int64_t i = 0; i < player_cnt; i++) {
+        winners_.at(player_cnt + i) = i;
+      }
+      for (int64_t n = player_cnt - 1; n > 0; n--) {
+        const int64_t l = winners_.at(2 * n);
+        const int64_t r = winners_.at(2 * n + 1);
+        if (less(r, l)) {
+          winners_.at(n) = r;
+          nodes_.at(n) = l;
+        } else {
+          winners_.at(n) = l;
+          nodes_.at(n) = r;
+        }
+      }
+      nodes_.at(0) = (1 == player_cnt ? 0 : winners_.at(1));
+      ret = cmp_.get_error_code();
+    }
+    if (OB_SUCC(ret)) {
+      is_built_ = true;
+    }
+    return ret;
+  }
+
+  T &top()
+  {
+    OB_ASSERT(is_built_ && !empty());
+    return players_.at(nodes_.at(0));
+  }
+
+  int replace_top(const T &player)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_UNLIKELY(!is_built_)) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_ENG_LOG(WARN, "loser tree is not built", K(ret));
+    } else if (OB_UNLIKELY(empty())) {
+      ret = OB_EMPTY_RESULT;
+      SQL_ENG_LOG(WARN, "loser tree is empty", K(ret));
+    } else {
+      const int64_t winner = nodes_.at(0);
+      players_.at(winner) = player;
+      ret = replay(winner);
+    }
+    return ret;
+  }
+
+  int pop()
+  {
+    int ret = OB_SUCCESS;
+    if (OB_UNLIKELY(!is_built_)) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_ENG_LOG(WARN, "loser tree is not built", K(ret));
+    } else if (OB_UNLIKELY(empty())) {
+      ret = OB_EMPTY_RESULT;
+      SQL_ENG_LOG(WARN, "loser tree is empty", K(ret));
+    } else {
+      const int64_t winner = nodes_.at(0);
+      is_end_.at(winner) = true;
+      active_cnt_--;
+      ret = replay(winner);
+    }
+    return ret;
+  }
+
+  bool empty() const { return 0 == active_cnt_; }
+  int64_t count() const { return active_cnt_; }
+  void reset()
+  {
+    players_.reset();
+    is_end_.reset();
+    nodes_.reset();
+    winners_.reset();
+    active_cnt_ = 0;
+    is_built_ = false;
+  }
+  TO_STRING_KV(K_(active_cnt), K_(is_built), "player_cnt", players_.count());
+
+private:
+  static common::ModulePageAllocator get_page_allocator(common::ObIAllocator *allocator)
+  {
+    return NULL == allocator ? common::ModulePageAllocator(common::ObModIds::OB_SE_ARRAY)
+                             : common::ModulePageAllocator(*allocator, common::ObModIds::OB_SE_ARRAY);
+  }
+  // whether player `l` should be output strictly before player `r`,
+  // finished players are output after all others.
+  OB_INLINE bool less(const int64_t l, const int64_t r)
+  {
+    return !is_end_.at(l) && (is_end_.at(r) || cmp_(players_.at(r), players_.at(l)));
+  }
+  OB_INLINE int replay(const int64_t player)
+  {
+    int64_t winner = player;
+    for (int64_t n = (players_.count() + player) >> 1; n > 0; n >>= 1) {
+      if (less(nodes_.at(n), winner)) {
+        std::swap(nodes_.at(n), winner);
+      }
+    }
+    nodes_.at(0) = winner;
+    return cmp_.get_error_code();
+  }
+
+private:
+  common::ObSEArray<T, LOCAL_ARRAY_SIZE> players_;
+  common::ObSEArray<bool, LOCAL_ARRAY_SIZE> is_end_;
+  common::ObSEArray<int64_t, LOCAL_ARRAY_SIZE> nodes_;
+  // winners of inner matches, only used during build
+  common::ObSEArray<int64_t, LOCAL_ARRAY_SIZE> winners_;
+  int64_t active_cnt_;
+  // players pushed after build are not in the tree, so fetching needs a rebuild
+  bool is_built_;
+  CompareFunctor &cmp_;
+  DISALLOW_COPY_AND_ASSIGN(ObSortVecOpLoserTree);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_SQL_ENGINE_SORT_SORT_VEC_OP_LOSER_TREE_H_ */
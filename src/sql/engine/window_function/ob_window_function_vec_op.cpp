@@ -2189,6 +2189,8 @@ int ObWindowFunctionVecOp::compute_wf_values(WinFuncColExpr *end, int64_t &check
       winfunc::AggrExpr *agg_expr = static_cast<winfunc::AggrExpr *>(it->wf_expr_);
       agg_expr->last_valid_frame_.reset();
       agg_expr->last_aggr_row_ = nullptr;
+      // segment tree is allocated by `win_expr_ctx`, only valid for current partition
+      agg_expr->seg_tree_.reset();
     }
     while (OB_SUCC(ret) && total_size > 0) {
       clear_evaluated_flag();
@@ -111,7 +111,11 @@ int WinExprWrapper<Derived>::process_partition(WinExprEvalCtx &ctx, const int64_
             }
           } else if (whole_frame) {
             ctx.win_col_.agg_ctx_->removal_info_.reset_for_new_frame();
-            if (OB_FAIL(static_cast<Derived *>(this)->process_window(ctx, cur_frame, row_idx, agg_row, is_null))) {
+            if (agg_expr->use_segment_tree(ctx, cur_frame)) {
+              if (OB_FAIL(agg_expr->segment_tree_process_window(ctx, cur_frame, row_idx, agg_row))) {
+                LOG_WARN("eval aggregate function by segment tree failed", K(ret));
+              }
+            } else if (OB_FAIL(static_cast<Derived *>(this)->process_window(ctx, cur_frame, row_idx, agg_row, is_null))) {
               LOG_WARN("eval aggregate function failed", K(ret));
             }
           } else if (OB_FAIL(static_cast<Derived *>(this)->accum_process_window(
@@ -1235,6 +1239,183 @@ int AggrExpr::calc_pushdown_skips(WinExprEvalCtx &ctx, const int64_t batch_size,
   return ret;
 }
 
+bool AggrExpr::use_segment_tree(WinExprEvalCtx &ctx, const Frame &frame) const
+{
+  const ObWindowFunctionVecSpec &spec = static_cast<const ObWindowFunctionVecSpec &>(ctx.win_col_.op_.get_spec());
+  const WinFuncInfo &wf_info = ctx.win_col_.wf_info_;
+  // aggregates of REMOVE_STATISTICS are evaluated incrementally by removing rows already, segment
+  // tree is used for min/max and sum of float/double, which restart aggregation whenever
+  // the frame slides. If frame head is unbounded, no row slides out and no need to build tree.
+  return (T_FUN_MIN == wf_info.func_type_ || T_FUN_MAX == wf_info.func_type_
+          || T_FUN_SUM == wf_info.func_type_)
+         && common::REMOVE_STATISTICS != wf_info.remove_type_
+         && !wf_info.aggr_info_.has_distinct_
+         && !wf_info.upper_.is_unbounded_
+         && !spec.single_part_parallel_
+         && !spec.is_push_down()
+         && frame.tail_ - frame.head_ >= SegmentTree::MIN_FRAME_SIZE;
+}
+
+int AggrExpr::segment_tree_process_window(WinExprEvalCtx &ctx, const Frame &frame,
+                                          const int64_t row_idx, char *agg_row)
+{
+  int ret = OB_SUCCESS;
+  aggregate::RuntimeContext &agg_ctx = *ctx.win_col_.agg_ctx_;
+  aggregate::RemovalInfo &removal_info = agg_ctx.removal_info_;
+  aggregate::IAggregate *iagg = aggr_processor_->get_aggregates().at(0);
+  const bool enable_removal_opt = removal_info.enable_removal_opt_;
+  const int64_t leaf_size = SegmentTree::LEAF_SIZE;
+  bool is_null = false;
+  // rows are only added to tree nodes and result, disable removal optimization to make
+  // aggregates maintain not null flags by themselves.
+  removal_info.enable_removal_opt_ = false;
+  if (nullptr == seg_tree_.nodes_ && OB_FAIL(build_segment_tree(ctx))) {
+    LOG_WARN("build segment tree failed", K(ret));
+  } else {
+    // leaves in [first_leaf, end_leaf) are covered by frame entirely, the rest rows of frame
+    // are aggregated directly.
+    const int64_t part_start = seg_tree_.part_start_;
+    const int64_t first_leaf = (frame.head_ - part_start + leaf_size - 1) / leaf_size;
+    const int64_t end_leaf = (frame.tail_ - part_start) / leaf_size;
+    Frame head_frame(frame.head_, part_start + first_leaf * leaf_size);
+    Frame tail_frame(part_start + end_leaf * leaf_size, frame.tail_);
+    LOG_DEBUG("segment tree process window", K(frame), K(first_leaf), K(end_leaf), K(seg_tree_));
+    if (first_leaf >= end_leaf) {
+      if (OB_FAIL(process_window(ctx, frame, row_idx, agg_row, is_null))) {
+        LOG_WARN("process window failed", K(ret));
+      }
+    } else if (!head_frame.is_empty()
+               && OB_FAIL(process_window(ctx, head_frame, row_idx, agg_row, is_null))) {
+      LOG_WARN("process window failed", K(ret), K(head_frame));
+    } else if (!tail_frame.is_empty()
+               && OB_FAIL(process_window(ctx, tail_frame, row_idx, agg_row, is_null))) {
+      LOG_WARN("process window failed", K(ret), K(tail_frame));
+    } else {
+      int64_t l = first_leaf + seg_tree_.leaf_cnt_;
+      int64_t r = end_leaf + seg_tree_.leaf_cnt_;
+      for (; OB_SUCC(ret) && l < r; l >>= 1, r >>= 1) {
+        if ((l & 1) && OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, seg_tree_.nodes_[l], agg_row, 0))) {
+          LOG_WARN("rollup aggregation failed", K(ret), K(l));
+        } else if ((r & 1)
+                   && OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, seg_tree_.nodes_[r - 1], agg_row, 0))) {
+          LOG_WARN("rollup aggregation failed", K(ret), K(r));
+        } else {
+          l += (l & 1);
+          r -= (r & 1);
+        }
+      }
+    }
+  }
+  removal_info.enable_removal_opt_ = enable_removal_opt;
+  // removal info does not describe the result, aggregation of next frame must be restarted
+  removal_info.reset_for_new_frame();
+  return ret;
+}
+
+int AggrExpr::build_segment_tree(WinExprEvalCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  ObWindowFunctionVecOp &op = ctx.win_col_.op_;
+  ObEvalCtx &eval_ctx = op.get_eval_ctx();
+  const RowMeta &input_row_meta = op.get_input_row_meta();
+  ObBitVector &eval_skip = *op.get_batch_ctx().bound_eval_skip_;
+  aggregate::RuntimeContext &agg_ctx = *ctx.win_col_.agg_ctx_;
+  aggregate::IAggregate *iagg = aggr_processor_->get_aggregates().at(0);
+  const int32_t row_size = agg_ctx.row_meta().row_size_;
+  const int64_t part_start = ctx.win_col_.part_first_row_idx_;
+  const int64_t part_end = op.get_part_end_idx();
+  const int64_t leaf_size = SegmentTree::LEAF_SIZE;
+  const int64_t leaf_cnt = (part_end - part_start + leaf_size - 1) / leaf_size;
+  char **nodes = nullptr;
+  char *rows_buf = nullptr;
+  ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx);
+  ObBatchRows tmp_brs;
+  seg_tree_.reset();
+  if (OB_UNLIKELY(leaf_cnt <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected empty partition", K(ret), K(part_start), K(part_end));
+  } else if (OB_ISNULL(nodes = reinterpret_cast<char **>(ctx.reserved_buf(sizeof(char *) * leaf_cnt * 2)))
+             || OB_ISNULL(rows_buf = ctx.reserved_buf(row_size * leaf_cnt * 2))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(leaf_cnt), K(row_size));
+  } else {
+    nodes[0] = nullptr; // not used
+    for (int64_t i = 1; OB_SUCC(ret) && i < leaf_cnt * 2; i++) {
+      nodes[i] = rows_buf + row_size * i;
+      if (OB_FAIL(aggr_processor_->add_one_aggregate_row(nodes[i], row_size, false))) {
+        LOG_WARN("setup aggregate row failed", K(ret));
+      }
+    }
+  }
+  // step.1: aggregate leaves, rows of one batch are split by leaf bounds
+  for (int64_t row_start = part_start; OB_SUCC(ret) && row_start < part_end;) {
+    int64_t batch_size = std::min(part_end - row_start, op.get_spec().max_batch_size_);
+    op.clear_evaluated_flag();
+    guard.set_batch_size(batch_size);
+    tmp_brs.size_ = batch_size;
+    tmp_brs.end_ = false;
+    tmp_brs.skip_ = &eval_skip;
+    if (OB_FAIL(ctx.input_rows_.attach_rows(op.get_all_expr(), input_row_meta, eval_ctx, row_start,
+                                            row_start + batch_size, false))) {
+      LOG_WARN("attach rows failed", K(ret));
+    } else if (OB_FAIL(calc_pushdown_skips(ctx, batch_size, eval_skip, tmp_brs.all_rows_active_))) {
+      LOG_WARN("calc pushdown skips failed", K(ret));
+    } else if (OB_FAIL(aggr_processor_->eval_aggr_param_batch(tmp_brs))) {
+      LOG_WARN("eval aggr params failed", K(ret));
+    }
+    for (int64_t begin = 0, end = 0; OB_SUCC(ret) && begin < batch_size; begin = end) {
+      int64_t leaf_idx = (row_start + begin - part_start) / leaf_size;
+      char *leaf_row = nodes[leaf_cnt + leaf_idx];
+      end = std::min(batch_size, part_start + (leaf_idx + 1) * leaf_size - row_start);
+      if (OB_FAIL(aggr_processor_->add_batch_rows(0, 1, leaf_row, tmp_brs, (uint16_t)begin,
+                                                  (uint16_t)end))) {
+        LOG_WARN("add batch rows failed", K(ret));
+      } else if (OB_FAIL(save_var_len_result(ctx, leaf_row))) {
+        LOG_WARN("save variable-length result failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_start += batch_size;
+    }
+  }
+  // step.2: rollup inner nodes bottom up
+  for (int64_t i = leaf_cnt - 1; OB_SUCC(ret) && i > 0; i--) {
+    if (OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, nodes[2 * i], nodes[i], 0))) {
+      LOG_WARN("rollup aggregation failed", K(ret), K(i));
+    } else if (OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, nodes[2 * i + 1], nodes[i], 0))) {
+      LOG_WARN("rollup aggregation failed", K(ret), K(i));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    seg_tree_.part_start_ = part_start;
+    seg_tree_.leaf_cnt_ = leaf_cnt;
+    seg_tree_.nodes_ = nodes;
+    LOG_TRACE("segment tree built", K(seg_tree_), K(part_end), K(row_size));
+  }
+  return ret;
+}
+
+int AggrExpr::save_var_len_result(WinExprEvalCtx &ctx, char *agg_row)
+{
+  int ret = OB_SUCCESS;
+  const aggregate::AggrRowMeta &row_meta = ctx.win_col_.agg_ctx_->row_meta();
+  // address stored in agg_row is invalid after next `attach_rows`, copy result out
+  if (row_meta.is_var_len(0) && row_meta.locate_notnulls_bitmap(agg_row).at(0)) {
+    int64_t &addr_val = *reinterpret_cast<int64_t *>(row_meta.locate_cell_payload(0, agg_row));
+    int32_t val_len = row_meta.get_cell_len(0, agg_row);
+    char *res_buf = nullptr;
+    if (val_len <= 0) {
+    } else if (OB_ISNULL(res_buf = ctx.reserved_buf(val_len))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(val_len));
+    } else {
+      MEMCPY(res_buf, reinterpret_cast<const char *>(addr_val), val_len);
+      addr_val = reinterpret_cast<int64_t>(res_buf);
+    }
+  }
+  return ret;
+}
+
 int AggrExpr::accum_process_window(WinExprEvalCtx &ctx, const Frame &cur_frame,
                                    const Frame &prev_frame, const int64_t row_idx, char *agg_row,
                                    bool &is_null)
@@ -298,7 +298,29 @@ public:
 class AggrExpr final: public WinExprWrapper<AggrExpr>
 {
 public:
-  AggrExpr(): aggr_processor_(nullptr), last_valid_frame_(), last_aggr_row_(nullptr) {}
+  // Segment tree over aggregate rows of current partition, used to evaluate sliding frames of
+  // aggregates which can't remove rows, e.g. min/max. Each leaf aggregates LEAF_SIZE consecutive
+  // rows, node `i` is the rollup of node `2i` and node `2i + 1`. A frame is aggregated by at most
+  // two partial leaves plus O(log n) nodes, instead of restarting aggregation of the whole frame.
+  struct SegmentTree
+  {
+    static const int64_t LEAF_SIZE = 16;
+    // smaller frames are cheaper to be aggregated row by row
+    static const int64_t MIN_FRAME_SIZE = 4 * LEAF_SIZE;
+    SegmentTree(): part_start_(-1), leaf_cnt_(0), nodes_(nullptr) {}
+    void reset()
+    {
+      part_start_ = -1;
+      leaf_cnt_ = 0;
+      nodes_ = nullptr;
+    }
+    TO_STRING_KV(K_(part_start), K_(leaf_cnt));
+    int64_t part_start_;
+    int64_t leaf_cnt_;
+    char **nodes_; // allocated by WinExprEvalCtx::allocator_, valid during partition process
+  };
+public:
+  AggrExpr(): aggr_processor_(nullptr), last_valid_frame_(), last_aggr_row_(nullptr), seg_tree_() {}
   int process_window(WinExprEvalCtx &ctx, const Frame &frame, const int64_t row_idx,
                      char *res, bool &is_null) override;
 
@@ -314,11 +336,19 @@ public:
 
   static int set_result_for_invalid_frame(WinExprEvalCtx &ctx, char *agg_row);
 
+  bool use_segment_tree(WinExprEvalCtx &ctx, const Frame &frame) const;
+  int segment_tree_process_window(WinExprEvalCtx &ctx, const Frame &frame, const int64_t row_idx,
+                                  char *agg_row);
+
   virtual void destroy() override;
 
 private:
   int calc_pushdown_skips(WinExprEvalCtx &ctx, const int64_t batch_size, sql::ObBitVector &skip, bool &all_active);
 
+  int build_segment_tree(WinExprEvalCtx &ctx);
+
+  int save_var_len_result(WinExprEvalCtx &ctx, char *agg_row);
+
   template <typename ColumnFmt>
   int set_payload(WinExprEvalCtx &ctx, ColumnFmt *columns, const int64_t idx,
                   const char *payload, int32_t len);
@@ -328,6 +358,7 @@ public:
   Frame last_valid_frame_;
   aggregate::RemovalInfo last_removal_info_;
   char *last_aggr_row_;
+  SegmentTree seg_tree_;
 };
 
 } // end winfunc
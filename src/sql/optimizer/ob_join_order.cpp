@@ -3027,6 +3027,8 @@ int ObJoinOrder::get_valid_index_ids(const uint64_t table_id,
   bool has_aggr = false; // defend aggr for ann search
   bool is_vec_index_hint = false;
   bool vector_index_match = false;
+  ObVecIdxQueryStrategy vec_query_strategy = OB_VEC_POST_FILTER;
+  double vec_filter_sel = 1.0;
   if (OB_ISNULL(get_plan()) ||
       OB_ISNULL(stmt = get_plan()->get_stmt()) ||
       OB_ISNULL(schema_guard = OPT_CTX.get_sql_schema_guard()) ||
@@ -3059,7 +3061,15 @@ int ObJoinOrder::get_valid_index_ids(const uint64_t table_id,
              && OB_NOT_NULL(vector_expr = stmt->get_first_vector_expr())
              && OB_FAIL(get_vector_inv_index_tid(schema_guard, vector_expr, table_id, ref_table_id, has_aggr, vector_index_match, valid_index_ids))) {
     LOG_WARN("failed to get matched vector index table id", K(ret));
-  } else if (vector_index_match) {
+  } else if (vector_index_match &&
+             OB_FAIL(get_vec_index_query_strategy(valid_index_ids.at(0),
+                                                  vec_query_strategy,
+                                                  vec_filter_sel))) {
+    LOG_WARN("failed to get vector index query strategy", K(ret));
+  } else if (vector_index_match && OB_VEC_BRUTE_FORCE == vec_query_strategy &&
+             OB_FALSE_IT(valid_index_ids.reuse())) {
+    // the filters are selective enough, scan the filtered rows and sort them by exact distance
+  } else if (vector_index_match && OB_VEC_BRUTE_FORCE != vec_query_strategy) {
     // defence weak read
     bool is_weak_read = false;
     if (!MTL_TENANT_ROLE_CACHE_IS_PRIMARY_OR_INVALID()) {
@@ -16461,6 +16471,93 @@ int ObJoinOrder::get_vector_inv_index_tid(ObSqlSchemaGuard *schema_guard,
   return ret;
 }
 
+// choose how the filters on the base table are applied for an approximate vector query, the
+// plan without vector index is used for very selective filters.
+int ObJoinOrder::get_vec_index_query_strategy(const uint64_t vec_index_tid,
+                                              ObVecIdxQueryStrategy &strategy,
+                                              double &selectivity)
+{
+  int ret = OB_SUCCESS;
+  const ObDMLStmt *stmt = NULL;
+  ObSqlSchemaGuard *schema_guard = NULL;
+  ObSQLSessionInfo *session_info = NULL;
+  const ObTableSchema *index_schema = NULL;
+  int64_t limit = 0;
+  int64_t offset = 0;
+  int64_t dim = 0;
+  uint64_t ef_search = 0;
+  bool is_null_value = false;
+  double cost = 0.0;
+  ObSEArray<ObRawExpr *, 4> filters;
+  ObRawExpr *threshold_filter = NULL;
+  ObRawExpr *threshold_expr = NULL;
+  strategy = OB_VEC_POST_FILTER;
+  selectivity = 1.0;
+  if (OB_ISNULL(get_plan()) ||
+      OB_ISNULL(stmt = get_plan()->get_stmt()) ||
+      OB_ISNULL(schema_guard = OPT_CTX.get_sql_schema_guard()) ||
+      OB_ISNULL(session_info = OPT_CTX.get_session_info())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get unexpected null", K(get_plan()), K(stmt), K(schema_guard), K(session_info), K(ret));
+  } else if (OB_FAIL(filters.assign(get_restrict_infos()))) {
+    LOG_WARN("failed to assign filters", K(ret));
+  } else if (NULL != stmt->get_first_vector_expr() &&
+             OB_FAIL(ObOptimizerUtil::get_vector_distance_threshold(stmt->get_first_vector_expr(),
+                                                                    get_restrict_infos(),
+                                                                    threshold_filter,
+                                                                    threshold_expr))) {
+    LOG_WARN("failed to get vector distance threshold", K(ret));
+  } else if (NULL != threshold_filter && OB_FAIL(ObOptimizerUtil::remove_item(filters, threshold_filter))) {
+    LOG_WARN("failed to remove distance threshold filter", K(ret));
+  } else if (filters.empty() || NULL == stmt->get_limit_expr()) {
+    // no filter to apply, or no top-k to enlarge. the distance threshold is applied by a range
+    // search of the index, not after lookup
+  } else if (OB_FAIL(ObOptSelectivity::calculate_selectivity(get_plan()->get_basic_table_metas(),
+                                                             get_plan()->get_selectivity_ctx(),
+                                                             filters,
+                                                             selectivity,
+                                                             get_plan()->get_predicate_selectivities()))) {
+    LOG_WARN("failed to calculate selectivity", K(ret));
+  } else if (OB_FAIL(ObTransformUtils::get_limit_value(stmt->get_limit_expr(),
+                                                       OPT_CTX.get_params(),
+                                                       OPT_CTX.get_exec_ctx(),
+                                                       &OPT_CTX.get_allocator(),
+                                                       limit,
+                                                       is_null_value))) {
+    LOG_WARN("failed to get limit value", K(ret));
+  } else if (!is_null_value &&
+             OB_FAIL(ObTransformUtils::get_limit_value(stmt->get_offset_expr(),
+                                                       OPT_CTX.get_params(),
+                                                       OPT_CTX.get_exec_ctx(),
+                                                       &OPT_CTX.get_allocator(),
+                                                       offset,
+                                                       is_null_value))) {
+    LOG_WARN("failed to get offset value", K(ret));
+  } else if (OB_FAIL(schema_guard->get_table_schema(vec_index_tid, index_schema))) {
+    LOG_WARN("failed to get vector index schema", K(ret), K(vec_index_tid));
+  } else if (OB_ISNULL(index_schema)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected null vector index schema", K(ret), K(vec_index_tid));
+  } else if (OB_FAIL(ObVectorIndexUtil::get_vector_index_column_dim(*index_schema, dim))) {
+    LOG_WARN("failed to get vector index dim", K(ret));
+  } else if (OB_FAIL(session_info->get_ob_hnsw_ef_search(ef_search))) {
+    LOG_WARN("failed to get ob_hnsw_ef_search", K(ret));
+  } else if (OB_FAIL(ObOptEstCost::cost_vec_index_query(table_meta_info_.table_row_count_,
+                                                        selectivity,
+                                                        limit + offset,
+                                                        dim,
+                                                        static_cast<int64_t>(ef_search),
+                                                        strategy,
+                                                        cost,
+                                                        OPT_CTX))) {
+    LOG_WARN("failed to est cost for vector index query", K(ret));
+  } else {
+    LOG_TRACE("succeed to choose vector index query strategy", K(strategy), K(selectivity),
+              K(limit), K(offset), K(dim), K(ef_search), K(cost));
+  }
+  return ret;
+}
+
 int ObJoinOrder::get_matched_inv_index_tid(ObMatchFunRawExpr *match_expr,
                                            uint64_t ref_table_id,
                                            uint64_t &inv_idx_tid)
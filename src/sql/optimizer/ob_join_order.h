@@ -1355,6 +1355,10 @@ struct NullAwareAntiJoinInfo {
                                  bool &vector_index_match,
                                  ObIArray<uint64_t> &valid_index_ids);
 
+    int get_vec_index_query_strategy(const uint64_t vec_index_tid,
+                                     ObVecIdxQueryStrategy &strategy,
+                                     double &selectivity);
+
     inline ObTablePartitionInfo *get_table_partition_info() { return table_partition_info_; }
 
     int param_funct_table_expr(ObRawExpr* &function_table_expr,
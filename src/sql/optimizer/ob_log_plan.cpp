@@ -2900,7 +2900,7 @@ int ObLogPlan::allocate_access_path(AccessPath *ap,
                  OB_FAIL(prepare_multivalue_retrieval_scan(scan))) {
         LOG_WARN("failed to prepare multivalue doc_rowkey ", K(ret));
       } else if (ap->est_cost_info_.index_meta_info_.is_vector_index_ && get_stmt()->has_vec_approx() &&
-                 OB_FAIL(prepare_vector_index_info(scan))) {
+                 OB_FAIL(prepare_vector_index_info(scan, *ap))) {
         LOG_WARN("failed to prepare multivalue doc_rowkey ", K(ret));
       }
     }
@@ -14063,7 +14063,7 @@ int ObLogPlan::prepare_text_retrieval_scan(const ObIArray<ObRawExpr *> &exprs, O
   return ret;
 }
 
-int ObLogPlan::prepare_vector_index_info(ObLogicalOperator *scan)
+int ObLogPlan::prepare_vector_index_info(ObLogicalOperator *scan, const AccessPath &ap)
 {
   int ret = OB_SUCCESS;
   ObLogTableScan *table_scan = static_cast<ObLogTableScan*>(scan);
@@ -14149,12 +14149,55 @@ int ObLogPlan::prepare_vector_index_info(ObLogicalOperator *scan)
         vc_info.topk_offset_expr_ = stmt->get_offset_expr();
         table_scan->set_doc_id_index_table_id(vec_id_rowkey_tid);
         table_scan->set_index_back(true);
+        if (OB_ISNULL(ap.parent_)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("unexpected null join order", K(ret));
+        } else if (OB_FAIL(ap.parent_->get_vec_index_query_strategy(ap.index_id_,
+                                                                   vc_info.query_strategy_,
+                                                                   vc_info.selectivity_))) {
+          LOG_WARN("failed to get vector index query strategy", K(ret));
+        } else if (OB_FAIL(prepare_vector_distance_threshold(*table_scan, vc_info))) {
+          LOG_WARN("failed to prepare vector distance threshold", K(ret));
+        }
       }
     }
   }
   return ret;
 }
 
+// a filter bounding the distance of the sort key lets the index be searched by range, the bound is
+// cast to double to be read by the vector index lookup. the filter is kept, so the rows are exact.
+int ObLogPlan::prepare_vector_distance_threshold(ObLogTableScan &table_scan, ObVectorIndexInfo &vc_info)
+{
+  int ret = OB_SUCCESS;
+  ObRawExpr *threshold_filter = NULL;
+  ObRawExpr *threshold_expr = NULL;
+  ObRawExpr *threshold_with_cast = NULL;
+  ObExprResType res_type;
+  res_type.set_double();
+  res_type.set_precision(ObAccuracy::DDL_DEFAULT_ACCURACY[ObDoubleType].precision_);
+  res_type.set_scale(ObAccuracy::DDL_DEFAULT_ACCURACY[ObDoubleType].scale_);
+  vc_info.distance_threshold_expr_ = NULL;
+  if (OB_FAIL(ObOptimizerUtil::get_vector_distance_threshold(vc_info.sort_key_.expr_,
+                                                             table_scan.get_filter_exprs(),
+                                                             threshold_filter,
+                                                             threshold_expr))) {
+    LOG_WARN("failed to get vector distance threshold", K(ret));
+  } else if (NULL == threshold_expr) {
+    // do nothing
+  } else if (OB_FAIL(ObRawExprUtils::try_add_cast_expr_above(&get_optimizer_context().get_expr_factory(),
+                                                             get_optimizer_context().get_session_info(),
+                                                             *threshold_expr,
+                                                             res_type,
+                                                             threshold_with_cast))) {
+    LOG_WARN("failed to add cast expr above distance threshold", K(ret));
+  } else {
+    vc_info.distance_threshold_expr_ = threshold_with_cast;
+    LOG_TRACE("vector index is searched by range", KPC(threshold_filter), KPC(threshold_with_cast));
+  }
+  return ret;
+}
+
 int ObLogPlan::prepare_multivalue_retrieval_scan(ObLogicalOperator *scan)
 {
   int ret = OB_SUCCESS;
@@ -57,6 +57,7 @@ namespace sql
 {
 class ObLogicalOperator;
 class ObLogTableScan;
+struct ObVectorIndexInfo;
 class ObLogDelUpd;
 class AllocExchContext;
 class ObJoinOrder;
@@ -1428,7 +1429,8 @@ public:
 
   int construct_startup_filter_for_limit(ObRawExpr *limit_expr, ObLogicalOperator *log_op);
 
-  int prepare_vector_index_info(ObLogicalOperator *scan);
+  int prepare_vector_index_info(ObLogicalOperator *scan, const AccessPath &ap);
+  int prepare_vector_distance_threshold(ObLogTableScan &table_scan, ObVectorIndexInfo &vc_info);
   int prepare_text_retrieval_scan(const ObIArray<ObRawExpr*> &exprs, ObLogicalOperator *scan);
   int prepare_multivalue_retrieval_scan(ObLogicalOperator *scan);
   int try_push_topn_into_domain_scan(ObLogicalOperator *&top,
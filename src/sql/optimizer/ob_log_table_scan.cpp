@@ -2488,6 +2488,9 @@ int ObLogTableScan::get_vec_idx_calc_exprs(ObIArray<ObRawExpr *> &all_exprs)
   } else if (OB_NOT_NULL(vec_info.topk_offset_expr_) &&
              OB_FAIL(all_exprs.push_back(vec_info.topk_offset_expr_))) {
     LOG_WARN("failed to append offset expr", K(ret));
+  } else if (OB_NOT_NULL(vec_info.distance_threshold_expr_) &&
+             OB_FAIL(all_exprs.push_back(vec_info.distance_threshold_expr_))) {
+    LOG_WARN("failed to append distance threshold expr", K(ret));
   }
   return ret;
 }
@@ -115,7 +115,10 @@ struct ObVectorIndexInfo
     delta_buffer_tid_(OB_INVALID_ID),
     index_id_tid_(OB_INVALID_ID),
     index_snapshot_data_tid_(OB_INVALID_ID),
-    main_table_tid_(OB_INVALID_ID)
+    main_table_tid_(OB_INVALID_ID),
+    query_strategy_(OB_VEC_POST_FILTER),
+    selectivity_(1.0),
+    distance_threshold_expr_(nullptr)
   { }
   ~ObVectorIndexInfo() {}
 
@@ -125,7 +128,8 @@ struct ObVectorIndexInfo
               KPC_(index_id_type_column), KPC_(index_id_vector_column),
               KPC_(snapshot_key_column), KPC_(snapshot_data_column),
               K_(delta_buffer_tid), K_(index_id_tid), K_(index_snapshot_data_tid),
-              K_(main_table_tid));
+              K_(main_table_tid), K_(query_strategy), K_(selectivity),
+              KPC_(distance_threshold_expr));
   bool need_sort() const { return sort_key_.expr_ != nullptr; }
 
   // topn infos
@@ -153,6 +157,11 @@ struct ObVectorIndexInfo
   uint64_t index_id_tid_;
   uint64_t index_snapshot_data_tid_;
   uint64_t main_table_tid_;
+  // how the filters on the main table are applied, and their selectivity
+  ObVecIdxQueryStrategy query_strategy_;
+  double selectivity_;
+  // upper bound of the sort key given by a filter, the index is then searched by range
+  ObRawExpr *distance_threshold_expr_;
 };
 
 class ObLogTableScan : public ObLogicalOperator
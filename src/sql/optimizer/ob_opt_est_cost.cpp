@@ -434,6 +434,29 @@ int ObOptEstCost::cost_window_function(double rows,
   return ret;
 }
 
+int ObOptEstCost::cost_vec_index_query(const double row_count,
+                                       const double selectivity,
+                                       const int64_t topk,
+                                       const int64_t dim,
+                                       const int64_t ef_search,
+                                       ObVecIdxQueryStrategy &strategy,
+                                       double &cost,
+                                       const ObOptimizerContext &opt_ctx)
+{
+  int ret = OB_SUCCESS;
+  GET_COST_MODEL();
+  if (OB_FAIL(model->cost_vec_index_query(row_count,
+                                          selectivity,
+                                          topk,
+                                          dim,
+                                          ef_search,
+                                          strategy,
+                                          cost))) {
+    LOG_WARN("failed to est cost for vector index query", K(ret));
+  }
+  return ret;
+}
+
 int ObOptEstCost::cost_insert(ObDelUpCostInfo& cost_info,
                               double &cost,
                               const ObOptimizerContext &opt_ctx)
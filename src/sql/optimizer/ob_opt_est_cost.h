@@ -189,6 +189,15 @@ public:
                                   double &cost,
                                   const ObOptimizerContext &opt_ctx);
 
+  static int cost_vec_index_query(const double row_count,
+                                  const double selectivity,
+                                  const int64_t topk,
+                                  const int64_t dim,
+                                  const int64_t ef_search,
+                                  ObVecIdxQueryStrategy &strategy,
+                                  double &cost,
+                                  const ObOptimizerContext &opt_ctx);
+
   static int cost_insert(ObDelUpCostInfo& cost_info,
                          double &cost,
                          const ObOptimizerContext &opt_ctx);
@@ -1997,6 +1997,68 @@ int ObOptEstCostModel::cost_window_function(double rows, double width, double wi
   return ret;
 }
 
+/**
+ * @brief     计算带过滤条件的向量近似查询的代价, 并选出代价最低的执行策略
+ * @formula   brute force : N * CPU_TUPLE_COST + N * sel * dim * CPU_OPERATOR_COST
+ *            in filter   : N * CPU_TUPLE_COST + N * sel * CPU_OPERATOR_COST
+ *                          + ef * log2(N) / sel * dim * CPU_OPERATOR_COST + k * FETCH_ROW_RND_COST
+ *            post filter : max(ef, k / sel) * log2(N) * dim * CPU_OPERATOR_COST
+ *                          + k / sel * FETCH_ROW_RND_COST
+ *            过滤后 hnsw 图上的有效点只剩 sel, 找到 ef 个有效点需要多访问 1 / sel 倍的点;
+ *            post filter 需要多取 k / sel 个结果才能在回表过滤后剩下 k 行, 超过查询上限时召回无法保证, 不选择
+ * @param[in] row_count   表的行数
+ * @param[in] selectivity 过滤条件的选择率
+ * @param[in] topk        limit + offset
+ * @param[in] dim         向量维度
+ * @param[in] ef_search   hnsw 查询的 ef_search
+ */
+int ObOptEstCostModel::cost_vec_index_query(const double row_count,
+                                            const double selectivity,
+                                            const int64_t topk,
+                                            const int64_t dim,
+                                            const int64_t ef_search,
+                                            ObVecIdxQueryStrategy &strategy,
+                                            double &cost)
+{
+  int ret = OB_SUCCESS;
+  // the executor does not fetch more results than this from the index
+  static const double VEC_POST_FILTER_MAX_FETCH = 16384;
+  if (OB_UNLIKELY(row_count < 0 || selectivity < 0 || topk < 0 || dim <= 0 || ef_search < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(row_count), K(selectivity), K(topk), K(dim), K(ef_search), K(ret));
+  } else {
+    const double sel = std::max(std::min(selectivity, 1.0), OB_DOUBLE_EPSINON);
+    const double rows = std::max(row_count, 1.0);
+    const double filtered_rows = rows * sel;
+    const double search_depth = std::max(LOG2(rows), 1.0);
+    const double ef = static_cast<double>(std::max(ef_search, topk));
+    const double dist_cost = dim * cost_params_.get_cpu_operator_cost(sys_stat_);
+    const double scan_cost = rows * cost_params_.get_cpu_tuple_cost(sys_stat_);
+    const double fetch_cost = cost_params_.get_fetch_row_rnd_cost(sys_stat_);
+    const double post_fetch_cnt = topk / sel;
+    double brute_force_cost = scan_cost + filtered_rows * dist_cost;
+    double in_filter_cost = scan_cost + filtered_rows * cost_params_.get_cpu_operator_cost(sys_stat_)
+                            + std::min(ef * search_depth / sel, rows) * dist_cost
+                            + topk * fetch_cost;
+    double post_filter_cost = std::max(ef, post_fetch_cnt) * search_depth * dist_cost
+                              + post_fetch_cnt * fetch_cost;
+    strategy = OB_VEC_BRUTE_FORCE;
+    cost = brute_force_cost;
+    if (in_filter_cost < cost) {
+      strategy = OB_VEC_IN_FILTER;
+      cost = in_filter_cost;
+    }
+    if (post_fetch_cnt <= VEC_POST_FILTER_MAX_FETCH && post_filter_cost < cost) {
+      strategy = OB_VEC_POST_FILTER;
+      cost = post_filter_cost;
+    }
+    LOG_TRACE("est cost for vector index query", K(row_count), K(selectivity), K(topk), K(dim),
+              K(ef_search), K(brute_force_cost), K(in_filter_cost), K(post_filter_cost),
+              K(strategy), K(cost));
+  }
+  return ret;
+}
+
 /**
  * @brief     计算filter的代价
  * @formula   cost = rows * CPU_TUPLE_COST + cost_quals
@@ -20,6 +20,7 @@
 #include "sql/optimizer/ob_opt_default_stat.h"
 #include "sql/resolver/dml/ob_dml_stmt.h"
 #include "share/stat/ob_opt_ds_stat.h"
+#include "sql/das/ob_das_define.h"
 
 namespace oceanbase
 {
@@ -787,6 +788,14 @@ public:
 
   int cost_window_function(double rows, double width, double win_func_cnt, double &cost);
 
+  int cost_vec_index_query(const double row_count,
+                           const double selectivity,
+                           const int64_t topk,
+                           const int64_t dim,
+                           const int64_t ef_search,
+                           ObVecIdxQueryStrategy &strategy,
+                           double &cost);
+
   int cost_insert(ObDelUpCostInfo& cost_info, double &cost);
 
   int cost_update(ObDelUpCostInfo& cost_info, double &cost);
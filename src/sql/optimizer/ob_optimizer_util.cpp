@@ -4595,6 +4595,48 @@ int ObOptimizerUtil::get_rownum_filter_info(ObRawExpr *rownum_expr,
   return ret;
 }
 
+int ObOptimizerUtil::get_vector_distance_threshold(const ObRawExpr *vector_expr,
+                                                   const ObIArray<ObRawExpr *> &filters,
+                                                   ObRawExpr *&threshold_filter,
+                                                   ObRawExpr *&threshold_expr)
+{
+  int ret = OB_SUCCESS;
+  threshold_filter = NULL;
+  threshold_expr = NULL;
+  if (OB_ISNULL(vector_expr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("expr is null", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && NULL == threshold_filter && i < filters.count(); ++i) {
+    ObRawExpr *filter = filters.at(i);
+    ObRawExpr *dist_param = NULL;
+    ObRawExpr *bound_param = NULL;
+    if (OB_ISNULL(filter)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("filter is null", K(ret));
+    } else if (!filter->is_op_expr() || 2 != filter->get_param_count()) {
+      // do nothing
+    } else if (T_OP_LT == filter->get_expr_type() || T_OP_LE == filter->get_expr_type()) {
+      dist_param = filter->get_param_expr(0);
+      bound_param = filter->get_param_expr(1);
+    } else if (T_OP_GT == filter->get_expr_type() || T_OP_GE == filter->get_expr_type()) {
+      dist_param = filter->get_param_expr(1);
+      bound_param = filter->get_param_expr(0);
+    }
+    if (OB_FAIL(ret) || NULL == dist_param) {
+    } else if (OB_ISNULL(bound_param)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null expr", K(ret), K(dist_param), K(bound_param));
+    } else if ((dist_param == vector_expr || dist_param->same_as(*vector_expr)) &&
+               bound_param->is_static_scalar_const_expr() &&
+               ob_is_numeric_type(bound_param->get_result_type().get_type())) {
+      threshold_filter = filter;
+      threshold_expr = bound_param;
+    }
+  }
+  return ret;
+}
+
 int ObOptimizerUtil::convert_rownum_filter_as_offset(ObRawExprFactory &expr_factory,
                                                      ObSQLSessionInfo *session_info,
                                                      const ObItemType filter_type,
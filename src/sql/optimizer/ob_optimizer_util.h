@@ -831,6 +831,13 @@ public:
                                     ObRawExpr *&const_expr,
                                     bool &is_const_filter);
 
+  // finds the filter bounding vector_expr from above by a const, like l2_distance(c, '[1,2]') < 0.5,
+  // threshold_filter and threshold_expr are null when there is none.
+  static int get_vector_distance_threshold(const ObRawExpr *vector_expr,
+                                           const ObIArray<ObRawExpr *> &filters,
+                                           ObRawExpr *&threshold_filter,
+                                           ObRawExpr *&threshold_expr);
+
   static int convert_rownum_filter_as_offset(ObRawExprFactory &expr_factory,
                                              ObSQLSessionInfo *session_info,
                                              const ObItemType filter_type,
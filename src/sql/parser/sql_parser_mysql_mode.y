@@ -22767,6 +22767,10 @@ INTNUM
 | relation_name
 {
   $$ = $1;
+}
+| INT8
+{
+  make_name_node($$, result->malloc_pool_, "int8");
 };
 
 /*===========================================================
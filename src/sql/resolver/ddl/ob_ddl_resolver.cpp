@@ -13120,6 +13120,8 @@ int ObDDLResolver::check_index_param(const ParseNode *option_node, ObString &ind
     bool m_is_set = false;
     bool ef_construction_is_set = false;
     bool ef_search_is_set = false;
+    bool is_hnsw_type = false;
+    bool is_float32_element = true;
 
     const ObString default_lib = "VSAG";
     const int64_t default_m_value = 16;
@@ -13139,7 +13141,9 @@ int ObDDLResolver::check_index_param(const ParseNode *option_node, ObString &ind
                    new_variable_name != "TYPE" &&
                    new_variable_name != "M" &&
                    new_variable_name != "EF_CONSTRUCTION" &&
-                   new_variable_name != "EF_SEARCH") {
+                   new_variable_name != "EF_SEARCH" &&
+                   new_variable_name != "BUILD_THREAD_NUM" &&
+                   new_variable_name != "ELEMENT_TYPE") {
           ret = OB_NOT_SUPPORTED;
           SQL_RESV_LOG(WARN, "unexpected vector variable name", K(ret), K(new_variable_name));
           LOG_USER_ERROR(OB_NOT_SUPPORTED, "unexpected vector index params items is");
@@ -13176,8 +13180,9 @@ int ObDDLResolver::check_index_param(const ParseNode *option_node, ObString &ind
             LOG_USER_ERROR(OB_NOT_SUPPORTED, "this type of vector index lib is");
           }
         } else if (last_variable == "TYPE") {
-          if (new_parser_name == "HNSW") {
+          if (new_parser_name == "HNSW" || new_parser_name == "HNSW_SQ" || new_parser_name == "DISKANN") {
             type_is_set = true;
+            is_hnsw_type = new_parser_name == "HNSW";
           } else {
             ret = OB_NOT_SUPPORTED;
             SQL_RESV_LOG(WARN, "not support vector index type", K(ret), K(new_parser_name));
@@ -13209,6 +13214,21 @@ int ObDDLResolver::check_index_param(const ParseNode *option_node, ObString &ind
             SQL_RESV_LOG(WARN, "invalid vector index ef_search value", K(ret), K(parser_value));
             LOG_USER_ERROR(OB_NOT_SUPPORTED, "this value of vector index ef_search is");
           }
+        } else if (last_variable == "BUILD_THREAD_NUM") {
+          if (parser_value < 1 || parser_value > 64) {
+            ret = OB_NOT_SUPPORTED;
+            SQL_RESV_LOG(WARN, "invalid vector index build_thread_num value", K(ret), K(parser_value));
+            LOG_USER_ERROR(OB_NOT_SUPPORTED, "this value of vector index build_thread_num is");
+          }
+        } else if (last_variable == "ELEMENT_TYPE") {
+          if (new_parser_name == "FLOAT32" || new_parser_name == "FLOAT16" ||
+              new_parser_name == "BFLOAT16" || new_parser_name == "INT8") {
+            is_float32_element = new_parser_name == "FLOAT32";
+          } else {
+            ret = OB_NOT_SUPPORTED;
+            SQL_RESV_LOG(WARN, "not support vector index element type", K(ret), K(new_parser_name));
+            LOG_USER_ERROR(OB_NOT_SUPPORTED, "this type of vector index element type is");
+          }
         } else {
           ret = OB_NOT_SUPPORTED;
           SQL_RESV_LOG(WARN, "not support vector index param", K(ret), K(last_variable));
@@ -13224,6 +13244,10 @@ int ObDDLResolver::check_index_param(const ParseNode *option_node, ObString &ind
         SQL_RESV_LOG(WARN, "unexpected setting of vector index param, distance or type has not been set",
           K(ret), K(distance_is_set), K(type_is_set));
         LOG_USER_ERROR(OB_NOT_SUPPORTED, "the vector index params of distance or type not set is");
+      } else if (!is_float32_element && !is_hnsw_type) {
+        ret = OB_NOT_SUPPORTED;
+        SQL_RESV_LOG(WARN, "vector index element type is only supported by hnsw", K(ret));
+        LOG_USER_ERROR(OB_NOT_SUPPORTED, "the vector index element type other than float32 with this index type is");
       } else if (ef_construction_value <= m_value) {
         ret = OB_NOT_SUPPORTED;
         SQL_RESV_LOG(WARN, "unexpected setting of vector index param, ef_construction value must be larger than m value",
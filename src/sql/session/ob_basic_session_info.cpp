@@ -3898,6 +3898,11 @@ int ObBasicSessionInfo::get_ob_hnsw_ef_search(uint64_t &ob_hnsw_ef_search) const
   return get_uint64_sys_var(SYS_VAR_OB_HNSW_EF_SEARCH, ob_hnsw_ef_search);
 }
 
+int ObBasicSessionInfo::get_ob_hnsw_target_recall(uint64_t &ob_hnsw_target_recall) const
+{
+  return get_uint64_sys_var(SYS_VAR_OB_HNSW_TARGET_RECALL, ob_hnsw_target_recall);
+}
+
 int ObBasicSessionInfo::get_sql_quote_show_create(bool &sql_quote_show_create) const
 {
   return get_bool_sys_var(SYS_VAR_SQL_QUOTE_SHOW_CREATE, sql_quote_show_create);
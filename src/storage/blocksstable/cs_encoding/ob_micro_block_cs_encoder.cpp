@@ -1131,6 +1131,10 @@ int ObMicroBlockCSEncoder::choose_encoder_(const int64_t column_idx)
     if (OB_FAIL(choose_encoder_for_integer_(column_idx, e))) {
       LOG_WARN("fail to choose encoder for integer", K(ret));
     }
+  } else if (is_fixed_len_vector_(column_idx)) {
+    if (OB_FAIL(alloc_and_init_encoder_<ObStringColumnEncoder>(column_idx, e))) {
+      LOG_WARN("fail to alloc encoder", K(ret), K(column_idx));
+    }
   } else if (is_string_store_(store_class, col_ctxs_.at(column_idx).is_wide_int_)) {
     if (OB_FAIL(choose_encoder_for_string_(column_idx, e))) {
       LOG_WARN("fail to choose encoder for variable length type", K(ret));
@@ -1196,6 +1200,18 @@ int ObMicroBlockCSEncoder::choose_encoder_for_integer_(
   return ret;
 }
 
+// Vectors of one column have the same dimension, so the in-row values have the same length.
+// The fixed length string stream keeps them back to back with a fixed stride and is decoded
+// without copy, while dict hardly finds duplicated vectors and costs a hash of every value.
+bool ObMicroBlockCSEncoder::is_fixed_len_vector_(const int64_t column_idx) const
+{
+  const ObColumnCSEncodingCtx &col_ctx = col_ctxs_.at(column_idx);
+  return ctx_.col_descs_->at(column_idx).col_type_.is_collection_sql_type()
+      && !has_lob_out_row_
+      && col_ctx.fix_data_size_ > 0
+      && !col_ctx.has_zero_length_datum_;
+}
+
 int ObMicroBlockCSEncoder::choose_encoder_for_string_(
   const int64_t column_idx, ObIColumnCSEncoder *&e)
 {
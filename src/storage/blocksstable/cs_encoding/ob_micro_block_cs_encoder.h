@@ -85,6 +85,7 @@ private:
   int choose_encoder_(const int64_t column_idx);
   int choose_encoder_for_integer_(const int64_t column_idx, ObIColumnCSEncoder *&e);
   int choose_encoder_for_string_(const int64_t column_idx, ObIColumnCSEncoder *&e);
+  bool is_fixed_len_vector_(const int64_t column_idx) const;
   int choose_specified_encoder_(const int64_t column_idx,
                                const ObObjTypeStoreClass store_class,
                                const ObCSColumnHeader::Type type,
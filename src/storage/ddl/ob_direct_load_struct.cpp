@@ -2173,6 +2173,76 @@ int ObVectorIndexSliceStore::append_row(const blocksstable::ObDatumRow &datum_ro
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(prepare_vector_buffer())) {
+    LOG_WARN("fail to prepare vector buffer", K(ret), KPC(this));
+  } else {
+    // get vid and vector
+    ObString vec_str;
+    int64_t vec_vid;
+    if (datum_row.get_column_count() <= vector_vid_col_idx_ || datum_row.get_column_count() <= vector_col_idx_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to get valid vector index col idx", K(ret), K(vector_col_idx_), K(vector_vid_col_idx_), K(datum_row));
+    } else if (datum_row.storage_datums_[vector_col_idx_].is_null()) {
+      // null vector is not indexed
+    } else if (FALSE_IT(vec_vid = datum_row.storage_datums_[vector_vid_col_idx_].get_int())) {
+    } else if (FALSE_IT(vec_str = datum_row.storage_datums_[vector_col_idx_].get_string())) {
+    } else if (OB_FAIL(ObTextStringHelper::read_real_string_data(&tmp_allocator_,
+                                                                  ObLongTextType,
+                                                                  CS_TYPE_BINARY,
+                                                                  true,
+                                                                  vec_str))) {
+      LOG_WARN("fail to get real data.", K(ret), K(vec_str));
+    } else if (vec_str.empty()) {
+      // empty vector is not indexed, same as null
+    } else if (OB_UNLIKELY(vec_str.length() != vec_dim_ * sizeof(float))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected vector length", K(ret), K(vec_str.length()), K(vec_dim_));
+    } else {
+      MEMCPY(vec_buf_ + buf_row_cnt_ * vec_dim_, vec_str.ptr(), vec_str.length());
+      vid_buf_[buf_row_cnt_++] = vec_vid;
+      if (buf_row_cnt_ >= buf_row_capacity_ && OB_FAIL(flush_vector_buffer())) {
+        LOG_WARN("fail to flush vector buffer", K(ret), KPC(this));
+      }
+    }
+  }
+  tmp_allocator_.reuse();
+  return ret;
+}
+
+int ObVectorIndexSliceStore::prepare_vector_buffer()
+{
+  int ret = OB_SUCCESS;
+  if (OB_NOT_NULL(vec_buf_)) {
+    // already prepared
+  } else if (OB_UNLIKELY(vec_dim_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected vector dim", K(ret), K(vec_dim_));
+  } else {
+    const int64_t row_size = vec_dim_ * sizeof(float);
+    buf_row_capacity_ = OB_MAX(1, OB_MIN(OB_VEC_IDX_BUILD_BATCH_MAX_ROW_CNT,
+                                         OB_VEC_IDX_BUILD_BATCH_MAX_MEM_SIZE / row_size));
+    buf_row_cnt_ = 0;
+    if (OB_ISNULL(vec_buf_ = static_cast<float *>(vec_allocator_.alloc(buf_row_capacity_ * row_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc vector buffer", K(ret), K(buf_row_capacity_), K(row_size));
+    } else if (OB_ISNULL(vid_buf_ = static_cast<int64_t *>(vec_allocator_.alloc(buf_row_capacity_ * sizeof(int64_t))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc vid buffer", K(ret), K(buf_row_capacity_));
+    }
+    if (OB_FAIL(ret)) {
+      vec_buf_ = nullptr;
+      vid_buf_ = nullptr;
+      buf_row_capacity_ = 0;
+    }
+  }
+  return ret;
+}
+
+int ObVectorIndexSliceStore::flush_vector_buffer()
+{
+  int ret = OB_SUCCESS;
+  if (buf_row_cnt_ <= 0) {
+    // nothing to flush
   } else {
     // append to vector inedx adaptor
     ObPluginVectorIndexService *vec_index_service = MTL(ObPluginVectorIndexService *);
@@ -2187,29 +2257,13 @@ int ObVectorIndexSliceStore::append_row(const blocksstable::ObDatumRow &datum_ro
                                                                 &vec_idx_param_,
                                                                 vec_dim_))) {
       LOG_WARN("fail to get ObMockPluginVectorIndexAdapter", K(ret), K(ctx_.ls_id_), K(tablet_id_));
+    } else if (OB_FAIL(adaptor_guard.get_adatper()->add_snap_index(vec_buf_, vid_buf_, buf_row_cnt_))) {
+      LOG_WARN("fail to build index to adaptor", K(ret), KPC(this));
     } else {
-      // get vid and vector
-      ObString vec_str;
-      int64_t vec_vid;
-      if (datum_row.get_column_count() <= vector_vid_col_idx_ || datum_row.get_column_count() <= vector_col_idx_) {
-        ret = OB_ERR_UNEXPECTED;
-        LOG_WARN("failed to get valid vector index col idx", K(ret), K(vector_col_idx_), K(vector_vid_col_idx_), K(datum_row));
-      } else if (FALSE_IT(vec_vid = datum_row.storage_datums_[vector_vid_col_idx_].get_int())) {
-      } else if (FALSE_IT(vec_str = datum_row.storage_datums_[vector_col_idx_].get_string())) {
-      } else if (OB_FAIL(ObTextStringHelper::read_real_string_data(&tmp_allocator_,
-                                                                    ObLongTextType,
-                                                                    CS_TYPE_BINARY,
-                                                                    true,
-                                                                    vec_str))) {
-        LOG_WARN("fail to get real data.", K(ret), K(vec_str));
-      } else if (OB_FAIL(adaptor_guard.get_adatper()->add_snap_index(reinterpret_cast<float*>(vec_str.ptr()), &vec_vid, 1))) {
-        LOG_WARN("fail to build index to adaptor", K(ret), KPC(this));
-      } else {
-        LOG_INFO("[vec index debug] add into snap index success", K(tablet_id_), K(vec_vid), K(vec_str));
-      }
+      LOG_INFO("[vec index debug] add into snap index success", K(tablet_id_), K(buf_row_cnt_));
+      buf_row_cnt_ = 0;
     }
   }
-  tmp_allocator_.reuse();
   return ret;
 }
 
@@ -2219,8 +2273,8 @@ int ObVectorIndexSliceStore::close()
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret));
-  } else {
-    // do nothing
+  } else if (OB_FAIL(flush_vector_buffer())) {
+    LOG_WARN("fail to flush vector buffer", K(ret), KPC(this));
   }
   return ret;
 }
@@ -2239,6 +2293,10 @@ void ObVectorIndexSliceStore::reset()
   vector_data_col_idx_ = -1;
   current_row_.reset();
   cur_row_pos_ = 0;
+  vec_buf_ = nullptr;
+  vid_buf_ = nullptr;
+  buf_row_cnt_ = 0;
+  buf_row_capacity_ = 0;
   vec_allocator_.reset();
   tmp_allocator_.reset();
 }
@@ -2253,7 +2311,9 @@ int ObVectorIndexSliceStore::serialize_vector_index(
   // first we do vsag serialize
   ObPluginVectorIndexService *vec_index_service = MTL(ObPluginVectorIndexService *);
   ObPluginVectorIndexAdapterGuard adaptor_guard;
-  if (OB_ISNULL(vec_index_service)) {
+  if (OB_FAIL(flush_vector_buffer())) {
+    LOG_WARN("fail to flush vector buffer", K(ret), KPC(this));
+  } else if (OB_ISNULL(vec_index_service)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("get null ObPluginVectorIndexService ptr", K(ret), K(MTL_ID()));
   } else if (OB_FAIL(vec_index_service->acquire_adapter_guard(ctx_.ls_id_,
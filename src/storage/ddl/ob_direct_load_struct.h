@@ -500,7 +500,8 @@ public:
       tmp_allocator_("VecIdxSSAR", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()),
       row_cnt_(0), ctx_(), tablet_id_(),
       vec_idx_param_(), vec_dim_(0), vector_vid_col_idx_(-1),
-      vector_col_idx_(-1), current_row_(), cur_row_pos_(0)
+      vector_col_idx_(-1), current_row_(), cur_row_pos_(0),
+      vec_buf_(nullptr), vid_buf_(nullptr), buf_row_cnt_(0), buf_row_capacity_(0)
   {}
   virtual ~ObVectorIndexSliceStore() { reset(); }
   int init(ObTabletDirectLoadMgr *tablet_direct_load_mgr,
@@ -525,7 +526,12 @@ public:
                K(vector_vid_col_idx_), K(vector_col_idx_), K(vector_key_col_idx_), K(vector_data_col_idx_));
 private:
   static const int64_t OB_VEC_IDX_SNAPSHOT_KEY_LENGTH = 256;
+  // rows are added into the snapshot index in batches so that vsag can build it with multiple threads
+  static const int64_t OB_VEC_IDX_BUILD_BATCH_MAX_ROW_CNT = 16384;
+  static const int64_t OB_VEC_IDX_BUILD_BATCH_MAX_MEM_SIZE = 64L * 1024L * 1024L; // 64MB
   bool is_vec_idx_col_invalid(const int64_t column_cnt) const;
+  int prepare_vector_buffer();
+  int flush_vector_buffer();
 public:
   bool is_inited_;
   ObArenaAllocator vec_allocator_;
@@ -541,6 +547,10 @@ public:
   int32_t vector_data_col_idx_;
   blocksstable::ObDatumRow current_row_;
   int64_t cur_row_pos_;
+  float *vec_buf_;
+  int64_t *vid_buf_;
+  int64_t buf_row_cnt_;
+  int64_t buf_row_capacity_;
 };
 
 class ObChunkSliceStore : public ObTabletSliceStore
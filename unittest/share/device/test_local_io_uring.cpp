@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <thread>
+#include <vector>
+#define private public
+#include "share/ob_local_io_uring.h"
+#undef private
+#include "lib/utility/ob_test_util.h"
+
+namespace oceanbase {
+namespace unittest {
+
+using namespace oceanbase::common;
+using namespace oceanbase::share;
+
+class TestLocalIOUring: public ::testing::Test
+{
+public:
+  static const int64_t BLOCK_SIZE = 4096;
+  static const int64_t BLOCK_CNT = 64;
+  TestLocalIOUring() : fd_(-1) {}
+  virtual ~TestLocalIOUring() {}
+  virtual void SetUp()
+  {
+    char path[] = "/tmp/test_local_io_uring_XXXXXX";
+    fd_ = ::mkstemp(path);
+    ASSERT_LE(0, fd_);
+    ::unlink(path);
+    ASSERT_EQ(0, ::ftruncate(fd_, BLOCK_SIZE * BLOCK_CNT));
+  }
+  virtual void TearDown()
+  {
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+  // the ring is not available on old kernels or when io_uring is disabled, e.g. in containers
+  bool init_ring(ObLocalIOUring &ring, const uint32_t entries, const bool use_sqpoll)
+  {
+    int ret = ring.init(entries, use_sqpoll);
+    if (OB_SUCCESS != ret) {
+      LOG_INFO("io uring is not available, skip the test", K(ret), K(use_sqpoll));
+    }
+    return OB_SUCCESS == ret;
+  }
+  // reap the completions until cnt of them are returned
+  void reap(ObLocalIOUring &ring, const int64_t cnt, std::vector<struct io_event> &events)
+  {
+    struct io_event batch[16];
+    struct timespec timeout;
+    timeout.tv_sec = 1;
+    timeout.tv_nsec = 0;
+    int64_t wait_cnt = 0;
+    while (static_cast<int64_t>(events.size()) < cnt && wait_cnt < 100) {
+      int64_t complete_cnt = 0;
+      ASSERT_EQ(OB_SUCCESS, ring.get_events(1, 16, batch, &timeout, complete_cnt));
+      if (0 == complete_cnt) {
+        ++wait_cnt;
+      }
+      for (int64_t i = 0; i < complete_cnt; ++i) {
+        events.push_back(batch[i]);
+      }
+    }
+    ASSERT_EQ(cnt, static_cast<int64_t>(events.size()));
+  }
+  void write_and_read(const bool use_sqpoll);
+protected:
+  int fd_;
+};
+
+void TestLocalIOUring::write_and_read(const bool use_sqpoll)
+{
+  ObLocalIOUring ring;
+  if (init_ring(ring, 32, use_sqpoll)) {
+    std::vector<char> write_buf(BLOCK_SIZE * BLOCK_CNT);
+    std::vector<char> read_buf(BLOCK_SIZE * BLOCK_CNT, 0);
+    for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+      MEMSET(&write_buf[i * BLOCK_SIZE], static_cast<int>('a' + i % 26), BLOCK_SIZE);
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+      const bool is_write = 0 == pass;
+      std::vector<struct iocb> cbs(BLOCK_CNT);
+      std::vector<struct io_event> events;
+      int64_t submit_cnt = 0;
+      // the ring holds 32 sqes, so the blocks are submitted in several rounds
+      while (submit_cnt < BLOCK_CNT) {
+        int64_t round_cnt = 0;
+        for (; submit_cnt < BLOCK_CNT; ++submit_cnt, ++round_cnt) {
+          struct iocb &cb = cbs[submit_cnt];
+          char *buf = is_write ? &write_buf[submit_cnt * BLOCK_SIZE]
+                               : &read_buf[submit_cnt * BLOCK_SIZE];
+          if (is_write) {
+            io_prep_pwrite(&cb, fd_, buf, BLOCK_SIZE, submit_cnt * BLOCK_SIZE);
+          } else {
+            io_prep_pread(&cb, fd_, buf, BLOCK_SIZE, submit_cnt * BLOCK_SIZE);
+          }
+          cb.data = &cb;
+          int ret = ring.submit(cb, ObLocalIOUring::NO_FIXED_BUFFER);
+          if (OB_EAGAIN == ret) {
+            break;
+          }
+          ASSERT_EQ(OB_SUCCESS, ret);
+        }
+        std::vector<struct io_event> round_events;
+        reap(ring, round_cnt, round_events);
+        events.insert(events.end(), round_events.begin(), round_events.end());
+      }
+      ASSERT_EQ(BLOCK_CNT, static_cast<int64_t>(events.size()));
+      for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+        ASSERT_EQ(BLOCK_SIZE, static_cast<int64_t>(events[i].res));
+        ASSERT_TRUE(events[i].data >= &cbs[0] && events[i].data <= &cbs[BLOCK_CNT - 1]);
+      }
+    }
+    ASSERT_EQ(0, MEMCMP(&write_buf[0], &read_buf[0], BLOCK_SIZE * BLOCK_CNT));
+    ASSERT_EQ(0U, ring.get_unsubmitted_cnt());
+  }
+}
+
+TEST_F(TestLocalIOUring, write_and_read)
+{
+  write_and_read(false);
+}
+
+TEST_F(TestLocalIOUring, write_and_read_sqpoll)
+{
+  write_and_read(true);
+}
+
+TEST_F(TestLocalIOUring, concurrent_submit)
+{
+  static const int64_t THREAD_CNT = 4;
+  static const int64_t IO_CNT_PER_THREAD = 256;
+  ObLocalIOUring ring;
+  if (init_ring(ring, 16, false)) {
+    std::vector<char> read_buf(BLOCK_SIZE * THREAD_CNT);
+    std::vector<struct iocb> cbs(THREAD_CNT * IO_CNT_PER_THREAD);
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < THREAD_CNT; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int64_t i = 0; i < IO_CNT_PER_THREAD; ++i) {
+          const int64_t idx = t * IO_CNT_PER_THREAD + i;
+          struct iocb &cb = cbs[idx];
+          io_prep_pread(&cb, fd_, &read_buf[t * BLOCK_SIZE], BLOCK_SIZE,
+                        (idx % BLOCK_CNT) * BLOCK_SIZE);
+          cb.data = reinterpret_cast<void *>(idx);
+          int ret = OB_SUCCESS;
+          // the reaper frees the sqes while the ring is full
+          while (OB_EAGAIN == (ret = ring.submit(cb, ObLocalIOUring::NO_FIXED_BUFFER))) {
+            ::usleep(100);
+          }
+          EXPECT_EQ(OB_SUCCESS, ret);
+        }
+      });
+    }
+    std::vector<struct io_event> events;
+    reap(ring, THREAD_CNT * IO_CNT_PER_THREAD, events);
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    // every io completes exactly once
+    std::vector<bool> completed(THREAD_CNT * IO_CNT_PER_THREAD, false);
+    for (const struct io_event &event : events) {
+      const int64_t idx = reinterpret_cast<int64_t>(event.data);
+      ASSERT_TRUE(idx >= 0 && idx < THREAD_CNT * IO_CNT_PER_THREAD);
+      ASSERT_FALSE(completed[idx]);
+      ASSERT_EQ(BLOCK_SIZE, static_cast<int64_t>(event.res));
+      completed[idx] = true;
+    }
+    ASSERT_EQ(0U, ring.get_unsubmitted_cnt());
+  }
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_local_io_uring.log");
+  OB_LOGGER.set_file_name("test_local_io_uring.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
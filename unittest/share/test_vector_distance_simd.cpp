@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2024 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SHARE
+#include <gtest/gtest.h>
+#include <float.h>
+#include <random>
+#include <vector>
+#include "common/ob_target_specific.h"
+#include "share/vector_type/ob_vector_l2_distance.h"
+#include "share/vector_type/ob_vector_ip_distance.h"
+#include "share/vector_type/ob_vector_l1_distance.h"
+#include "share/vector_type/ob_vector_norm.h"
+#include "share/vector_type/ob_vector_cosine_distance.h"
+
+namespace oceanbase {
+namespace common {
+
+static const int64_t TEST_LENS[] = {1, 7, 8, 15, 16, 17, 1000};
+
+class TestVectorDistanceSimd : public ::testing::Test
+{
+public:
+  TestVectorDistanceSimd() : rand_(0) {}
+  ~TestVectorDistanceSimd() {}
+
+  void gen_vector(const int64_t len, std::vector<float> &v)
+  {
+    std::uniform_real_distribution<float> dist(-10.0, 10.0);
+    v.resize(len);
+    for (int64_t i = 0; i < len; ++i) {
+      v[i] = dist(rand_);
+    }
+  }
+  // the simd funcs only differ from the normal funcs in the summation order
+  static double tolerance(const int64_t len, const double expect)
+  {
+    return 1e-6 * (len + fabs(expect));
+  }
+
+protected:
+  std::mt19937 rand_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(TestVectorDistanceSimd);
+};
+
+// runs the simd func of each arch supported by the cpu
+#define FOREACH_SUPPORTED_ARCH(func_prefix, ...)                                \
+  for (int arch_idx = 0; arch_idx < 2; ++arch_idx) {                            \
+    const bool is_avx512 = (1 == arch_idx);                                     \
+    if (!is_arch_supported(is_avx512 ? ObTargetArch::AVX512 : ObTargetArch::AVX2)) { \
+      continue;                                                                 \
+    }                                                                           \
+    auto simd_func = is_avx512 ? func_prefix##_avx512 : func_prefix##_avx2;     \
+    __VA_ARGS__                                                                 \
+  }
+
+TEST_F(TestVectorDistanceSimd, l2_square)
+{
+  std::vector<float> a;
+  std::vector<float> b;
+  for (int64_t len : TEST_LENS) {
+    gen_vector(len, a);
+    gen_vector(len, b);
+    double expect = 0;
+    double res = 0;
+    ASSERT_EQ(OB_SUCCESS, ObVectorL2Distance::l2_square_normal(a.data(), b.data(), len, expect));
+    ASSERT_EQ(OB_SUCCESS, ObVectorL2Distance::l2_square_func(a.data(), b.data(), len, res));
+    ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len;
+    FOREACH_SUPPORTED_ARCH(ObVectorL2Distance::l2_square, {
+      res = 0;
+      ASSERT_TRUE(simd_func(a.data(), b.data(), len, res)) << "len=" << len;
+      ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len << " avx512=" << is_avx512;
+    });
+  }
+}
+
+TEST_F(TestVectorDistanceSimd, ip_distance)
+{
+  std::vector<float> a;
+  std::vector<float> b;
+  for (int64_t len : TEST_LENS) {
+    gen_vector(len, a);
+    gen_vector(len, b);
+    // the inner product is accumulated into the output
+    const double init = 1.5;
+    double expect = init;
+    double res = init;
+    ASSERT_EQ(OB_SUCCESS, ObVectorIpDistance::ip_distance_normal(a.data(), b.data(), len, expect));
+    ASSERT_EQ(OB_SUCCESS, ObVectorIpDistance::ip_distance_func(a.data(), b.data(), len, res));
+    ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len;
+    FOREACH_SUPPORTED_ARCH(ObVectorIpDistance::ip_distance, {
+      res = init;
+      ASSERT_TRUE(simd_func(a.data(), b.data(), len, res)) << "len=" << len;
+      ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len << " avx512=" << is_avx512;
+    });
+  }
+}
+
+TEST_F(TestVectorDistanceSimd, l1_distance)
+{
+  std::vector<float> a;
+  std::vector<float> b;
+  for (int64_t len : TEST_LENS) {
+    gen_vector(len, a);
+    gen_vector(len, b);
+    double expect = 0;
+    double res = 0;
+    ASSERT_EQ(OB_SUCCESS, ObVectorL1Distance::l1_distance_normal(a.data(), b.data(), len, expect));
+    ASSERT_EQ(OB_SUCCESS, ObVectorL1Distance::l1_distance_func(a.data(), b.data(), len, res));
+    ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len;
+    FOREACH_SUPPORTED_ARCH(ObVectorL1Distance::l1_distance, {
+      res = 0;
+      ASSERT_TRUE(simd_func(a.data(), b.data(), len, res)) << "len=" << len;
+      ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len << " avx512=" << is_avx512;
+    });
+  }
+}
+
+TEST_F(TestVectorDistanceSimd, vector_norm_square)
+{
+  std::vector<float> a;
+  for (int64_t len : TEST_LENS) {
+    gen_vector(len, a);
+    double expect = 0;
+    double res = 0;
+    ASSERT_EQ(OB_SUCCESS, ObVectorNorm::vector_norm_square_normal(a.data(), len, expect));
+    ASSERT_EQ(OB_SUCCESS, ObVectorNorm::vector_norm_square_func(a.data(), len, res));
+    ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len;
+    FOREACH_SUPPORTED_ARCH(ObVectorNorm::vector_norm_square, {
+      res = 0;
+      ASSERT_TRUE(simd_func(a.data(), len, res)) << "len=" << len;
+      ASSERT_NEAR(expect, res, tolerance(len, expect)) << "len=" << len << " avx512=" << is_avx512;
+    });
+  }
+}
+
+TEST_F(TestVectorDistanceSimd, cosine)
+{
+  std::vector<float> a;
+  std::vector<float> b;
+  for (int64_t len : TEST_LENS) {
+    gen_vector(len, a);
+    gen_vector(len, b);
+    double ip = 0;
+    double abs_dist_a = 0;
+    double abs_dist_b = 0;
+    double expect = 0;
+    double res = 0;
+    ASSERT_EQ(OB_SUCCESS, ObVectorCosineDistance::cosine_calculate_normal(a.data(), b.data(), len,
+                                                                          ip, abs_dist_a, abs_dist_b));
+    ASSERT_EQ(OB_SUCCESS, ObVectorCosineDistance::cosine_similarity_normal(a.data(), b.data(), len, expect));
+    ASSERT_EQ(OB_SUCCESS, ObVectorCosineDistance::cosine_similarity_func(a.data(), b.data(), len, res));
+    ASSERT_NEAR(expect, res, 1e-6) << "len=" << len;
+    FOREACH_SUPPORTED_ARCH(ObVectorCosineDistance::cosine_calculate, {
+      double simd_ip = 0;
+      double simd_abs_dist_a = 0;
+      double simd_abs_dist_b = 0;
+      ASSERT_TRUE(simd_func(a.data(), b.data(), len, simd_ip, simd_abs_dist_a, simd_abs_dist_b));
+      ASSERT_NEAR(ip, simd_ip, tolerance(len, ip)) << "len=" << len << " avx512=" << is_avx512;
+      ASSERT_NEAR(abs_dist_a, simd_abs_dist_a, tolerance(len, abs_dist_a)) << "len=" << len;
+      ASSERT_NEAR(abs_dist_b, simd_abs_dist_b, tolerance(len, abs_dist_b)) << "len=" << len;
+    });
+  }
+  // zero vector has no direction
+  double similarity = 0;
+  a.assign(17, 0);
+  gen_vector(17, b);
+  ASSERT_EQ(OB_ERR_NULL_VALUE, ObVectorCosineDistance::cosine_similarity_func(a.data(), b.data(), 17, similarity));
+}
+
+// when the simd result is not finite the funcs fall back to the normal funcs, which report
+// the overflow, and nan is returned as it is.
+TEST_F(TestVectorDistanceSimd, non_finite_fallback)
+{
+  for (int64_t len : TEST_LENS) {
+    std::vector<float> big(len, FLT_MAX);
+    std::vector<float> neg_big(len, -FLT_MAX);
+    std::vector<float> nan_vec;
+    gen_vector(len, nan_vec);
+    nan_vec[len / 2] = NAN;
+    double res = 0;
+    double ip = 0;
+    double abs_dist_a = 0;
+    double abs_dist_b = 0;
+
+    ASSERT_EQ(OB_NUMERIC_OVERFLOW, ObVectorL2Distance::l2_square_func(big.data(), neg_big.data(), len, res));
+    ASSERT_EQ(OB_NUMERIC_OVERFLOW, ObVectorIpDistance::ip_distance_func(big.data(), big.data(), len, res = 0));
+    ASSERT_EQ(OB_NUMERIC_OVERFLOW, ObVectorL1Distance::l1_distance_func(big.data(), neg_big.data(), len, res = 0));
+    ASSERT_EQ(OB_NUMERIC_OVERFLOW, ObVectorNorm::vector_norm_square_func(big.data(), len, res));
+    ASSERT_EQ(OB_NUMERIC_OVERFLOW, ObVectorCosineDistance::cosine_similarity_func(big.data(), big.data(), len, res));
+    FOREACH_SUPPORTED_ARCH(ObVectorL2Distance::l2_square, {
+      ASSERT_FALSE(simd_func(big.data(), neg_big.data(), len, res));
+      ASSERT_FALSE(simd_func(nan_vec.data(), big.data(), len, res));
+    });
+    FOREACH_SUPPORTED_ARCH(ObVectorIpDistance::ip_distance, {
+      ASSERT_FALSE(simd_func(big.data(), big.data(), len, res = 0));
+      ASSERT_FALSE(simd_func(nan_vec.data(), nan_vec.data(), len, res = 0));
+    });
+    FOREACH_SUPPORTED_ARCH(ObVectorL1Distance::l1_distance, {
+      ASSERT_FALSE(simd_func(big.data(), neg_big.data(), len, res = 0));
+      ASSERT_FALSE(simd_func(nan_vec.data(), big.data(), len, res = 0));
+    });
+    FOREACH_SUPPORTED_ARCH(ObVectorNorm::vector_norm_square, {
+      ASSERT_FALSE(simd_func(big.data(), len, res));
+      ASSERT_FALSE(simd_func(nan_vec.data(), len, res));
+    });
+    FOREACH_SUPPORTED_ARCH(ObVectorCosineDistance::cosine_calculate, {
+      ASSERT_FALSE(simd_func(big.data(), big.data(), len, ip, abs_dist_a, abs_dist_b));
+      ASSERT_FALSE(simd_func(nan_vec.data(), nan_vec.data(), len, ip = 0, abs_dist_a = 0, abs_dist_b = 0));
+    });
+
+    // nan is not an overflow, the normal funcs return it as the result
+    ASSERT_EQ(OB_SUCCESS, ObVectorL2Distance::l2_square_func(nan_vec.data(), nan_vec.data(), len, res));
+    ASSERT_TRUE(std::isnan(res));
+    ASSERT_EQ(OB_SUCCESS, ObVectorIpDistance::ip_distance_func(nan_vec.data(), nan_vec.data(), len, res = 0));
+    ASSERT_TRUE(std::isnan(res));
+    ASSERT_EQ(OB_SUCCESS, ObVectorL1Distance::l1_distance_func(nan_vec.data(), nan_vec.data(), len, res = 0));
+    ASSERT_TRUE(std::isnan(res));
+    ASSERT_EQ(OB_SUCCESS, ObVectorNorm::vector_norm_square_func(nan_vec.data(), len, res));
+    ASSERT_TRUE(std::isnan(res));
+    ASSERT_EQ(OB_SUCCESS, ObVectorCosineDistance::cosine_similarity_func(nan_vec.data(), nan_vec.data(), len, res));
+    ASSERT_TRUE(std::isnan(res));
+  }
+}
+
+} // namespace common
+} // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "lib/container/ob_heap.h"
+#include "sql/engine/sort/ob_sort_vec_op_loser_tree.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+typedef std::vector<std::vector<int64_t>> Runs;
+
+// the next row of a sorted run
+struct RunCursor
+{
+  int64_t run_idx_;
+  int64_t pos_;
+};
+
+// same contract as the comparator of ObBinaryHeap: true if `r` should be output before `l`
+class RunCursorCmp
+{
+public:
+  explicit RunCursorCmp(const Runs &runs) : runs_(runs) {}
+  bool operator()(const RunCursor &l, const RunCursor &r)
+  {
+    return key(r) < key(l);
+  }
+  int get_error_code() { return OB_SUCCESS; }
+  int64_t key(const RunCursor &c) const { return runs_[c.run_idx_][c.pos_]; }
+private:
+  const Runs &runs_;
+};
+
+typedef ObSortVecOpLoserTree<RunCursor, RunCursorCmp> LoserTree;
+typedef ObBinaryHeap<RunCursor, RunCursorCmp> BinaryHeap;
+
+class TestSortVecOpLoserTree : public ::testing::Test
+{
+public:
+  TestSortVecOpLoserTree() : rand_(0) {}
+  virtual ~TestSortVecOpLoserTree() {}
+
+  void gen_runs(const std::vector<int64_t> &lens, const int64_t max_key, Runs &runs)
+  {
+    runs.clear();
+    for (int64_t len : lens) {
+      std::vector<int64_t> run;
+      for (int64_t i = 0; i < len; i++) {
+        run.push_back(static_cast<int64_t>(rand_() % max_key));
+      }
+      std::sort(run.begin(), run.end());
+      runs.push_back(run);
+    }
+  }
+
+  // merge the runs like ObSortVecOpImpl::heap_next: replace the top by the next row of its run,
+  // or pop it when the run is finished.
+  template <typename Heap>
+  void merge(Heap &heap, RunCursorCmp &cmp, const Runs &runs, std::vector<int64_t> &out)
+  {
+    std::vector<int64_t> fetched(runs.size(), 0);
+    while (!heap.empty()) {
+      RunCursor c = heap.top();
+      out.push_back(cmp.key(c));
+      ASSERT_EQ(fetched[c.run_idx_]++, c.pos_);
+      if (++c.pos_ < static_cast<int64_t>(runs[c.run_idx_].size())) {
+        ASSERT_EQ(OB_SUCCESS, heap.replace_top(c));
+      } else {
+        ASSERT_EQ(OB_SUCCESS, heap.pop());
+      }
+    }
+    // every row of every run is output exactly once, in the order of its run
+    for (int64_t i = 0; i < static_cast<int64_t>(runs.size()); i++) {
+      ASSERT_EQ(static_cast<int64_t>(runs[i].size()), fetched[i]);
+    }
+  }
+
+  void check_merge(const Runs &runs)
+  {
+    RunCursorCmp cmp(runs);
+    LoserTree tree(cmp);
+    BinaryHeap heap(cmp);
+    std::vector<int64_t> expect;
+    for (int64_t i = 0; i < static_cast<int64_t>(runs.size()); i++) {
+      expect.insert(expect.end(), runs[i].begin(), runs[i].end());
+      if (!runs[i].empty()) {
+        RunCursor c;
+        c.run_idx_ = i;
+        c.pos_ = 0;
+        ASSERT_EQ(OB_SUCCESS, tree.push(c));
+        ASSERT_EQ(OB_SUCCESS, heap.push(c));
+      }
+    }
+    std::sort(expect.begin(), expect.end());
+    ASSERT_EQ(OB_SUCCESS, tree.build());
+    ASSERT_EQ(heap.count(), tree.count());
+
+    std::vector<int64_t> tree_out;
+    std::vector<int64_t> heap_out;
+    merge(tree, cmp, runs, tree_out);
+    merge(heap, cmp, runs, heap_out);
+    ASSERT_EQ(expect, tree_out);
+    ASSERT_EQ(heap_out, tree_out);
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(0, tree.count());
+  }
+
+protected:
+  std::mt19937_64 rand_;
+};
+
+TEST_F(TestSortVecOpLoserTree, single_run)
+{
+  Runs runs;
+  gen_runs({1}, 100, runs);
+  check_merge(runs);
+  gen_runs({1000}, 100, runs);
+  check_merge(runs);
+}
+
+TEST_F(TestSortVecOpLoserTree, non_power_of_two_runs)
+{
+  const int64_t run_cnts[] = {2, 3, 5, 6, 7, 9, 13, 16, 17, 100};
+  for (int64_t run_cnt : run_cnts) {
+    Runs runs;
+    gen_runs(std::vector<int64_t>(run_cnt, 50), 1000, runs);
+    check_merge(runs);
+  }
+}
+
+TEST_F(TestSortVecOpLoserTree, runs_end_at_different_times)
+{
+  Runs runs;
+  // empty runs are never pushed, like the empty chunks of external merge sort
+  gen_runs({1, 0, 100, 7, 0, 33, 2}, 1000, runs);
+  check_merge(runs);
+  for (int64_t i = 0; i < 20; i++) {
+    std::vector<int64_t> lens;
+    for (int64_t run_cnt = 1 + rand_() % 23; run_cnt > 0; run_cnt--) {
+      lens.push_back(rand_() % 64);
+    }
+    gen_runs(lens, 1000, runs);
+    check_merge(runs);
+  }
+  // runs with disjoint keys finish one after another, the last run finishes first
+  runs.clear();
+  for (int64_t i = 5; i > 0; i--) {
+    std::vector<int64_t> run;
+    for (int64_t j = 0; j < 10 * i; j++) {
+      run.push_back(i * 1000 + j);
+    }
+    runs.push_back(run);
+  }
+  check_merge(runs);
+}
+
+TEST_F(TestSortVecOpLoserTree, duplicate_keys)
+{
+  Runs runs;
+  gen_runs({10, 20, 30, 40, 50}, 3, runs);
+  check_merge(runs);
+  // all keys are equal
+  runs.assign(7, std::vector<int64_t>(10, 42));
+  check_merge(runs);
+  // the same run repeated
+  gen_runs({64}, 8, runs);
+  runs.assign(6, runs[0]);
+  check_merge(runs);
+}
+
+TEST_F(TestSortVecOpLoserTree, no_run)
+{
+  Runs runs;
+  RunCursorCmp cmp(runs);
+  LoserTree tree(cmp);
+  ASSERT_EQ(OB_SUCCESS, tree.build());
+  ASSERT_TRUE(tree.empty());
+  RunCursor c;
+  c.run_idx_ = 0;
+  c.pos_ = 0;
+  ASSERT_EQ(OB_EMPTY_RESULT, tree.replace_top(c));
+  ASSERT_EQ(OB_EMPTY_RESULT, tree.pop());
+}
+
+TEST_F(TestSortVecOpLoserTree, fetch_before_build)
+{
+  Runs runs;
+  gen_runs({3, 4}, 100, runs);
+  RunCursorCmp cmp(runs);
+  LoserTree tree(cmp);
+  RunCursor c;
+  c.run_idx_ = 0;
+  c.pos_ = 0;
+  ASSERT_EQ(OB_SUCCESS, tree.push(c));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.replace_top(c));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.pop());
+  ASSERT_EQ(OB_SUCCESS, tree.build());
+  ASSERT_EQ(0, tree.top().run_idx_);
+  // pushing again requires another build
+  c.run_idx_ = 1;
+  ASSERT_EQ(OB_SUCCESS, tree.push(c));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.pop());
+  ASSERT_EQ(OB_SUCCESS, tree.build());
+  ASSERT_EQ(2, tree.count());
+  // reset drops the built tree
+  tree.reset();
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.pop());
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_sort_vec_op_loser_tree.log");
+  OB_LOGGER.set_file_name("test_sort_vec_op_loser_tree.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -620,6 +620,49 @@ TEST_F(TestCSEncoder, test_dict_const_ref_encoder)
   reuse();
 }
 
+TEST_F(TestCSEncoder, test_fixed_len_vector_encoder)
+{
+  const int64_t rowkey_cnt = 1;
+  const int64_t col_cnt = 2;
+  ObObjType col_types[col_cnt] = {ObIntType, ObCollectionSQLType};
+  ASSERT_EQ(OB_SUCCESS, prepare(col_types, rowkey_cnt, col_cnt));
+
+  // only 10 distinct vectors, dict would be smaller but vector column always use fixed length string
+  const int64_t row_cnt = 100;
+  const int64_t distinct_cnt = 10;
+  const int64_t dim = 4;
+  const int64_t vector_len = sizeof(ObLobCommon) + dim * sizeof(float);
+  ObMicroBlockCSEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, col_cnt));
+  for (int64_t i = 0; i < row_cnt; i++) {
+    char *vector_data = static_cast<char *>(allocator_.alloc(vector_len));
+    ASSERT_TRUE(nullptr != vector_data);
+    new (vector_data) ObLobCommon();
+    float *floats = reinterpret_cast<float *>(vector_data + sizeof(ObLobCommon));
+    for (int64_t j = 0; j < dim; j++) {
+      floats[j] = static_cast<float>(i % distinct_cnt + j);
+    }
+    row.storage_datums_[0].set_int(i);
+    row.storage_datums_[1].set_string(vector_data, vector_len);
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+  }
+  char *buf = nullptr;
+  int64_t buf_size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, buf_size));
+
+  ObIColumnCSEncoder *e = encoder.encoders_[1];
+  ASSERT_EQ(e->get_type(), ObCSColumnHeader::Type::STRING);
+  ASSERT_EQ(vector_len, e->ctx_->fix_data_size_);
+  ASSERT_EQ(false, e->get_column_header().has_null_bitmap());
+  ObStringColumnEncoder *str_encoder = reinterpret_cast<ObStringColumnEncoder *>(e);
+  ASSERT_EQ(true, str_encoder->enc_ctx_.meta_.is_fixed_len_string());
+  ASSERT_EQ(vector_len, str_encoder->enc_ctx_.meta_.get_fixed_string_len());
+  ASSERT_EQ(1, str_encoder->stream_offsets_.count());
+  reuse();
+}
+
 TEST_F(TestCSEncoder, test_decimal_int_encoder)
 {
   const int64_t rowkey_cnt = 1;